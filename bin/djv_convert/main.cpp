@@ -0,0 +1,658 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCmdLineApp/Application.h>
+
+#include <djvAV/AVSystem.h>
+#include <djvAV/IOSystem.h>
+
+#include <djvOCIO/OCIO.h>
+
+#include <djvImage/Convert.h>
+#include <djvImage/Data.h>
+#include <djvImage/InfoFunc.h>
+#include <djvImage/TypeFunc.h>
+
+#include <djvMath/FrameNumberFunc.h>
+
+#include <djvSystem/Context.h>
+#include <djvSystem/FileInfo.h>
+#include <djvSystem/LogSystem.h>
+#include <djvSystem/TextSystem.h>
+#include <djvSystem/ThreadPool.h>
+
+#include <djvCore/ErrorFunc.h>
+#include <djvCore/MemoryFunc.h>
+#include <djvCore/StringFormat.h>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <thread>
+
+using namespace djv;
+
+namespace _OCIO = OCIO_NAMESPACE;
+
+namespace
+{
+    const size_t threadCountDefault = 4;
+    const size_t queueSizeDefault   = 4;
+
+    //! \todo Should this be configurable?
+    const size_t timeout = 1;
+
+    //! This struct provides the statistics for a pipeline stage. The time is
+    //! measured from the start of the pipeline to the last frame the stage
+    //! has finished.
+    struct Stats
+    {
+        size_t frameCount = 0;
+        size_t byteCount  = 0;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point end;
+
+        void add(const std::shared_ptr<Image::Data>& image)
+        {
+            end = std::chrono::steady_clock::now();
+            ++frameCount;
+            byteCount += image ? image->getDataByteCount() : 0;
+        }
+    };
+
+} // namespace
+
+class Application : public CmdLine::Application
+{
+    DJV_NON_COPYABLE(Application);
+
+protected:
+    void _init(std::list<std::string>&);
+
+    Application();
+
+public:
+    ~Application() override;
+
+    static std::shared_ptr<Application> create(std::list<std::string>&);
+
+    void run() override;
+
+protected:
+    void _parseCmdLine(std::list<std::string>&) override;
+    void _printUsage() override;
+
+private:
+    std::vector<std::string> _getArgs(std::list<std::string>&, std::list<std::string>::iterator&, const std::string&, size_t count = 1);
+    std::string _getArg(std::list<std::string>&, std::list<std::string>::iterator&, const std::string&);
+    size_t _getThreadCount(std::list<std::string>&, std::list<std::string>::iterator&, const std::string&);
+
+    void _convertThread();
+    std::shared_ptr<Image::Data> _convert(const std::shared_ptr<Image::Data>&, Image::Convert&);
+
+    void _printStats(const std::string& name, const Stats&);
+
+    std::string _input;
+    std::string _output;
+    std::unique_ptr<Math::Frame::Range> _frames;
+    size_t _layer = 0;
+    std::unique_ptr<Image::Size> _resize;
+    std::unique_ptr<Image::Type> _type;
+    OCIO::Convert _colorSpace;
+    std::map<std::string, std::string> _writeOptions;
+    size_t _readThreadCount = threadCountDefault;
+    size_t _convertThreadCount = threadCountDefault;
+    size_t _writeThreadCount = threadCountDefault;
+    size_t _queueSize = queueSizeDefault;
+
+    _OCIO::ConstProcessorRcPtr _ocioProcessor;
+
+    // The frames waiting to be converted and the converted frames waiting
+    // to be written in order.
+    std::mutex _mutex;
+    std::condition_variable _convertCV;
+    std::list<AV::IO::VideoFrame> _convertQueue;
+    std::map<Math::Frame::Number, std::shared_ptr<Image::Data> > _converted;
+    size_t _convertActive = 0;
+    bool _running = false;
+    Stats _convertStats;
+    std::vector<std::thread> _convertThreads;
+};
+
+void Application::_init(std::list<std::string>& args)
+{
+    CmdLine::Application::_init(args, false);
+
+    _parseCmdLine(args);
+}
+
+Application::Application()
+{}
+
+Application::~Application()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _convertCV.notify_all();
+    for (auto& i : _convertThreads)
+    {
+        if (i.joinable())
+        {
+            i.join();
+        }
+    }
+}
+
+std::shared_ptr<Application> Application::create(std::list<std::string>& args)
+{
+    auto out = std::shared_ptr<Application>(new Application);
+    out->_init(args);
+    return out;
+}
+
+void Application::run()
+{
+    auto textSystem = getSystemT<System::TextSystem>();
+    auto io = getSystemT<AV::IO::IOSystem>();
+    for (const auto& i : _writeOptions)
+    {
+        rapidjson::Document document;
+        rapidjson::ParseResult result = document.Parse(i.second.c_str(), i.second.size());
+        if (!result)
+        {
+            throw std::runtime_error(Core::String::Format("{0}: {1}").
+                arg(i.first).
+                arg(textSystem->getText(DJV_TEXT("djv_convert_write_options_error"))));
+        }
+        io->setOptions(i.first, document);
+    }
+    if (_colorSpace.isValid())
+    {
+        _ocioProcessor = _OCIO::GetCurrentConfig()->getProcessor(
+            _colorSpace.input.c_str(),
+            _colorSpace.output.c_str());
+    }
+
+    // Open the input. Each stage has its own thread pool so that the thread
+    // budgets are independent.
+    AV::IO::ReadOptions readOptions;
+    readOptions.layer = _layer;
+    readOptions.videoQueueSize = _queueSize;
+    readOptions.threadPool = System::ThreadPool::create(_readThreadCount);
+    const System::File::Info inputFileInfo(_input);
+    auto read = io->read(inputFileInfo, readOptions);
+    const auto info = read->getInfo().get();
+    if (_layer >= info.video.size())
+    {
+        throw std::runtime_error(Core::String::Format("{0}: {1}").
+            arg(_input).
+            arg(textSystem->getText(DJV_TEXT("djv_convert_layer_error"))));
+    }
+    const size_t sequenceFrameCount = info.videoSequence.getFrameCount();
+    Math::Frame::Index inIndex = 0;
+    Math::Frame::Index outIndex = sequenceFrameCount > 0 ? sequenceFrameCount - 1 : 0;
+    if (_frames && sequenceFrameCount > 0)
+    {
+        inIndex = info.videoSequence.getIndex(_frames->getMin());
+        outIndex = info.videoSequence.getIndex(_frames->getMax());
+        if (Math::Frame::invalidIndex == inIndex || Math::Frame::invalidIndex == outIndex)
+        {
+            throw std::runtime_error(Core::String::Format("{0}: {1}").
+                arg(_input).
+                arg(textSystem->getText(DJV_TEXT("djv_convert_frames_error"))));
+        }
+    }
+    const size_t frameCount = static_cast<size_t>(outIndex - inIndex + 1);
+
+    // The sequence readers read half of their thread count at a time during
+    // playback.
+    read->setThreadCount(_readThreadCount * 2);
+    read->setCacheEnabled(false);
+    read->setInOutPoints(AV::IO::InOutPoints(true, inIndex, outIndex));
+    read->seek(inIndex, AV::IO::Direction::Forward);
+    read->setPlayback(true);
+
+    // Open the output. If the output file name has a frame number the frames
+    // are written as a sequence starting at that number.
+    const auto& inImageInfo = info.video[_layer];
+    Image::Info outImageInfo(
+        _resize ? *_resize : inImageInfo.size,
+        _type ? *_type : inImageInfo.type);
+    outImageInfo.pixelAspectRatio = inImageInfo.pixelAspectRatio;
+    AV::IO::Info outInfo;
+    outInfo.videoSpeed = info.videoSpeed;
+    outInfo.video.push_back(outImageInfo);
+    outInfo.tags = info.tags;
+    const System::File::Path outputPath(_output);
+    System::File::Info outputFileInfo(outputPath);
+    const std::string& number = outputPath.getNumber();
+    if (!number.empty() && frameCount > 1)
+    {
+        const Math::Frame::Number start = std::stoi(number);
+        const size_t pad = number.size() > 1 && '0' == number[0] ? number.size() : 0;
+        outInfo.videoSequence = Math::Frame::Sequence(start, start + frameCount - 1, pad);
+        outputFileInfo = System::File::Info(outputPath, System::File::Type::Sequence, outInfo.videoSequence);
+    }
+    else
+    {
+        outInfo.videoSequence = Math::Frame::Sequence(0, frameCount - 1);
+    }
+    AV::IO::WriteOptions writeOptions;
+    writeOptions.videoQueueSize = _queueSize;
+    writeOptions.threadPool = System::ThreadPool::create(_writeThreadCount);
+    auto write = io->write(outputFileInfo, outInfo, writeOptions);
+    write->setThreadCount(_writeThreadCount);
+
+    // Start the conversion threads.
+    const auto start = std::chrono::steady_clock::now();
+    Stats readStats;
+    Stats writeStats;
+    readStats.start = readStats.end = start;
+    writeStats.start = writeStats.end = start;
+    _convertStats.start = _convertStats.end = start;
+    _running = true;
+    for (size_t i = 0; i < _convertThreadCount; ++i)
+    {
+        _convertThreads.push_back(std::thread(
+            [this]
+            {
+                _convertThread();
+            }));
+    }
+
+    // Move the frames between the stages until they have all been written.
+    Math::Frame::Index readFrame = inIndex;
+    Math::Frame::Index writeFrame = inIndex;
+    bool readFinished = false;
+    bool writeFinished = false;
+    size_t errorCount = 0;
+    while (write->isRunning())
+    {
+        bool progress = false;
+
+        // Read -> convert.
+        if (!readFinished)
+        {
+            std::lock_guard<std::mutex> readLock(read->getMutex());
+            auto& readQueue = read->getVideoQueue();
+            while (!readQueue.isEmpty() && readFrame <= outIndex)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    const size_t pending = _convertQueue.size() + _convertActive + _converted.size();
+                    if (_convertQueue.size() >= _queueSize || pending >= _queueSize + _convertThreadCount)
+                    {
+                        break;
+                    }
+                }
+                auto frame = readQueue.popFrame();
+                readStats.add(frame.data);
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _convertQueue.push_back(AV::IO::VideoFrame(readFrame, frame.data));
+                }
+                _convertCV.notify_one();
+                ++readFrame;
+                progress = true;
+            }
+            readFinished = readFrame > outIndex || (readQueue.isEmpty() && readQueue.isFinished());
+        }
+
+        // Convert -> write, in order.
+        if (!writeFinished)
+        {
+            std::lock_guard<std::mutex> writeLock(write->getMutex());
+            auto& writeQueue = write->getVideoQueue();
+            std::lock_guard<std::mutex> lock(_mutex);
+            while (writeQueue.getCount() < writeQueue.getMax())
+            {
+                const auto i = _converted.find(writeFrame);
+                if (i == _converted.end())
+                {
+                    break;
+                }
+                if (i->second)
+                {
+                    writeStats.add(i->second);
+                    writeQueue.addFrame(AV::IO::VideoFrame(writeFrame, i->second));
+                }
+                else
+                {
+                    ++errorCount;
+                }
+                _converted.erase(i);
+                ++writeFrame;
+                progress = true;
+            }
+            if (readFinished && writeFrame == readFrame)
+            {
+                writeQueue.setFinished(true);
+                writeFinished = true;
+            }
+        }
+
+        tick();
+        if (!progress)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+        }
+    }
+    writeStats.end = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _convertCV.notify_all();
+    for (auto& i : _convertThreads)
+    {
+        i.join();
+    }
+    _convertThreads.clear();
+
+    _printStats(textSystem->getText(DJV_TEXT("djv_convert_stats_read")), readStats);
+    _printStats(textSystem->getText(DJV_TEXT("djv_convert_stats_convert")), _convertStats);
+    _printStats(textSystem->getText(DJV_TEXT("djv_convert_stats_write")), writeStats);
+
+    if (errorCount > 0 || writeFrame != readFrame || static_cast<size_t>(readFrame - inIndex) != frameCount)
+    {
+        std::cout << Core::Error::format(textSystem->getText(DJV_TEXT("djv_convert_error"))) << std::endl;
+        exit(1);
+    }
+}
+
+void Application::_parseCmdLine(std::list<std::string>& args)
+{
+    CmdLine::Application::_parseCmdLine(args);
+    if (0 == getExitCode())
+    {
+        auto textSystem = getSystemT<System::TextSystem>();
+        auto i = args.begin();
+        while (i != args.end())
+        {
+            if ("-frames" == *i)
+            {
+                Math::Frame::Range value;
+                size_t pad = 0;
+                Math::Frame::fromString(_getArg(args, i, "-frames"), value, pad);
+                _frames.reset(new Math::Frame::Range(value));
+            }
+            else if ("-layer" == *i)
+            {
+                std::stringstream ss(_getArg(args, i, "-layer"));
+                int value = 0;
+                ss >> value;
+                _layer = static_cast<size_t>(std::max(value, 0));
+            }
+            else if ("-resize" == *i)
+            {
+                std::stringstream ss(_getArg(args, i, "-resize"));
+                Image::Size value;
+                ss >> value;
+                _resize.reset(new Image::Size(value));
+            }
+            else if ("-type" == *i)
+            {
+                std::stringstream ss(_getArg(args, i, "-type"));
+                Image::Type value = Image::Type::None;
+                ss >> value;
+                _type.reset(new Image::Type(value));
+            }
+            else if ("-color_space" == *i)
+            {
+                const auto values = _getArgs(args, i, "-color_space", 2);
+                _colorSpace = OCIO::Convert(values[0], values[1]);
+            }
+            else if ("-write_options" == *i)
+            {
+                const auto values = _getArgs(args, i, "-write_options", 2);
+                _writeOptions[values[0]] = values[1];
+            }
+            else if ("-read_threads" == *i)
+            {
+                _readThreadCount = _getThreadCount(args, i, "-read_threads");
+            }
+            else if ("-convert_threads" == *i)
+            {
+                _convertThreadCount = _getThreadCount(args, i, "-convert_threads");
+            }
+            else if ("-write_threads" == *i)
+            {
+                _writeThreadCount = _getThreadCount(args, i, "-write_threads");
+            }
+            else if ("-queue_size" == *i)
+            {
+                _queueSize = _getThreadCount(args, i, "-queue_size");
+            }
+            else
+            {
+                ++i;
+            }
+        }
+        if (!args.size())
+        {
+            _printUsage();
+            exit(1);
+        }
+        else if (2 == args.size())
+        {
+            _input = args.front();
+            args.pop_front();
+            _output = args.front();
+            args.pop_front();
+        }
+        else
+        {
+            throw std::runtime_error(textSystem->getText(DJV_TEXT("djv_convert_input_output_error")));
+        }
+    }
+}
+
+void Application::_printUsage()
+{
+    auto textSystem = getSystemT<System::TextSystem>();
+    std::cout << std::endl;
+    std::cout << " " << textSystem->getText(DJV_TEXT("djv_convert_cli_description")) << std::endl;
+    std::cout << std::endl;
+    std::cout << " " << textSystem->getText(DJV_TEXT("djv_convert_cli_usage")) << std::endl;
+    std::cout << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_usage_format")) << std::endl;
+    std::cout << std::endl;
+    std::cout << " " << textSystem->getText(DJV_TEXT("djv_convert_cli_options")) << std::endl;
+    std::cout << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_frames")) << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_frames_description")) << std::endl;
+    std::cout << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_layer")) << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_layer_description")) << std::endl;
+    std::cout << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_resize")) << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_resize_description")) << std::endl;
+    std::cout << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_type")) << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_type_description")) << std::endl;
+    std::cout << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_color_space")) << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_color_space_description")) << std::endl;
+    std::cout << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_write_options")) << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_write_options_description")) << std::endl;
+    std::cout << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_threads")) << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_threads_description")) << threadCountDefault << std::endl;
+    std::cout << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_queue_size")) << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_queue_size_description")) << queueSizeDefault << std::endl;
+    std::cout << std::endl;
+    std::cout << " " << textSystem->getText(DJV_TEXT("djv_convert_cli_examples")) << std::endl;
+    std::cout << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_example_1")) << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_example_1_description")) << std::endl;
+    std::cout << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_example_2")) << std::endl;
+    std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_example_2_description")) << std::endl;
+    std::cout << std::endl;
+
+    CmdLine::Application::_printUsage();
+}
+
+std::vector<std::string> Application::_getArgs(
+    std::list<std::string>& args,
+    std::list<std::string>::iterator& i,
+    const std::string& name,
+    size_t count)
+{
+    std::vector<std::string> out;
+    i = args.erase(i);
+    for (size_t j = 0; j < count; ++j)
+    {
+        if (args.end() == i)
+        {
+            auto textSystem = getSystemT<System::TextSystem>();
+            throw std::runtime_error(Core::String::Format("{0}: {1}").
+                arg(name).
+                arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+        }
+        out.push_back(*i);
+        i = args.erase(i);
+    }
+    return out;
+}
+
+std::string Application::_getArg(
+    std::list<std::string>& args,
+    std::list<std::string>::iterator& i,
+    const std::string& name)
+{
+    return _getArgs(args, i, name)[0];
+}
+
+size_t Application::_getThreadCount(
+    std::list<std::string>& args,
+    std::list<std::string>::iterator& i,
+    const std::string& name)
+{
+    std::stringstream ss(_getArg(args, i, name));
+    int value = 0;
+    ss >> value;
+    return static_cast<size_t>(std::max(value, 1));
+}
+
+void Application::_convertThread()
+{
+    auto convert = Image::Convert::create();
+    while (true)
+    {
+        AV::IO::VideoFrame frame;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _convertCV.wait(
+                lock,
+                [this]
+                {
+                    return !_running || !_convertQueue.empty();
+                });
+            if (!_running)
+            {
+                break;
+            }
+            frame = _convertQueue.front();
+            _convertQueue.pop_front();
+            ++_convertActive;
+        }
+        std::shared_ptr<Image::Data> image;
+        try
+        {
+            image = _convert(frame.data, *convert);
+        }
+        catch (const std::exception& e)
+        {
+            getSystemT<System::LogSystem>()->log("djv_convert", e.what(), System::LogLevel::Error);
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_convertActive;
+            _converted[frame.frame] = image;
+            _convertStats.add(image);
+        }
+    }
+}
+
+std::shared_ptr<Image::Data> Application::_convert(const std::shared_ptr<Image::Data>& image, Image::Convert& convert)
+{
+    std::shared_ptr<Image::Data> out = image;
+    if (out)
+    {
+        const auto& info = image->getInfo();
+        Image::Info outInfo(
+            _resize ? *_resize : info.size,
+            _type ? *_type : info.type);
+        outInfo.pixelAspectRatio = info.pixelAspectRatio;
+
+        // The color space conversion is done on 32-bit float RGBA data.
+        if (_ocioProcessor)
+        {
+            Image::Info floatInfo(outInfo.size, Image::Type::RGBA_F32);
+            floatInfo.pixelAspectRatio = info.pixelAspectRatio;
+            auto floatImage = Image::Data::create(floatInfo);
+            convert.process(*out, floatInfo, *floatImage);
+            _OCIO::PackedImageDesc imageDesc(
+                reinterpret_cast<float*>(floatImage->getData()),
+                floatInfo.size.w,
+                floatInfo.size.h,
+                4);
+            _ocioProcessor->apply(imageDesc);
+            out = floatImage;
+        }
+
+        if (out->getInfo() != outInfo)
+        {
+            auto tmp = Image::Data::create(outInfo);
+            convert.process(*out, outInfo, *tmp);
+            out = tmp;
+        }
+        if (out != image)
+        {
+            out->setPluginName(image->getPluginName());
+            out->setTags(image->getTags());
+        }
+    }
+    return out;
+}
+
+void Application::_printStats(const std::string& name, const Stats& stats)
+{
+    const double seconds = std::chrono::duration<double>(stats.end - stats.start).count();
+    const double megabytes = stats.byteCount / static_cast<double>(Core::Memory::megabyte);
+    std::cout << std::setw(8) << std::left << name << ": " << stats.frameCount << " frames, ";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << megabytes << " MB, " << seconds << " s, ";
+    std::cout << (seconds > 0.0 ? stats.frameCount / seconds : 0.0) << " frames/s, ";
+    std::cout << (seconds > 0.0 ? megabytes / seconds : 0.0) << " MB/s" << std::endl;
+}
+
+DJV_MAIN()
+{
+    int r = 1;
+    try
+    {
+        auto args = Application::args(argc, argv);
+        auto app = Application::create(args);
+        if (0 == app->getExitCode())
+        {
+            app->run();
+        }
+        r = app->getExitCode();
+    }
+    catch (const std::exception & e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
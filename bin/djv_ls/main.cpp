@@ -23,7 +23,7 @@ class Application : public CmdLine::Application
 protected:
     void _init(std::list<std::string>& args)
     {
-        CmdLine::Application::_init(args);
+        CmdLine::Application::_init(args, false);
 
         _parseCmdLine(args);
 
@@ -7,6 +7,7 @@
 #include <djvAV/IOSystem.h>
 #include <djvAV/SpeedFunc.h>
 #include <djvAV/ThumbnailSystem.h>
+#include <djvAV/WaveformSystem.h>
 
 #include <djvOCIO/OCIOSystem.h>
 
@@ -30,9 +31,10 @@ namespace djv
             std::shared_ptr<Observer::ValueSubject<Time::Units> > timeUnits;
             std::shared_ptr<Observer::ValueSubject<FPS> > defaultSpeed;
             std::shared_ptr<ThumbnailSystem> thumbnailSystem;
+            std::shared_ptr<WaveformSystem> waveformSystem;
         };
 
-        void AVSystem::_init(const std::shared_ptr<System::Context>& context)
+        void AVSystem::_init(const std::shared_ptr<System::Context>& context, bool gl)
         {
             ISystem::_init("djv::AV::AVSystem", context);
 
@@ -41,17 +43,26 @@ namespace djv
             p.defaultSpeed = Observer::ValueSubject<FPS>::create(getDefaultSpeed());
 
             auto audioSystem = Audio::AudioSystem::create(context);
-            auto glfwSystem = GL::GLFW::GLFWSystem::create(context);
-            auto shaderSystem = GL::ShaderSystem::create(context);
+            addDependency(audioSystem);
+            if (gl)
+            {
+                auto glfwSystem = GL::GLFW::GLFWSystem::create(context);
+                auto shaderSystem = GL::ShaderSystem::create(context);
+                addDependency(glfwSystem);
+                addDependency(shaderSystem);
+            }
+            else
+            {
+                _log("Headless, OpenGL is disabled");
+            }
             auto ocioSystem = OCIO::OCIOSystem::create(context);
             auto ioSystem = IO::IOSystem::create(context);
             p.thumbnailSystem = ThumbnailSystem::create(context);
-            addDependency(audioSystem);
-            addDependency(glfwSystem);
-            addDependency(shaderSystem);
+            p.waveformSystem = WaveformSystem::create(context);
             addDependency(ocioSystem);
             addDependency(ioSystem);
             addDependency(p.thumbnailSystem);
+            addDependency(p.waveformSystem);
 
             _logInitTime();
         }
@@ -63,13 +74,13 @@ namespace djv
         AVSystem::~AVSystem()
         {}
 
-        std::shared_ptr<AVSystem> AVSystem::create(const std::shared_ptr<System::Context>& context)
+        std::shared_ptr<AVSystem> AVSystem::create(const std::shared_ptr<System::Context>& context, bool gl)
         {
             auto out = context->getSystemT<AVSystem>();
             if (!out)
             {
                 out = std::shared_ptr<AVSystem>(new AVSystem);
-                out->_init(context);
+                out->_init(context, gl);
             }
             return out;
         }
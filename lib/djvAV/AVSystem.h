@@ -16,18 +16,23 @@ namespace djv
     namespace AV
     {
         //! This class provides an AV system.
+        //!
+        //! The system can be created without OpenGL for headless use, in
+        //! which case the GLFW and shader systems are not created and the
+        //! I/O and thumbnail systems convert images on the CPU.
         class AVSystem : public System::ISystem
         {
             DJV_NON_COPYABLE(AVSystem);
 
         protected:
-            void _init(const std::shared_ptr<System::Context>&);
+            void _init(const std::shared_ptr<System::Context>&, bool gl);
             AVSystem();
 
         public:
             ~AVSystem() override;
 
-            static std::shared_ptr<AVSystem> create(const std::shared_ptr<System::Context>&);
+            //! Create a new AV system, or return the existing one.
+            static std::shared_ptr<AVSystem> create(const std::shared_ptr<System::Context>&, bool gl = true);
 
             std::shared_ptr<Core::Observer::IValueSubject<Time::Units> > observeTimeUnits() const;
             std::shared_ptr<Core::Observer::IValueSubject<FPS> > observeDefaultSpeed() const;
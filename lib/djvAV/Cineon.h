@@ -181,13 +181,25 @@ namespace djv
                         const std::shared_ptr<System::ResourceSystem>&,
                         const std::shared_ptr<System::LogSystem>&);
 
+                    //! Read the image data of a file. Proxies are read with
+                    //! decimated reads and regions of interest with a read
+                    //! for each scanline.
                     static std::shared_ptr<Image::Data> readImage(
                         const Info&,
-                        const std::shared_ptr<System::File::IO>&);
+                        const std::shared_ptr<System::File::IO>&,
+                        const ReadOptions& = ReadOptions());
+
+                    //! Create an image for reading the data of a file.
+                    static std::shared_ptr<Image::Data> createImage(const Info&);
+
+                    //! Convert the image data after it has been read.
+                    static void convertImage(const Info&, Image::Data&);
 
                 protected:
                     Info _readInfo(const std::string&) override;
                     std::shared_ptr<Image::Data> _readImage(const std::string&) override;
+                    bool _canReadAsync() const override;
+                    void _readImageAsync(const std::string&, const ReadCallback&) override;
 
                 private:
                     Info _open(const std::string&, const std::shared_ptr<System::File::IO>&);
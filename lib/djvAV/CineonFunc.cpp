@@ -197,6 +197,90 @@ namespace djv
 
                 } // namespace
 
+                void readTags(const Header& header, Info& info)
+                {
+                    if (isValid(header.file.time, 24))
+                    {
+                        info.tags.set("Time", toString(header.file.time, 24));
+                    }
+                    if (isValid(&header.source.offset[0]) && isValid(&header.source.offset[1]))
+                    {
+                        std::stringstream ss;
+                        ss << header.source.offset[0] << " " << header.source.offset[1];
+                        info.tags.set("Source Offset", ss.str());
+                    }
+                    if (isValid(header.source.file, 100))
+                    {
+                        info.tags.set("Source File", toString(header.source.file, 100));
+                    }
+                    if (isValid(header.source.time, 24))
+                    {
+                        info.tags.set("Source Time", toString(header.source.time, 24));
+                    }
+                    if (isValid(header.source.inputDevice, 64))
+                    {
+                        info.tags.set("Source Input Device", toString(header.source.inputDevice, 64));
+                    }
+                    if (isValid(header.source.inputModel, 32))
+                    {
+                        info.tags.set("Source Input Model", toString(header.source.inputModel, 32));
+                    }
+                    if (isValid(header.source.inputSerial, 32))
+                    {
+                        info.tags.set("Source Input Serial", toString(header.source.inputSerial, 32));
+                    }
+                    if (isValid(&header.source.inputPitch[0]) && isValid(&header.source.inputPitch[1]))
+                    {
+                        std::stringstream ss;
+                        ss << header.source.inputPitch[0] << " " << header.source.inputPitch[1];
+                        info.tags.set("Source Input Pitch", ss.str());
+                    }
+                    if (isValid(&header.source.gamma))
+                    {
+                        std::stringstream ss;
+                        ss << header.source.gamma;
+                        info.tags.set("Source Gamma", ss.str());
+                    }
+                    if (isValid(&header.film.id) &&
+                        isValid(&header.film.type) &&
+                        isValid(&header.film.offset) &&
+                        isValid(&header.film.prefix) &&
+                        isValid(&header.film.count))
+                    {
+                        info.tags.set( "Keycode", Time::keycodeToString(
+                            header.film.id,
+                            header.film.type,
+                            header.film.prefix,
+                            header.film.count,
+                            header.film.offset));
+                    }
+                    if (isValid(header.film.format, 32))
+                    {
+                        info.tags.set("Film Format", toString(header.film.format, 32));
+                    }
+                    if (isValid(&header.film.frame))
+                    {
+                        std::stringstream ss;
+                        ss << header.film.frame;
+                        info.tags.set("Film Frame", ss.str());
+                    }
+                    if (isValid(&header.film.frameRate) && header.film.frameRate >= _minSpeed)
+                    {
+                        info.videoSpeed = fromSpeed(header.film.frameRate);
+                        std::stringstream ss;
+                        ss << header.film.frameRate;
+                        info.tags.set("Film Frame Rate", ss.str());
+                    }
+                    if (isValid(header.film.frameId, 32))
+                    {
+                        info.tags.set("Film Frame ID", toString(header.film.frameId, 32));
+                    }
+                    if (isValid(header.film.slate, 200))
+                    {
+                        info.tags.set("Film Slate", toString(header.film.slate, 200));
+                    }
+                }
+
                 Header read(
                     const std::shared_ptr<System::File::IO>& io,
                     Info& info,
@@ -328,86 +412,7 @@ namespace djv
                         break;
                     default: break;
                     }
-                    if (isValid(out.file.time, 24))
-                    {
-                        info.tags.set("Time", toString(out.file.time, 24));
-                    }
-                    if (isValid(&out.source.offset[0]) && isValid(&out.source.offset[1]))
-                    {
-                        std::stringstream ss;
-                        ss << out.source.offset[0] << " " << out.source.offset[1];
-                        info.tags.set("Source Offset", ss.str());
-                    }
-                    if (isValid(out.source.file, 100))
-                    {
-                        info.tags.set("Source File", toString(out.source.file, 100));
-                    }
-                    if (isValid(out.source.time, 24))
-                    {
-                        info.tags.set("Source Time", toString(out.source.time, 24));
-                    }
-                    if (isValid(out.source.inputDevice, 64))
-                    {
-                        info.tags.set("Source Input Device", toString(out.source.inputDevice, 64));
-                    }
-                    if (isValid(out.source.inputModel, 32))
-                    {
-                        info.tags.set("Source Input Model", toString(out.source.inputModel, 32));
-                    }
-                    if (isValid(out.source.inputSerial, 32))
-                    {
-                        info.tags.set("Source Input Serial", toString(out.source.inputSerial, 32));
-                    }
-                    if (isValid(&out.source.inputPitch[0]) && isValid(&out.source.inputPitch[1]))
-                    {
-                        std::stringstream ss;
-                        ss << out.source.inputPitch[0] << " " << out.source.inputPitch[1];
-                        info.tags.set("Source Input Pitch", ss.str());
-                    }
-                    if (isValid(&out.source.gamma))
-                    {
-                        std::stringstream ss;
-                        ss << out.source.gamma;
-                        info.tags.set("Source Gamma", ss.str());
-                    }
-                    if (isValid(&out.film.id) &&
-                        isValid(&out.film.type) &&
-                        isValid(&out.film.offset) &&
-                        isValid(&out.film.prefix) &&
-                        isValid(&out.film.count))
-                    {
-                        info.tags.set( "Keycode", Time::keycodeToString(
-                            out.film.id,
-                            out.film.type,
-                            out.film.prefix,
-                            out.film.count,
-                            out.film.offset));
-                    }
-                    if (isValid(out.film.format, 32))
-                    {
-                        info.tags.set("Film Format", toString(out.film.format, 32));
-                    }
-                    if (isValid(&out.film.frame))
-                    {
-                        std::stringstream ss;
-                        ss << out.film.frame;
-                        info.tags.set("Film Frame", ss.str());
-                    }
-                    if (isValid(&out.film.frameRate) && out.film.frameRate >= _minSpeed)
-                    {
-                        info.videoSpeed = fromSpeed(out.film.frameRate);
-                        std::stringstream ss;
-                        ss << out.film.frameRate;
-                        info.tags.set("Film Frame Rate", ss.str());
-                    }
-                    if (isValid(out.film.frameId, 32))
-                    {
-                        info.tags.set("Film Frame ID", toString(out.film.frameId, 32));
-                    }
-                    if (isValid(out.film.slate, 200))
-                    {
-                        info.tags.set("Film Slate", toString(out.film.slate, 200));
-                    }
+                    readTags(out, info);
                     switch (static_cast<Descriptor>(out.image.channel[0].descriptor[1]))
                     {
                     case Descriptor::RedFilmPrint: colorProfile = ColorProfile::FilmPrint; break;
@@ -433,6 +438,77 @@ namespace djv
                     return out;
                 }
 
+                HeaderTemplate createHeaderTemplate(
+                    const std::shared_ptr<System::File::IO>& io,
+                    const Info& info,
+                    ColorProfile colorProfile)
+                {
+                    HeaderTemplate out;
+                    const size_t pos = io->getPos();
+                    io->setPos(0);
+                    io->read(&out.raw, sizeof(Header));
+                    io->setPos(pos);
+                    out.info = info;
+                    out.info.tags = Image::Tags();
+                    out.colorProfile = colorProfile;
+                    out.fileSize = io->getSize();
+                    return out;
+                }
+
+                bool read(
+                    const std::shared_ptr<System::File::IO>& io,
+                    const HeaderTemplate& headerTemplate,
+                    Header& out,
+                    Info& info,
+                    ColorProfile& colorProfile)
+                {
+                    static_assert(
+                        sizeof(Header) ==
+                        sizeof(Header::File) +
+                        sizeof(Header::Image) +
+                        sizeof(Header::Source) +
+                        sizeof(Header::Film),
+                        "The header must not contain padding");
+
+                    // Compare the file size and header fingerprint against the
+                    // template. The image section describes the data layout so
+                    // it must match exactly.
+                    if (io->getSize() != headerTemplate.fileSize)
+                    {
+                        return false;
+                    }
+                    io->read(&out, sizeof(Header));
+                    const auto& raw = headerTemplate.raw;
+                    if (out.file.magic != raw.file.magic ||
+                        out.file.imageOffset != raw.file.imageOffset ||
+                        out.file.size != raw.file.size ||
+                        memcmp(&out.image, &raw.image, sizeof(Header::Image)) != 0)
+                    {
+                        io->setPos(0);
+                        return false;
+                    }
+
+                    // Flip the endian of the data if necessary.
+                    info = headerTemplate.info;
+                    info.fileName = io->getFileName();
+                    if (info.video[0].layout.endian != Memory::getEndian())
+                    {
+                        io->setEndianConversion(true);
+                        convertEndian(out);
+                    }
+
+                    colorProfile = headerTemplate.colorProfile;
+                    readTags(out, info);
+
+                    // Set the file position.
+                    if (out.file.imageOffset)
+                    {
+                        io->setPos(out.file.imageOffset);
+                    }
+
+                    return true;
+                }
+
                 void write(
                     const std::shared_ptr<System::File::IO>& io,
                     const Info& info,
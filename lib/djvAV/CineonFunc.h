@@ -43,6 +43,45 @@ namespace djv
                     ColorProfile&,
                     const std::shared_ptr<System::TextSystem>&);
                 
+                //! This struct provides a template for reading the headers of a
+                //! file sequence. The frames in a sequence usually share the same
+                //! header layout, so once the first frame has been read the
+                //! following frames only need to be checked against it.
+                struct HeaderTemplate
+                {
+                    Header                  raw;            //!< The unconverted header of the first frame
+                    Info                    info;
+                    ColorProfile            colorProfile    = ColorProfile::FilmPrint;
+                    size_t                  fileSize        = 0;
+                };
+
+                //! Create a header template from a file that has already been
+                //! read with read().
+                //!
+                //! Throws:
+                //! - System::File::Error
+                HeaderTemplate createHeaderTemplate(
+                    const std::shared_ptr<System::File::IO>&,
+                    const Info&,
+                    ColorProfile);
+
+                //! Read a Cineon file header using a template. If the header does
+                //! not match the template false is returned, the file position
+                //! is reset, and the header should be read with read() instead.
+                //! The tags are still read from each header.
+                //!
+                //! Throws:
+                //! - System::File::Error
+                bool read(
+                    const std::shared_ptr<System::File::IO>&,
+                    const HeaderTemplate&,
+                    Header&,
+                    Info&,
+                    ColorProfile&);
+
+                //! Read the tags from a Cineon file header.
+                void readTags(const Header&, Info&);
+
                 //! Write a Cineon file header.
                 //!
                 //! Throws:
@@ -5,9 +5,12 @@
 #include <djvAV/Cineon.h>
 
 #include <djvAV/CineonFunc.h>
+#include <djvAV/IOFunc.h>
 
 #include <djvSystem/FileIO.h>
 
+#include <mutex>
+
 using namespace djv::Core;
 
 namespace djv
@@ -20,7 +23,8 @@ namespace djv
             {
                 struct Read::Private
                 {
-                    ColorProfile colorProfile = ColorProfile::FilmPrint;
+                    std::shared_ptr<HeaderTemplate> headerTemplate;
+                    std::mutex mutex;
                 };
 
                 Read::Read() :
@@ -46,34 +50,55 @@ namespace djv
                 
                 std::shared_ptr<Image::Data> Read::readImage(
                     const Info& info,
-                    const std::shared_ptr<System::File::IO>& io)
+                    const std::shared_ptr<System::File::IO>& io,
+                    const ReadOptions& options)
                 {
 #if defined(DJV_MMAP)
                     auto out = Image::Data::create(info.video[0].info, io);
 #else // DJV_MMAP
-                    auto infoTmp = info;
-                    bool convertEndian = false;
-                    if (infoTmp.video[0].layout.endian != Memory::getEndian())
+                    std::shared_ptr<Image::Data> out;
+                    auto imageInfo = info.video[0];
+                    imageInfo.layout.endian = Memory::getEndian();
+                    const Math::BBox2i roi = getROI(options, imageInfo.size);
+                    if (options.proxy != Proxy::None)
                     {
-                        convertEndian = true;
-                        infoTmp.video[0].layout.endian = Memory::getEndian();
+                        out = readProxy(io, imageInfo, options.proxy);
                     }
-                    auto out = Image::Data::create(infoTmp.video[0]);
-                    io->read(out->getData(), out->getDataByteCount());
-                    if (convertEndian)
+                    else if (roi.isValid())
                     {
-                        const size_t dataByteCount = out->getDataByteCount();
-                        switch (Image::getDataType(infoTmp.video[0].type))
+                        out = readROI(io, imageInfo, roi);
+                    }
+                    else
+                    {
+                        out = createImage(info);
+                        io->read(out->getData(), out->getDataByteCount());
+                    }
+                    convertImage(info, *out);
+#endif // DJV_MMAP
+                    out->setTags(info.tags);
+                    return out;
+                }
+
+                std::shared_ptr<Image::Data> Read::createImage(const Info& info)
+                {
+                    auto imageInfo = info.video[0];
+                    imageInfo.layout.endian = Memory::getEndian();
+                    return Image::Data::create(imageInfo);
+                }
+
+                void Read::convertImage(const Info& info, Image::Data& data)
+                {
+                    if (info.video[0].layout.endian != Memory::getEndian())
+                    {
+                        const size_t dataByteCount = data.getDataByteCount();
+                        switch (Image::getDataType(info.video[0].type))
                         {
                             case Image::DataType::U10:
-                                Memory::endian(out->getData(), dataByteCount / 4, 4);
+                                Memory::endian(data.getData(), dataByteCount / 4, 4);
                                 break;
-                            default: break;                            
+                            default: break;
                         }
                     }
-#endif // DJV_MMAP
-                    out->setTags(infoTmp.tags);
-                    return out;
                 }
 
                 Info Read::_readInfo(const std::string& fileName)
@@ -86,11 +111,33 @@ namespace djv
                 {
                     auto io = System::File::IO::create();
                     const auto info = _open(fileName, io);
-                    auto out = readImage(info, io);
+                    auto out = readImage(info, io, _options);
                     out->setPluginName(pluginName);
                     return out;
                 }
 
+                bool Read::_canReadAsync() const
+                {
+                    return true;
+                }
+
+                void Read::_readImageAsync(const std::string& fileName, const ReadCallback& callback)
+                {
+                    auto io = System::File::IO::create();
+                    const auto info = _open(fileName, io);
+                    auto image = createImage(info);
+                    image->setPluginName(pluginName);
+                    image->setTags(info.tags);
+                    _readDataAsync(
+                        io,
+                        image,
+                        [info](Image::Data& data)
+                        {
+                            convertImage(info, data);
+                        },
+                        callback);
+                }
+
                 Info Read::_open(const std::string& fileName, const std::shared_ptr<System::File::IO>& io)
                 {
                     DJV_PRIVATE_PTR();
@@ -99,7 +146,26 @@ namespace djv
                     info.videoSpeed = _speed;
                     info.videoSequence = _sequence;
                     info.video.push_back(Image::Info());
-                    read(io, info, p.colorProfile, _textSystem);
+
+                    // Try reading the header with the template from the first
+                    // frame, falling back to reading the full header.
+                    std::shared_ptr<HeaderTemplate> headerTemplate;
+                    {
+                        std::lock_guard<std::mutex> lock(p.mutex);
+                        headerTemplate = p.headerTemplate;
+                    }
+                    Header header;
+                    ColorProfile colorProfile = ColorProfile::FilmPrint;
+                    if (!headerTemplate || !read(io, *headerTemplate, header, info, colorProfile))
+                    {
+                        read(io, info, colorProfile, _textSystem);
+                        if (!headerTemplate)
+                        {
+                            headerTemplate.reset(new HeaderTemplate(createHeaderTemplate(io, info, colorProfile)));
+                            std::lock_guard<std::mutex> lock(p.mutex);
+                            p.headerTemplate = headerTemplate;
+                        }
+                    }
                     return info;
                 }
 
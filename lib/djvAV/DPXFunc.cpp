@@ -153,6 +153,218 @@ namespace djv
 
                 } // namespace
 
+                void readTags(const Header& header, Info& info)
+                {
+                    if (Cineon::isValid(header.file.time, 24))
+                    {
+                        info.tags.set("Time", Cineon::toString(header.file.time, 24));
+                    }
+                    if (Cineon::isValid(header.file.creator, 100))
+                    {
+                        info.tags.set("Creator", Cineon::toString(header.file.creator, 100));
+                    }
+                    if (Cineon::isValid(header.file.project, 200))
+                    {
+                        info.tags.set("Project", Cineon::toString(header.file.project, 200));
+                    }
+                    if (Cineon::isValid(header.file.copyright, 200))
+                    {
+                        info.tags.set("Copyright", Cineon::toString(header.file.copyright, 200));
+                    }
+
+                    if (isValid(&header.source.offset[0]) && isValid(&header.source.offset[1]))
+                    {
+                        std::stringstream ss;
+                        ss << header.source.offset[0] << " " << header.source.offset[1];
+                        info.tags.set("Source Offset", ss.str());
+                    }
+                    if (isValid(&header.source.center[0]) && isValid(&header.source.center[1]))
+                    {
+                        std::stringstream ss;
+                        ss << header.source.center[0] << " " << header.source.center[1];
+                        info.tags.set("Source Center", ss.str());
+                    }
+                    if (isValid(&header.source.size[0]) && isValid(&header.source.size[1]))
+                    {
+                        std::stringstream ss;
+                        ss << header.source.size[0] << " " << header.source.size[1];
+                        info.tags.set("Source Size", ss.str());
+                    }
+                    if (Cineon::isValid(header.source.file, 100))
+                    {
+                        info.tags.set("Source File", Cineon::toString(header.source.file, 100));
+                    }
+                    if (Cineon::isValid(header.source.time, 24))
+                    {
+                        info.tags.set("Source Time", Cineon::toString(header.source.time, 24));
+                    }
+                    if (Cineon::isValid(header.source.inputDevice, 32))
+                    {
+                        info.tags.set("Source Input Device", Cineon::toString(header.source.inputDevice, 32));
+                    }
+                    if (Cineon::isValid(header.source.inputSerial, 32))
+                    {
+                        info.tags.set("Source Input Serial", Cineon::toString(header.source.inputSerial, 32));
+                    }
+                    if (isValid(&header.source.border[0]) && isValid(&header.source.border[1]) &&
+                        isValid(&header.source.border[2]) && isValid(&header.source.border[3]))
+                    {
+                        std::stringstream ss;
+                        ss << header.source.border[0] << " ";
+                        ss << header.source.border[1] << " ";
+                        ss << header.source.border[2] << " ";
+                        ss << header.source.border[3];
+                        info.tags.set("Source Border", ss.str());
+                    }
+                    if (isValid(&header.source.pixelAspect[0]) && isValid(&header.source.pixelAspect[1]))
+                    {
+                        std::stringstream ss;
+                        ss << header.source.pixelAspect[0] << " " << header.source.pixelAspect[1];
+                        info.tags.set("Source Pixel Aspect", ss.str());
+                    }
+                    if (isValid(&header.source.scanSize[0]) && isValid(&header.source.scanSize[1]))
+                    {
+                        std::stringstream ss;
+                        ss << header.source.scanSize[0] << " " << header.source.scanSize[1];
+                        info.tags.set("Source Scan Size", ss.str());
+                    }
+
+                    if (Cineon::isValid(header.film.id, 2) && Cineon::isValid(header.film.type, 2) &&
+                        Cineon::isValid(header.film.offset, 2) && Cineon::isValid(header.film.prefix, 6) &&
+                        Cineon::isValid(header.film.count, 4))
+                    {
+                        info.tags.set("Keycode", Time::keycodeToString(
+                            std::stoi(std::string(header.film.id, 2)),
+                            std::stoi(std::string(header.film.type, 2)),
+                            std::stoi(std::string(header.film.prefix, 6)),
+                            std::stoi(std::string(header.film.count, 4)),
+                            std::stoi(std::string(header.film.offset, 2))));
+                    }
+                    if (Cineon::isValid(header.film.format, 32))
+                    {
+                        info.tags.set("Film Format", Cineon::toString(header.film.format, 32));
+                    }
+                    if (isValid(&header.film.frame))
+                    {
+                        std::stringstream ss;
+                        ss << header.film.frame;
+                        info.tags.set("Film Frame", ss.str());
+                    }
+                    if (isValid(&header.film.sequence))
+                    {
+                        std::stringstream ss;
+                        ss << header.film.sequence;
+                        info.tags.set("Film Sequence", ss.str());
+                    }
+                    if (isValid(&header.film.hold))
+                    {
+                        std::stringstream ss;
+                        ss << header.film.hold;
+                        info.tags.set("Film Hold", ss.str());
+                    }
+                    if (isValid(&header.film.frameRate) && header.film.frameRate > _minSpeed)
+                    {
+                        info.videoSpeed = fromSpeed(header.film.frameRate);
+                        std::stringstream ss;
+                        ss << header.film.frameRate;
+                        info.tags.set("Film Frame Rate", ss.str());
+                    }
+                    if (isValid(&header.film.shutter))
+                    {
+                        std::stringstream ss;
+                        ss << header.film.shutter;
+                        info.tags.set("Film Shutter", ss.str());
+                    }
+                    if (Cineon::isValid(header.film.frameId, 32))
+                    {
+                        info.tags.set("Film Frame ID", Cineon::toString(header.film.frameId, 32));
+                    }
+                    if (Cineon::isValid(header.film.slate, 100))
+                    {
+                        info.tags.set("Film Slate", Cineon::toString(header.film.slate, 100));
+                    }
+
+                    if (isValid(&header.tv.timecode))
+                    {
+                        std::stringstream ss;
+                        ss << header.tv.timecode;
+                        info.tags.set("Timecode", ss.str());
+                    }
+                    if (isValid(&header.tv.interlace))
+                    {
+                        std::stringstream ss;
+                        ss << static_cast<unsigned int>(header.tv.interlace);
+                        info.tags.set("TV Interlace", ss.str());
+                    }
+                    if (isValid(&header.tv.field))
+                    {
+                        std::stringstream ss;
+                        ss << static_cast<unsigned int>(header.tv.field);
+                        info.tags.set("TV Field", ss.str());
+                    }
+                    if (isValid(&header.tv.videoSignal))
+                    {
+                        std::stringstream ss;
+                        ss << static_cast<unsigned int>(header.tv.videoSignal);
+                        info.tags.set("TV Video Signal", ss.str());
+                    }
+                    if (isValid(&header.tv.sampleRate[0]) && isValid(&header.tv.sampleRate[1]))
+                    {
+                        std::stringstream ss;
+                        ss << header.tv.sampleRate[0] << " " << header.tv.sampleRate[1];
+                        info.tags.set("TV Sample Rate", ss.str());
+                    }
+                    if (isValid(&header.tv.frameRate) && header.tv.frameRate > _minSpeed)
+                    {
+                        info.videoSpeed = fromSpeed(header.tv.frameRate);
+                        std::stringstream ss;
+                        ss << header.tv.frameRate;
+                        info.tags.set("TV Frame Rate", ss.str());
+                    }
+                    if (isValid(&header.tv.timeOffset))
+                    {
+                        std::stringstream ss;
+                        ss << header.tv.timeOffset;
+                        info.tags.set("TV Time Offset", ss.str());
+                    }
+                    if (isValid(&header.tv.gamma))
+                    {
+                        std::stringstream ss;
+                        ss << header.tv.gamma;
+                        info.tags.set("TV Gamma", ss.str());
+                    }
+                    if (isValid(&header.tv.blackLevel))
+                    {
+                        std::stringstream ss;
+                        ss << header.tv.blackLevel;
+                        info.tags.set("TV Black Level", ss.str());
+                    }
+                    if (isValid(&header.tv.blackGain))
+                    {
+                        std::stringstream ss;
+                        ss << header.tv.blackGain;
+                        info.tags.set("TV Black Gain", ss.str());
+                    }
+                    if (isValid(&header.tv.breakpoint))
+                    {
+                        std::stringstream ss;
+                        ss << header.tv.breakpoint;
+                        info.tags.set("TV Breakpoint", ss.str());
+                    }
+                    if (isValid(&header.tv.whiteLevel))
+                    {
+                        std::stringstream ss;
+                        ss << header.tv.whiteLevel;
+                        info.tags.set("TV White Level", ss.str());
+                    }
+                    if (isValid(&header.tv.integrationTimes))
+                    {
+                        std::stringstream ss;
+                        ss << header.tv.integrationTimes;
+                        info.tags.set("TV Integration Times", ss.str());
+                    }
+                }
+
                 Header read(
                     const std::shared_ptr<System::File::IO>& io,
                     Info& info,
@@ -301,230 +513,95 @@ namespace djv
                         transfer = Transfer::FilmPrint;
                     }
 
-                    if (Cineon::isValid(out.file.time, 24))
-                    {
-                        info.tags.set("Time", Cineon::toString(out.file.time, 24));
-                    }
-                    if (Cineon::isValid(out.file.creator, 100))
-                    {
-                        info.tags.set("Creator", Cineon::toString(out.file.creator, 100));
-                    }
-                    if (Cineon::isValid(out.file.project, 200))
-                    {
-                        info.tags.set("Project", Cineon::toString(out.file.project, 200));
-                    }
-                    if (Cineon::isValid(out.file.copyright, 200))
-                    {
-                        info.tags.set("Copyright", Cineon::toString(out.file.copyright, 200));
-                    }
+                    readTags(out, info);
 
-                    if (isValid(&out.source.offset[0]) && isValid(&out.source.offset[1]))
-                    {
-                        std::stringstream ss;
-                        ss << out.source.offset[0] << " " << out.source.offset[1];
-                        info.tags.set("Source Offset", ss.str());
-                    }
-                    if (isValid(&out.source.center[0]) && isValid(&out.source.center[1]))
-                    {
-                        std::stringstream ss;
-                        ss << out.source.center[0] << " " << out.source.center[1];
-                        info.tags.set("Source Center", ss.str());
-                    }
-                    if (isValid(&out.source.size[0]) && isValid(&out.source.size[1]))
-                    {
-                        std::stringstream ss;
-                        ss << out.source.size[0] << " " << out.source.size[1];
-                        info.tags.set("Source Size", ss.str());
-                    }
-                    if (Cineon::isValid(out.source.file, 100))
-                    {
-                        info.tags.set("Source File", Cineon::toString(out.source.file, 100));
-                    }
-                    if (Cineon::isValid(out.source.time, 24))
-                    {
-                        info.tags.set("Source Time", Cineon::toString(out.source.time, 24));
-                    }
-                    if (Cineon::isValid(out.source.inputDevice, 32))
-                    {
-                        info.tags.set("Source Input Device", Cineon::toString(out.source.inputDevice, 32));
-                    }
-                    if (Cineon::isValid(out.source.inputSerial, 32))
-                    {
-                        info.tags.set("Source Input Serial", Cineon::toString(out.source.inputSerial, 32));
-                    }
-                    if (isValid(&out.source.border[0]) && isValid(&out.source.border[1]) &&
-                        isValid(&out.source.border[2]) && isValid(&out.source.border[3]))
-                    {
-                        std::stringstream ss;
-                        ss << out.source.border[0] << " ";
-                        ss << out.source.border[1] << " ";
-                        ss << out.source.border[2] << " ";
-                        ss << out.source.border[3];
-                        info.tags.set("Source Border", ss.str());
-                    }
-                    if (isValid(&out.source.pixelAspect[0]) && isValid(&out.source.pixelAspect[1]))
+                    // Set the file position.
+                    if (out.file.imageOffset)
                     {
-                        std::stringstream ss;
-                        ss << out.source.pixelAspect[0] << " " << out.source.pixelAspect[1];
-                        info.tags.set("Source Pixel Aspect", ss.str());
+                        io->setPos(out.file.imageOffset);
                     }
-                    if (isValid(&out.source.scanSize[0]) && isValid(&out.source.scanSize[1]))
+                    const size_t ioPos = io->getPos();
+                    const size_t fileDataByteCount = ioSize > 0 ? (ioSize - ioPos) : 0;
+                    if (dataByteCount > fileDataByteCount)
                     {
-                        std::stringstream ss;
-                        ss << out.source.scanSize[0] << " " << out.source.scanSize[1];
-                        info.tags.set("Source Scan Size", ss.str());
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(io->getFileName()).
+                            arg(textSystem->getText(DJV_TEXT("error_incomplete_file"))));
                     }
 
-                    if (Cineon::isValid(out.film.id, 2) && Cineon::isValid(out.film.type, 2) &&
-                        Cineon::isValid(out.film.offset, 2) && Cineon::isValid(out.film.prefix, 6) &&
-                        Cineon::isValid(out.film.count, 4))
-                    {
-                        info.tags.set("Keycode", Time::keycodeToString(
-                            std::stoi(std::string(out.film.id, 2)),
-                            std::stoi(std::string(out.film.type, 2)),
-                            std::stoi(std::string(out.film.prefix, 6)),
-                            std::stoi(std::string(out.film.count, 4)),
-                            std::stoi(std::string(out.film.offset, 2))));
-                    }
-                    if (Cineon::isValid(out.film.format, 32))
-                    {
-                        info.tags.set("Film Format", Cineon::toString(out.film.format, 32));
-                    }
-                    if (isValid(&out.film.frame))
-                    {
-                        std::stringstream ss;
-                        ss << out.film.frame;
-                        info.tags.set("Film Frame", ss.str());
-                    }
-                    if (isValid(&out.film.sequence))
-                    {
-                        std::stringstream ss;
-                        ss << out.film.sequence;
-                        info.tags.set("Film Sequence", ss.str());
-                    }
-                    if (isValid(&out.film.hold))
-                    {
-                        std::stringstream ss;
-                        ss << out.film.hold;
-                        info.tags.set("Film Hold", ss.str());
-                    }
-                    if (isValid(&out.film.frameRate) && out.film.frameRate > _minSpeed)
-                    {
-                        info.videoSpeed = fromSpeed(out.film.frameRate);
-                        std::stringstream ss;
-                        ss << out.film.frameRate;
-                        info.tags.set("Film Frame Rate", ss.str());
-                    }
-                    if (isValid(&out.film.shutter))
-                    {
-                        std::stringstream ss;
-                        ss << out.film.shutter;
-                        info.tags.set("Film Shutter", ss.str());
-                    }
-                    if (Cineon::isValid(out.film.frameId, 32))
-                    {
-                        info.tags.set("Film Frame ID", Cineon::toString(out.film.frameId, 32));
-                    }
-                    if (Cineon::isValid(out.film.slate, 100))
-                    {
-                        info.tags.set("Film Slate", Cineon::toString(out.film.slate, 100));
-                    }
+                    return out;
+                }
 
-                    if (isValid(&out.tv.timecode))
-                    {
-                        std::stringstream ss;
-                        ss << out.tv.timecode;
-                        info.tags.set("Timecode", ss.str());
-                    }
-                    if (isValid(&out.tv.interlace))
-                    {
-                        std::stringstream ss;
-                        ss << static_cast<unsigned int>(out.tv.interlace);
-                        info.tags.set("TV Interlace", ss.str());
-                    }
-                    if (isValid(&out.tv.field))
-                    {
-                        std::stringstream ss;
-                        ss << static_cast<unsigned int>(out.tv.field);
-                        info.tags.set("TV Field", ss.str());
-                    }
-                    if (isValid(&out.tv.videoSignal))
-                    {
-                        std::stringstream ss;
-                        ss << static_cast<unsigned int>(out.tv.videoSignal);
-                        info.tags.set("TV Video Signal", ss.str());
-                    }
-                    if (isValid(&out.tv.sampleRate[0]) && isValid(&out.tv.sampleRate[1]))
-                    {
-                        std::stringstream ss;
-                        ss << out.tv.sampleRate[0] << " " << out.tv.sampleRate[1];
-                        info.tags.set("TV Sample Rate", ss.str());
-                    }
-                    if (isValid(&out.tv.frameRate) && out.tv.frameRate > _minSpeed)
-                    {
-                        info.videoSpeed = fromSpeed(out.tv.frameRate);
-                        std::stringstream ss;
-                        ss << out.tv.frameRate;
-                        info.tags.set("TV Frame Rate", ss.str());
-                    }
-                    if (isValid(&out.tv.timeOffset))
-                    {
-                        std::stringstream ss;
-                        ss << out.tv.timeOffset;
-                        info.tags.set("TV Time Offset", ss.str());
-                    }
-                    if (isValid(&out.tv.gamma))
-                    {
-                        std::stringstream ss;
-                        ss << out.tv.gamma;
-                        info.tags.set("TV Gamma", ss.str());
-                    }
-                    if (isValid(&out.tv.blackLevel))
-                    {
-                        std::stringstream ss;
-                        ss << out.tv.blackLevel;
-                        info.tags.set("TV Black Level", ss.str());
-                    }
-                    if (isValid(&out.tv.blackGain))
-                    {
-                        std::stringstream ss;
-                        ss << out.tv.blackGain;
-                        info.tags.set("TV Black Gain", ss.str());
-                    }
-                    if (isValid(&out.tv.breakpoint))
+                HeaderTemplate createHeaderTemplate(
+                    const std::shared_ptr<System::File::IO>& io,
+                    const Info& info,
+                    Transfer transfer)
+                {
+                    HeaderTemplate out;
+                    const size_t pos = io->getPos();
+                    io->setPos(0);
+                    io->read(&out.raw, sizeof(Header));
+                    io->setPos(pos);
+                    out.info = info;
+                    out.info.tags = Image::Tags();
+                    out.transfer = transfer;
+                    out.fileSize = io->getSize();
+                    return out;
+                }
+
+                bool read(
+                    const std::shared_ptr<System::File::IO>& io,
+                    const HeaderTemplate& headerTemplate,
+                    Header& out,
+                    Info& info,
+                    Transfer& transfer)
+                {
+                    static_assert(
+                        sizeof(Header) ==
+                        sizeof(Header::File) +
+                        sizeof(Header::Image) +
+                        sizeof(Header::Source) +
+                        sizeof(Header::Film) +
+                        sizeof(Header::TV),
+                        "The header must not contain padding");
+
+                    // Compare the file size and header fingerprint against the
+                    // template. The image section describes the data layout so
+                    // it must match exactly.
+                    if (io->getSize() != headerTemplate.fileSize)
                     {
-                        std::stringstream ss;
-                        ss << out.tv.breakpoint;
-                        info.tags.set("TV Breakpoint", ss.str());
+                        return false;
                     }
-                    if (isValid(&out.tv.whiteLevel))
+                    io->read(&out, sizeof(Header));
+                    const auto& raw = headerTemplate.raw;
+                    if (out.file.magic != raw.file.magic ||
+                        out.file.imageOffset != raw.file.imageOffset ||
+                        out.file.size != raw.file.size ||
+                        memcmp(&out.image, &raw.image, sizeof(Header::Image)) != 0)
                     {
-                        std::stringstream ss;
-                        ss << out.tv.whiteLevel;
-                        info.tags.set("TV White Level", ss.str());
+                        io->setPos(0);
+                        return false;
                     }
-                    if (isValid(&out.tv.integrationTimes))
+
+                    // Flip the endian of the data if necessary.
+                    info = headerTemplate.info;
+                    info.fileName = io->getFileName();
+                    if (info.video[0].layout.endian != Memory::getEndian())
                     {
-                        std::stringstream ss;
-                        ss << out.tv.integrationTimes;
-                        info.tags.set("TV Integration Times", ss.str());
+                        io->setEndianConversion(true);
+                        convertEndian(out);
                     }
 
+                    transfer = headerTemplate.transfer;
+                    readTags(out, info);
+
                     // Set the file position.
                     if (out.file.imageOffset)
                     {
                         io->setPos(out.file.imageOffset);
                     }
-                    const size_t ioPos = io->getPos();
-                    const size_t fileDataByteCount = ioSize > 0 ? (ioSize - ioPos) : 0;
-                    if (dataByteCount > fileDataByteCount)
-                    {
-                        throw System::File::Error(String::Format("{0}: {1}").
-                            arg(io->getFileName()).
-                            arg(textSystem->getText(DJV_TEXT("error_incomplete_file"))));
-                    }
 
-                    return out;
+                    return true;
                 }
 
                 void write(
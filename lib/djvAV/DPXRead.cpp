@@ -9,6 +9,8 @@
 
 #include <djvSystem/FileIO.h>
 
+#include <mutex>
+
 using namespace djv::Core;
 
 namespace djv
@@ -21,7 +23,8 @@ namespace djv
             {
                 struct Read::Private
                 {
-                    Transfer transfer = Transfer::FilmPrint;
+                    std::shared_ptr<HeaderTemplate> headerTemplate;
+                    std::mutex mutex;
                     Options options;
                 };
 
@@ -58,11 +61,33 @@ namespace djv
                 {
                     auto io = System::File::IO::create();
                     const auto info = _open(fileName, io);
-                    auto out = Cineon::Read::readImage(info, io);
+                    auto out = Cineon::Read::readImage(info, io, _options);
                     out->setPluginName(pluginName);
                     return out;
                 }
 
+                bool Read::_canReadAsync() const
+                {
+                    return true;
+                }
+
+                void Read::_readImageAsync(const std::string& fileName, const ReadCallback& callback)
+                {
+                    auto io = System::File::IO::create();
+                    const auto info = _open(fileName, io);
+                    auto image = Cineon::Read::createImage(info);
+                    image->setPluginName(pluginName);
+                    image->setTags(info.tags);
+                    _readDataAsync(
+                        io,
+                        image,
+                        [info](Image::Data& data)
+                        {
+                            Cineon::Read::convertImage(info, data);
+                        },
+                        callback);
+                }
+
                 Info Read::_open(const std::string& fileName, const std::shared_ptr<System::File::IO>& io)
                 {
                     DJV_PRIVATE_PTR();
@@ -71,7 +96,26 @@ namespace djv
                     info.videoSpeed = _speed;
                     info.videoSequence = _sequence;
                     info.video.push_back(Image::Info());
-                    DPX::read(io, info, p.transfer, _textSystem);
+
+                    // Try reading the header with the template from the first
+                    // frame, falling back to reading the full header.
+                    std::shared_ptr<HeaderTemplate> headerTemplate;
+                    {
+                        std::lock_guard<std::mutex> lock(p.mutex);
+                        headerTemplate = p.headerTemplate;
+                    }
+                    Header header;
+                    Transfer transfer = Transfer::FilmPrint;
+                    if (!headerTemplate || !DPX::read(io, *headerTemplate, header, info, transfer))
+                    {
+                        DPX::read(io, info, transfer, _textSystem);
+                        if (!headerTemplate)
+                        {
+                            headerTemplate.reset(new HeaderTemplate(createHeaderTemplate(io, info, transfer)));
+                            std::lock_guard<std::mutex> lock(p.mutex);
+                            p.headerTemplate = headerTemplate;
+                        }
+                    }
                     return info;
                 }
 
@@ -12,6 +12,8 @@
 
 #include <djvCore/String.h>
 
+#include <algorithm>
+
 extern "C"
 {
 #include <libavformat/avformat.h>
@@ -29,7 +31,14 @@ namespace djv
             {
                 bool Options::operator == (const Options& other) const
                 {
-                    return threadCount == other.threadCount;
+                    return
+                        threadCount == other.threadCount &&
+                        threadType == other.threadType &&
+                        codecThreadTypes == other.codecThreadTypes &&
+                        codec == other.codec &&
+                        proResProfile == other.proResProfile &&
+                        dnxhrProfile == other.dnxhrProfile &&
+                        h264CRF == other.h264CRF;
                 }
                 
                 namespace
@@ -79,6 +88,13 @@ namespace djv
                     return out;
                 }
 
+                bool Plugin::canWrite(const System::File::Info& fileInfo, const Info& info) const
+                {
+                    std::string extension = fileInfo.getPath().getExtension();
+                    std::transform(extension.begin(), extension.end(), extension.begin(), tolower);
+                    return info.video.size() && writeFileExtensions.find(extension) != writeFileExtensions.end();
+                }
+
                 rapidjson::Value Plugin::getOptions(rapidjson::Document::AllocatorType& allocator) const
                 {
                     DJV_PRIVATE_PTR();
@@ -97,6 +113,12 @@ namespace djv
                     return Read::create(fileInfo, options, p.options, _textSystem, _resourceSystem, _logSystem);
                 }
 
+                std::shared_ptr<IWrite> Plugin::write(const System::File::Info& fileInfo, const Info& info, const WriteOptions& options) const
+                {
+                    DJV_PRIVATE_PTR();
+                    return Write::create(fileInfo, info, options, p.options, _textSystem, _resourceSystem, _logSystem);
+                }
+
             } // namespace FFmpeg
         } // namespace IO
     } // namespace AV
@@ -14,8 +14,14 @@ extern "C"
 {
 #include <libavcodec/avcodec.h>
 
+struct AVStream;
+struct SwsContext;
+
 } // extern "C"
 
+#include <map>
+#include <vector>
+
 namespace djv
 {
     namespace AV
@@ -51,14 +57,144 @@ namespace djv
                     ".webp"
                 };
 
+                //! The file extensions that can be written.
+                static const std::set<std::string> writeFileExtensions =
+                {
+                    ".mkv",
+                    ".mov",
+                    ".mp4",
+                    ".m4v",
+                    ".mxf"
+                };
+
+                //! This enumeration provides how the video decoders use threads.
+                //!
+                //! Frame threading decodes several frames at once, which helps
+                //! codecs like ProRes, H.264 and HEVC that do not split frames
+                //! into slices. It adds a delay of one frame per thread.
+                enum class ThreadType
+                {
+                    Slice,
+                    Frame,
+                    SliceAndFrame,
+
+                    Count,
+                    First = Slice
+                };
+
+                //! This enumeration provides the video codecs for writing.
+                enum class Codec
+                {
+                    ProRes,
+                    DNxHR,
+                    H264,
+
+                    Count,
+                    First = ProRes
+                };
+
+                //! This enumeration provides the ProRes profiles.
+                enum class ProResProfile
+                {
+                    Proxy,
+                    LT,
+                    Standard,
+                    HQ,
+                    _4444,
+                    _4444XQ,
+
+                    Count,
+                    First = Proxy
+                };
+
+                //! This enumeration provides the DNxHR profiles.
+                enum class DNxHRProfile
+                {
+                    LB,
+                    SQ,
+                    HQ,
+                    HQX,
+                    _444,
+
+                    Count,
+                    First = LB
+                };
+
                 //! This struct provides the FFmpeg file I/O optioms.
                 struct Options
                 {
-                    size_t threadCount = 4;
+                    size_t     threadCount = 4;
+                    ThreadType threadType  = ThreadType::SliceAndFrame;
+
+                    //! Thread types for specific codecs, using the FFmpeg codec
+                    //! names (for example "prores" or "h264").
+                    std::map<std::string, ThreadType> codecThreadTypes;
+
+                    Codec         codec         = Codec::ProRes;
+                    ProResProfile proResProfile = ProResProfile::HQ;
+                    DNxHRProfile  dnxhrProfile  = DNxHRProfile::HQ;
+
+                    //! The H.264 constant rate factor, lower values are higher
+                    //! quality.
+                    size_t h264CRF = 18;
                     
                     bool operator == (const Options&) const;
                 };
 
+                //! This class provides an index of the keyframes in a video
+                //! stream. Seeks use the index to start decoding from the
+                //! nearest keyframe before the target.
+                class KeyframeIndex
+                {
+                public:
+                    //! \name Keyframes
+                    ///@{
+
+                    size_t getCount() const;
+
+                    //! Add a keyframe time stamp in the stream time base.
+                    void add(int64_t);
+
+                    //! Get the nearest keyframe at or before the given time
+                    //! stamp. Returns false if there is no keyframe, or if the
+                    //! index is not complete and does not cover the time stamp.
+                    bool getKeyframe(int64_t, int64_t&) const;
+
+                    //! Get whether the whole stream has been indexed.
+                    bool isComplete() const;
+
+                    void setComplete(bool);
+
+                    ///@}
+
+                    //! \name Cache
+                    ///@{
+
+                    //! Get the name of the cache file for a media file. The name
+                    //! is made from the path, modification time, and size of the
+                    //! file.
+                    static std::string getCacheFileName(const System::File::Info&);
+
+                    //! Read the index from a cache file.
+                    //! Throws:
+                    //! - System::File::Error
+                    void read(
+                        const std::string& fileName,
+                        const System::File::Info&,
+                        const std::shared_ptr<System::TextSystem>&);
+
+                    //! Write the index to a cache file.
+                    //! Throws:
+                    //! - System::File::Error
+                    void write(const std::string& fileName, const System::File::Info&) const;
+
+                    ///@}
+
+                private:
+                    std::vector<int64_t> _keyframes;
+                    bool                 _complete  = false;
+                };
+
                 //! This class provides the FFmpeg file reader.
                 class Read : public IRead
                 {
@@ -85,13 +221,36 @@ namespace djv
                         const std::shared_ptr<System::ResourceSystem>&,
                         const std::shared_ptr<System::LogSystem>&);
 
+                    //! This struct provides seek statistics.
+                    struct SeekStats
+                    {
+                        size_t count          = 0;   //!< The total number of seeks
+                        size_t indexedCount   = 0;   //!< The number of seeks that used a keyframe index
+                        float  lastLatency    = 0.F; //!< The time from the last seek to its first frame in milliseconds
+                        float  averageLatency = 0.F; //!< The average seek latency in milliseconds
+                    };
+
+                    //! Get the seek statistics for all readers.
+                    static SeekStats getSeekStats();
+
                     bool isRunning() const override;
 
                     std::future<Info> getInfo() override;
 
                     void seek(int64_t, Direction) override;
+                    bool hasCache() const override;
 
                 private:
+                    SwsContext* _createSwsContext(const AVCodecContext*, const Image::Info&) const;
+                    std::shared_ptr<Image::Data> _copyImage(const AVFrame*, SwsContext*) const;
+                    Math::Frame::Number _getVideoFrame(int64_t pts) const;
+                    int64_t _getVideoTime(Math::Frame::Number) const;
+
+                    //! Add the frames that are in the cache to the video queue,
+                    //! starting at the next frame in the playback direction. A
+                    //! maximum of zero fills the queue.
+                    size_t _queueCachedFrames(size_t max = 0);
+
                     struct DecodeVideo
                     {
                         AVPacket*           packet       = nullptr;
@@ -100,6 +259,18 @@ namespace djv
                     };
                     int _decodeVideo(const DecodeVideo&, Math::Frame::Number&);
 
+                    //! Start indexing the keyframes in the background. This is
+                    //! called the first time the index is needed, by a seek or
+                    //! by the cache.
+                    void _startKeyframeIndex();
+                    void _buildKeyframeIndex();
+
+                    //! Decode the frames in the cache window that are missing,
+                    //! a group of pictures at a time. Each cache thread runs
+                    //! this with its own decoder, the index selects whether
+                    //! the thread is active for the current thread count.
+                    void _fillCache(size_t index);
+
                     struct DecodeAudio
                     {
                         AVPacket*           packet = nullptr;
@@ -107,6 +278,59 @@ namespace djv
                     };
                     int _decodeAudio(const DecodeAudio&, Math::Frame::Number&);
 
+                    //! Write the audio samples that did not fit in the ring
+                    //! buffer. Returns false if some are still waiting.
+                    bool _writeAudioPending();
+
+                    DJV_PRIVATE();
+                };
+
+                //! This class provides the FFmpeg file writer.
+                //!
+                //! The video frames are encoded on a separate thread as they are
+                //! added to the video queue. When the information has audio the
+                //! audio queue must also be filled and finished.
+                class Write : public IWrite
+                {
+                    DJV_NON_COPYABLE(Write);
+
+                protected:
+                    void _init(
+                        const System::File::Info&,
+                        const Info&,
+                        const WriteOptions&,
+                        const Options&,
+                        const std::shared_ptr<System::TextSystem>&,
+                        const std::shared_ptr<System::ResourceSystem>&,
+                        const std::shared_ptr<System::LogSystem>&);
+                    Write();
+
+                public:
+                    ~Write() override;
+
+                    //! Throws:
+                    //! - System::File::Error
+                    static std::shared_ptr<Write> create(
+                        const System::File::Info&,
+                        const Info&,
+                        const WriteOptions&,
+                        const Options&,
+                        const std::shared_ptr<System::TextSystem>&,
+                        const std::shared_ptr<System::ResourceSystem>&,
+                        const std::shared_ptr<System::LogSystem>&);
+
+                    bool isRunning() const override;
+
+                private:
+                    void _open();
+                    void _openVideo();
+                    void _openAudio();
+                    AVFrame* _getVideoFrame();
+                    void _convertImage(const std::shared_ptr<Image::Data>&, AVFrame*);
+                    void _writeAudio(const std::shared_ptr<Audio::Data>&);
+                    void _encode(AVCodecContext*, AVStream*, const AVFrame*);
+                    void _close();
+
                     DJV_PRIVATE();
                 };
 
@@ -126,7 +350,10 @@ namespace djv
                     rapidjson::Value getOptions(rapidjson::Document::AllocatorType&) const override;
                     void setOptions(const rapidjson::Value&) override;
 
+                    bool canWrite(const System::File::Info&, const Info&) const override;
+
                     std::shared_ptr<IRead> read(const System::File::Info&, const ReadOptions&) const override;
+                    std::shared_ptr<IWrite> write(const System::File::Info&, const Info&, const WriteOptions&) const override;
 
                 private:
                     DJV_PRIVATE();
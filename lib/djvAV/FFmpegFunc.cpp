@@ -8,6 +8,14 @@
 
 #include <djvCore/String.h>
 
+#include <array>
+
+extern "C"
+{
+#include <libavutil/pixdesc.h>
+
+} // extern "C"
+
 using namespace djv::Core;
 
 namespace djv
@@ -36,6 +44,20 @@ namespace djv
                     return out;
                 }
 
+                AVSampleFormat toFFmpeg(Audio::Type value)
+                {
+                    AVSampleFormat out = AV_SAMPLE_FMT_NONE;
+                    switch (value)
+                    {
+                    case Audio::Type::S16: out = AV_SAMPLE_FMT_S16; break;
+                    case Audio::Type::S32: out = AV_SAMPLE_FMT_S32; break;
+                    case Audio::Type::F32: out = AV_SAMPLE_FMT_FLT; break;
+                    case Audio::Type::F64: out = AV_SAMPLE_FMT_DBL; break;
+                    default: break;
+                    }
+                    return out;
+                }
+
                 std::string toString(AVSampleFormat value)
                 {
                     //! \todo How can we translate this?
@@ -196,6 +218,51 @@ namespace djv
                     }
                 }
 
+                Image::Type getImageType(AVPixelFormat value)
+                {
+                    Image::Type out = Image::Type::RGBA_U8;
+                    if (const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(value))
+                    {
+                        const bool alpha = desc->flags & AV_PIX_FMT_FLAG_ALPHA;
+                        const bool gray =
+                            !(desc->flags & AV_PIX_FMT_FLAG_RGB) &&
+                            !(desc->flags & AV_PIX_FMT_FLAG_PAL) &&
+                            desc->nb_components <= 2;
+                        const bool u16 = desc->comp[0].depth > 8;
+                        if (gray)
+                        {
+                            out = alpha ?
+                                (u16 ? Image::Type::LA_U16 : Image::Type::LA_U8) :
+                                (u16 ? Image::Type::L_U16 : Image::Type::L_U8);
+                        }
+                        else
+                        {
+                            out = alpha ?
+                                (u16 ? Image::Type::RGBA_U16 : Image::Type::RGBA_U8) :
+                                (u16 ? Image::Type::RGB_U16 : Image::Type::RGB_U8);
+                        }
+                    }
+                    return out;
+                }
+
+                AVPixelFormat toFFmpeg(Image::Type value)
+                {
+                    AVPixelFormat out = AV_PIX_FMT_NONE;
+                    switch (value)
+                    {
+                    case Image::Type::L_U8:     out = AV_PIX_FMT_GRAY8;  break;
+                    case Image::Type::L_U16:    out = AV_PIX_FMT_GRAY16; break;
+                    case Image::Type::LA_U8:    out = AV_PIX_FMT_YA8;    break;
+                    case Image::Type::LA_U16:   out = AV_PIX_FMT_YA16;   break;
+                    case Image::Type::RGB_U8:   out = AV_PIX_FMT_RGB24;  break;
+                    case Image::Type::RGB_U16:  out = AV_PIX_FMT_RGB48;  break;
+                    case Image::Type::RGBA_U8:  out = AV_PIX_FMT_RGBA;   break;
+                    case Image::Type::RGBA_U16: out = AV_PIX_FMT_RGBA64; break;
+                    default: break;
+                    }
+                    return out;
+                }
+
                 std::string getErrorString(int r)
                 {
                     char buf[String::cStringLength];
@@ -203,15 +270,167 @@ namespace djv
                     return std::string(buf);
                 }
 
+                ThreadType getThreadType(const Options& options, const std::string& codecName)
+                {
+                    const auto i = options.codecThreadTypes.find(codecName);
+                    return i != options.codecThreadTypes.end() ? i->second : options.threadType;
+                }
+
+                int toFFmpeg(ThreadType value)
+                {
+                    const std::array<int, static_cast<size_t>(ThreadType::Count)> data =
+                    {
+                        FF_THREAD_SLICE,
+                        FF_THREAD_FRAME,
+                        FF_THREAD_SLICE | FF_THREAD_FRAME
+                    };
+                    return data[static_cast<size_t>(value)];
+                }
+
+                std::string getProfileName(ProResProfile value)
+                {
+                    const std::array<std::string, static_cast<size_t>(ProResProfile::Count)> data =
+                    {
+                        "proxy",
+                        "lt",
+                        "standard",
+                        "hq",
+                        "4444",
+                        "4444xq"
+                    };
+                    return data[static_cast<size_t>(value)];
+                }
+
+                std::string getProfileName(DNxHRProfile value)
+                {
+                    const std::array<std::string, static_cast<size_t>(DNxHRProfile::Count)> data =
+                    {
+                        "dnxhr_lb",
+                        "dnxhr_sq",
+                        "dnxhr_hq",
+                        "dnxhr_hqx",
+                        "dnxhr_444"
+                    };
+                    return data[static_cast<size_t>(value)];
+                }
+
+                AVPixelFormat getPixelFormat(const Options& options, bool alpha)
+                {
+                    AVPixelFormat out = AV_PIX_FMT_NONE;
+                    switch (options.codec)
+                    {
+                    case Codec::ProRes:
+                        switch (options.proResProfile)
+                        {
+                        case ProResProfile::_4444:
+                        case ProResProfile::_4444XQ:
+                            out = alpha ? AV_PIX_FMT_YUVA444P10 : AV_PIX_FMT_YUV444P10;
+                            break;
+                        default:
+                            out = AV_PIX_FMT_YUV422P10;
+                            break;
+                        }
+                        break;
+                    case Codec::DNxHR:
+                        switch (options.dnxhrProfile)
+                        {
+                        case DNxHRProfile::HQX: out = AV_PIX_FMT_YUV422P10; break;
+                        case DNxHRProfile::_444: out = AV_PIX_FMT_YUV444P10; break;
+                        default: out = AV_PIX_FMT_YUV422P; break;
+                        }
+                        break;
+                    case Codec::H264:
+                        out = AV_PIX_FMT_YUV420P;
+                        break;
+                    default: break;
+                    }
+                    return out;
+                }
+
+                DJV_ENUM_HELPERS_IMPLEMENTATION(ThreadType);
+                DJV_ENUM_HELPERS_IMPLEMENTATION(Codec);
+                DJV_ENUM_HELPERS_IMPLEMENTATION(ProResProfile);
+                DJV_ENUM_HELPERS_IMPLEMENTATION(DNxHRProfile);
+
             } // namespace FFmpeg
         } // namespace IO
     } // namespace AV
 
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::IO::FFmpeg,
+        ThreadType,
+        DJV_TEXT("ffmpeg_thread_type_slice"),
+        DJV_TEXT("ffmpeg_thread_type_frame"),
+        DJV_TEXT("ffmpeg_thread_type_slice_and_frame"));
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::IO::FFmpeg,
+        Codec,
+        DJV_TEXT("ffmpeg_codec_prores"),
+        DJV_TEXT("ffmpeg_codec_dnxhr"),
+        DJV_TEXT("ffmpeg_codec_h264"));
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::IO::FFmpeg,
+        ProResProfile,
+        DJV_TEXT("ffmpeg_prores_profile_proxy"),
+        DJV_TEXT("ffmpeg_prores_profile_lt"),
+        DJV_TEXT("ffmpeg_prores_profile_standard"),
+        DJV_TEXT("ffmpeg_prores_profile_hq"),
+        DJV_TEXT("ffmpeg_prores_profile_4444"),
+        DJV_TEXT("ffmpeg_prores_profile_4444xq"));
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::IO::FFmpeg,
+        DNxHRProfile,
+        DJV_TEXT("ffmpeg_dnxhr_profile_lb"),
+        DJV_TEXT("ffmpeg_dnxhr_profile_sq"),
+        DJV_TEXT("ffmpeg_dnxhr_profile_hq"),
+        DJV_TEXT("ffmpeg_dnxhr_profile_hqx"),
+        DJV_TEXT("ffmpeg_dnxhr_profile_444"));
+
     rapidjson::Value toJSON(const AV::IO::FFmpeg::Options& value, rapidjson::Document::AllocatorType& allocator)
     {
         rapidjson::Value out(rapidjson::kObjectType);
         {
             out.AddMember("ThreadCount", toJSON(value.threadCount, allocator), allocator);
+            {
+                std::stringstream ss;
+                ss << value.threadType;
+                const std::string& s = ss.str();
+                out.AddMember("ThreadType", rapidjson::Value(s.c_str(), s.size(), allocator), allocator);
+            }
+            rapidjson::Value codecThreadTypes(rapidjson::kObjectType);
+            for (const auto& i : value.codecThreadTypes)
+            {
+                std::stringstream ss;
+                ss << i.second;
+                const std::string& s = ss.str();
+                codecThreadTypes.AddMember(
+                    rapidjson::Value(i.first.c_str(), i.first.size(), allocator),
+                    rapidjson::Value(s.c_str(), s.size(), allocator),
+                    allocator);
+            }
+            out.AddMember("CodecThreadTypes", codecThreadTypes, allocator);
+            {
+                std::stringstream ss;
+                ss << value.codec;
+                const std::string& s = ss.str();
+                out.AddMember("Codec", rapidjson::Value(s.c_str(), s.size(), allocator), allocator);
+            }
+            {
+                std::stringstream ss;
+                ss << value.proResProfile;
+                const std::string& s = ss.str();
+                out.AddMember("ProResProfile", rapidjson::Value(s.c_str(), s.size(), allocator), allocator);
+            }
+            {
+                std::stringstream ss;
+                ss << value.dnxhrProfile;
+                const std::string& s = ss.str();
+                out.AddMember("DNxHRProfile", rapidjson::Value(s.c_str(), s.size(), allocator), allocator);
+            }
+            out.AddMember("H264CRF", toJSON(value.h264CRF, allocator), allocator);
         }
         return out;
     }
@@ -226,6 +445,44 @@ namespace djv
                 {
                     fromJSON(i.value, out.threadCount);
                 }
+                else if (0 == strcmp("ThreadType", i.name.GetString()) && i.value.IsString())
+                {
+                    std::stringstream ss(i.value.GetString());
+                    ss >> out.threadType;
+                }
+                else if (0 == strcmp("CodecThreadTypes", i.name.GetString()) && i.value.IsObject())
+                {
+                    out.codecThreadTypes.clear();
+                    for (const auto& j : i.value.GetObject())
+                    {
+                        if (j.value.IsString())
+                        {
+                            std::stringstream ss(j.value.GetString());
+                            AV::IO::FFmpeg::ThreadType threadType = AV::IO::FFmpeg::ThreadType::First;
+                            ss >> threadType;
+                            out.codecThreadTypes[j.name.GetString()] = threadType;
+                        }
+                    }
+                }
+                else if (0 == strcmp("Codec", i.name.GetString()) && i.value.IsString())
+                {
+                    std::stringstream ss(i.value.GetString());
+                    ss >> out.codec;
+                }
+                else if (0 == strcmp("ProResProfile", i.name.GetString()) && i.value.IsString())
+                {
+                    std::stringstream ss(i.value.GetString());
+                    ss >> out.proResProfile;
+                }
+                else if (0 == strcmp("DNxHRProfile", i.name.GetString()) && i.value.IsString())
+                {
+                    std::stringstream ss(i.value.GetString());
+                    ss >> out.dnxhrProfile;
+                }
+                else if (0 == strcmp("H264CRF", i.name.GetString()))
+                {
+                    fromJSON(i.value, out.h264CRF);
+                }
             }
         }
         else
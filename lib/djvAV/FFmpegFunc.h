@@ -6,6 +6,11 @@
 
 #include <djvAV/FFmpeg.h>
 
+#include <djvCore/Enum.h>
+#include <djvCore/RapidJSONFunc.h>
+
+#include <sstream>
+
 namespace djv
 {
     namespace AV
@@ -15,8 +20,19 @@ namespace djv
             namespace FFmpeg
             {
                 Audio::Type toAudioType(AVSampleFormat);
+
+                //! Convert an audio type to a packed sample format.
+                AVSampleFormat toFFmpeg(Audio::Type);
+
                 std::string toString(AVSampleFormat);
 
+                //! Get the image type for a pixel format. Formats with more
+                //! than eight bits per component use 16-bit image types.
+                Image::Type getImageType(AVPixelFormat);
+
+                //! Convert an image type to a packed pixel format.
+                AVPixelFormat toFFmpeg(Image::Type);
+
                 void extractAudio(
                     uint8_t**                    inData,
                     int                          inFormat,
@@ -25,10 +41,36 @@ namespace djv
 
                 std::string getErrorString(int);
 
+                //! Get the thread type for a codec.
+                ThreadType getThreadType(const Options&, const std::string& codecName);
+
+                //! Convert a thread type to the FFmpeg thread type flags.
+                int toFFmpeg(ThreadType);
+
+                //! Get the encoder profile name for a ProRes profile.
+                std::string getProfileName(ProResProfile);
+
+                //! Get the encoder profile name for a DNxHR profile.
+                std::string getProfileName(DNxHRProfile);
+
+                //! Get the encoder pixel format for the write options. The
+                //! alpha channel is only kept when the profile supports it.
+                AVPixelFormat getPixelFormat(const Options&, bool alpha);
+
+                DJV_ENUM_HELPERS(ThreadType);
+                DJV_ENUM_HELPERS(Codec);
+                DJV_ENUM_HELPERS(ProResProfile);
+                DJV_ENUM_HELPERS(DNxHRProfile);
+
             } // namespace FFmpeg
         } // namespace IO
     } // namespace AV
 
+    DJV_ENUM_SERIALIZE_HELPERS(AV::IO::FFmpeg::ThreadType);
+    DJV_ENUM_SERIALIZE_HELPERS(AV::IO::FFmpeg::Codec);
+    DJV_ENUM_SERIALIZE_HELPERS(AV::IO::FFmpeg::ProResProfile);
+    DJV_ENUM_SERIALIZE_HELPERS(AV::IO::FFmpeg::DNxHRProfile);
+
     rapidjson::Value toJSON(const AV::IO::FFmpeg::Options&, rapidjson::Document::AllocatorType&);
 
     //! Throws:
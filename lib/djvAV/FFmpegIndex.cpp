@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/FFmpeg.h>
+
+#include <djvSystem/File.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/TextSystem.h>
+
+#include <djvCore/StringFormat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace FFmpeg
+            {
+                namespace
+                {
+                    const char     cacheMagic[]      = "djvKeyframeIndex";
+                    const uint32_t cacheVersion      = 1;
+                    const char     cacheExtension[]  = ".djvki";
+
+                } // namespace
+
+                size_t KeyframeIndex::getCount() const
+                {
+                    return _keyframes.size();
+                }
+
+                void KeyframeIndex::add(int64_t value)
+                {
+                    // Keyframes are usually added in order, so only search
+                    // when they are not.
+                    if (_keyframes.empty() || value > _keyframes.back())
+                    {
+                        _keyframes.push_back(value);
+                    }
+                    else
+                    {
+                        const auto i = std::lower_bound(_keyframes.begin(), _keyframes.end(), value);
+                        if (i == _keyframes.end() || *i != value)
+                        {
+                            _keyframes.insert(i, value);
+                        }
+                    }
+                }
+
+                bool KeyframeIndex::getKeyframe(int64_t value, int64_t& out) const
+                {
+                    // A partial index can only be used when it has a keyframe
+                    // after the time stamp, otherwise a nearer keyframe may
+                    // not have been indexed yet.
+                    const auto i = std::upper_bound(_keyframes.begin(), _keyframes.end(), value);
+                    if (i != _keyframes.begin() && (_complete || i != _keyframes.end()))
+                    {
+                        out = *(i - 1);
+                        return true;
+                    }
+                    return false;
+                }
+
+                bool KeyframeIndex::isComplete() const
+                {
+                    return _complete;
+                }
+
+                void KeyframeIndex::setComplete(bool value)
+                {
+                    _complete = value;
+                }
+
+                std::string KeyframeIndex::getCacheFileName(const System::File::Info& fileInfo)
+                {
+                    std::stringstream ss;
+                    ss << fileInfo.getFileName() << ":" << fileInfo.getTime() << ":" << fileInfo.getSize();
+                    std::stringstream out;
+                    out << std::hex << std::setfill('0') << std::setw(16) << std::hash<std::string>()(ss.str());
+                    out << cacheExtension;
+                    return out.str();
+                }
+
+                void KeyframeIndex::read(
+                    const std::string& fileName,
+                    const System::File::Info& fileInfo,
+                    const std::shared_ptr<System::TextSystem>& textSystem)
+                {
+                    auto io = System::File::IO::create();
+                    io->open(fileName, System::File::Mode::Read);
+                    char magic[sizeof(cacheMagic)];
+                    io->read(magic, sizeof(cacheMagic));
+                    uint32_t version = 0;
+                    io->readU32(&version);
+                    uint64_t size = 0;
+                    io->read(&size, 1, sizeof(uint64_t));
+                    int64_t time = 0;
+                    io->read(&time, 1, sizeof(int64_t));
+                    if (memcmp(magic, cacheMagic, sizeof(cacheMagic)) != 0 ||
+                        version != cacheVersion ||
+                        size != fileInfo.getSize() ||
+                        time != static_cast<int64_t>(fileInfo.getTime()))
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(textSystem->getText(DJV_TEXT("error_keyframe_index"))));
+                    }
+                    uint64_t count = 0;
+                    io->read(&count, 1, sizeof(uint64_t));
+                    if (count > (io->getSize() - io->getPos()) / sizeof(int64_t))
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(textSystem->getText(DJV_TEXT("error_keyframe_index"))));
+                    }
+                    std::vector<int64_t> keyframes(count);
+                    if (count > 0)
+                    {
+                        io->read(keyframes.data(), count, sizeof(int64_t));
+                    }
+                    _keyframes = std::move(keyframes);
+                    _complete = true;
+                }
+
+                void KeyframeIndex::write(const std::string& fileName, const System::File::Info& fileInfo) const
+                {
+                    auto io = System::File::IO::create();
+                    io->open(fileName, System::File::Mode::Write);
+                    io->write(cacheMagic, sizeof(cacheMagic));
+                    io->writeU32(cacheVersion);
+                    const uint64_t size = fileInfo.getSize();
+                    io->write(&size, 1, sizeof(uint64_t));
+                    const int64_t time = fileInfo.getTime();
+                    io->write(&time, 1, sizeof(int64_t));
+                    const uint64_t count = _keyframes.size();
+                    io->write(&count, 1, sizeof(uint64_t));
+                    if (count > 0)
+                    {
+                        io->write(_keyframes.data(), count, sizeof(int64_t));
+                    }
+                }
+
+            } // namespace FFmpeg
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
@@ -3,9 +3,18 @@
 // All rights reserved.
 
 #include <djvAV/FFmpegFunc.h>
+#include <djvAV/IOFunc.h>
+
+#include <djvAudio/RingBuffer.h>
+
+#include <djvImage/TypeFunc.h>
 
 #include <djvSystem/File.h>
+#include <djvSystem/FileInfo.h>
+#include <djvSystem/FileInfoFunc.h>
 #include <djvSystem/LogSystem.h>
+#include <djvSystem/PathFunc.h>
+#include <djvSystem/ResourceSystem.h>
 #include <djvSystem/TimerFunc.h>
 #include <djvSystem/TextSystem.h>
 
@@ -16,10 +25,14 @@ extern "C"
 #include <libavformat/avformat.h>
 #include <libavutil/dict.h>
 #include <libavutil/imgutils.h>
+#include <libswresample/swresample.h>
 #include <libswscale/swscale.h>
 
 } // extern "C"
 
+#include <chrono>
+#include <set>
+
 using namespace djv::Core;
 
 namespace djv
@@ -30,6 +43,37 @@ namespace djv
         {
             namespace FFmpeg
             {
+                namespace
+                {
+                    //! \todo Should this be configurable?
+                    const double infoTimeout = 0.5;
+
+                    //! The number of frames that are cached for reverse playback
+                    //! when the cache is disabled.
+                    const size_t reverseCacheFrameCount = 48;
+
+                    //! The size of the audio ring buffer in seconds.
+                    const size_t audioRingBufferSeconds = 1;
+
+                    std::mutex seekStatsMutex;
+                    Read::SeekStats seekStats;
+
+                    void addSeekStats(const std::chrono::steady_clock::time_point& seekTime, bool indexed)
+                    {
+                        const float latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - seekTime).count() / 1000.F;
+                        std::lock_guard<std::mutex> lock(seekStatsMutex);
+                        ++seekStats.count;
+                        if (indexed)
+                        {
+                            ++seekStats.indexedCount;
+                        }
+                        seekStats.lastLatency = latency;
+                        seekStats.averageLatency += (latency - seekStats.averageLatency) / seekStats.count;
+                    }
+
+                } // namespace
+
                 struct Read::Private
                 {
                     Options options;
@@ -40,6 +84,27 @@ namespace djv
                     Direction direction = Direction::Forward;
                     std::thread thread;
                     std::atomic<bool> running;
+                    int frameThreadDelay = 0;
+
+                    KeyframeIndex keyframeIndex;
+                    std::mutex keyframeIndexMutex;
+                    std::thread keyframeIndexThread;
+
+                    std::chrono::steady_clock::time_point seekTime;
+                    bool seekPending = false;
+                    bool seekIndexed = false;
+
+                    Math::Frame::Number frame = Math::Frame::invalid;
+                    bool resync = false;
+                    std::mutex cacheMutex;
+                    std::condition_variable cacheCV;
+                    std::vector<std::thread> cacheThreads;
+                    std::atomic<size_t> cacheThreadCount;
+                    std::set<int64_t> cacheGOPs;
+                    std::set<Math::Frame::Index> cacheMissing;
+                    std::atomic<size_t> cacheGeneration;
+                    bool cacheReady = false;
+                    std::chrono::steady_clock::time_point infoTimer;
 
                     AVFormatContext* avFormatContext = nullptr;
                     int avVideoStream = -1;
@@ -47,8 +112,20 @@ namespace djv
                     std::map<int, AVCodecParameters*> avCodecParameters;
                     std::map<int, AVCodecContext*> avCodecContext;
                     AVFrame* avFrame = nullptr;
-                    AVFrame* avFrameRgb = nullptr;
+                    AVRational avVideoTimeBase = { 0, 1 };
+                    AVPixelFormat avPixelFormatOut = AV_PIX_FMT_NONE;
                     SwsContext* swsContext = nullptr;
+
+                    //! The audio is resampled when the output format is
+                    //! different from the file.
+                    Audio::Info audioOutputInfo;
+                    SwrContext* swrContext = nullptr;
+                    std::vector<uint8_t> audioBuffer;
+
+                    //! The decoded samples that did not fit in the ring buffer.
+                    //! They are written before more packets are demuxed, so
+                    //! no audio is dropped when the video is far ahead.
+                    std::vector<uint8_t> audioPending;
                 };
 
                 void Read::_init(
@@ -62,6 +139,8 @@ namespace djv
                     IRead::_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
                     DJV_PRIVATE_PTR();
                     p.options = options;
+                    p.cacheGeneration = 0;
+                    p.cacheThreadCount = 0;
                     p.running = true;
                     p.thread = std::thread(
                         [this]
@@ -98,7 +177,7 @@ namespace djv
                             // Find the first video and audio stream.
                             for (unsigned int i = 0; i < p.avFormatContext->nb_streams; ++i)
                             {
-                                if (-1 == p.avVideoStream && p.avFormatContext->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
+                                if (-1 == p.avVideoStream && _options.video && p.avFormatContext->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
                                 {
                                     p.avVideoStream = i;
                                 }
@@ -127,6 +206,7 @@ namespace djv
                             {
                                 // Find the codec for the video stream.
                                 auto avVideoStream = p.avFormatContext->streams[p.avVideoStream];
+                                p.avVideoTimeBase = avVideoStream->time_base;
                                 auto avVideoCodecParameters = avVideoStream->codecpar;
                                 auto avVideoCodec = avcodec_find_decoder(avVideoCodecParameters->codec_id);
                                 if (!avVideoCodec)
@@ -152,7 +232,7 @@ namespace djv
                                         arg(FFmpeg::getErrorString(r)));
                                 }
                                 p.avCodecContext[p.avVideoStream]->thread_count = p.options.threadCount;
-                                p.avCodecContext[p.avVideoStream]->thread_type = FF_THREAD_SLICE;
+                                p.avCodecContext[p.avVideoStream]->thread_type = toFFmpeg(getThreadType(p.options, avVideoCodec->name));
                                 r = avcodec_open2(p.avCodecContext[p.avVideoStream], avVideoCodec, 0);
                                 if (r < 0)
                                 {
@@ -161,27 +241,30 @@ namespace djv
                                         arg(FFmpeg::getErrorString(r)));
                                 }
 
-                                // Initialize the buffers.
-                                p.avFrameRgb = av_frame_alloc();
-
-                                // Initialize the software scaler.
-                                p.swsContext = sws_getContext(
-                                    p.avCodecParameters[p.avVideoStream]->width,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    static_cast<AVPixelFormat>(p.avCodecParameters[p.avVideoStream]->format),
-                                    p.avCodecParameters[p.avVideoStream]->width,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    AV_PIX_FMT_RGBA,
-                                    SWS_BILINEAR,
-                                    0,
-                                    0,
-                                    0);
+                                // Frame threading delays the output of the
+                                // decoder by one frame per thread. The video
+                                // queue is made larger so that playback does not
+                                // stall while the decoder refills after a seek.
+                                if (p.avCodecContext[p.avVideoStream]->active_thread_type & FF_THREAD_FRAME)
+                                {
+                                    p.frameThreadDelay = std::max(p.avCodecContext[p.avVideoStream]->thread_count - 1, 0);
+                                    std::lock_guard<std::mutex> lock(_mutex);
+                                    _videoQueue.setMax(_videoQueue.getMax() + p.frameThreadDelay);
+                                }
 
-                                // Get information.
+                                // Get the image type. Sources with more than
+                                // eight bits per component are read as 16-bit.
+                                const AVPixelFormat avPixelFormat = static_cast<AVPixelFormat>(p.avCodecParameters[p.avVideoStream]->format);
                                 Image::Info imageInfo;
                                 imageInfo.size.w = p.avCodecParameters[p.avVideoStream]->width;
                                 imageInfo.size.h = p.avCodecParameters[p.avVideoStream]->height;
-                                imageInfo.type = Image::Type::RGBA_U8;
+                                imageInfo.type = getImageType(avPixelFormat);
+                                p.avPixelFormatOut = toFFmpeg(imageInfo.type);
+
+                                // Initialize the software scaler.
+                                p.swsContext = _createSwsContext(p.avCodecContext[p.avVideoStream], imageInfo);
+
+                                // Get information.
                                 imageInfo.codec = avVideoCodec->long_name;
                                 if (avVideoStream->duration != AV_NOPTS_VALUE)
                                 {
@@ -287,6 +370,48 @@ namespace djv
                                 p.info.audio.sampleRate = p.avCodecParameters[p.avAudioStream]->sample_rate;
                                 p.info.audio.codec = std::string(avAudioCodec->long_name);
                                 p.info.audioSampleCount = sampleCount;
+
+                                // Convert the audio to the output format in
+                                // this thread, so that the audio callback only
+                                // needs to copy the samples.
+                                p.audioOutputInfo = getAudioOutputInfo(p.info.audio, _options.audioOutput);
+                                if (p.audioOutputInfo.sampleRate != p.info.audio.sampleRate ||
+                                    p.audioOutputInfo.channelCount != p.info.audio.channelCount ||
+                                    p.audioOutputInfo.type != p.info.audio.type)
+                                {
+                                    const AVCodecContext* avCodecContext = p.avCodecContext[p.avAudioStream];
+                                    const AVSampleFormat avSampleFormatOut = FFmpeg::toFFmpeg(p.audioOutputInfo.type);
+                                    if (AV_SAMPLE_FMT_NONE == avSampleFormatOut)
+                                    {
+                                        throw System::File::Error(String::Format("{0}: {1}").
+                                            arg(_fileInfo.getFileName()).
+                                            arg(_textSystem->getText(DJV_TEXT("error_unsupported_audio_format"))));
+                                    }
+                                    p.swrContext = swr_alloc_set_opts(
+                                        nullptr,
+                                        av_get_default_channel_layout(p.audioOutputInfo.channelCount),
+                                        avSampleFormatOut,
+                                        static_cast<int>(p.audioOutputInfo.sampleRate),
+                                        avCodecContext->channel_layout ?
+                                            avCodecContext->channel_layout :
+                                            av_get_default_channel_layout(avCodecContext->channels),
+                                        avCodecContext->sample_fmt,
+                                        avCodecContext->sample_rate,
+                                        0,
+                                        nullptr);
+                                    if (!p.swrContext || swr_init(p.swrContext) < 0)
+                                    {
+                                        throw System::File::Error(String::Format("{0}: {1}").
+                                            arg(_fileInfo.getFileName()).
+                                            arg(_textSystem->getText(DJV_TEXT("error_unsupported_audio_format"))));
+                                    }
+                                }
+                                if (_options.audioRingBuffer)
+                                {
+                                    _audioRingBuffer = Audio::RingBuffer::create(
+                                        p.audioOutputInfo,
+                                        p.audioOutputInfo.sampleRate * audioRingBufferSeconds);
+                                }
                             }
 
                             AVDictionaryEntry* tag = nullptr;
@@ -297,92 +422,200 @@ namespace djv
 
                             p.infoPromise.set_value(p.info);
 
+                            p.infoTimer = std::chrono::steady_clock::now();
                             while (p.running)
                             {
-                                //! \todo Implement me!
-                                /*bool cacheEnabled = false;
+                                // Update the cache. Reverse playback always uses
+                                // the cache since the frames are decoded forwards
+                                // a group of pictures at a time.
+                                size_t threadCount = 4;
+                                bool playback = false;
+                                InOutPoints inOutPoints;
+                                bool cacheEnabled = false;
                                 size_t cacheMaxByteCount = 0;
+                                Math::Frame::Number currentFrame = p.frame;
                                 {
                                     std::lock_guard<std::mutex> lock(_mutex);
+                                    threadCount = _threadCount;
+                                    playback = _playback;
+                                    inOutPoints = _inOutPoints;
                                     cacheEnabled = _cacheEnabled;
                                     cacheMaxByteCount = _cacheMaxByteCount;
-                                    _cachedFrames = _getCachedFrames(_cache);
-                                }
-                                if (!cacheEnabled)
-                                {
-                                    _cache.clear();
+                                    if (_videoQueue.getCount())
+                                    {
+                                        currentFrame = _videoQueue.getFrame().frame;
+                                    }
                                 }
-                                if (info.video.size() && _options.layer < info.video.size())
+                                if (p.info.video.size())
                                 {
-                                    const size_t dataByteCount = info.video[_options.layer].info.getDataByteCount();
-                                    _cache.setMax(cacheMaxByteCount / dataByteCount);
+                                    const Image::Info& imageInfo = p.info.video[0];
+                                    const size_t byteCountEstimate = Image::Info(
+                                        getProxySize(imageInfo.size, _options.proxy),
+                                        imageInfo.type).getDataByteCount();
+                                    cacheMaxByteCount = cacheEnabled ? _getCacheMaxByteCount(cacheMaxByteCount) : 0;
+                                    if (Direction::Reverse == p.direction)
+                                    {
+                                        cacheMaxByteCount = std::max(cacheMaxByteCount, byteCountEstimate * reverseCacheFrameCount);
+                                    }
+                                    cacheEnabled = cacheMaxByteCount > 0;
+                                    {
+                                        std::lock_guard<std::mutex> lock(p.cacheMutex);
+                                        if (!cacheEnabled)
+                                        {
+                                            _cache.clear();
+                                        }
+                                        _cache.setMaxByteCount(cacheMaxByteCount);
+                                        _cache.setByteCountEstimate(byteCountEstimate);
+                                        _cache.setSequenceSize(p.info.videoSequence.getFrameCount());
+                                        _cache.setInOutPoints(inOutPoints);
+                                        _cache.setDirection(p.direction);
+                                        if (currentFrame != Math::Frame::invalid)
+                                        {
+                                            _cache.setCurrentFrame(currentFrame);
+                                        }
+                                    }
+
+                                    // The cache is filled by several decoders in
+                                    // parallel, each one decoding a different group
+                                    // of pictures. The number of decoders follows
+                                    // the thread count, during playback half of the
+                                    // threads are left for the playback decoder.
+                                    // The decoders are only created once the cache
+                                    // is used, so readers for thumbnails do not
+                                    // open the file again.
+                                    p.cacheThreadCount = cacheEnabled ?
+                                        std::max(playback ? (threadCount / 2) : threadCount, static_cast<size_t>(1)) :
+                                        0;
+                                    if (cacheEnabled)
+                                    {
+                                        _startKeyframeIndex();
+                                    }
+                                    while (p.cacheThreads.size() < p.cacheThreadCount)
+                                    {
+                                        const size_t index = p.cacheThreads.size();
+                                        p.cacheThreads.push_back(std::thread(
+                                            [this, index]
+                                            {
+                                                _fillCache(index);
+                                            }));
+                                    }
+                                    p.cacheCV.notify_all();
                                 }
                                 else
                                 {
-                                    _cache.setMax(0);
-                                }*/
+                                    cacheEnabled = false;
+                                }
 
                                 bool read = false;
                                 int64_t seek = Math::Frame::invalid;
                                 {
-                                    //const std::vector<Math::Frame::Number> cachedFrames = _cache.getKeys();
                                     std::unique_lock<std::mutex> lock(_mutex);
                                     if (p.queueCV.wait_for(
                                         lock,
                                         System::getTimerDuration(System::TimerValue::Fast),
-                                        [this, sequenceSize]
-                                        //[this, sequenceSize, cacheEnabled, &cachedFrames]
+                                        [this]
                                     {
                                         DJV_PRIVATE_PTR();
-                                        const bool video = p.avVideoStream != -1 && (_videoQueue.isFinished() ? false : (_videoQueue.getCount() < _videoQueue.getMax()));
-                                        const bool audio = p.avAudioStream != -1 && (_audioQueue.isFinished() ? false : (_audioQueue.getCount() < _audioQueue.getMax()));
-
-                                        /*bool cache = false;
-                                        if (cacheEnabled && !_videoQueue.isFinished() && !_audioQueue.isFinished())
-                                        {
-                                            const size_t cacheMax = _cache.getMax();
-                                            cache |= _cache.getSize() < cacheMax;
-                                            if (_videoQueue.getFrameCount())
-                                            {
-                                                const auto& frame = _videoQueue.getFrame();
-                                                for (const auto& i : cachedFrames)
-                                                {
-                                                    if (i < frame.frame || i > frame.frame + cacheMax)
-                                                    {
-                                                        cache = true;
-                                                        break;
-                                                    }
-                                                }
-                                            }
-                                        }*/
-                                        
-                                        return video || audio || p.seek != Math::Frame::invalid || p.direction != _direction;
-                                        //return video || audio || p.seek != Math::Frame::invalid || p.direction != _direction || cache;
+                                        const bool forward = Direction::Forward == p.direction;
+                                        const bool video = p.avVideoStream != -1 && (_videoQueue.isFinished() ? false : (_videoQueue.getCount() < _videoQueue.getMax())) &&
+                                            (forward || p.cacheReady);
+                                        // The ring buffer is refilled once half of it
+                                        // has been read.
+                                        const bool audio = p.avAudioStream != -1 && (_audioQueue.isFinished() ? false :
+                                            (_audioRingBuffer ?
+                                                (_audioRingBuffer->getWriteAvailable() >= _audioRingBuffer->getSampleCount() / 2) :
+                                                (_audioQueue.getCount() < _audioQueue.getMax()))) &&
+                                            forward;
+                                        // Nothing is demuxed while the samples
+                                        // that are waiting do not fit.
+                                        const bool audioFull = _audioRingBuffer &&
+                                            p.audioPending.size() / _audioRingBuffer->getInfo().getByteCount() > _audioRingBuffer->getWriteAvailable();
+                                        return ((video || audio) && !audioFull) || p.seek != Math::Frame::invalid || p.direction != _direction;
                                     }))
                                     {
                                         read = true;
+                                        p.cacheReady = false;
                                         if (p.direction != _direction)
                                         {
                                             p.direction = _direction;
+                                            p.audioPending.clear();
                                             _videoQueue.setFinished(false);
                                             _videoQueue.clearFrames();
-                                            _audioQueue.setFinished(false);
+                                            _audioQueue.setFinished(Direction::Reverse == p.direction);
                                             _audioQueue.clearFrames();
+                                            if (_audioRingBuffer)
+                                            {
+                                                _audioRingBuffer->setFinished(Direction::Reverse == p.direction);
+                                            }
                                         }
                                         if (p.seek != Math::Frame::invalid)
                                         {
                                             seek = p.seek;
                                             p.seek = Math::Frame::invalid;
+                                            p.seekPending = true;
+                                            p.audioPending.clear();
                                             _videoQueue.setFinished(false);
                                             _videoQueue.clearFrames();
-                                            _audioQueue.setFinished(false);
+                                            _audioQueue.setFinished(Direction::Reverse == p.direction);
                                             _audioQueue.clearFrames();
+                                            if (_audioRingBuffer)
+                                            {
+                                                _audioRingBuffer->setFinished(Direction::Reverse == p.direction);
+                                            }
                                         }
                                     }
                                 }
+                                if (!_writeAudioPending() && Math::Frame::invalid == seek)
+                                {
+                                    read = false;
+                                }
+
                                 AVPacket packet;
                                 try
                                 {
+                                    if (seek != Math::Frame::invalid)
+                                    {
+                                        p.frame = seek;
+                                        p.resync = false;
+                                    }
+
+                                    if (Direction::Reverse == p.direction)
+                                    {
+                                        // Queue the cached frames backwards.
+                                        if (read)
+                                        {
+                                            _queueCachedFrames();
+                                        }
+                                        read = false;
+                                        seek = Math::Frame::invalid;
+                                    }
+                                    else if (p.avVideoStream != -1 && cacheEnabled)
+                                    {
+                                        if (-1 == p.avAudioStream)
+                                        {
+                                            // Files without audio are played from
+                                            // the cache when possible, the demuxer
+                                            // is only moved when a frame is missing.
+                                            if (read && _queueCachedFrames() > 0)
+                                            {
+                                                p.resync = true;
+                                                read = false;
+                                                seek = Math::Frame::invalid;
+                                            }
+                                            else if (p.resync)
+                                            {
+                                                p.resync = false;
+                                                seek = p.frame;
+                                            }
+                                        }
+                                        else if (seek != Math::Frame::invalid)
+                                        {
+                                            // Show the cached frame immediately, the
+                                            // audio still needs to be decoded.
+                                            _queueCachedFrames(1);
+                                        }
+                                    }
+
                                     if (seek != Math::Frame::invalid)
                                     {
                                         int64_t t = 0;
@@ -390,11 +623,7 @@ namespace djv
                                         if (p.avVideoStream != -1)
                                         {
                                             stream = p.avVideoStream;
-                                            AVRational r;
-                                            r.num = p.info.videoSpeed.getDen();
-                                            r.den = p.info.videoSpeed.getNum();
-                                            t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avVideoStream]->time_base);
-                                            //t = av_rescale_q(seek, r, av_get_time_base_q());
+                                            t = _getVideoTime(seek);
                                         }
                                         else if (p.avAudioStream != -1)
                                         {
@@ -405,6 +634,7 @@ namespace djv
                                             t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avAudioStream]->time_base);
                                             //t = av_rescale_q(seek, r, av_get_time_base_q());
                                         }
+                                        int64_t seekTarget = t;
                                         if (p.avVideoStream != -1)
                                         {
                                             avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
@@ -412,26 +642,51 @@ namespace djv
                                         if (p.avAudioStream != -1)
                                         {
                                             avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
+                                            if (p.swrContext)
+                                            {
+                                                // Discard the buffered samples.
+                                                swr_init(p.swrContext);
+                                            }
+                                        }
+
+                                        // Seek directly to the nearest keyframe
+                                        // when the index has it.
+                                        p.seekIndexed = false;
+                                        if (stream == p.avVideoStream)
+                                        {
+                                            _startKeyframeIndex();
+                                            int64_t keyframe = 0;
+                                            std::lock_guard<std::mutex> lock(p.keyframeIndexMutex);
+                                            if (p.keyframeIndex.getKeyframe(t, keyframe))
+                                            {
+                                                seekTarget = keyframe;
+                                                p.seekIndexed = true;
+                                            }
                                         }
                                         if (av_seek_frame(
                                             p.avFormatContext,
                                             stream,
-                                            t,
+                                            seekTarget,
                                             AVSEEK_FLAG_BACKWARD) < 0)
                                         {
                                             throw std::exception();
                                         }
                                         Math::Frame::Number videoFrame = Math::Frame::invalid;
                                         Math::Frame::Number audioFrame = Math::Frame::invalid;
-                                        while (videoFrame < seek - 1 || audioFrame < seek - 1)
+                                        // Decode until each stream has reached the seek
+                                        // frame. With frame threading the frames come
+                                        // out of the decoder late, so streams that are
+                                        // not present must not keep the loop going.
+                                        while ((p.avVideoStream != -1 && videoFrame < seek - 1) ||
+                                            (p.avAudioStream != -1 && audioFrame < seek - 1))
                                         {
                                             if (av_read_frame(p.avFormatContext, &packet) < 0)
                                             {
                                                 if (p.avVideoStream != -1)
                                                 {
                                                     DecodeVideo dv;
-                                                    //dv.cacheEnabled = cacheEnabled;
-                                                    dv.seek         = seek;
+                                                    dv.seek         = p.frame;
+                                                    dv.cacheEnabled = cacheEnabled;
                                                     _decodeVideo(dv, videoFrame);
                                                     avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
                                                 }
@@ -446,10 +701,17 @@ namespace djv
                                             }
                                             if (p.avVideoStream == packet.stream_index)
                                             {
+                                                // Frames before the seek target are
+                                                // not shown, so only the reference
+                                                // frames among them are decoded.
+                                                p.avCodecContext[p.avVideoStream]->skip_frame =
+                                                    packet.pts != AV_NOPTS_VALUE && packet.pts < t ?
+                                                    AVDISCARD_NONREF :
+                                                    AVDISCARD_DEFAULT;
                                                 DecodeVideo dv;
                                                 dv.packet       = &packet;
-                                                dv.seek         = seek;
-                                                //dv.cacheEnabled = cacheEnabled;
+                                                dv.seek         = p.frame;
+                                                dv.cacheEnabled = cacheEnabled;
                                                 if (_decodeVideo(dv, videoFrame) < 0)
                                                 {
                                                     throw std::exception();
@@ -467,6 +729,10 @@ namespace djv
                                             }
                                             av_packet_unref(&packet);
                                         }
+                                        if (p.avVideoStream != -1)
+                                        {
+                                            p.avCodecContext[p.avVideoStream]->skip_frame = AVDISCARD_DEFAULT;
+                                        }
                                     }
                                     if (read)
                                     {
@@ -478,7 +744,7 @@ namespace djv
                                             if (p.avVideoStream != -1)
                                             {
                                                 DecodeVideo dv;
-                                                //dv.cacheEnabled = cacheEnabled;
+                                                dv.cacheEnabled = cacheEnabled;
                                                 _decodeVideo(dv, videoFrame);
                                                 avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
                                             }
@@ -494,7 +760,7 @@ namespace djv
                                         {
                                             DecodeVideo dv;
                                             dv.packet       = &packet;
-                                            //dv.cacheEnabled = cacheEnabled;
+                                            dv.cacheEnabled = cacheEnabled;
                                             if (_decodeVideo(dv, videoFrame) < 0)
                                             {
                                                 throw std::exception();
@@ -524,6 +790,33 @@ namespace djv
                                         std::lock_guard<std::mutex> lock(_mutex);
                                         _videoQueue.setFinished(true);
                                         _audioQueue.setFinished(true);
+                                        if (_audioRingBuffer)
+                                        {
+                                            _audioRingBuffer->setFinished(true);
+                                        }
+                                    }
+                                }
+
+                                // Update information.
+                                const auto now = std::chrono::steady_clock::now();
+                                std::chrono::duration<double> delta = now - p.infoTimer;
+                                if (delta.count() > infoTimeout)
+                                {
+                                    p.infoTimer = now;
+                                    size_t cacheByteCount = 0;
+                                    Math::Frame::Sequence cacheSequence;
+                                    Math::Frame::Sequence cachedFrames;
+                                    {
+                                        std::lock_guard<std::mutex> lock(p.cacheMutex);
+                                        cacheByteCount = _cache.getTotalByteCount();
+                                        cacheSequence = _cache.getSequence();
+                                        cachedFrames = _cache.getFrames();
+                                    }
+                                    {
+                                        std::lock_guard<std::mutex> lock(_mutex);
+                                        _cacheByteCount = cacheByteCount;
+                                        _cacheSequence = cacheSequence;
+                                        _cachedFrames = std::move(cachedFrames);
                                     }
                                 }
                             }
@@ -533,13 +826,21 @@ namespace djv
                             p.infoPromise.set_value(Info());
                             _logSystem->log("djvAV::IO::FFmpeg::Read", e.what(), System::LogLevel::Error);
                         }
+                        p.running = false;
+                        for (auto& i : p.cacheThreads)
+                        {
+                            if (i.joinable())
+                            {
+                                i.join();
+                            }
+                        }
                         if (p.swsContext)
                         {
                             sws_freeContext(p.swsContext);
                         }
-                        if (p.avFrameRgb)
+                        if (p.swrContext)
                         {
-                            av_frame_free(&p.avFrameRgb);
+                            swr_free(&p.swrContext);
                         }
                         if (p.avFrame)
                         {
@@ -574,6 +875,10 @@ namespace djv
 						//! \todo How do we safely detach the thread here so we don't block?
                         p.thread.join();
                     }
+                    if (p.keyframeIndexThread.joinable())
+                    {
+                        p.keyframeIndexThread.join();
+                    }
                 }
 
                 std::shared_ptr<Read> Read::create(
@@ -599,16 +904,193 @@ namespace djv
                     return _p->infoPromise.get_future();
                 }
 
-                void Read::seek(Math::Frame::Number value, Direction)
+                Read::SeekStats Read::getSeekStats()
+                {
+                    std::lock_guard<std::mutex> lock(seekStatsMutex);
+                    return seekStats;
+                }
+
+                void Read::seek(Math::Frame::Number value, Direction direction)
                 {
                     DJV_PRIVATE_PTR();
                     {
                         std::lock_guard<std::mutex> lock(_mutex);
                         _videoQueue.clearFrames();
                         _audioQueue.clearFrames();
+                        if (_audioRingBuffer)
+                        {
+                            _audioRingBuffer->flush();
+                        }
                         p.seek = value;
+                        p.seekTime = std::chrono::steady_clock::now();
+                        _direction = direction;
                     }
+                    ++p.cacheGeneration;
                     p.queueCV.notify_one();
+                    p.cacheCV.notify_all();
+                }
+
+                bool Read::hasCache() const
+                {
+                    return _p->info.videoSequence.getFrameCount() > 1;
+                }
+
+                SwsContext* Read::_createSwsContext(const AVCodecContext* avCodecContext, const Image::Info& info) const
+                {
+                    // The scaler is not needed when the decoder already outputs
+                    // the image type, proxies are reduced by the scaler.
+                    DJV_PRIVATE_PTR();
+                    SwsContext* out = nullptr;
+                    if (avCodecContext->pix_fmt != p.avPixelFormatOut || _options.proxy != Proxy::None)
+                    {
+                        const Image::Size proxySize = getProxySize(info.size, _options.proxy);
+                        int flags = _options.proxy != Proxy::None ? SWS_AREA : SWS_BILINEAR;
+                        if (Image::getBitDepth(info.type) > 8)
+                        {
+                            flags |= SWS_ACCURATE_RND | SWS_FULL_CHR_H_INT;
+                        }
+                        out = sws_getContext(
+                            info.size.w,
+                            info.size.h,
+                            avCodecContext->pix_fmt,
+                            proxySize.w,
+                            proxySize.h,
+                            p.avPixelFormatOut,
+                            flags,
+                            0,
+                            0,
+                            0);
+                        if (!out)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(_fileInfo.getFileName()).
+                                arg(_textSystem->getText(DJV_TEXT("error_unsupported_image_type"))));
+                        }
+
+                        // Use the color space and range of the source instead
+                        // of the scaler defaults.
+                        sws_setColorspaceDetails(
+                            out,
+                            sws_getCoefficients(avCodecContext->colorspace != AVCOL_SPC_UNSPECIFIED ?
+                                avCodecContext->colorspace :
+                                SWS_CS_DEFAULT),
+                            AVCOL_RANGE_JPEG == avCodecContext->color_range ? 1 : 0,
+                            sws_getCoefficients(SWS_CS_DEFAULT),
+                            1,
+                            0,
+                            1 << 16,
+                            1 << 16);
+                    }
+                    return out;
+                }
+
+                std::shared_ptr<Image::Data> Read::_copyImage(const AVFrame* avFrame, SwsContext* swsContext) const
+                {
+                    DJV_PRIVATE_PTR();
+                    Image::Info imageInfo;
+                    if (p.info.video.size())
+                    {
+                        imageInfo = p.info.video[0];
+                        imageInfo.size = getProxySize(imageInfo.size, _options.proxy);
+                    }
+                    if (!((0 == avFrame->sample_aspect_ratio.num && 1 == avFrame->sample_aspect_ratio.den) ||
+                        0 == avFrame->sample_aspect_ratio.den))
+                    {
+                        imageInfo.pixelAspectRatio = avFrame->sample_aspect_ratio.num / static_cast<float>(avFrame->sample_aspect_ratio.den);
+                    }
+                    auto out = Image::Data::create(imageInfo);
+                    out->setPluginName(pluginName);
+                    out->setScale(getProxyScale(_options.proxy));
+                    if (swsContext)
+                    {
+                        uint8_t* data[4] = { out->getData(), nullptr, nullptr, nullptr };
+                        const int linesize[4] = { static_cast<int>(out->getScanlineByteCount()), 0, 0, 0 };
+                        sws_scale(
+                            swsContext,
+                            (uint8_t const* const*)avFrame->data,
+                            avFrame->linesize,
+                            0,
+                            avFrame->height,
+                            data,
+                            linesize);
+                    }
+                    else
+                    {
+                        av_image_copy_plane(
+                            out->getData(),
+                            static_cast<int>(out->getScanlineByteCount()),
+                            avFrame->data[0],
+                            avFrame->linesize[0],
+                            static_cast<int>(out->getWidth() * out->getPixelByteCount()),
+                            out->getHeight());
+                    }
+                    return out;
+                }
+
+                Math::Frame::Number Read::_getVideoFrame(int64_t pts) const
+                {
+                    DJV_PRIVATE_PTR();
+                    AVRational r;
+                    r.num = p.info.videoSpeed.getDen();
+                    r.den = p.info.videoSpeed.getNum();
+                    return av_rescale_q(pts, p.avVideoTimeBase, r);
+                }
+
+                int64_t Read::_getVideoTime(Math::Frame::Number value) const
+                {
+                    DJV_PRIVATE_PTR();
+                    AVRational r;
+                    r.num = p.info.videoSpeed.getDen();
+                    r.den = p.info.videoSpeed.getNum();
+                    return av_rescale_q(value, r, p.avVideoTimeBase);
+                }
+
+                size_t Read::_queueCachedFrames(size_t max)
+                {
+                    DJV_PRIVATE_PTR();
+                    size_t count = 0;
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        if (_videoQueue.getCount() < _videoQueue.getMax())
+                        {
+                            count = _videoQueue.getMax() - _videoQueue.getCount();
+                        }
+                    }
+                    if (max > 0)
+                    {
+                        count = std::min(count, max);
+                    }
+                    const Math::Frame::Number step = Direction::Forward == p.direction ? 1 : -1;
+                    std::vector<VideoFrame> frames;
+                    {
+                        std::lock_guard<std::mutex> lock(p.cacheMutex);
+                        std::shared_ptr<Image::Data> image;
+                        while (frames.size() < count && p.frame >= 0 && _cache.get(p.frame, image))
+                        {
+                            frames.push_back(VideoFrame(p.frame, image));
+                            p.frame += step;
+                        }
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        if (Math::Frame::invalid == p.seek)
+                        {
+                            for (const auto& i : frames)
+                            {
+                                _videoQueue.addFrame(i);
+                            }
+                            if (Direction::Reverse == p.direction && p.frame < 0)
+                            {
+                                _videoQueue.setFinished(true);
+                            }
+                            if (frames.size() && p.seekPending)
+                            {
+                                p.seekPending = false;
+                                addSeekStats(p.seekTime, false);
+                            }
+                        }
+                    }
+                    return frames.size();
                 }
 
                 int Read::_decodeVideo(const DecodeVideo& dv, Math::Frame::Number& frame)
@@ -628,52 +1110,24 @@ namespace djv
                             break;
                         }
                         
-                        AVRational r;
-                        r.num = p.info.videoSpeed.getDen();
-                        r.den = p.info.videoSpeed.getNum();
-                        frame = av_rescale_q(
-                            p.avFrame->pts,
-                            p.avFormatContext->streams[p.avVideoStream]->time_base,
-                            r);
+                        frame = _getVideoFrame(p.avFrame->pts);
                         //std::cout << "decode video = " << frame << std::endl;
 
                         if (Math::Frame::invalid == dv.seek || frame >= dv.seek)
                         {
                             std::shared_ptr<Image::Data> image;
-                            if (dv.cacheEnabled && _cache.get(frame, image))
-                            {}
-                            else
+                            bool cached = false;
+                            if (dv.cacheEnabled)
                             {
-                                Image::Info imageInfo;
-                                if (p.info.video.size())
-                                {
-                                    imageInfo = p.info.video[0];
-                                }
-                                if (!((0 == p.avFrame->sample_aspect_ratio.num && 1 == p.avFrame->sample_aspect_ratio.den) ||
-                                    0 == p.avFrame->sample_aspect_ratio.den))
-                                {
-                                    imageInfo.pixelAspectRatio = p.avFrame->sample_aspect_ratio.num / static_cast<float>(p.avFrame->sample_aspect_ratio.den);
-                                }
-                                image = Image::Data::create(imageInfo);
-                                image->setPluginName(pluginName);
-                                av_image_fill_arrays(
-                                    p.avFrameRgb->data,
-                                    p.avFrameRgb->linesize,
-                                    image->getData(),
-                                    AV_PIX_FMT_RGBA,
-                                    image->getWidth(),
-                                    image->getHeight(),
-                                    1);
-                                sws_scale(
-                                    p.swsContext,
-                                    (uint8_t const* const*)p.avFrame->data,
-                                    p.avFrame->linesize,
-                                    0,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    p.avFrameRgb->data,
-                                    p.avFrameRgb->linesize);
+                                std::lock_guard<std::mutex> lock(p.cacheMutex);
+                                cached = _cache.get(frame, image);
+                            }
+                            if (!cached)
+                            {
+                                image = _copyImage(p.avFrame, p.swsContext);
                                 if (dv.cacheEnabled)
                                 {
+                                    std::lock_guard<std::mutex> lock(p.cacheMutex);
                                     _cache.add(frame, image);
                                 }
                             }
@@ -682,6 +1136,12 @@ namespace djv
                                 if (Math::Frame::invalid == p.seek)
                                 {
                                     _videoQueue.addFrame(VideoFrame(frame, image));
+                                    p.frame = frame + 1;
+                                    if (p.seekPending)
+                                    {
+                                        p.seekPending = false;
+                                        addSeekStats(p.seekTime, p.seekIndexed);
+                                    }
                                 }
                             }
                         }
@@ -689,6 +1149,376 @@ namespace djv
                     return r;
                 }
 
+                void Read::_startKeyframeIndex()
+                {
+                    DJV_PRIVATE_PTR();
+
+                    // Every frame of an intra-only codec is a keyframe, so
+                    // there is nothing to index.
+                    bool intraOnly = false;
+                    if (p.avVideoStream != -1)
+                    {
+                        const AVCodecDescriptor* avCodecDescriptor = avcodec_descriptor_get(
+                            p.avCodecParameters[p.avVideoStream]->codec_id);
+                        intraOnly = avCodecDescriptor && (avCodecDescriptor->props & AV_CODEC_PROP_INTRA_ONLY);
+                    }
+
+                    if (p.avVideoStream != -1 && !intraOnly && !p.keyframeIndexThread.joinable())
+                    {
+                        p.keyframeIndexThread = std::thread(
+                            [this]
+                            {
+                                _buildKeyframeIndex();
+                            });
+                    }
+                }
+
+                void Read::_buildKeyframeIndex()
+                {
+                    DJV_PRIVATE_PTR();
+                    const std::string fileName = _fileInfo.getFileName();
+                    const System::File::Info fileInfo(fileName);
+                    const System::File::Path cachePath(
+                        _resourceSystem->getPath(System::File::ResourcePath::Documents),
+                        "KeyframeIndex");
+                    const std::string cacheFileName = System::File::Path(
+                        cachePath,
+                        KeyframeIndex::getCacheFileName(fileInfo)).get();
+
+                    // Use the cached index if it is still valid.
+                    try
+                    {
+                        KeyframeIndex keyframeIndex;
+                        keyframeIndex.read(cacheFileName, fileInfo, _textSystem);
+                        std::lock_guard<std::mutex> lock(p.keyframeIndexMutex);
+                        p.keyframeIndex = std::move(keyframeIndex);
+                        return;
+                    }
+                    catch (const std::exception&)
+                    {}
+
+                    // Open a separate context so the decoder is not disturbed.
+                    AVFormatContext* avFormatContext = nullptr;
+                    if (avformat_open_input(&avFormatContext, fileName.c_str(), nullptr, nullptr) < 0)
+                    {
+                        return;
+                    }
+
+                    // Containers with a seek index, like MP4 and MOV, list
+                    // the keyframes in their header so the packets do not
+                    // need to be read.
+                    bool indexed = false;
+                    if (p.avVideoStream < static_cast<int>(avFormatContext->nb_streams))
+                    {
+                        AVStream* avStream = avFormatContext->streams[p.avVideoStream];
+                        std::lock_guard<std::mutex> lock(p.keyframeIndexMutex);
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100)
+                        const int count = avformat_index_get_entries_count(avStream);
+#else // LIBAVFORMAT_VERSION_INT
+                        const int count = avStream->nb_index_entries;
+#endif // LIBAVFORMAT_VERSION_INT
+                        for (int i = 0; i < count; ++i)
+                        {
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100)
+                            const AVIndexEntry* entry = avformat_index_get_entry(avStream, i);
+#else // LIBAVFORMAT_VERSION_INT
+                            const AVIndexEntry* entry = &avStream->index_entries[i];
+#endif // LIBAVFORMAT_VERSION_INT
+                            if (entry->flags & AVINDEX_KEYFRAME)
+                            {
+                                p.keyframeIndex.add(entry->timestamp);
+                                indexed = true;
+                            }
+                        }
+                    }
+
+                    // Otherwise scan the packets.
+                    AVPacket packet;
+                    av_init_packet(&packet);
+                    while (!indexed && p.running && av_read_frame(avFormatContext, &packet) >= 0)
+                    {
+                        if (p.avVideoStream == packet.stream_index && (packet.flags & AV_PKT_FLAG_KEY))
+                        {
+                            const int64_t t = packet.pts != AV_NOPTS_VALUE ? packet.pts : packet.dts;
+                            if (t != AV_NOPTS_VALUE)
+                            {
+                                std::lock_guard<std::mutex> lock(p.keyframeIndexMutex);
+                                p.keyframeIndex.add(t);
+                            }
+                        }
+                        av_packet_unref(&packet);
+                    }
+                    avformat_close_input(&avFormatContext);
+
+                    if (p.running)
+                    {
+                        try
+                        {
+                            std::lock_guard<std::mutex> lock(p.keyframeIndexMutex);
+                            p.keyframeIndex.setComplete(true);
+                            if (!System::File::Info(cachePath).doesExist())
+                            {
+                                System::File::mkdir(cachePath);
+                            }
+                            p.keyframeIndex.write(cacheFileName, fileInfo);
+                        }
+                        catch (const std::exception& e)
+                        {
+                            _logSystem->log("djv::AV::IO::FFmpeg::Read", e.what(), System::LogLevel::Warning);
+                        }
+                    }
+                }
+
+                void Read::_fillCache(size_t index)
+                {
+                    DJV_PRIVATE_PTR();
+                    AVFormatContext* avFormatContext = nullptr;
+                    AVCodecContext* avCodecContext = nullptr;
+                    SwsContext* swsContext = nullptr;
+                    AVFrame* avFrame = nullptr;
+                    AVPacket packet;
+                    av_init_packet(&packet);
+                    try
+                    {
+                        // Open a separate decoder so the playback decoder is not
+                        // disturbed.
+                        const std::string fileName = _fileInfo.getFileName();
+                        int r = avformat_open_input(&avFormatContext, fileName.c_str(), nullptr, nullptr);
+                        if (r < 0)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(fileName).
+                                arg(FFmpeg::getErrorString(r)));
+                        }
+                        r = avformat_find_stream_info(avFormatContext, 0);
+                        if (r < 0)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(fileName).
+                                arg(FFmpeg::getErrorString(r)));
+                        }
+                        auto avCodecParameters = avFormatContext->streams[p.avVideoStream]->codecpar;
+                        auto avCodec = avcodec_find_decoder(avCodecParameters->codec_id);
+                        if (!avCodec)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(fileName).
+                                arg(_textSystem->getText(DJV_TEXT("error_no_video_codecs"))));
+                        }
+                        avCodecContext = avcodec_alloc_context3(avCodec);
+                        r = avcodec_parameters_to_context(avCodecContext, avCodecParameters);
+                        if (r < 0)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(fileName).
+                                arg(FFmpeg::getErrorString(r)));
+                        }
+                        // The decoder threads are shared between the cache
+                        // decoders.
+                        avCodecContext->thread_count = static_cast<int>(std::max(
+                            p.options.threadCount / std::max(p.cacheThreadCount.load(), static_cast<size_t>(1)),
+                            static_cast<size_t>(1)));
+                        avCodecContext->thread_type = toFFmpeg(getThreadType(p.options, avCodec->name));
+                        r = avcodec_open2(avCodecContext, avCodec, 0);
+                        if (r < 0)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(fileName).
+                                arg(FFmpeg::getErrorString(r)));
+                        }
+                        swsContext = _createSwsContext(avCodecContext, p.info.video[0]);
+                        avFrame = av_frame_alloc();
+
+                        bool idle = true;
+                        while (p.running)
+                        {
+                            // Find the first frame in the cache window that has
+                            // not been decoded and whose group of pictures is not
+                            // being decoded by another decoder. Groups are found
+                            // with the keyframe index, until it is available only
+                            // the first decoder runs.
+                            Math::Frame::Index frame = Math::Frame::invalid;
+                            int64_t t = 0;
+                            int64_t gop = 0;
+                            bool indexed = false;
+                            {
+                                std::unique_lock<std::mutex> lock(p.cacheMutex);
+                                if (idle)
+                                {
+                                    p.cacheCV.wait_for(lock, System::getTimerDuration(System::TimerValue::Fast));
+                                }
+                                if (index < p.cacheThreadCount)
+                                {
+                                    for (const auto i : _cache.getWindow())
+                                    {
+                                        if (!_cache.contains(i) && p.cacheMissing.find(i) == p.cacheMissing.end())
+                                        {
+                                            t = _getVideoTime(i);
+                                            {
+                                                std::lock_guard<std::mutex> indexLock(p.keyframeIndexMutex);
+                                                indexed = p.keyframeIndex.getKeyframe(t, gop);
+                                            }
+                                            if (!indexed)
+                                            {
+                                                gop = t;
+                                            }
+                                            if ((indexed || 0 == index) && p.cacheGOPs.find(gop) == p.cacheGOPs.end())
+                                            {
+                                                p.cacheGOPs.insert(gop);
+                                                frame = i;
+                                                break;
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+                            idle = Math::Frame::invalid == frame;
+                            if (idle)
+                            {
+                                continue;
+                            }
+
+                            // Seek to the start of the group of pictures.
+                            const size_t generation = p.cacheGeneration;
+                            avcodec_flush_buffers(avCodecContext);
+                            if (av_seek_frame(avFormatContext, p.avVideoStream, gop, AVSEEK_FLAG_BACKWARD) < 0)
+                            {
+                                std::lock_guard<std::mutex> lock(p.cacheMutex);
+                                p.cacheGOPs.erase(gop);
+                                p.cacheMissing.insert(frame);
+                                continue;
+                            }
+
+                            // Decode forwards until a frame is reached that is
+                            // already cached, outside of the cache window, or in
+                            // the next group of pictures. The decoding stops early
+                            // if there is a seek.
+                            bool done = false;
+                            while (p.running && !done && generation == p.cacheGeneration)
+                            {
+                                const bool eof = av_read_frame(avFormatContext, &packet) < 0;
+                                if (!eof && packet.stream_index != p.avVideoStream)
+                                {
+                                    av_packet_unref(&packet);
+                                    continue;
+                                }
+                                if (!eof)
+                                {
+                                    avCodecContext->skip_frame = packet.pts != AV_NOPTS_VALUE && packet.pts < t ?
+                                        AVDISCARD_NONREF :
+                                        AVDISCARD_DEFAULT;
+                                }
+                                r = avcodec_send_packet(avCodecContext, eof ? nullptr : &packet);
+                                av_packet_unref(&packet);
+                                while (r >= 0 && !done)
+                                {
+                                    r = avcodec_receive_frame(avCodecContext, avFrame);
+                                    if (r < 0)
+                                    {
+                                        break;
+                                    }
+                                    if (indexed && avFrame->pts != AV_NOPTS_VALUE)
+                                    {
+                                        // Past the coverage of a partial index
+                                        // the next group of pictures is found
+                                        // from the decoded keyframe instead.
+                                        int64_t keyframe = 0;
+                                        bool covered = false;
+                                        {
+                                            std::lock_guard<std::mutex> lock(p.keyframeIndexMutex);
+                                            covered = p.keyframeIndex.getKeyframe(avFrame->pts, keyframe);
+                                        }
+                                        if ((covered && keyframe != gop) ||
+                                            (!covered && avFrame->key_frame && avFrame->pts != gop))
+                                        {
+                                            done = true;
+                                            break;
+                                        }
+                                    }
+                                    const Math::Frame::Index decodedFrame = _getVideoFrame(avFrame->pts);
+                                    if (decodedFrame >= frame)
+                                    {
+                                        bool add = false;
+                                        {
+                                            std::lock_guard<std::mutex> lock(p.cacheMutex);
+                                            add = _cache.getSequence().contains(decodedFrame) && !_cache.contains(decodedFrame);
+                                        }
+                                        if (add)
+                                        {
+                                            auto image = _copyImage(avFrame, swsContext);
+                                            {
+                                                std::lock_guard<std::mutex> lock(p.cacheMutex);
+                                                _cache.add(decodedFrame, image);
+                                            }
+                                            {
+                                                std::lock_guard<std::mutex> lock(_mutex);
+                                                p.cacheReady = true;
+                                            }
+                                            p.queueCV.notify_one();
+                                        }
+                                        else if (decodedFrame > frame)
+                                        {
+                                            done = true;
+                                        }
+                                    }
+                                }
+                                done |= eof;
+                            }
+                            {
+                                std::lock_guard<std::mutex> lock(p.cacheMutex);
+                                p.cacheGOPs.erase(gop);
+                                if (p.running && generation == p.cacheGeneration && !_cache.contains(frame))
+                                {
+                                    p.cacheMissing.insert(frame);
+                                }
+                            }
+                            p.cacheCV.notify_all();
+                        }
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _logSystem->log("djv::AV::IO::FFmpeg::Read", e.what(), System::LogLevel::Error);
+                    }
+                    av_packet_unref(&packet);
+                    if (avFrame)
+                    {
+                        av_frame_free(&avFrame);
+                    }
+                    if (swsContext)
+                    {
+                        sws_freeContext(swsContext);
+                    }
+                    if (avCodecContext)
+                    {
+                        avcodec_close(avCodecContext);
+                        avcodec_free_context(&avCodecContext);
+                    }
+                    if (avFormatContext)
+                    {
+                        avformat_close_input(&avFormatContext);
+                    }
+                }
+
+                bool Read::_writeAudioPending()
+                {
+                    DJV_PRIVATE_PTR();
+                    if (_audioRingBuffer && !p.audioPending.empty())
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        if (Math::Frame::invalid == p.seek)
+                        {
+                            const size_t sampleByteCount = _audioRingBuffer->getInfo().getByteCount();
+                            const size_t written = _audioRingBuffer->write(
+                                p.audioPending.data(),
+                                p.audioPending.size() / sampleByteCount);
+                            p.audioPending.erase(
+                                p.audioPending.begin(),
+                                p.audioPending.begin() + written * sampleByteCount);
+                        }
+                    }
+                    return p.audioPending.empty();
+                }
+
                 int Read::_decodeAudio(const DecodeAudio& da, Math::Frame::Number& frame)
                 {
                     DJV_PRIVATE_PTR();
@@ -717,17 +1547,77 @@ namespace djv
 
                         if (Math::Frame::invalid == da.seek || frame >= da.seek)
                         {
-                            auto audioData = Audio::Data::create(p.info.audio, p.avFrame->nb_samples);
-                            extractAudio(
-                                p.avFrame->data,
-                                p.avCodecParameters[p.avAudioStream]->format,
-                                p.avCodecParameters[p.avAudioStream]->channels,
-                                audioData);
+                            std::shared_ptr<Audio::Data> audioData;
+                            const uint8_t* samples = nullptr;
+                            size_t sampleCount = 0;
+                            if (p.swrContext)
+                            {
+                                // The resampler may hold back samples, so the
+                                // output is converted into a buffer first.
+                                const int sampleRate = p.avCodecContext[p.avAudioStream]->sample_rate;
+                                const int maxSampleCount = static_cast<int>(av_rescale_rnd(
+                                    swr_get_delay(p.swrContext, sampleRate) + p.avFrame->nb_samples,
+                                    p.audioOutputInfo.sampleRate,
+                                    sampleRate,
+                                    AV_ROUND_UP));
+                                const size_t byteCount = maxSampleCount * p.audioOutputInfo.getByteCount();
+                                if (p.audioBuffer.size() < byteCount)
+                                {
+                                    p.audioBuffer.resize(byteCount);
+                                }
+                                uint8_t* outData[1] = { p.audioBuffer.data() };
+                                const int convertCount = swr_convert(
+                                    p.swrContext,
+                                    outData,
+                                    maxSampleCount,
+                                    const_cast<const uint8_t**>(p.avFrame->extended_data),
+                                    p.avFrame->nb_samples);
+                                if (convertCount > 0)
+                                {
+                                    // The ring buffer is written from the
+                                    // conversion buffer without a copy.
+                                    samples = p.audioBuffer.data();
+                                    sampleCount = static_cast<size_t>(convertCount);
+                                    if (!_audioRingBuffer)
+                                    {
+                                        audioData = Audio::Data::create(p.audioOutputInfo, sampleCount);
+                                        memcpy(audioData->getData(), samples, audioData->getByteCount());
+                                    }
+                                }
+                            }
+                            else
+                            {
+                                audioData = Audio::Data::create(p.info.audio, p.avFrame->nb_samples);
+                                extractAudio(
+                                    p.avFrame->data,
+                                    p.avCodecParameters[p.avAudioStream]->format,
+                                    p.avCodecParameters[p.avAudioStream]->channels,
+                                    audioData);
+                                samples = audioData->getData();
+                                sampleCount = audioData->getSampleCount();
+                            }
+                            if (sampleCount > 0)
                             {
                                 std::lock_guard<std::mutex> lock(_mutex);
                                 if (Math::Frame::invalid == p.seek)
                                 {
-                                    _audioQueue.addFrame(AudioFrame(audioData));
+                                    if (_audioRingBuffer)
+                                    {
+                                        // Keep the samples that do not fit, the
+                                        // older waiting samples go first.
+                                        const size_t sampleByteCount = _audioRingBuffer->getInfo().getByteCount();
+                                        const size_t written = p.audioPending.empty() ?
+                                            _audioRingBuffer->write(samples, sampleCount) :
+                                            0;
+                                        p.audioPending.insert(
+                                            p.audioPending.end(),
+                                            samples + written * sampleByteCount,
+                                            samples + sampleCount * sampleByteCount);
+                                    }
+                                    else
+                                    {
+                                        _audioQueue.addFrame(AudioFrame(audioData));
+                                    }
                                 }
                             }
                         }
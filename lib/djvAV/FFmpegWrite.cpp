@@ -0,0 +1,685 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/FFmpegFunc.h>
+
+#include <djvImage/Convert.h>
+#include <djvImage/TypeFunc.h>
+
+#include <djvAudio/DataFunc.h>
+
+#include <djvSystem/File.h>
+#include <djvSystem/LogSystem.h>
+#include <djvSystem/TextSystem.h>
+#include <djvSystem/TimerFunc.h>
+
+#include <djvCore/StringFormat.h>
+
+extern "C"
+{
+#include <libavformat/avformat.h>
+#include <libavutil/dict.h>
+#include <libavutil/pixdesc.h>
+#include <libswresample/swresample.h>
+#include <libswscale/swscale.h>
+
+} // extern "C"
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace FFmpeg
+            {
+                struct Write::Private
+                {
+                    Options options;
+                    AVFormatContext* avFormatContext = nullptr;
+                    AVCodecContext* avVideoCodecContext = nullptr;
+                    AVStream* avVideoStream = nullptr;
+                    std::vector<AVFrame*> avVideoFrames;
+                    int64_t videoPTS = 0;
+                    SwsContext* swsContext = nullptr;
+                    std::shared_ptr<Image::Convert> convert;
+                    std::shared_ptr<Image::Data> convertData;
+                    AVCodecContext* avAudioCodecContext = nullptr;
+                    AVStream* avAudioStream = nullptr;
+                    AVFrame* avAudioFrame = nullptr;
+                    int audioFrameSize = 0;
+                    int64_t audioPTS = 0;
+                    Audio::Type audioType = Audio::Type::None;
+                    SwrContext* swrContext = nullptr;
+                    AVPacket* avPacket = nullptr;
+                    std::thread thread;
+                    std::atomic<bool> running;
+                };
+
+                void Write::_init(
+                    const System::File::Info& fileInfo,
+                    const Info& info,
+                    const WriteOptions& writeOptions,
+                    const Options& options,
+                    const std::shared_ptr<System::TextSystem>& textSystem,
+                    const std::shared_ptr<System::ResourceSystem>& resourceSystem,
+                    const std::shared_ptr<System::LogSystem>& logSystem)
+                {
+                    IWrite::_init(fileInfo, info, writeOptions, textSystem, resourceSystem, logSystem);
+
+                    DJV_PRIVATE_PTR();
+                    p.options = options;
+                    try
+                    {
+                        _open();
+                    }
+                    catch (const std::exception&)
+                    {
+                        _close();
+                        throw;
+                    }
+
+                    p.running = true;
+                    p.thread = std::thread(
+                        [this]
+                    {
+                        DJV_PRIVATE_PTR();
+                        try
+                        {
+                            const auto timeout = System::getTimerValue(System::TimerValue::VeryFast);
+                            bool videoFinished = false;
+                            bool audioFinished = !p.avAudioCodecContext;
+                            while (p.running && !(videoFinished && audioFinished))
+                            {
+                                std::vector<std::shared_ptr<Image::Data> > images;
+                                std::vector<std::shared_ptr<Audio::Data> > audio;
+                                {
+                                    std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+                                    if (lock.owns_lock())
+                                    {
+                                        while (!_videoQueue.isEmpty())
+                                        {
+                                            images.push_back(_videoQueue.popFrame().data);
+                                        }
+                                        videoFinished = _videoQueue.isFinished();
+                                        if (p.avAudioCodecContext)
+                                        {
+                                            while (!_audioQueue.isEmpty())
+                                            {
+                                                audio.push_back(_audioQueue.popFrame().data);
+                                            }
+                                            audioFinished = _audioQueue.isFinished();
+                                        }
+                                    }
+                                }
+                                for (const auto& i : audio)
+                                {
+                                    _writeAudio(i);
+                                }
+                                for (const auto& i : images)
+                                {
+                                    AVFrame* avFrame = _getVideoFrame();
+                                    _convertImage(i, avFrame);
+                                    avFrame->pts = p.videoPTS++;
+                                    _encode(p.avVideoCodecContext, p.avVideoStream, avFrame);
+                                }
+                                if (images.empty() && audio.empty() && !(videoFinished && audioFinished))
+                                {
+                                    std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+                                }
+                            }
+
+                            // Flush the encoders and finish the file, this also
+                            // happens when writing is stopped early so that the
+                            // frames that have been written can be read.
+                            if (p.avAudioCodecContext)
+                            {
+                                _writeAudio(nullptr);
+                                _encode(p.avAudioCodecContext, p.avAudioStream, nullptr);
+                            }
+                            _encode(p.avVideoCodecContext, p.avVideoStream, nullptr);
+                            const int r = av_write_trailer(p.avFormatContext);
+                            if (r < 0)
+                            {
+                                throw System::File::Error(String::Format("{0}: {1}").
+                                    arg(_fileInfo.getFileName()).
+                                    arg(getErrorString(r)));
+                            }
+                        }
+                        catch (const std::exception& e)
+                        {
+                            _logSystem->log("djv::AV::IO::FFmpeg::Write", e.what(), System::LogLevel::Error);
+                        }
+                        _close();
+                        p.running = false;
+                    });
+                }
+
+                Write::Write() :
+                    _p(new Private)
+                {}
+
+                Write::~Write()
+                {
+                    DJV_PRIVATE_PTR();
+                    p.running = false;
+                    if (p.thread.joinable())
+                    {
+                        p.thread.join();
+                    }
+                }
+
+                std::shared_ptr<Write> Write::create(
+                    const System::File::Info& fileInfo,
+                    const Info& info,
+                    const WriteOptions& writeOptions,
+                    const Options& options,
+                    const std::shared_ptr<System::TextSystem>& textSystem,
+                    const std::shared_ptr<System::ResourceSystem>& resourceSystem,
+                    const std::shared_ptr<System::LogSystem>& logSystem)
+                {
+                    auto out = std::shared_ptr<Write>(new Write);
+                    out->_init(fileInfo, info, writeOptions, options, textSystem, resourceSystem, logSystem);
+                    return out;
+                }
+
+                bool Write::isRunning() const
+                {
+                    return _p->running;
+                }
+
+                void Write::_open()
+                {
+                    DJV_PRIVATE_PTR();
+                    const std::string fileName = _fileInfo.getFileName();
+                    int r = avformat_alloc_output_context2(&p.avFormatContext, nullptr, nullptr, fileName.c_str());
+                    if (r < 0)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(getErrorString(r)));
+                    }
+
+                    _openVideo();
+                    if (_info.audio.isValid())
+                    {
+                        _openAudio();
+                    }
+
+                    if (!(p.avFormatContext->oformat->flags & AVFMT_NOFILE))
+                    {
+                        r = avio_open(&p.avFormatContext->pb, fileName.c_str(), AVIO_FLAG_WRITE);
+                        if (r < 0)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(fileName).
+                                arg(getErrorString(r)));
+                        }
+                    }
+                    r = avformat_write_header(p.avFormatContext, nullptr);
+                    if (r < 0)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(getErrorString(r)));
+                    }
+
+                    p.avPacket = av_packet_alloc();
+                }
+
+                void Write::_openVideo()
+                {
+                    DJV_PRIVATE_PTR();
+                    const std::string fileName = _fileInfo.getFileName();
+                    if (_info.video.empty())
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(_textSystem->getText(DJV_TEXT("error_no_streams"))));
+                    }
+                    const Image::Info& imageInfo = _info.video[0];
+
+                    const AVCodec* avCodec = nullptr;
+                    AVDictionary* codecOptions = nullptr;
+                    switch (p.options.codec)
+                    {
+                    case Codec::ProRes:
+                        avCodec = avcodec_find_encoder_by_name("prores_ks");
+                        av_dict_set(&codecOptions, "profile", getProfileName(p.options.proResProfile).c_str(), 0);
+                        break;
+                    case Codec::DNxHR:
+                        avCodec = avcodec_find_encoder(AV_CODEC_ID_DNXHD);
+                        av_dict_set(&codecOptions, "profile", getProfileName(p.options.dnxhrProfile).c_str(), 0);
+                        break;
+                    case Codec::H264:
+                        // FFmpeg does not have a native H.264 encoder, so this
+                        // requires FFmpeg to be built with libx264 or another
+                        // H.264 encoder.
+                        avCodec = avcodec_find_encoder_by_name("libx264");
+                        if (!avCodec)
+                        {
+                            avCodec = avcodec_find_encoder(AV_CODEC_ID_H264);
+                        }
+                        av_dict_set(&codecOptions, "crf", std::to_string(p.options.h264CRF).c_str(), 0);
+                        break;
+                    default: break;
+                    }
+                    if (!avCodec || avformat_query_codec(p.avFormatContext->oformat, avCodec->id, FF_COMPLIANCE_NORMAL) != 1)
+                    {
+                        av_dict_free(&codecOptions);
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(_textSystem->getText(DJV_TEXT("error_no_video_codecs"))));
+                    }
+
+                    p.avVideoStream = avformat_new_stream(p.avFormatContext, avCodec);
+                    p.avVideoCodecContext = avcodec_alloc_context3(avCodec);
+                    if (!p.avVideoStream || !p.avVideoCodecContext)
+                    {
+                        av_dict_free(&codecOptions);
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(_textSystem->getText(DJV_TEXT("error_file_write"))));
+                    }
+
+                    // Sub-sampled pixel formats need the size to be a multiple
+                    // of the chroma size.
+                    const uint8_t channelCount = Image::getChannelCount(imageInfo.type);
+                    const AVPixelFormat avPixelFormat = getPixelFormat(p.options, 2 == channelCount || 4 == channelCount);
+                    const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(avPixelFormat);
+                    const int wMask = desc ? (1 << desc->log2_chroma_w) - 1 : 0;
+                    const int hMask = desc ? (1 << desc->log2_chroma_h) - 1 : 0;
+                    AVCodecContext* avCodecContext = p.avVideoCodecContext;
+                    avCodecContext->width = imageInfo.size.w & ~wMask;
+                    avCodecContext->height = imageInfo.size.h & ~hMask;
+                    avCodecContext->pix_fmt = avPixelFormat;
+                    avCodecContext->time_base.num = _info.videoSpeed.getDen();
+                    avCodecContext->time_base.den = _info.videoSpeed.getNum();
+                    avCodecContext->framerate.num = _info.videoSpeed.getNum();
+                    avCodecContext->framerate.den = _info.videoSpeed.getDen();
+                    avCodecContext->sample_aspect_ratio = av_d2q(imageInfo.pixelAspectRatio, 255);
+                    avCodecContext->colorspace = AVCOL_SPC_BT709;
+                    avCodecContext->color_range = AVCOL_RANGE_MPEG;
+                    avCodecContext->thread_count = static_cast<int>(p.options.threadCount);
+                    avCodecContext->thread_type = toFFmpeg(getThreadType(p.options, avCodec->name));
+                    if (p.avFormatContext->oformat->flags & AVFMT_GLOBALHEADER)
+                    {
+                        avCodecContext->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+                    }
+                    int r = avcodec_open2(avCodecContext, avCodec, &codecOptions);
+                    av_dict_free(&codecOptions);
+                    if (r < 0)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(getErrorString(r)));
+                    }
+                    r = avcodec_parameters_from_context(p.avVideoStream->codecpar, avCodecContext);
+                    if (r < 0)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(getErrorString(r)));
+                    }
+                    p.avVideoStream->time_base = avCodecContext->time_base;
+                    p.avVideoStream->avg_frame_rate = avCodecContext->framerate;
+                }
+
+                void Write::_openAudio()
+                {
+                    DJV_PRIVATE_PTR();
+                    const std::string fileName = _fileInfo.getFileName();
+                    const Audio::Info& audioInfo = _info.audio;
+
+                    // Use uncompressed audio when the container supports it,
+                    // otherwise AAC.
+                    p.audioType = Audio::Type::S8 == audioInfo.type ? Audio::Type::S16 : audioInfo.type;
+                    AVCodecID avCodecID = AV_CODEC_ID_NONE;
+                    switch (p.audioType)
+                    {
+                    case Audio::Type::S16: avCodecID = AV_CODEC_ID_PCM_S16LE; break;
+                    case Audio::Type::S32: avCodecID = AV_CODEC_ID_PCM_S32LE; break;
+                    case Audio::Type::F32: avCodecID = AV_CODEC_ID_PCM_F32LE; break;
+                    case Audio::Type::F64: avCodecID = AV_CODEC_ID_PCM_F64LE; break;
+                    default: break;
+                    }
+                    if (avformat_query_codec(p.avFormatContext->oformat, avCodecID, FF_COMPLIANCE_NORMAL) != 1)
+                    {
+                        avCodecID = AV_CODEC_ID_AAC;
+                    }
+                    const AVCodec* avCodec = avcodec_find_encoder(avCodecID);
+                    if (!avCodec)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(_textSystem->getText(DJV_TEXT("error_no_audio_codecs"))));
+                    }
+
+                    p.avAudioStream = avformat_new_stream(p.avFormatContext, avCodec);
+                    p.avAudioCodecContext = avcodec_alloc_context3(avCodec);
+                    if (!p.avAudioStream || !p.avAudioCodecContext)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(_textSystem->getText(DJV_TEXT("error_file_write"))));
+                    }
+                    AVCodecContext* avCodecContext = p.avAudioCodecContext;
+                    avCodecContext->sample_fmt = avCodec->sample_fmts ? avCodec->sample_fmts[0] : toFFmpeg(p.audioType);
+                    avCodecContext->sample_rate = static_cast<int>(audioInfo.sampleRate);
+                    avCodecContext->channels = audioInfo.channelCount;
+                    avCodecContext->channel_layout = av_get_default_channel_layout(audioInfo.channelCount);
+                    avCodecContext->time_base.num = 1;
+                    avCodecContext->time_base.den = avCodecContext->sample_rate;
+                    if (AV_CODEC_ID_AAC == avCodecID)
+                    {
+                        avCodecContext->bit_rate = 64000 * audioInfo.channelCount;
+                    }
+                    if (p.avFormatContext->oformat->flags & AVFMT_GLOBALHEADER)
+                    {
+                        avCodecContext->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+                    }
+                    int r = avcodec_open2(avCodecContext, avCodec, nullptr);
+                    if (r < 0)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(getErrorString(r)));
+                    }
+                    r = avcodec_parameters_from_context(p.avAudioStream->codecpar, avCodecContext);
+                    if (r < 0)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(getErrorString(r)));
+                    }
+                    p.avAudioStream->time_base = avCodecContext->time_base;
+
+                    // The converter also buffers the samples so that they can
+                    // be encoded in frames of the size the encoder requires.
+                    p.swrContext = swr_alloc_set_opts(
+                        nullptr,
+                        avCodecContext->channel_layout,
+                        avCodecContext->sample_fmt,
+                        avCodecContext->sample_rate,
+                        avCodecContext->channel_layout,
+                        toFFmpeg(p.audioType),
+                        avCodecContext->sample_rate,
+                        0,
+                        nullptr);
+                    if (!p.swrContext || swr_init(p.swrContext) < 0)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(_textSystem->getText(DJV_TEXT("error_unsupported_audio_format"))));
+                    }
+
+                    p.audioFrameSize = avCodecContext->frame_size > 0 ? avCodecContext->frame_size : 1024;
+                    p.avAudioFrame = av_frame_alloc();
+                    p.avAudioFrame->nb_samples = p.audioFrameSize;
+                    p.avAudioFrame->format = avCodecContext->sample_fmt;
+                    p.avAudioFrame->channel_layout = avCodecContext->channel_layout;
+                    p.avAudioFrame->sample_rate = avCodecContext->sample_rate;
+                    r = av_frame_get_buffer(p.avAudioFrame, 0);
+                    if (r < 0)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(getErrorString(r)));
+                    }
+                }
+
+                AVFrame* Write::_getVideoFrame()
+                {
+                    // The encoder keeps a reference to the frames it is
+                    // encoding, so a frame is only reused once the encoder
+                    // has released it. The number of frames grows to the
+                    // encoder delay and then stays the same.
+                    DJV_PRIVATE_PTR();
+                    for (auto i : p.avVideoFrames)
+                    {
+                        if (av_frame_is_writable(i))
+                        {
+                            return i;
+                        }
+                    }
+                    AVFrame* out = av_frame_alloc();
+                    out->format = p.avVideoCodecContext->pix_fmt;
+                    out->width = p.avVideoCodecContext->width;
+                    out->height = p.avVideoCodecContext->height;
+                    const int r = av_frame_get_buffer(out, 0);
+                    if (r < 0)
+                    {
+                        av_frame_free(&out);
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(_fileInfo.getFileName()).
+                            arg(getErrorString(r)));
+                    }
+                    p.avVideoFrames.push_back(out);
+                    return out;
+                }
+
+                void Write::_convertImage(const std::shared_ptr<Image::Data>& image, AVFrame* avFrame)
+                {
+                    DJV_PRIVATE_PTR();
+
+                    // Image types that the scaler does not support are first
+                    // converted to 16-bit integer, using a buffer that is kept
+                    // between frames.
+                    std::shared_ptr<Image::Data> data = image;
+                    AVPixelFormat avPixelFormat = toFFmpeg(data->getType());
+                    if (AV_PIX_FMT_NONE == avPixelFormat || data->getLayout().mirror.x)
+                    {
+                        const Image::Info info(
+                            data->getSize(),
+                            Image::getIntType(Image::getChannelCount(data->getType()), 16));
+                        if (!p.convertData || p.convertData->getInfo() != info)
+                        {
+                            p.convertData = Image::Data::create(info);
+                        }
+                        if (!p.convert)
+                        {
+                            p.convert = Image::Convert::create(_threadPool);
+                        }
+                        p.convert->process(*data, info, *p.convertData);
+                        data = p.convertData;
+                        avPixelFormat = toFFmpeg(data->getType());
+                    }
+
+                    const Image::Size& size = data->getSize();
+                    int flags = SWS_BICUBIC;
+                    if (Image::getBitDepth(data->getType()) > 8)
+                    {
+                        flags |= SWS_ACCURATE_RND | SWS_FULL_CHR_H_INT;
+                    }
+                    SwsContext* swsContext = sws_getCachedContext(
+                        p.swsContext,
+                        size.w,
+                        size.h,
+                        avPixelFormat,
+                        p.avVideoCodecContext->width,
+                        p.avVideoCodecContext->height,
+                        p.avVideoCodecContext->pix_fmt,
+                        flags,
+                        0,
+                        0,
+                        0);
+                    if (!swsContext)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(_fileInfo.getFileName()).
+                            arg(_textSystem->getText(DJV_TEXT("error_unsupported_image_type"))));
+                    }
+                    if (swsContext != p.swsContext)
+                    {
+                        p.swsContext = swsContext;
+                        sws_setColorspaceDetails(
+                            p.swsContext,
+                            sws_getCoefficients(SWS_CS_DEFAULT),
+                            1,
+                            sws_getCoefficients(SWS_CS_ITU709),
+                            0,
+                            0,
+                            1 << 16,
+                            1 << 16);
+                    }
+
+                    // Vertically mirrored images are flipped with a negative
+                    // stride instead of a copy.
+                    const bool mirrorY = data->getLayout().mirror.y;
+                    const int scanlineByteCount = static_cast<int>(data->getScanlineByteCount());
+                    const uint8_t* inData[4] =
+                    {
+                        mirrorY ? data->getData(size.h - 1) : data->getData(),
+                        nullptr,
+                        nullptr,
+                        nullptr
+                    };
+                    const int inLinesize[4] = { mirrorY ? -scanlineByteCount : scanlineByteCount, 0, 0, 0 };
+                    sws_scale(
+                        p.swsContext,
+                        inData,
+                        inLinesize,
+                        0,
+                        size.h,
+                        avFrame->data,
+                        avFrame->linesize);
+                }
+
+                void Write::_writeAudio(const std::shared_ptr<Audio::Data>& data)
+                {
+                    DJV_PRIVATE_PTR();
+                    int r = 0;
+                    if (data)
+                    {
+                        auto tmp = data->getType() != p.audioType ? Audio::convert(data, p.audioType) : data;
+                        const uint8_t* inData[1] = { tmp->getData() };
+                        r = swr_convert(p.swrContext, nullptr, 0, inData, static_cast<int>(tmp->getSampleCount()));
+                        if (r < 0)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(_fileInfo.getFileName()).
+                                arg(getErrorString(r)));
+                        }
+                    }
+
+                    // Encode the buffered samples a frame at a time, a null
+                    // data pointer flushes the last partial frame.
+                    while (true)
+                    {
+                        const int sampleCount = swr_get_out_samples(p.swrContext, 0);
+                        if (sampleCount <= 0 || (data && sampleCount < p.audioFrameSize))
+                        {
+                            break;
+                        }
+                        p.avAudioFrame->nb_samples = p.audioFrameSize;
+                        r = av_frame_make_writable(p.avAudioFrame);
+                        if (r < 0)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(_fileInfo.getFileName()).
+                                arg(getErrorString(r)));
+                        }
+                        r = swr_convert(p.swrContext, p.avAudioFrame->data, p.audioFrameSize, nullptr, 0);
+                        if (r < 0)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(_fileInfo.getFileName()).
+                                arg(getErrorString(r)));
+                        }
+                        else if (0 == r)
+                        {
+                            break;
+                        }
+                        p.avAudioFrame->nb_samples = r;
+                        p.avAudioFrame->pts = p.audioPTS;
+                        p.audioPTS += r;
+                        _encode(p.avAudioCodecContext, p.avAudioStream, p.avAudioFrame);
+                    }
+                }
+
+                void Write::_encode(AVCodecContext* avCodecContext, AVStream* avStream, const AVFrame* avFrame)
+                {
+                    DJV_PRIVATE_PTR();
+                    int r = avcodec_send_frame(avCodecContext, avFrame);
+                    if (r < 0)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(_fileInfo.getFileName()).
+                            arg(getErrorString(r)));
+                    }
+                    while (true)
+                    {
+                        r = avcodec_receive_packet(avCodecContext, p.avPacket);
+                        if (AVERROR(EAGAIN) == r || AVERROR_EOF == r)
+                        {
+                            break;
+                        }
+                        else if (r < 0)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(_fileInfo.getFileName()).
+                                arg(getErrorString(r)));
+                        }
+                        av_packet_rescale_ts(p.avPacket, avCodecContext->time_base, avStream->time_base);
+                        p.avPacket->stream_index = avStream->index;
+                        r = av_interleaved_write_frame(p.avFormatContext, p.avPacket);
+                        if (r < 0)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(_fileInfo.getFileName()).
+                                arg(getErrorString(r)));
+                        }
+                    }
+                }
+
+                void Write::_close()
+                {
+                    DJV_PRIVATE_PTR();
+                    if (p.swrContext)
+                    {
+                        swr_free(&p.swrContext);
+                    }
+                    if (p.swsContext)
+                    {
+                        sws_freeContext(p.swsContext);
+                        p.swsContext = nullptr;
+                    }
+                    for (auto& i : p.avVideoFrames)
+                    {
+                        av_frame_free(&i);
+                    }
+                    p.avVideoFrames.clear();
+                    if (p.avAudioFrame)
+                    {
+                        av_frame_free(&p.avAudioFrame);
+                    }
+                    if (p.avPacket)
+                    {
+                        av_packet_free(&p.avPacket);
+                    }
+                    if (p.avVideoCodecContext)
+                    {
+                        avcodec_free_context(&p.avVideoCodecContext);
+                    }
+                    if (p.avAudioCodecContext)
+                    {
+                        avcodec_free_context(&p.avAudioCodecContext);
+                    }
+                    if (p.avFormatContext)
+                    {
+                        if (p.avFormatContext->pb && !(p.avFormatContext->oformat->flags & AVFMT_NOFILE))
+                        {
+                            avio_closep(&p.avFormatContext->pb);
+                        }
+                        avformat_free_context(p.avFormatContext);
+                        p.avFormatContext = nullptr;
+                    }
+                }
+
+            } // namespace FFmpeg
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,404 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/FrameCache.h>
+
+#include <djvCore/UIDFunc.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace
+            {
+                struct Client
+                {
+                    bool enabled = false;
+                    bool active = false;
+                    Math::Frame::Index playhead = 0;
+                    size_t byteCount = 0;
+                };
+
+                struct Entry
+                {
+                    std::shared_ptr<Image::Data> data;
+                    UID client = 0;
+                    size_t byteCount = 0;
+                    uint64_t lastUsed = 0;
+                };
+
+            } // namespace
+
+            FrameCache::Key::Key()
+            {}
+
+            FrameCache::Key::Key(
+                const std::string& fileName,
+                size_t layer,
+                Math::Frame::Index frame,
+                const std::string& options,
+                Proxy proxy,
+                const Math::BBox2i& roi) :
+                fileName(fileName),
+                layer(layer),
+                frame(frame),
+                options(options),
+                proxy(proxy),
+                roi(roi)
+            {}
+
+            bool FrameCache::Key::operator == (const Key& other) const
+            {
+                return
+                    fileName == other.fileName &&
+                    layer == other.layer &&
+                    frame == other.frame &&
+                    options == other.options &&
+                    proxy == other.proxy &&
+                    roi == other.roi;
+            }
+
+            bool FrameCache::Key::operator < (const Key& other) const
+            {
+                return
+                    std::tie(fileName, layer, frame, options, proxy, roi.min.x, roi.min.y, roi.max.x, roi.max.y) <
+                    std::tie(other.fileName, other.layer, other.frame, other.options, other.proxy, other.roi.min.x, other.roi.min.y, other.roi.max.x, other.roi.max.y);
+            }
+
+            struct FrameCache::Private
+            {
+                mutable std::mutex mutex;
+                size_t maxByteCount = 0;
+                size_t byteCount = 0;
+                std::map<UID, Client> clients;
+                std::map<Key, Entry> entries;
+                uint64_t counter = 0;
+
+                void removeEntry(std::map<Key, Entry>::iterator);
+            };
+
+            void FrameCache::Private::removeEntry(std::map<Key, Entry>::iterator i)
+            {
+                byteCount -= i->second.byteCount;
+                const auto j = clients.find(i->second.client);
+                if (j != clients.end())
+                {
+                    j->second.byteCount -= i->second.byteCount;
+                }
+                entries.erase(i);
+            }
+
+            void FrameCache::_init()
+            {}
+
+            FrameCache::FrameCache() :
+                _p(new Private)
+            {}
+
+            FrameCache::~FrameCache()
+            {}
+
+            std::shared_ptr<FrameCache> FrameCache::create()
+            {
+                auto out = std::shared_ptr<FrameCache>(new FrameCache);
+                out->_init();
+                return out;
+            }
+
+            size_t FrameCache::getMaxByteCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.maxByteCount;
+            }
+
+            size_t FrameCache::getByteCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.byteCount;
+            }
+
+            size_t FrameCache::getCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.entries.size();
+            }
+
+            void FrameCache::setMaxByteCount(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.maxByteCount = value;
+                _evict();
+            }
+
+            UID FrameCache::addClient()
+            {
+                DJV_PRIVATE_PTR();
+                const UID out = createUID();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.clients[out] = Client();
+                return out;
+            }
+
+            void FrameCache::removeClient(UID client)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                auto i = p.entries.begin();
+                while (i != p.entries.end())
+                {
+                    auto j = i;
+                    ++i;
+                    if (client == j->second.client)
+                    {
+                        p.removeEntry(j);
+                    }
+                }
+                p.clients.erase(client);
+            }
+
+            void FrameCache::setEnabled(UID client, bool value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.clients.find(client);
+                if (i != p.clients.end())
+                {
+                    i->second.enabled = value;
+                }
+            }
+
+            void FrameCache::setActive(UID client, bool value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.clients.find(client);
+                if (i != p.clients.end())
+                {
+                    i->second.active = value;
+                }
+            }
+
+            void FrameCache::setPlayhead(UID client, Math::Frame::Index value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.clients.find(client);
+                if (i != p.clients.end())
+                {
+                    i->second.playhead = value;
+                }
+            }
+
+            size_t FrameCache::getMaxByteCount(UID client) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                size_t out = 0;
+                const auto i = p.clients.find(client);
+                if (i != p.clients.end())
+                {
+                    // Active clients split the budget between them, the other
+                    // clients split what is left over.
+                    size_t activeCount = 0;
+                    size_t activeByteCount = 0;
+                    size_t inactiveCount = 0;
+                    for (const auto& j : p.clients)
+                    {
+                        if (j.second.enabled || j.first == client)
+                        {
+                            if (j.second.active)
+                            {
+                                ++activeCount;
+                                activeByteCount += j.second.byteCount;
+                            }
+                            else
+                            {
+                                ++inactiveCount;
+                            }
+                        }
+                    }
+                    if (i->second.active)
+                    {
+                        out = p.maxByteCount / activeCount;
+                    }
+                    else if (p.maxByteCount > activeByteCount)
+                    {
+                        out = (p.maxByteCount - activeByteCount) / inactiveCount;
+                    }
+                }
+                return out;
+            }
+
+            size_t FrameCache::getByteCount(UID client) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.clients.find(client);
+                return i != p.clients.end() ? i->second.byteCount : 0;
+            }
+
+            bool FrameCache::contains(const Key& key) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.entries.find(key) != p.entries.end();
+            }
+
+            bool FrameCache::get(UID client, const Key& key, std::shared_ptr<Image::Data>& out)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.entries.find(key);
+                const bool found = i != p.entries.end();
+                if (found)
+                {
+                    auto& entry = i->second;
+                    out = entry.data;
+                    entry.lastUsed = ++p.counter;
+                    if (entry.client != client)
+                    {
+                        auto j = p.clients.find(entry.client);
+                        if (j != p.clients.end())
+                        {
+                            j->second.byteCount -= entry.byteCount;
+                        }
+                        j = p.clients.find(client);
+                        if (j != p.clients.end())
+                        {
+                            j->second.byteCount += entry.byteCount;
+                        }
+                        entry.client = client;
+                    }
+                }
+                return found;
+            }
+
+            void FrameCache::add(UID client, const Key& key, const std::shared_ptr<Image::Data>& data)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.entries.find(key);
+                if (i != p.entries.end())
+                {
+                    p.removeEntry(i);
+                }
+                Entry entry;
+                entry.data = data;
+                entry.client = client;
+                entry.byteCount = data ? data->getDataByteCount() : 0;
+                entry.lastUsed = ++p.counter;
+                p.byteCount += entry.byteCount;
+                const auto j = p.clients.find(client);
+                if (j != p.clients.end())
+                {
+                    j->second.byteCount += entry.byteCount;
+                }
+                p.entries[key] = std::move(entry);
+                _evict();
+            }
+
+            void FrameCache::remove(UID client, const Key& key)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.entries.find(key);
+                if (i != p.entries.end() && client == i->second.client)
+                {
+                    p.removeEntry(i);
+                }
+            }
+
+            void FrameCache::clear(UID client)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                auto i = p.entries.begin();
+                while (i != p.entries.end())
+                {
+                    auto j = i;
+                    ++i;
+                    if (client == j->second.client)
+                    {
+                        p.removeEntry(j);
+                    }
+                }
+            }
+
+            void FrameCache::clear()
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.entries.clear();
+                p.byteCount = 0;
+                for (auto& i : p.clients)
+                {
+                    i.second.byteCount = 0;
+                }
+            }
+
+            void FrameCache::_evict()
+            {
+                DJV_PRIVATE_PTR();
+                if (p.byteCount <= p.maxByteCount)
+                {
+                    return;
+                }
+
+                // Order the entries by priority: frames without a client
+                // first, then the frames of inactive clients, then the frames
+                // of active clients. Within each group the frames are weighted
+                // by the distance from the playhead and the time since they
+                // were last used. The order does not change while entries are
+                // removed, so it is only computed once.
+                struct Victim
+                {
+                    int priority;
+                    uint64_t weight;
+                    std::map<Key, Entry>::iterator entry;
+                };
+                std::vector<Victim> victims;
+                victims.reserve(p.entries.size());
+                for (auto i = p.entries.begin(); i != p.entries.end(); ++i)
+                {
+                    int priority = 0;
+                    uint64_t weight = p.counter - i->second.lastUsed;
+                    const auto j = p.clients.find(i->second.client);
+                    if (j != p.clients.end())
+                    {
+                        priority = j->second.active ? 2 : 1;
+                        const Math::Frame::Index distance = i->first.frame - j->second.playhead;
+                        weight += static_cast<uint64_t>(distance < 0 ? -distance : distance);
+                    }
+                    victims.push_back({ priority, weight, i });
+                }
+                std::stable_sort(
+                    victims.begin(),
+                    victims.end(),
+                    [](const Victim& a, const Victim& b)
+                    {
+                        return a.priority < b.priority || (a.priority == b.priority && a.weight > b.weight);
+                    });
+                for (auto i = victims.begin(); i != victims.end() && p.byteCount > p.maxByteCount; ++i)
+                {
+                    p.removeEntry(i->entry);
+                }
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/IO.h>
+
+#include <djvImage/Data.h>
+
+#include <djvMath/FrameNumber.h>
+
+#include <djvCore/UID.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            //! This class provides a frame cache that is shared by all of the
+            //! readers with a single memory budget.
+            //!
+            //! Each reader using the cache registers itself as a client. When
+            //! the cache is full the frames of inactive clients are removed
+            //! first, then the frames that are furthest from their client's
+            //! playhead and least recently used.
+            class FrameCache : public std::enable_shared_from_this<FrameCache>
+            {
+                DJV_NON_COPYABLE(FrameCache);
+                void _init();
+                FrameCache();
+
+            public:
+                ~FrameCache();
+
+                static std::shared_ptr<FrameCache> create();
+
+                //! This struct provides a frame cache key.
+                struct Key
+                {
+                    Key();
+                    Key(
+                        const std::string& fileName,
+                        size_t layer,
+                        Math::Frame::Index,
+                        const std::string& options,
+                        Proxy = Proxy::None,
+                        const Math::BBox2i& roi = Math::BBox2i());
+
+                    std::string        fileName;
+                    size_t             layer    = 0;
+                    Math::Frame::Index frame    = 0;
+                    std::string        options;
+                    Proxy              proxy    = Proxy::None;
+                    Math::BBox2i       roi;
+
+                    bool operator == (const Key&) const;
+                    bool operator < (const Key&) const;
+                };
+
+                //! \name Size
+                ///@{
+
+                size_t getMaxByteCount() const;
+                size_t getByteCount() const;
+                size_t getCount() const;
+
+                void setMaxByteCount(size_t);
+
+                ///@}
+
+                //! \name Clients
+                ///@{
+
+                Core::UID addClient();
+                void removeClient(Core::UID);
+
+                //! Set whether the client is using the cache. Clients that
+                //! are not using the cache do not take a share of the budget.
+                void setEnabled(Core::UID, bool);
+
+                //! Set whether the client is active. Active clients are given
+                //! priority over the other clients.
+                void setActive(Core::UID, bool);
+
+                void setPlayhead(Core::UID, Math::Frame::Index);
+
+                //! Get the share of the budget that is available to the client.
+                size_t getMaxByteCount(Core::UID) const;
+
+                size_t getByteCount(Core::UID) const;
+
+                ///@}
+
+                //! \name Frames
+                ///@{
+
+                bool contains(const Key&) const;
+
+                //! Get a frame. The client becomes the owner of the frame.
+                bool get(Core::UID, const Key&, std::shared_ptr<Image::Data>&);
+
+                void add(Core::UID, const Key&, const std::shared_ptr<Image::Data>&);
+
+                //! Remove a frame if it is owned by the client.
+                void remove(Core::UID, const Key&);
+
+                //! Remove all of the frames owned by the client.
+                void clear(Core::UID);
+
+                void clear();
+
+                ///@}
+
+            private:
+                void _evict();
+
+                DJV_PRIVATE();
+            };
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
@@ -4,8 +4,14 @@
 
 #include <djvAV/IO.h>
 
+#include <djvAV/FrameCache.h>
 #include <djvAV/SpeedFunc.h>
 
+#include <djvMath/FrameNumberFunc.h>
+#include <djvMath/MathFunc.h>
+
+#include <algorithm>
+
 using namespace djv::Core;
 
 namespace djv
@@ -119,47 +125,79 @@ namespace djv
             Cache::Cache()
             {}
 
-            void Cache::setMax(size_t value)
+            void Cache::setFrameCache(
+                const std::shared_ptr<FrameCache>& frameCache,
+                Core::UID client,
+                const std::string& fileName,
+                size_t layer,
+                const std::string& options,
+                Proxy proxy,
+                const Math::BBox2i& roi)
             {
-                if (value == _max)
-                    return;
-                _max = value;
-                _cacheUpdate();
+                clear();
+                _frameCache         = frameCache;
+                _frameCacheClient   = client;
+                _frameCacheFileName = fileName;
+                _frameCacheLayer    = layer;
+                _frameCacheOptions  = options;
+                _frameCacheProxy    = proxy;
+                _frameCacheROI      = roi;
             }
 
-            Math::Frame::Sequence Cache::getFrames() const
+            size_t Cache::getCount() const
             {
-                Math::Frame::Sequence out;
-                std::vector<Math::Frame::Index> frames;
-                for (const auto& i : _cache)
-                {
-                    frames.push_back(i.first);
-                }
-                const size_t size = frames.size();
-                if (size)
+                size_t out = 0;
+                if (_frameCache)
                 {
-                    std::sort(frames.begin(), frames.end());
-                    Math::Frame::Number rangeStart = frames[0];
-                    Math::Frame::Number prevFrame = frames[0];
-                    size_t i = 1;
-                    for (; i < size; prevFrame = frames[i], ++i)
+                    for (const auto& i : _byteCounts)
                     {
-                        if (frames[i] != prevFrame + 1)
+                        if (contains(i.first))
                         {
-                            out.add(Math::Frame::Range(rangeStart, prevFrame));
-                            rangeStart = frames[i];
+                            ++out;
                         }
                     }
-                    if (size > 1)
-                    {
-                        out.add(Math::Frame::Range(rangeStart, prevFrame));
-                    }
-                    else
+                }
+                else
+                {
+                    out = _cache.size();
+                }
+                return out;
+            }
+
+            size_t Cache::getTotalByteCount() const
+            {
+                return _frameCache ?
+                    _frameCache->getByteCount(_frameCacheClient) :
+                    _totalByteCount;
+            }
+
+            void Cache::setMaxByteCount(size_t value)
+            {
+                if (value == _maxByteCount)
+                    return;
+                _maxByteCount = value;
+                _cacheUpdate();
+            }
+
+            void Cache::setByteCountEstimate(size_t value)
+            {
+                if (value == _byteCountEstimate)
+                    return;
+                _byteCountEstimate = value;
+                _cacheUpdate();
+            }
+
+            Math::Frame::Sequence Cache::getFrames() const
+            {
+                std::vector<Math::Frame::Index> frames;
+                for (const auto& i : _byteCounts)
+                {
+                    if (!_frameCache || contains(i.first))
                     {
-                        out.add(Math::Frame::Range(rangeStart));
+                        frames.push_back(i.first);
                     }
                 }
-                return out;
+                return Math::Frame::fromFrames(frames);
             }
 
             void Cache::setSequenceSize(size_t value)
@@ -191,102 +229,190 @@ namespace djv
                 if (value == _currentFrame)
                     return;
                 _currentFrame = value;
+                if (_frameCache)
+                {
+                    _frameCache->setPlayhead(_frameCacheClient, _currentFrame);
+                }
                 _cacheUpdate();
             }
 
+            bool Cache::contains(Math::Frame::Index value) const
+            {
+                return _frameCache ?
+                    _frameCache->contains(FrameCache::Key(_frameCacheFileName, _frameCacheLayer, value, _frameCacheOptions, _frameCacheProxy, _frameCacheROI)) :
+                    (_cache.find(value) != _cache.end());
+            }
+
+            bool Cache::get(Math::Frame::Index index, std::shared_ptr<Image::Data>& out) const
+            {
+                bool found = false;
+                if (_frameCache)
+                {
+                    found = _frameCache->get(
+                        _frameCacheClient,
+                        FrameCache::Key(_frameCacheFileName, _frameCacheLayer, index, _frameCacheOptions, _frameCacheProxy, _frameCacheROI),
+                        out);
+                }
+                else
+                {
+                    const auto i = _cache.find(index);
+                    found = i != _cache.end();
+                    if (found)
+                    {
+                        out = i->second;
+                    }
+                }
+                return found;
+            }
+
             void Cache::add(Math::Frame::Index index, const std::shared_ptr<Image::Data>& image)
             {
-                _cache[index] = image;
+                _remove(index);
+                const size_t byteCount = image ? image->getDataByteCount() : 0;
+                if (_frameCache)
+                {
+                    _frameCache->add(
+                        _frameCacheClient,
+                        FrameCache::Key(_frameCacheFileName, _frameCacheLayer, index, _frameCacheOptions, _frameCacheProxy, _frameCacheROI),
+                        image);
+                }
+                else
+                {
+                    _cache[index] = image;
+                }
+                _byteCounts[index] = byteCount;
+                _totalByteCount += byteCount;
                 _cacheUpdate();
             }
 
-            void Cache::_cacheUpdate()
+            void Cache::clear()
             {
-                const auto range = _inOutPoints.getRange(_sequenceSize);
-                Math::Frame::Index frame = _currentFrame;
-                _sequence = Math::Frame::Sequence();
-                switch (_direction)
+                if (_frameCache && !_byteCounts.empty())
                 {
-                case Direction::Forward:
+                    _frameCache->clear(_frameCacheClient);
+                }
+                _cache.clear();
+                _byteCounts.clear();
+                _totalByteCount = 0;
+            }
+
+            void Cache::_remove(Math::Frame::Index index)
+            {
+                const auto i = _byteCounts.find(index);
+                if (i != _byteCounts.end())
                 {
-                    for (size_t i = 0; i < _readBehind; ++i)
+                    if (_frameCache)
                     {
-                        --frame;
-                        if (frame < range.getMin())
-                        {
-                            frame = range.getMax();
-                        }
+                        _frameCache->remove(
+                            _frameCacheClient,
+                            FrameCache::Key(_frameCacheFileName, _frameCacheLayer, index, _frameCacheOptions, _frameCacheProxy, _frameCacheROI));
                     }
-                    _sequence.add(Math::Frame::Range(frame));
-                    const Math::Frame::Index first = frame;
-                    for (size_t i = 0; i < _max; ++i)
+                    else
                     {
-                        ++frame;
-                        if (first == frame)
-                        {
-                            break;
-                        }
-                        if (frame > range.getMax())
-                        {
-                            frame = range.getMin();
-                            if (frame != _sequence.getRanges().back().getMax())
-                            {
-                                _sequence.add(Math::Frame::Range(frame));
-                            }
-                        }
-                        else
-                        {
-                            _sequence.add(Math::Frame::Range(frame));
-                        }
+                        _cache.erase(index);
                     }
-                    break;
+                    _totalByteCount -= i->second;
+                    _byteCounts.erase(i);
                 }
-                case Direction::Reverse:
+            }
+
+            void Cache::_cacheUpdate()
+            {
+                // Find the frames that fit in the cache, starting with the
+                // current frame and the frames ahead of it and then the frames
+                // behind it. Frames that have been read use their actual size,
+                // the other frames use an estimate. Part of the cache is
+                // reserved for the frames behind so that they are not pushed
+                // out by the frames ahead.
+                _window.clear();
+                const auto range = _inOutPoints.getRange(_sequenceSize);
+                const Math::Frame::Index rangeMin = range.getMin();
+                const Math::Frame::Index rangeMax = range.getMax();
+                if (_maxByteCount > 0 && _sequenceSize > 0 && rangeMax >= rangeMin)
                 {
-                    for (size_t i = 0; i < _readBehind; ++i)
+                    const size_t frameCount = static_cast<size_t>(rangeMax - rangeMin + 1);
+                    const size_t estimate = _byteCounts.size() > 0 ?
+                        (_totalByteCount / _byteCounts.size()) :
+                        _byteCountEstimate;
+                    const size_t readBehind = std::min(_readBehind, frameCount - 1);
+                    const size_t readBehindByteCount = std::min(readBehind * estimate, _maxByteCount / 2);
+                    size_t byteCount = 0;
+                    auto addFrame = [this, estimate, &byteCount](Math::Frame::Index frame, size_t maxByteCount)
                     {
-                        ++frame;
-                        if (frame > range.getMax())
+                        const auto i = _byteCounts.find(frame);
+                        const size_t frameByteCount = i != _byteCounts.end() ? i->second : estimate;
+                        const bool out = byteCount + frameByteCount <= maxByteCount;
+                        if (out)
                         {
-                            frame = range.getMin();
+                            byteCount += frameByteCount;
+                            _window.push_back(frame);
                         }
-                    }
-                    _sequence.add(Math::Frame::Range(frame));
-                    const Math::Frame::Index first = frame;
-                    for (size_t i = 0; i < _max; ++i)
+                        return out;
+                    };
+                    auto nextFrame = [rangeMin, rangeMax](Math::Frame::Index frame, Math::Frame::Index step)
                     {
-                        --frame;
-                        if (first == frame)
+                        frame += step;
+                        if (frame > rangeMax)
                         {
-                            break;
+                            frame = rangeMin;
                         }
-                        if (frame < range.getMin())
+                        else if (frame < rangeMin)
                         {
-                            frame = range.getMax();
-                            if (frame != _sequence.getRanges().back().getMin())
-                            {
-                                _sequence.add(Math::Frame::Range(frame));
-                            }
+                            frame = rangeMax;
                         }
-                        else
+                        return frame;
+                    };
+                    const Math::Frame::Index step = Direction::Forward == _direction ? 1 : -1;
+                    const Math::Frame::Index currentFrame = Math::clamp(_currentFrame, rangeMin, rangeMax);
+
+                    // The current frame may use the whole cache, the frames
+                    // ahead of it leave room for the frames behind.
+                    Math::Frame::Index frame = currentFrame;
+                    size_t count = 0;
+                    for (; count < frameCount &&
+                        addFrame(frame, 0 == count ? _maxByteCount : (_maxByteCount - readBehindByteCount)); ++count)
+                    {
+                        frame = nextFrame(frame, step);
+                    }
+                    const size_t aheadCount = count;
+                    frame = currentFrame;
+                    for (size_t i = 0; i < readBehind && count < frameCount; ++i, ++count)
+                    {
+                        frame = nextFrame(frame, -step);
+                        if (!addFrame(frame, _maxByteCount))
                         {
-                            _sequence.add(Math::Frame::Range(frame));
+                            break;
                         }
                     }
-                    break;
-                }
-                default: break;
+
+                    // Use what is left of the reserve for more frames ahead.
+                    frame = currentFrame;
+                    for (size_t i = 0; i < aheadCount; ++i)
+                    {
+                        frame = nextFrame(frame, step);
+                    }
+                    for (; count < frameCount && addFrame(frame, _maxByteCount); ++count)
+                    {
+                        frame = nextFrame(frame, step);
+                    }
                 }
-                auto i = _cache.begin();
-                while (i != _cache.end())
+
+                // Remove the frames that no longer fit.
+                std::vector<Math::Frame::Index> frames = _window;
+                std::sort(frames.begin(), frames.end());
+                _sequence = Math::Frame::fromFrames(frames);
+                std::vector<Math::Frame::Index> remove;
+                for (const auto& i : _byteCounts)
                 {
-                    auto j = i;
-                    ++i;
-                    if (!_sequence.contains(j->first))
+                    if (!std::binary_search(frames.begin(), frames.end(), i.first))
                     {
-                        _cache.erase(j);
+                        remove.push_back(i.first);
                     }
                 }
+                for (const auto& i : remove)
+                {
+                    _remove(i);
+                }
             }
 
         } // namespace IO
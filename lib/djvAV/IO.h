@@ -8,10 +8,14 @@
 
 #include <djvAudio/Data.h>
 
+#include <djvMath/BBox.h>
 #include <djvMath/FrameNumber.h>
 #include <djvMath/Rational.h>
 
+#include <djvCore/UID.h>
+
 #include <future>
+#include <map>
 #include <queue>
 #include <set>
 
@@ -22,6 +26,8 @@ namespace djv
         //! This namespace provides I/O functionality.
         namespace IO
         {
+            class FrameCache;
+
             //! This class provides I/O information.
             class Info
             {
@@ -192,20 +198,60 @@ namespace djv
                 Reverse
             };
 
+            //! This enumeration provides the proxy levels for reading images
+            //! at a reduced resolution.
+            enum class Proxy
+            {
+                None,
+                _1_2,
+                _1_4,
+                _1_8,
+
+                Count,
+                First = None
+            };
+
             //! This class provides a frame cache.
+            //!
+            //! The cache holds the frames around the current frame up to a
+            //! maximum number of bytes. The size of each frame is tracked so
+            //! frames with different sizes are accounted for correctly, frames
+            //! that have not been read yet use an estimated size.
+            //!
+            //! If a shared frame cache is set the frames are stored there
+            //! instead of in this object.
             class Cache
             {
             public:
                 Cache();
                 
+                //! \name Frame Cache
+                ///@{
+
+                void setFrameCache(
+                    const std::shared_ptr<FrameCache>&,
+                    Core::UID client,
+                    const std::string& fileName,
+                    size_t layer,
+                    const std::string& options,
+                    Proxy = Proxy::None,
+                    const Math::BBox2i& roi = Math::BBox2i());
+
+                ///@}
+
                 //! \name Size
                 ///@{
 
-                size_t getMax() const;
+                size_t getMaxByteCount() const;
                 size_t getCount() const;
                 size_t getTotalByteCount() const;
 
-                void setMax(size_t);
+                void setMaxByteCount(size_t);
+
+                //! Set the estimated size of the frames that have not been
+                //! read yet. The average size of the cached frames is used
+                //! once there are frames in the cache.
+                void setByteCountEstimate(size_t);
 
                 ///@}
 
@@ -216,6 +262,10 @@ namespace djv
                 size_t getReadBehind() const;
                 const Math::Frame::Sequence& getSequence() const;
 
+                //! Get the frames that should be cached, in the order they
+                //! should be read.
+                const std::vector<Math::Frame::Index>& getWindow() const;
+
                 void setSequenceSize(size_t);
                 void setInOutPoints(const InOutPoints&);
                 void setDirection(Direction);
@@ -230,9 +280,18 @@ namespace djv
                 ///@}
 
             private:
+                void _remove(Math::Frame::Index);
                 void _cacheUpdate();
 
-                size_t _max = 0;
+                std::shared_ptr<FrameCache> _frameCache;
+                Core::UID _frameCacheClient = 0;
+                std::string _frameCacheFileName;
+                size_t _frameCacheLayer = 0;
+                std::string _frameCacheOptions;
+                Proxy _frameCacheProxy = Proxy::None;
+                Math::BBox2i _frameCacheROI;
+                size_t _maxByteCount = 0;
+                size_t _byteCountEstimate = 0;
                 size_t _sequenceSize = 0;
                 InOutPoints _inOutPoints;
                 Direction _direction = Direction::Forward;
@@ -240,7 +299,10 @@ namespace djv
                 //! \todo Should this be configurable?
                 size_t _readBehind = 10;
                 Math::Frame::Sequence _sequence;
+                std::vector<Math::Frame::Index> _window;
                 std::map<Math::Frame::Index, std::shared_ptr<Image::Data> > _cache;
+                std::map<Math::Frame::Index, size_t> _byteCounts;
+                size_t _totalByteCount = 0;
             };
 
         } // namespace IO
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/IOFunc.h>
+
+#include <djvSystem/FileIO.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            uint16_t getProxyScale(Proxy value)
+            {
+                const std::array<uint16_t, static_cast<size_t>(Proxy::Count)> data =
+                {
+                    1,
+                    2,
+                    4,
+                    8
+                };
+                return data[static_cast<size_t>(value)];
+            }
+
+            Image::Size getProxySize(const Image::Size& value, Proxy proxy)
+            {
+                const uint16_t scale = getProxyScale(proxy);
+                return Image::Size(
+                    (value.w + scale - 1) / scale,
+                    (value.h + scale - 1) / scale);
+            }
+
+            Proxy getProxy(const Image::Size& value, const Image::Size& size)
+            {
+                Proxy out = Proxy::None;
+                for (const auto i : getProxyEnums())
+                {
+                    const Image::Size proxySize = getProxySize(value, i);
+                    if (proxySize.w >= size.w && proxySize.h >= size.h)
+                    {
+                        out = i;
+                    }
+                }
+                return out;
+            }
+
+            std::shared_ptr<Image::Data> readProxy(
+                const std::shared_ptr<System::File::IO>& io,
+                const Image::Info& info,
+                Proxy proxy)
+            {
+                const size_t scale = getProxyScale(proxy);
+                Image::Info proxyInfo = info;
+                proxyInfo.size = getProxySize(info.size, proxy);
+                auto out = Image::Data::create(proxyInfo);
+                const size_t pixelByteCount = info.getPixelByteCount();
+                const size_t scanlineByteCount = info.getScanlineByteCount();
+                const size_t pos = io->getPos();
+                std::vector<uint8_t> buf(scanlineByteCount);
+                for (uint16_t y = 0; y < proxyInfo.size.h; ++y)
+                {
+                    io->readAt(pos + y * scale * scanlineByteCount, buf.data(), scanlineByteCount);
+                    const uint8_t* inP = buf.data();
+                    uint8_t* outP = out->getData(y);
+                    for (uint16_t x = 0; x < proxyInfo.size.w; ++x, inP += scale * pixelByteCount, outP += pixelByteCount)
+                    {
+                        memcpy(outP, inP, pixelByteCount);
+                    }
+                }
+                return out;
+            }
+
+            Math::BBox2i getROI(const ReadOptions& options, const Image::Size& size)
+            {
+                Math::BBox2i out;
+                if (Proxy::None == options.proxy && options.roi.isValid() && size.isValid())
+                {
+                    const Math::BBox2i bounds(0, 0, size.w, size.h);
+                    out = options.roi.intersect(bounds);
+                    if (out == bounds)
+                    {
+                        out = Math::BBox2i();
+                    }
+                }
+                return out;
+            }
+
+            Math::BBox2i mirrorROI(const Image::Info& info, const Math::BBox2i& roi)
+            {
+                Math::BBox2i out = roi;
+                if (info.layout.mirror.x)
+                {
+                    out.min.x = info.size.w - 1 - roi.max.x;
+                    out.max.x = info.size.w - 1 - roi.min.x;
+                }
+                if (info.layout.mirror.y)
+                {
+                    out.min.y = info.size.h - 1 - roi.max.y;
+                    out.max.y = info.size.h - 1 - roi.min.y;
+                }
+                return out;
+            }
+
+            std::shared_ptr<Image::Data> readROI(
+                const std::shared_ptr<System::File::IO>& io,
+                const Image::Info& info,
+                const Math::BBox2i& roi)
+            {
+                Image::Info roiInfo = info;
+                roiInfo.size = Image::Size(roi.w(), roi.h());
+                auto out = Image::Data::create(roiInfo);
+                out->setOrigin(roi.min);
+                const Math::BBox2i bounds = mirrorROI(info, roi);
+                const size_t pixelByteCount = info.getPixelByteCount();
+                const size_t scanlineByteCount = info.getScanlineByteCount();
+                const size_t roiByteCount = roiInfo.size.w * pixelByteCount;
+                const size_t pos = io->getPos() + bounds.min.x * pixelByteCount;
+                for (uint16_t y = 0; y < roiInfo.size.h; ++y)
+                {
+                    io->readAt(pos + (bounds.min.y + y) * scanlineByteCount, out->getData(y), roiByteCount);
+                }
+                return out;
+            }
+
+            Audio::Info getAudioOutputInfo(const Audio::Info& value, const Audio::Info& output)
+            {
+                Audio::Info out = value;
+                if (!value.isValid())
+                {
+                    return out;
+                }
+                if (output.channelCount > 0)
+                {
+                    out.channelCount = std::min(value.channelCount, output.channelCount);
+                }
+                if (output.type != Audio::Type::None)
+                {
+                    out.type = output.type;
+                }
+                if (output.sampleRate > 0)
+                {
+                    out.sampleRate = output.sampleRate;
+                }
+                return out;
+            }
+
+            DJV_ENUM_HELPERS_IMPLEMENTATION(Proxy);
+
+        } // namespace IO
+    } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::IO,
+        Proxy,
+        "None",
+        "1/2",
+        "1/4",
+        "1/8");
+
+} // namespace djv
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/IOPlugin.h>
+
+#include <djvCore/Enum.h>
+#include <djvCore/RapidJSONFunc.h>
+
+#include <sstream>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            //! \name Proxies
+            ///@{
+
+            //! Get the scale factor of a proxy level.
+            uint16_t getProxyScale(Proxy);
+
+            //! Get the size of an image at a proxy level. The size is rounded
+            //! up so that no pixels are lost.
+            Image::Size getProxySize(const Image::Size&, Proxy);
+
+            //! Get the lowest resolution proxy level that is still at least
+            //! the given size.
+            Proxy getProxy(const Image::Size&, const Image::Size&);
+
+            //! Read uncompressed image data at a proxy level from the current
+            //! file position. Only the scanlines that are needed are read, and
+            //! the pixels are decimated. The data is not converted.
+            //! Throws:
+            //! - System::File::Error
+            std::shared_ptr<Image::Data> readProxy(
+                const std::shared_ptr<System::File::IO>&,
+                const Image::Info&,
+                Proxy);
+
+            ///@}
+
+            //! \name Regions of Interest
+            ///@{
+
+            //! Get the region of interest of the read options clamped to the
+            //! image size. The region is not valid if the full image should
+            //! be read.
+            Math::BBox2i getROI(const ReadOptions&, const Image::Size&);
+
+            //! Convert a region of interest to the coordinates of the image
+            //! data, for images that are stored mirrored.
+            Math::BBox2i mirrorROI(const Image::Info&, const Math::BBox2i&);
+
+            //! Read a region of uncompressed image data from the current file
+            //! position. Only the scanlines in the region are read. The data
+            //! is not converted.
+            //! Throws:
+            //! - System::File::Error
+            std::shared_ptr<Image::Data> readROI(
+                const std::shared_ptr<System::File::IO>&,
+                const Image::Info&,
+                const Math::BBox2i&);
+
+            ///@}
+
+            //! \name Audio
+            ///@{
+
+            //! Get the format of audio data that is converted to an output
+            //! format. The sample rate and type of the output are used when
+            //! they are set. Channels are only mixed down, so audio with
+            //! fewer channels than the output keeps its channel count.
+            Audio::Info getAudioOutputInfo(const Audio::Info&, const Audio::Info& output);
+
+            ///@}
+
+            DJV_ENUM_HELPERS(Proxy);
+
+        } // namespace IO
+    } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS(AV::IO::Proxy);
+
+} // namespace djv
@@ -120,29 +120,11 @@ namespace djv
                     _out == other._out;
             }
             
-            inline size_t Cache::getMax() const
+            inline size_t Cache::getMaxByteCount() const
             {
-                return _max;
+                return _maxByteCount;
             }
             
-            inline size_t Cache::getCount() const
-            {
-                return _cache.size();
-            }
-
-            inline size_t Cache::getTotalByteCount() const
-            {
-                size_t out = 0;
-                for (const auto& i : _cache)
-                {
-                    if (i.second)
-                    {
-                        out += i.second->getDataByteCount();
-                    }
-                }
-                return out;
-            }
-
             inline size_t Cache::getReadBehind() const
             {
                 return _readBehind;
@@ -153,25 +135,9 @@ namespace djv
                 return _sequence;
             }
 
-            inline bool Cache::contains(Math::Frame::Index value) const
-            {
-                return _cache.find(value) != _cache.end();
-            }
-
-            inline bool Cache::get(Math::Frame::Index index, std::shared_ptr<Image::Data>& out) const
-            {
-                const auto i = _cache.find(index);
-                const bool found = i != _cache.end();
-                if (found)
-                {
-                    out = i->second;
-                }
-                return found;
-            }
-
-            inline void Cache::clear()
+            inline const std::vector<Math::Frame::Index>& Cache::getWindow() const
             {
-                _cache.clear();
+                return _window;
             }
 
         } // namespace IO
@@ -4,6 +4,8 @@
 
 #include <djvAV/IOPlugin.h>
 
+#include <djvAV/FrameCache.h>
+
 #include <djvSystem/Context.h>
 #include <djvSystem/LogSystem.h>
 #include <djvSystem/ResourceSystem.h>
@@ -30,6 +32,7 @@ namespace djv
                 _logSystem      = logSystem;
                 _textSystem     = textSystem;
                 _resourceSystem = resourceSystem;
+                _threadPool     = options.threadPool;
                 _fileInfo       = fileInfo;
                 _videoQueue.setMax(options.videoQueueSize);
                 _audioQueue.setMax(options.audioQueueSize);
@@ -53,10 +56,27 @@ namespace djv
             {
                 IIO::_init(fileInfo, options, textSystem, resourceSystem, logSystem);
                 _options = options;
+                if (_options.frameCache)
+                {
+                    _frameCacheClient = _options.frameCache->addClient();
+                    _cache.setFrameCache(
+                        _options.frameCache,
+                        _frameCacheClient,
+                        fileInfo.getFileName(),
+                        _options.layer,
+                        _options.colorSpace,
+                        _options.proxy,
+                        _options.roi);
+                }
             }
 
             IRead::~IRead()
-            {}
+            {
+                if (_options.frameCache)
+                {
+                    _options.frameCache->removeClient(_frameCacheClient);
+                }
+            }
 
             void IRead::setPlayback(bool value)
             {
@@ -98,6 +118,10 @@ namespace djv
             {
                 std::lock_guard<std::mutex> lock(_mutex);
                 _cacheEnabled = value;
+                if (_options.frameCache)
+                {
+                    _options.frameCache->setEnabled(_frameCacheClient, value);
+                }
             }
 
             void IRead::setCacheMaxByteCount(size_t value)
@@ -106,6 +130,21 @@ namespace djv
                 _cacheMaxByteCount = value;
             }
 
+            void IRead::setCacheActive(bool value)
+            {
+                if (_options.frameCache)
+                {
+                    _options.frameCache->setActive(_frameCacheClient, value);
+                }
+            }
+
+            size_t IRead::_getCacheMaxByteCount(size_t value) const
+            {
+                return _options.frameCache ?
+                    std::min(value, _options.frameCache->getMaxByteCount(_frameCacheClient)) :
+                    value;
+            }
+
             void IWrite::_init(
                 const System::File::Info& fileInfo,
                 const Info& info,
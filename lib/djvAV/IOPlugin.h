@@ -8,6 +8,8 @@
 
 #include <djvSystem/FileInfo.h>
 
+#include <djvMath/BBox.h>
+
 namespace djv
 {
     namespace System
@@ -16,9 +18,22 @@ namespace djv
         class LogSystem;
         class ResourceSystem;
         class TextSystem;
+        class ThreadPool;
+
+        namespace File
+        {
+            class AsyncIO;
+            class IO;
 
+        } // namespace File
     } // namespace System
 
+    namespace Audio
+    {
+        class RingBuffer;
+
+    } // namespace Audio
+
     namespace AV
     {
         namespace IO
@@ -29,6 +44,10 @@ namespace djv
                 size_t videoQueueSize = 1;
                 //! \todo What is a good default for this value?
                 size_t audioQueueSize = 30;
+
+                //! The thread pool used for reading and writing frames. If this
+                //! is not set a new thread is started for each frame.
+                std::shared_ptr<System::ThreadPool> threadPool;
             };
 
             //! This class provides the base interface for I/O.
@@ -74,6 +93,7 @@ namespace djv
                 std::shared_ptr<System::LogSystem> _logSystem;
                 std::shared_ptr<System::ResourceSystem> _resourceSystem;
                 std::shared_ptr<System::TextSystem> _textSystem;
+                std::shared_ptr<System::ThreadPool> _threadPool;
                 System::File::Info _fileInfo;
                 std::mutex _mutex;
                 VideoQueue _videoQueue;
@@ -88,6 +108,57 @@ namespace djv
                 
                 size_t layer = 0;
                 std::string colorSpace;
+
+                //! The proxy level. The images are read at a reduced resolution,
+                //! natively by the formats that support it, otherwise they are
+                //! reduced with a box filter. The information returned by
+                //! IRead::getInfo() is always for the full resolution.
+                Proxy proxy = Proxy::None;
+
+                //! The region of interest in the pixel coordinates of the
+                //! displayed image. Formats that support it only read the
+                //! region, and the origin of the image data is set to the
+                //! position of the region. The region is not used with
+                //! proxies.
+                //!
+                //! The viewer does not set a region, since the reader would
+                //! be reopened whenever the view is panned; it only sets the
+                //! proxy level from the zoom.
+                Math::BBox2i roi;
+
+                //! The frame cache shared between readers. If this is not set
+                //! each reader caches frames on its own.
+                std::shared_ptr<FrameCache> frameCache;
+
+                //! The asynchronous I/O used by formats that can read their
+                //! image data directly. If this is not set the images are read
+                //! with blocking I/O on the thread pool.
+                std::shared_ptr<System::File::AsyncIO> asyncIO;
+
+                //! The number of frames that can be read ahead with the
+                //! asynchronous I/O.
+                size_t asyncReadAhead = 16;
+
+                //! The number of frame files ahead of the playhead that the
+                //! operating system is asked to read into the page cache. The
+                //! files behind the cache read behind are released. A value of
+                //! zero disables the hints.
+                size_t fileReadAhead = 0;
+
+                //! Whether the video is read. Formats that can skip it only
+                //! decode the audio, for example to build a waveform.
+                bool video = true;
+
+                //! The format the audio is converted to while it is read, for
+                //! example the native format of the output device. Values that
+                //! are not set use the format of the file, see
+                //! getAudioOutputInfo().
+                Audio::Info audioOutput;
+
+                //! Whether the audio is written to a lock-free ring buffer
+                //! instead of the audio queue, for the formats that support
+                //! it. See IRead::getAudioRingBuffer().
+                bool audioRingBuffer = false;
             };
 
             //! This class provides the interface for reading.
@@ -111,6 +182,16 @@ namespace djv
 
                 ///@}
 
+                //! \name Audio
+                ///@{
+
+                //! Get the audio ring buffer. This is only set when it is
+                //! requested with the read options and supported by the
+                //! format, and it is available once the information is.
+                const std::shared_ptr<Audio::RingBuffer>& getAudioRingBuffer() const;
+
+                ///@}
+
                 //! \name Playback
                 ///@{
 
@@ -137,9 +218,17 @@ namespace djv
                 void setCacheEnabled(bool);
                 void setCacheMaxByteCount(size_t);
 
+                //! Set whether this reader is given priority in the shared
+                //! frame cache.
+                void setCacheActive(bool);
+
                 ///@}
 
             protected:
+                //! Get the cache size limited by the share of the frame cache
+                //! that is available to this reader.
+                size_t _getCacheMaxByteCount(size_t) const;
+
                 ReadOptions _options;
                 InOutPoints _inOutPoints;
                 Direction _direction = Direction::Forward;
@@ -150,13 +239,20 @@ namespace djv
                 size_t _cacheByteCount = 0;
                 Math::Frame::Sequence _cacheSequence;
                 Math::Frame::Sequence _cachedFrames;
+                Core::UID _frameCacheClient = 0;
                 Cache _cache;
+                std::shared_ptr<Audio::RingBuffer> _audioRingBuffer;
             };
 
             //! This class provides options for writing.
             struct WriteOptions : IOOptions
             {
                 std::string colorSpace;
+
+                //! Use OpenGL to convert the images. This is disabled by the
+                //! I/O system when there is no GLFW system, in which case the
+                //! images are converted on the CPU.
+                bool gl = true;
             };
 
             //! This class provides the interface for writing.
@@ -28,6 +28,11 @@ namespace djv
                 return  _audioQueue;
             }
 
+            inline const std::shared_ptr<Audio::RingBuffer>& IRead::getAudioRingBuffer() const
+            {
+                return _audioRingBuffer;
+            }
+
             inline bool IRead::hasCache() const
             {
                 return false;
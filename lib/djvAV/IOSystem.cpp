@@ -6,6 +6,7 @@
 
 #include <djvAV/Cineon.h>
 #include <djvAV/DPX.h>
+#include <djvAV/FrameCache.h>
 #include <djvAV/IFF.h>
 #include <djvAV/PFM.h>
 #include <djvAV/PPM.h>
@@ -33,11 +34,15 @@
 
 #include <djvSystem/Context.h>
 #include <djvSystem/File.h>
+#include <djvSystem/FileAsyncIO.h>
 #include <djvSystem/TextSystem.h>
+#include <djvSystem/ThreadPool.h>
 
 #include <djvCore/StringFormat.h>
 #include <djvCore/StringFunc.h>
 
+#include <atomic>
+
 using namespace djv::Core;
 
 namespace djv
@@ -50,6 +55,10 @@ namespace djv
             {
                 std::shared_ptr<System::TextSystem> textSystem;
                 std::shared_ptr<Observer::ValueSubject<bool> > optionsChanged;
+                std::shared_ptr<System::ThreadPool> threadPool;
+                std::shared_ptr<System::File::AsyncIO> asyncIO;
+                std::shared_ptr<FrameCache> frameCache;
+                std::atomic<size_t> fileReadAhead;
                 std::map<std::string, std::shared_ptr<IPlugin> > plugins;
                 std::set<std::string> sequenceExtensions;
                 std::set<std::string> nonSequenceExtensions;
@@ -61,12 +70,40 @@ namespace djv
 
                 DJV_PRIVATE_PTR();
 
-                addDependency(GL::GLFW::GLFWSystem::create(context));
+                // OpenGL is optional, without it the images are converted on
+                // the CPU.
+                if (auto glfwSystem = context->getSystemT<GL::GLFW::GLFWSystem>())
+                {
+                    addDependency(glfwSystem);
+                }
 
                 p.textSystem = context->getSystemT<System::TextSystem>();
 
                 p.optionsChanged = Observer::ValueSubject<bool>::create();
 
+                p.threadPool = System::ThreadPool::create();
+                {
+                    std::stringstream ss;
+                    ss << "Thread pool size: " << p.threadPool->getThreadCount();
+                    _log(ss.str());
+                }
+
+                p.asyncIO = System::File::AsyncIO::create(p.threadPool);
+                {
+                    std::stringstream ss;
+                    ss << "Asynchronous I/O: ";
+                    switch (p.asyncIO->getBackend())
+                    {
+                    case System::File::AsyncIOBackend::IOURing: ss << "io_uring"; break;
+                    default: ss << "thread pool"; break;
+                    }
+                    ss << ", queue depth " << p.asyncIO->getQueueDepth();
+                    _log(ss.str());
+                }
+
+                p.frameCache = FrameCache::create();
+                p.fileReadAhead = 8;
+
                 p.plugins[Cineon::pluginName] = Cineon::Plugin::create(context);
                 p.plugins[DPX::pluginName] = DPX::Plugin::create(context);
                 p.plugins[IFF::pluginName] = IFF::Plugin::create(context);
@@ -182,6 +219,31 @@ namespace djv
                 return _p->optionsChanged;
             }
 
+            const std::shared_ptr<System::ThreadPool>& IOSystem::getThreadPool() const
+            {
+                return _p->threadPool;
+            }
+
+            const std::shared_ptr<System::File::AsyncIO>& IOSystem::getAsyncIO() const
+            {
+                return _p->asyncIO;
+            }
+
+            const std::shared_ptr<FrameCache>& IOSystem::getFrameCache() const
+            {
+                return _p->frameCache;
+            }
+
+            size_t IOSystem::getFileReadAhead() const
+            {
+                return _p->fileReadAhead;
+            }
+
+            void IOSystem::setFileReadAhead(size_t value)
+            {
+                _p->fileReadAhead = value;
+            }
+
             const std::set<std::string>& IOSystem::getSequenceExtensions() const
             {
                 return _p->sequenceExtensions;
@@ -218,11 +280,20 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 std::shared_ptr<IRead> out;
+                ReadOptions readOptions = options;
+                if (!readOptions.threadPool)
+                {
+                    readOptions.threadPool = p.threadPool;
+                }
+                if (!readOptions.asyncIO)
+                {
+                    readOptions.asyncIO = p.asyncIO;
+                }
                 for (const auto& i : p.plugins)
                 {
                     if (i.second->canRead(fileInfo))
                     {
-                        out = i.second->read(fileInfo, options);
+                        out = i.second->read(fileInfo, readOptions);
                         break;
                     }
                 }
@@ -252,11 +323,20 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 std::shared_ptr<IWrite> out;
+                WriteOptions writeOptions = options;
+                if (!writeOptions.threadPool)
+                {
+                    writeOptions.threadPool = p.threadPool;
+                }
+                if (auto context = getContext().lock())
+                {
+                    writeOptions.gl &= context->getSystemT<GL::GLFW::GLFWSystem>() != nullptr;
+                }
                 for (const auto& i : p.plugins)
                 {
                     if (i.second->canWrite(fileInfo, info))
                     {
-                        out = i.second->write(fileInfo, info, options);
+                        out = i.second->write(fileInfo, info, writeOptions);
                         break;
                     }
                 }
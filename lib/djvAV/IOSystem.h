@@ -49,6 +49,33 @@ namespace djv
 
                 std::shared_ptr<Core::Observer::IValueSubject<bool> > observeOptionsChanged() const;
 
+                ///@}
+
+                //! \name Threads
+                ///@{
+
+                //! Get the thread pool shared by all readers and writers.
+                const std::shared_ptr<System::ThreadPool>& getThreadPool() const;
+
+                //! Get the asynchronous I/O shared by all readers.
+                const std::shared_ptr<System::File::AsyncIO>& getAsyncIO() const;
+
+                ///@}
+
+                //! \name Cache
+                ///@{
+
+                //! Get the frame cache that can be shared by readers. Readers
+                //! only use this cache when it is set in the read options.
+                const std::shared_ptr<FrameCache>& getFrameCache() const;
+
+                //! Get the number of frame files that sequence readers ask
+                //! the operating system to read ahead. Readers only use this
+                //! value when it is set in the read options.
+                size_t getFileReadAhead() const;
+
+                void setFileReadAhead(size_t);
+
                 ///@}
                 
                 //! \name Sequences
@@ -69,7 +69,7 @@ namespace djv
 
                 private:
                     class File;
-                    Info _open(const std::string&, const std::shared_ptr<File>&);
+                    Info _open(const std::string&, const std::shared_ptr<File>&, Proxy = Proxy::None);
                 };
                 
                 //! This class provides the JPEG file writer.
@@ -4,6 +4,8 @@
 
 #include <djvAV/JPEG.h>
 
+#include <djvAV/IOFunc.h>
+
 #include <djvSystem/File.h>
 #include <djvSystem/FileFunc.h>
 #include <djvSystem/FileIO.h>
@@ -121,7 +123,7 @@ namespace djv
                 {
                     // Open the file.
                     auto f = File::create();
-                    const auto info = _open(fileName, f);
+                    const auto info = _open(fileName, f, _options.proxy);
 
                     // Read the file.
                     auto out = Image::Data::create(info.video[0]);
@@ -183,6 +185,7 @@ namespace djv
                     bool jpegOpen(
                         FILE*                   f,
                         jpeg_decompress_struct* jpeg,
+                        Proxy                   proxy,
                         JPEGErrorStruct*        error)
                     {
                         if (::setjmp(error->jump))
@@ -195,6 +198,10 @@ namespace djv
                         {
                             return false;
                         }
+
+                        // Proxies use the DCT scaling of the decompressor.
+                        jpeg->scale_num = 1;
+                        jpeg->scale_denom = getProxyScale(proxy);
                         if (!jpeg_start_decompress(jpeg))
                         {
                             return false;
@@ -204,7 +211,7 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string& fileName, const std::shared_ptr<File>& f)
+                Info Read::_open(const std::string& fileName, const std::shared_ptr<File>& f, Proxy proxy)
                 {
                     f->jpeg.err = jpeg_std_error(&f->jpegError.pub);
                     f->jpegError.pub.error_exit = djvJPEGError;
@@ -229,7 +236,7 @@ namespace djv
                             arg(fileName).
                             arg(_textSystem->getText(DJV_TEXT("error_file_open"))));
                     }
-                    if (!jpegOpen(f->f, &f->jpeg, &f->jpegError))
+                    if (!jpegOpen(f->f, &f->jpeg, proxy, &f->jpegError))
                     {
                         std::vector<std::string> messages;
                         messages.push_back(String::Format("{0}: {1}").
@@ -4,8 +4,13 @@
 
 #include <djvAV/OpenEXR.h>
 
+#include <djvAV/FrameCache.h>
 #include <djvAV/OpenEXRFunc.h>
 
+#include <djvImage/Data.h>
+
+#include <tuple>
+
 using namespace djv::Core;
 
 namespace djv
@@ -51,9 +56,130 @@ namespace djv
                         dwaCompressionLevel == other.dwaCompressionLevel;
                 }
                 
+                namespace
+                {
+                    //! The tile cache budget is this fraction of the frame cache
+                    //! budget.
+                    const size_t tileCacheShare = 4;
+
+                } // namespace
+
+                bool TileCache::Key::operator < (const Key& other) const
+                {
+                    return
+                        std::tie(fileName, time, size, layer, level, x, y) <
+                        std::tie(other.fileName, other.time, other.size, other.layer, other.level, other.x, other.y);
+                }
+
+                struct TileCache::Private
+                {
+                    size_t maxByteCount = 0;
+                    size_t byteCount = 0;
+                    typedef std::list<std::pair<Key, std::shared_ptr<Image::Data> > > List;
+                    List tiles;
+                    std::map<Key, List::iterator> map;
+                    mutable std::mutex mutex;
+                };
+
+                TileCache::TileCache() :
+                    _p(new Private)
+                {}
+
+                TileCache::~TileCache()
+                {}
+
+                std::shared_ptr<TileCache> TileCache::create()
+                {
+                    return std::shared_ptr<TileCache>(new TileCache);
+                }
+
+                size_t TileCache::getMaxByteCount() const
+                {
+                    DJV_PRIVATE_PTR();
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    return p.maxByteCount;
+                }
+
+                size_t TileCache::getByteCount() const
+                {
+                    DJV_PRIVATE_PTR();
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    return p.byteCount;
+                }
+
+                size_t TileCache::getCount() const
+                {
+                    DJV_PRIVATE_PTR();
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    return p.tiles.size();
+                }
+
+                void TileCache::setMaxByteCount(size_t value)
+                {
+                    DJV_PRIVATE_PTR();
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.maxByteCount = value;
+                    _maxUpdate();
+                }
+
+                std::shared_ptr<Image::Data> TileCache::get(const Key& key)
+                {
+                    DJV_PRIVATE_PTR();
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    std::shared_ptr<Image::Data> out;
+                    const auto i = p.map.find(key);
+                    if (i != p.map.end())
+                    {
+                        // Move the tile to the front of the list so that it is
+                        // the most recently used.
+                        p.tiles.splice(p.tiles.begin(), p.tiles, i->second);
+                        out = i->second->second;
+                    }
+                    return out;
+                }
+
+                void TileCache::add(const Key& key, const std::shared_ptr<Image::Data>& value)
+                {
+                    DJV_PRIVATE_PTR();
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    const auto i = p.map.find(key);
+                    if (i != p.map.end())
+                    {
+                        p.byteCount -= i->second->second->getDataByteCount();
+                        p.tiles.erase(i->second);
+                        p.map.erase(i);
+                    }
+                    p.tiles.push_front(std::make_pair(key, value));
+                    p.map[key] = p.tiles.begin();
+                    p.byteCount += value->getDataByteCount();
+                    _maxUpdate();
+                }
+
+                void TileCache::clear()
+                {
+                    DJV_PRIVATE_PTR();
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.tiles.clear();
+                    p.map.clear();
+                    p.byteCount = 0;
+                }
+
+                void TileCache::_maxUpdate()
+                {
+                    DJV_PRIVATE_PTR();
+                    while (p.byteCount > p.maxByteCount && !p.tiles.empty())
+                    {
+                        const auto& back = p.tiles.back();
+                        p.byteCount -= back.second->getDataByteCount();
+                        p.map.erase(back.first);
+                        p.tiles.pop_back();
+                    }
+                }
+
                 struct Plugin::Private
                 {
                     Options options;
+                    std::shared_ptr<TileCache> tileCache;
                 };
 
                 Plugin::Plugin() :
@@ -63,6 +189,7 @@ namespace djv
                 std::shared_ptr<Plugin> Plugin::create(const std::shared_ptr<System::Context>& context)
                 {
                     auto out = std::shared_ptr<Plugin>(new Plugin);
+                    out->_p->tileCache = TileCache::create();
                     Imf::setGlobalThreadCount(out->_p->options.threadCount);
                     out->_init(
                         pluginName,
@@ -80,13 +207,26 @@ namespace djv
                 void Plugin::setOptions(const rapidjson::Value& value)
                 {
                     DJV_PRIVATE_PTR();
+                    const Options options = p.options;
                     fromJSON(value, p.options);
                     Imf::setGlobalThreadCount(p.options.threadCount);
+                    if (p.options.channels != options.channels)
+                    {
+                        // The layer indices in the tile cache depend on how
+                        // the channels are grouped.
+                        p.tileCache->clear();
+                    }
                 }
 
                 std::shared_ptr<IRead> Plugin::read(const System::File::Info& fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _p->options, _textSystem, _resourceSystem, _logSystem);
+                    // The tile cache takes a share of the frame cache budget,
+                    // so it follows the cache settings.
+                    if (options.frameCache)
+                    {
+                        _p->tileCache->setMaxByteCount(options.frameCache->getMaxByteCount() / tileCacheShare);
+                    }
+                    return Read::create(fileInfo, options, _p->options, _p->tileCache, _textSystem, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const System::File::Info& fileInfo, const Info& info, const WriteOptions& options) const
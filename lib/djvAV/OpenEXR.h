@@ -14,6 +14,10 @@
 #include <ImfInputFile.h>
 #include <ImfPixelType.h>
 
+#include <list>
+#include <map>
+#include <mutex>
+
 namespace djv
 {
     namespace AV
@@ -98,6 +102,71 @@ namespace djv
                     bool operator == (const Options&) const;
                 };
 
+                //! This class provides a cache of decoded tiles that is shared
+                //! by the readers. Tiles are only decoded once when the region
+                //! of interest is panned. The tiles of whole images are not
+                //! cached since the frame cache already holds the images.
+                //!
+                //! The plugin sets the budget to a share of the frame cache
+                //! budget, the cache is empty until a reader with a frame cache
+                //! is created.
+                class TileCache
+                {
+                    DJV_NON_COPYABLE(TileCache);
+                    TileCache();
+
+                public:
+                    ~TileCache();
+
+                    static std::shared_ptr<TileCache> create();
+
+                    //! This struct provides a tile cache key.
+                    //!
+                    //! The modification time and size of the file are part of
+                    //! the key so tiles of a file that has been re-rendered are
+                    //! not used.
+                    struct Key
+                    {
+                        std::string fileName;
+                        time_t      time     = 0;
+                        uint64_t    size     = 0;
+                        size_t      layer    = 0;
+                        int         level    = 0;
+                        int         x        = 0;
+                        int         y        = 0;
+
+                        bool operator < (const Key&) const;
+                    };
+
+                    //! \name Size
+                    ///@{
+
+                    size_t getMaxByteCount() const;
+                    size_t getByteCount() const;
+                    size_t getCount() const;
+
+                    void setMaxByteCount(size_t);
+
+                    ///@}
+
+                    //! \name Contents
+                    ///@{
+
+                    //! Get a tile. A null pointer is returned if the tile is
+                    //! not in the cache.
+                    std::shared_ptr<Image::Data> get(const Key&);
+
+                    void add(const Key&, const std::shared_ptr<Image::Data>&);
+                    void clear();
+
+                    ///@}
+
+                private:
+                    void _maxUpdate();
+
+                    DJV_PRIVATE();
+                };
+
                 //! This class provides a memory-mapped input stream.
                 class MemoryMappedIStream : public Imf::IStream
                 {
@@ -132,6 +201,7 @@ namespace djv
                         const System::File::Info&,
                         const ReadOptions&,
                         const Options&,
+                        const std::shared_ptr<TileCache>&,
                         const std::shared_ptr<System::TextSystem>&,
                         const std::shared_ptr<System::ResourceSystem>&,
                         const std::shared_ptr<System::LogSystem>&);
@@ -142,7 +212,7 @@ namespace djv
 
                 private:
                     struct File;
-                    Info _open(const std::string&, File&);
+                    Info _open(const std::string&, File&, bool tiles = false);
 
                     DJV_PRIVATE();
                 };
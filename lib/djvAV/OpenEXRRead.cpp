@@ -4,10 +4,12 @@
 
 #include <djvAV/OpenEXR.h>
 
+#include <djvAV/IOFunc.h>
 #include <djvAV/OpenEXRFunc.h>
 
 #include <djvSystem/File.h>
 #include <djvSystem/FileIO.h>
+#include <djvSystem/FileInfo.h>
 #include <djvSystem/TextSystem.h>
 
 #include <djvCore/StringFormat.h>
@@ -16,6 +18,8 @@
 #include <ImfHeader.h>
 #include <ImfInputFile.h>
 #include <ImfRgbaYca.h>
+#include <ImfTestFile.h>
+#include <ImfTiledInputFile.h>
 
 using namespace djv::Core;
 
@@ -95,8 +99,14 @@ namespace djv
                     {
                     }
 
+                    const Imf::Header& header() const
+                    {
+                        return f ? f->header() : t->header();
+                    }
+
                     std::unique_ptr<MemoryMappedIStream> s;
                     std::unique_ptr<Imf::InputFile>      f;
+                    std::unique_ptr<Imf::TiledInputFile> t;
                     Math::BBox2i                         displayWindow;
                     Math::BBox2i                         dataWindow;
                     Math::BBox2i                         intersectedWindow;
@@ -107,6 +117,7 @@ namespace djv
                 struct Read::Private
                 {
                     Options options;
+                    std::shared_ptr<TileCache> tileCache;
                 };
 
                 Read::Read() :
@@ -122,12 +133,14 @@ namespace djv
                     const System::File::Info& fileInfo,
                     const ReadOptions& readOptions,
                     const Options& options,
+                    const std::shared_ptr<TileCache>& tileCache,
                     const std::shared_ptr<System::TextSystem>& textSystem,
                     const std::shared_ptr<System::ResourceSystem>& resourceSystem,
                     const std::shared_ptr<System::LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
                     out->_p->options = options;
+                    out->_p->tileCache = tileCache;
                     out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
                     return out;
                 }
@@ -138,17 +151,247 @@ namespace djv
                     return _open(fileName, f);
                 }
 
+                namespace
+                {
+                    //! Get the level of a tiled image for a proxy.
+                    int getLevel(const Imf::TiledInputFile& f, Proxy proxy)
+                    {
+                        int levelCount = 1;
+                        switch (f.header().tileDescription().mode)
+                        {
+                        case Imf::MIPMAP_LEVELS: levelCount = f.numLevels(); break;
+                        case Imf::RIPMAP_LEVELS: levelCount = std::min(f.numXLevels(), f.numYLevels()); break;
+                        default: break;
+                        }
+                        int out = 0;
+                        for (uint16_t scale = getProxyScale(proxy); scale > 1 && out < levelCount - 1; scale /= 2)
+                        {
+                            ++out;
+                        }
+                        return out;
+                    }
+
+                    //! Read a region of a tiled image level. Only the tiles that
+                    //! intersect the region are read, and tiles that have
+                    //! already been decoded are taken from the cache.
+                    std::shared_ptr<Image::Data> readTiles(
+                        Imf::TiledInputFile& f,
+                        const System::File::Info& fileInfo,
+                        size_t layerIndex,
+                        const Layer& layer,
+                        const Image::Info& info,
+                        int level,
+                        const Math::BBox2i& region,
+                        const std::shared_ptr<TileCache>& tileCache)
+                    {
+                        Image::Info regionInfo = info;
+                        regionInfo.size = Image::Size(region.w(), region.h());
+                        auto out = Image::Data::create(regionInfo);
+                        const size_t channels = Image::getChannelCount(info.type);
+                        const size_t channelByteCount = Image::getByteCount(Image::getDataType(info.type));
+                        const size_t cb = channels * channelByteCount;
+
+                        const Math::BBox2i levelWindow = fromImath(f.dataWindowForLevel(level, level));
+                        const Imf::TileDescription& tileDescription = f.header().tileDescription();
+                        const int tileX0 = region.min.x / tileDescription.xSize;
+                        const int tileX1 = region.max.x / tileDescription.xSize;
+                        const int tileY0 = region.min.y / tileDescription.ySize;
+                        const int tileY1 = region.max.y / tileDescription.ySize;
+
+                        // Copy the part of an image that intersects the region.
+                        auto copy = [&out, &region, &levelWindow, cb](
+                            const std::shared_ptr<Image::Data>& data,
+                            const Math::BBox2i& window)
+                        {
+                            const Math::BBox2i dataBounds(
+                                window.min - levelWindow.min,
+                                window.max - levelWindow.min);
+                            const Math::BBox2i bounds = dataBounds.intersect(region);
+                            for (int y = bounds.min.y; y <= bounds.max.y; ++y)
+                            {
+                                memcpy(
+                                    out->getData(bounds.min.x - region.min.x, y - region.min.y),
+                                    data->getData(bounds.min.x - dataBounds.min.x, y - dataBounds.min.y),
+                                    bounds.w() * cb);
+                            }
+                        };
+
+                        // Look up the tiles in the cache.
+                        std::vector<std::pair<TileCache::Key, std::shared_ptr<Image::Data> > > tiles;
+                        bool missing = false;
+                        for (int tileY = tileY0; tileY <= tileY1; ++tileY)
+                        {
+                            for (int tileX = tileX0; tileX <= tileX1; ++tileX)
+                            {
+                                TileCache::Key key;
+                                key.fileName = fileInfo.getFileName();
+                                key.time = fileInfo.getTime();
+                                key.size = fileInfo.getSize();
+                                key.layer = layerIndex;
+                                key.level = level;
+                                key.x = tileX;
+                                key.y = tileY;
+                                auto tile = tileCache ? tileCache->get(key) : nullptr;
+                                if (!tile)
+                                {
+                                    missing = true;
+                                }
+                                tiles.push_back(std::make_pair(key, tile));
+                            }
+                        }
+
+                        if (missing)
+                        {
+                            // Read the range of tiles with a single call so that
+                            // OpenEXR can decode them in parallel.
+                            const Math::BBox2i rangeWindow(
+                                fromImath(f.dataWindowForTile(tileX0, tileY0, level, level)).min,
+                                fromImath(f.dataWindowForTile(tileX1, tileY1, level, level)).max);
+                            Image::Info rangeInfo = info;
+                            rangeInfo.size = Image::Size(rangeWindow.w(), rangeWindow.h());
+                            auto range = Image::Data::create(rangeInfo);
+                            const size_t scb = range->getScanlineByteCount();
+                            Imf::FrameBuffer frameBuffer;
+                            for (size_t c = 0; c < channels; ++c)
+                            {
+                                frameBuffer.insert(
+                                    layer.channels[c].name.c_str(),
+                                    Imf::Slice(
+                                        toImf(Image::getDataType(info.type)),
+                                        (char*)range->getData() - (rangeWindow.min.x * cb) - (rangeWindow.min.y * scb) + (c * channelByteCount),
+                                        cb,
+                                        scb));
+                            }
+                            f.setFrameBuffer(frameBuffer);
+                            f.readTiles(tileX0, tileX1, tileY0, tileY1, level, level);
+                            copy(range, rangeWindow);
+
+                            if (tileCache)
+                            {
+                                for (const auto& i : tiles)
+                                {
+                                    if (!i.second)
+                                    {
+                                        const Math::BBox2i tileWindow = fromImath(f.dataWindowForTile(i.first.x, i.first.y, level, level));
+                                        Image::Info tileInfo = info;
+                                        tileInfo.size = Image::Size(tileWindow.w(), tileWindow.h());
+                                        auto tile = Image::Data::create(tileInfo);
+                                        for (int y = 0; y < tileInfo.size.h; ++y)
+                                        {
+                                            memcpy(
+                                                tile->getData(y),
+                                                range->getData(tileWindow.min.x - rangeWindow.min.x, tileWindow.min.y - rangeWindow.min.y + y),
+                                                tileInfo.size.w * cb);
+                                        }
+                                        tileCache->add(i.first, tile);
+                                    }
+                                }
+                            }
+                        }
+                        else
+                        {
+                            for (const auto& i : tiles)
+                            {
+                                copy(i.second, fromImath(f.dataWindowForTile(i.first.x, i.first.y, level, level)));
+                            }
+                        }
+                        return out;
+                    }
+
+                } // namespace
+
                 std::shared_ptr<Image::Data> Read::_readImage(const std::string& fileName)
                 {
+                    // Tiled images are only opened as tiles for proxies and
+                    // regions of interest, full resolution images are read
+                    // with the scanline interface below.
                     File f;
-                    Info info = _open(fileName, f);
+                    Info info = _open(fileName, f, _options.proxy != Proxy::None || _options.roi.isValid());
+                    if (f.t && !f.fast)
+                    {
+                        // The tile path needs the display and data windows
+                        // to match and no channel sampling.
+                        f.t.reset();
+                        info = _open(fileName, f);
+                    }
                     Image::Info imageInfo = info.video[std::min(_options.layer, info.video.size() - 1)];
-                    std::shared_ptr<Image::Data> out = Image::Data::create(imageInfo);
-                    out->setPluginName(pluginName);
-                    out->setTags(info.tags);
+
+                    // Proxies are read from the mipmap or ripmap levels, and
+                    // only the tiles in the region of interest are read.
+                    const Math::BBox2i roi = getROI(_options, imageInfo.size);
+                    if (f.t)
+                    {
+                        const int level = getLevel(*f.t, _options.proxy);
+                        Math::BBox2i region(0, 0, f.t->levelWidth(level), f.t->levelHeight(level));
+                        if (roi.isValid())
+                        {
+                            region = roi;
+                        }
+
+                        // Only the tiles of a region of interest are cached,
+                        // whole images are already kept by the frame cache.
+                        const size_t layerIndex = std::min(_options.layer, f.layers.size() - 1);
+                        auto out = readTiles(
+                            *f.t,
+                            System::File::Info(fileName),
+                            layerIndex,
+                            f.layers[layerIndex],
+                            imageInfo,
+                            level,
+                            region,
+                            roi.isValid() ? _p->tileCache : nullptr);
+                        out->setPluginName(pluginName);
+                        out->setTags(info.tags);
+                        if (roi.isValid())
+                        {
+                            out->setOrigin(roi.min);
+                        }
+                        return out;
+                    }
+
                     const size_t channels = Image::getChannelCount(imageInfo.type);
                     const size_t channelByteCount = Image::getByteCount(getDataType(imageInfo.type));
                     const size_t cb = channels * channelByteCount;
+
+                    // Only the scanlines of the region of interest are read.
+                    // They are read into a buffer with the width of the data
+                    // window and the columns of the region are copied out.
+                    if (roi.isValid() && f.fast)
+                    {
+                        Image::Info roiInfo = imageInfo;
+                        roiInfo.size = Image::Size(roi.w(), roi.h());
+                        auto out = Image::Data::create(roiInfo);
+                        out->setPluginName(pluginName);
+                        out->setTags(info.tags);
+                        out->setOrigin(roi.min);
+                        const size_t rowByteCount = f.dataWindow.w() * cb;
+                        std::vector<char> buf(rowByteCount * roiInfo.size.h);
+                        Imf::FrameBuffer frameBuffer;
+                        for (size_t c = 0; c < channels; ++c)
+                        {
+                            frameBuffer.insert(
+                                f.layers[_options.layer].channels[c].name.c_str(),
+                                Imf::Slice(
+                                    toImf(Image::getDataType(imageInfo.type)),
+                                    buf.data() - (f.dataWindow.min.x * cb) - ((f.dataWindow.min.y + roi.min.y) * rowByteCount) + (c * channelByteCount),
+                                    cb,
+                                    rowByteCount));
+                        }
+                        f.f->setFrameBuffer(frameBuffer);
+                        f.f->readPixels(f.dataWindow.min.y + roi.min.y, f.dataWindow.min.y + roi.max.y);
+                        for (uint16_t y = 0; y < roiInfo.size.h; ++y)
+                        {
+                            memcpy(
+                                out->getData(y),
+                                buf.data() + y * rowByteCount + roi.min.x * cb,
+                                roiInfo.size.w * cb);
+                        }
+                        return out;
+                    }
+
+                    std::shared_ptr<Image::Data> out = Image::Data::create(imageInfo);
+                    out->setPluginName(pluginName);
+                    out->setTags(info.tags);
                     const size_t scb = imageInfo.size.w * channels * channelByteCount;
                     if (f.fast)
                     {
@@ -214,31 +457,47 @@ namespace djv
                     return out;
                 }
 
-                Info Read::_open(const std::string& fileName, File& f)
+                Info Read::_open(const std::string& fileName, File& f, bool tiles)
                 {
                     DJV_PRIVATE_PTR();
 
                     Info out;
 
-                    // Open the file.
+                    // Open the file. Tiled files are opened with the tiled
+                    // interface when tiles are requested.
+                    bool tiled = false;
 #if defined(DJV_MMAP)
                     f.s.reset(new MemoryMappedIStream(fileName.c_str()));
-                    f.f.reset(new Imf::InputFile(*f.s.get()));
+                    if (tiles && Imf::isOpenExrFile(*f.s.get(), tiled) && tiled)
+                    {
+                        f.t.reset(new Imf::TiledInputFile(*f.s.get()));
+                    }
+                    else
+                    {
+                        f.f.reset(new Imf::InputFile(*f.s.get()));
+                    }
 #else // DJV_MMAP
-                    f.f.reset(new Imf::InputFile(fileName.c_str()));
+                    if (tiles && Imf::isOpenExrFile(fileName.c_str(), tiled) && tiled)
+                    {
+                        f.t.reset(new Imf::TiledInputFile(fileName.c_str()));
+                    }
+                    else
+                    {
+                        f.f.reset(new Imf::InputFile(fileName.c_str()));
+                    }
 #endif // DJV_MMAP
 
                     // Get the display and data windows.
-                    f.displayWindow = fromImath(f.f->header().displayWindow());
-                    f.dataWindow = fromImath(f.f->header().dataWindow());
+                    f.displayWindow = fromImath(f.header().displayWindow());
+                    f.dataWindow = fromImath(f.header().dataWindow());
                     f.intersectedWindow = f.displayWindow.intersect(f.dataWindow);
                     f.fast = f.displayWindow == f.dataWindow;
 
                     // Get the tags.
-                    readTags(f.f->header(), out.tags, _speed);
+                    readTags(f.header(), out.tags, _speed);
 
                     // Get the layers.
-                    f.layers = getLayers(f.f->header().channels(), p.options.channels);
+                    f.layers = getLayers(f.header().channels(), p.options.channels);
                     out.fileName = fileName;
                     out.videoSequence = _sequence;
                     out.videoSpeed = _speed;
@@ -253,7 +512,7 @@ namespace djv
                         info.name = layer.name;
                         info.size.w = f.displayWindow.w();
                         info.size.h = f.displayWindow.h();
-                        info.pixelAspectRatio = f.f->header().pixelAspectRatio();
+                        info.pixelAspectRatio = f.header().pixelAspectRatio();
                         switch (layer.channels[0].type)
                         {
                         case Image::DataType::F16:
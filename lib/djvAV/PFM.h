@@ -48,6 +48,8 @@ namespace djv
                 protected:
                     Info _readInfo(const std::string& fileName) override;
                     std::shared_ptr<Image::Data> _readImage(const std::string& fileName) override;
+                    bool _canReadAsync() const override;
+                    void _readImageAsync(const std::string& fileName, const ReadCallback&) override;
 
                 private:
                     Info _open(const std::string&, const std::shared_ptr<System::File::IO>&, float& scale);
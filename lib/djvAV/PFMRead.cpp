@@ -21,6 +21,23 @@ namespace djv
         {
             namespace PFM
             {
+                namespace
+                {
+                    void scaleImage(Image::Data& image, float scale)
+                    {
+                        if(scale - 1 > 1E-6)
+                        {
+                            auto* data = reinterpret_cast<float*>(image.getData());
+                            const size_t floats = image.getDataByteCount() / sizeof(float);
+                            for (size_t i = 0; i < floats; ++i)
+                            {
+                                data[i] *= scale;
+                            }
+                        }
+                    }
+
+                } // namespace
+
                 Read::Read()
                 {}
 
@@ -63,21 +80,35 @@ namespace djv
                     io->read(out->getData(), out->getDataByteCount());
 #endif // DJV_MMAP
 
-                    if(scale - 1 > 1E-6)
-                    {
-                        auto* data = reinterpret_cast<float*>(out->getData());
-                        const size_t floats = out->getDataByteCount() / sizeof(float);
-                        for (size_t i = 0; i < floats; ++i)
-                        {
-                            data[i] *= scale;
-                        }
-                    }
+                    scaleImage(*out, scale);
                     
                     out->setPluginName(pluginName);
 
                     return out;
                 }
                 
+                bool Read::_canReadAsync() const
+                {
+                    return true;
+                }
+
+                void Read::_readImageAsync(const std::string& fileName, const ReadCallback& callback)
+                {
+                    auto io = System::File::IO::create();
+                    float scale;
+                    const auto info = _open(fileName, io, scale);
+                    auto image = Image::Data::create(info.video[0]);
+                    image->setPluginName(pluginName);
+                    _readDataAsync(
+                        io,
+                        image,
+                        [scale](Image::Data& data)
+                        {
+                            scaleImage(data, scale);
+                        },
+                        callback);
+                }
+
                 Info Read::_open(const std::string& fileName, const std::shared_ptr<System::File::IO>& io, float& scale)
                 {
                     io->open(fileName, System::File::Mode::Read);
@@ -70,6 +70,8 @@ namespace djv
                 protected:
                     Info _readInfo(const std::string&) override;
                     std::shared_ptr<Image::Data> _readImage(const std::string&) override;
+                    bool _canReadAsync() const override;
+                    void _readImageAsync(const std::string&, const ReadCallback&) override;
 
                 private:
                     Info _open(const std::string&, const std::shared_ptr<System::File::IO>&, Data&);
@@ -4,6 +4,7 @@
 
 #include <djvAV/PPM.h>
 
+#include <djvAV/IOFunc.h>
 #include <djvAV/PPMFunc.h>
 
 #include <djvSystem/File.h>
@@ -23,6 +24,24 @@ namespace djv
         {
             namespace PPM
             {
+                namespace
+                {
+                    std::shared_ptr<Image::Data> readASCIIImage(
+                        const std::shared_ptr<System::File::IO>& io,
+                        const Image::Info& imageInfo)
+                    {
+                        auto out = Image::Data::create(imageInfo);
+                        const size_t channelCount = Image::getChannelCount(imageInfo.type);
+                        const size_t bitDepth = Image::getBitDepth(imageInfo.type);
+                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                        {
+                            readASCII(io, out->getData(y), imageInfo.size.w * channelCount, bitDepth);
+                        }
+                        return out;
+                    }
+
+                } // namespace
+
                 Read::Read()
                 {}
 
@@ -61,14 +80,8 @@ namespace djv
                     {
                     case Data::ASCII:
                     {
-                        out = Image::Data::create(imageInfo);
+                        out = readASCIIImage(io, imageInfo);
                         out->setPluginName(pluginName);
-                        const size_t channelCount = Image::getChannelCount(imageInfo.type);
-                        const size_t bitDepth = Image::getBitDepth(imageInfo.type);
-                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
-                        {
-                            readASCII(io, out->getData(y), imageInfo.size.w * channelCount, bitDepth);
-                        }
                         break;
                     }
                     case Data::Binary:
@@ -80,8 +93,20 @@ namespace djv
 #if defined(DJV_MMAP)
                         out = Image::Data::create(imageInfo, io);
 #else // DJV_MMAP
-                        out = Image::Data::create(imageInfo);
-                        io->read(out->getData(), out->getDataByteCount());
+                        const Math::BBox2i roi = getROI(_options, imageInfo.size);
+                        if (_options.proxy != Proxy::None)
+                        {
+                            out = readProxy(io, imageInfo, _options.proxy);
+                        }
+                        else if (roi.isValid())
+                        {
+                            out = readROI(io, imageInfo, roi);
+                        }
+                        else
+                        {
+                            out = Image::Data::create(imageInfo);
+                            io->read(out->getData(), out->getDataByteCount());
+                        }
 #endif // DJV_MMAP
                         out->setPluginName(pluginName);
                         break;
@@ -91,6 +116,41 @@ namespace djv
                     return out;
                 }
 
+                bool Read::_canReadAsync() const
+                {
+                    return true;
+                }
+
+                void Read::_readImageAsync(const std::string& fileName, const ReadCallback& callback)
+                {
+                    auto io = System::File::IO::create();
+                    Data data = Data::First;
+                    const auto info = _open(fileName, io, data);
+                    auto imageInfo = info.video[0];
+                    switch (data)
+                    {
+                    case Data::ASCII:
+                    {
+                        // ASCII data needs to be parsed so it is read here.
+                        auto image = readASCIIImage(io, imageInfo);
+                        image->setPluginName(pluginName);
+                        callback(image, nullptr);
+                        break;
+                    }
+                    case Data::Binary:
+                    {
+                        imageInfo.layout.endian = Memory::getEndian();
+                        auto image = Image::Data::create(imageInfo);
+                        image->setPluginName(pluginName);
+                        _readDataAsync(io, image, nullptr, callback);
+                        break;
+                    }
+                    default:
+                        callback(nullptr, nullptr);
+                        break;
+                    }
+                }
+
                 Info Read::_open(const std::string& fileName, const std::shared_ptr<System::File::IO>& io, Data& data)
                 {
                     io->open(fileName, System::File::Mode::Read);
@@ -6,10 +6,16 @@
 
 #include <djvGL/ImageConvert.h>
 
+#include <djvAV/IOFunc.h>
 #include <djvAV/SpeedFunc.h>
 
+#include <djvImage/Convert.h>
+
 #include <djvSystem/Context.h>
 #include <djvSystem/File.h>
+#include <djvSystem/FileAsyncIO.h>
+#include <djvSystem/FileFunc.h>
+#include <djvSystem/FileIO.h>
 #include <djvSystem/FileInfo.h>
 #include <djvSystem/LogSystem.h>
 #include <djvSystem/Path.h>
@@ -19,11 +25,15 @@
 #include <djvCore/OSFunc.h>
 #include <djvCore/String.h>
 #include <djvCore/StringFormat.h>
+#include <djvCore/UIDFunc.h>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <atomic>
 #include <future>
+#include <set>
 
 using namespace djv::Core;
 
@@ -38,6 +48,22 @@ namespace djv
                 //! \todo Should this be configurable?
                 const double infoTimeout = 0.5;
 
+                std::atomic<size_t> willNeedCount(0);
+                std::atomic<size_t> dontNeedCount(0);
+
+                void adviseFile(const std::string& fileName, System::File::Advice advice)
+                {
+                    if (System::File::advise(fileName, advice))
+                    {
+                        switch (advice)
+                        {
+                        case System::File::Advice::WillNeed: ++willNeedCount; break;
+                        case System::File::Advice::DontNeed: ++dontNeedCount; break;
+                        default: break;
+                        }
+                    }
+                }
+
             } // namespace
 
             struct ISequenceRead::Future
@@ -50,13 +76,17 @@ namespace djv
             {
                 Math::Frame::Number frame = Math::Frame::invalid;
                 std::promise<Info> infoPromise;
-                std::vector<std::future<Future> > cacheFutures;
+                Core::UID cacheGroup = 0;
+                std::vector<std::pair<Math::Frame::Index, std::future<Future> > > cacheFutures;
+                std::set<Math::Frame::Index> readAheadFrames;
                 std::condition_variable queueCV;
                 Direction direction = Direction::Forward;
                 Math::Frame::Number seek = Math::Frame::invalid;
                 std::thread thread;
                 std::atomic<bool> running;
                 std::chrono::steady_clock::time_point infoTimer;
+                Image::Size proxySize;
+                std::shared_ptr<Image::Convert> proxyConvert;
             };
 
             void ISequenceRead::_init(
@@ -68,6 +98,11 @@ namespace djv
             {
                 IRead::_init(fileInfo, options, textSystem, resourceSystem, logSystem);
                 _speed = fromSpeed(getDefaultSpeed());
+                _p->cacheGroup = createUID();
+                if (_options.proxy != Proxy::None)
+                {
+                    _p->proxyConvert = Image::Convert::create();
+                }
                 _p->running = true;
                 _p->thread = std::thread(
                     [this]
@@ -99,6 +134,10 @@ namespace djv
                     {
                         info = _readInfo(fileName);
                         info.fileName = _fileInfo.getFileName();
+                        if (_options.layer < info.video.size())
+                        {
+                            p.proxySize = getProxySize(info.video[_options.layer].size, _options.proxy);
+                        }
                         p.infoPromise.set_value(info);
                     }
                     catch (const std::exception&)
@@ -140,20 +179,24 @@ namespace djv
                             cacheEnabled = _cacheEnabled;
                             cacheMaxByteCount = _cacheMaxByteCount;
                         }
+                        cacheMaxByteCount = _getCacheMaxByteCount(cacheMaxByteCount);
                         if (!cacheEnabled)
                         {
                             _cache.clear();
                         }
                         if (info.video.size() && _options.layer < info.video.size())
                         {
-                            const size_t dataByteCount = info.video[_options.layer].getDataByteCount();
-                            _cache.setMax(dataByteCount ? (cacheMaxByteCount / dataByteCount) : 0);
+                            _cache.setMaxByteCount(cacheMaxByteCount);
+                            auto imageInfo = info.video[_options.layer];
+                            const Math::BBox2i roi = getROI(_options, imageInfo.size);
+                            imageInfo.size = roi.isValid() ? Image::Size(roi.w(), roi.h()) : p.proxySize;
+                            _cache.setByteCountEstimate(imageInfo.getDataByteCount());
                             _cache.setSequenceSize(info.videoSequence.getFrameCount());
                             _cache.setInOutPoints(inOutPoints);
                         }
                         else
                         {
-                            _cache.setMax(0);
+                            _cache.setMaxByteCount(0);
                         }
 
                         // Check to see if there is work to be done.
@@ -188,6 +231,13 @@ namespace djv
                         if (seek != Math::Frame::invalid)
                         {
                             p.frame = seek;
+
+                            // Cancel the cache reads that have not started yet,
+                            // they are probably stale now.
+                            if (_threadPool)
+                            {
+                                _threadPool->cancel(p.cacheGroup);
+                            }
                             /*{
                                 std::stringstream ss;
                                 ss << _fileName << ": seek " << p.frame;
@@ -202,10 +252,24 @@ namespace djv
                             read = _readQueue(queueCount, loop, cacheEnabled);
                         }
 
-                        // Fill the cache.
+                        // Fill the cache. Readers using the asynchronous I/O
+                        // do not block a thread for each frame so they can
+                        // have more frames in flight.
                         if (cacheEnabled)
                         {
-                            _readCache(playback ? (threadCount / 2) : threadCount, inOutPoints);
+                            size_t cacheReadCount = playback ? (threadCount / 2) : threadCount;
+                            if (_hasAsyncRead())
+                            {
+                                cacheReadCount = std::max(cacheReadCount, _options.asyncReadAhead);
+                            }
+                            _readCache(cacheReadCount);
+                        }
+
+                        // Give the operating system hints about which files
+                        // will be read next.
+                        if (_options.fileReadAhead > 0 && sequenceFrameCount > 1)
+                        {
+                            _readAhead(_options.fileReadAhead, loop, inOutPoints);
                         }
 
                         // Update information.
@@ -263,6 +327,97 @@ namespace djv
                 return _sequence.getFrameCount() > 1;
             }
 
+            ISequenceRead::ReadAheadStats ISequenceRead::getReadAheadStats()
+            {
+                ReadAheadStats out;
+                out.willNeedCount = willNeedCount;
+                out.dontNeedCount = dontNeedCount;
+                return out;
+            }
+
+            bool ISequenceRead::_hasAsyncRead() const
+            {
+#if defined(DJV_MMAP)
+                return false;
+#else // DJV_MMAP
+                // Proxies and regions of interest are read with partial
+                // reads instead.
+                return _options.asyncIO && _threadPool && _canReadAsync() &&
+                    Proxy::None == _options.proxy &&
+                    !_options.roi.isValid();
+#endif // DJV_MMAP
+            }
+
+            bool ISequenceRead::_canReadAsync() const
+            {
+                return false;
+            }
+
+            void ISequenceRead::_readImageAsync(const std::string& fileName, const ReadCallback& callback)
+            {
+                std::shared_ptr<Image::Data> image;
+                std::exception_ptr error;
+                try
+                {
+                    image = _readImage(fileName);
+                }
+                catch (const std::exception&)
+                {
+                    error = std::current_exception();
+                }
+                callback(image, error);
+            }
+
+            void ISequenceRead::_readDataAsync(
+                const std::shared_ptr<System::File::IO>& io,
+                const std::shared_ptr<Image::Data>& image,
+                const std::function<void(Image::Data&)>& func,
+                const ReadCallback& callback)
+            {
+                _options.asyncIO->read(
+                    System::File::ReadRequest(io, io->getPos(), image->getDataByteCount(), image->getData()),
+                    [image, func, callback](const std::exception_ptr& value)
+                    {
+                        std::exception_ptr error = value;
+                        if (!error && func)
+                        {
+                            try
+                            {
+                                func(*image);
+                            }
+                            catch (const std::exception&)
+                            {
+                                error = std::current_exception();
+                            }
+                        }
+                        callback(error ? nullptr : image, error);
+                    });
+            }
+
+            std::shared_ptr<Image::Data> ISequenceRead::_proxy(const std::shared_ptr<Image::Data>& value) const
+            {
+                DJV_PRIVATE_PTR();
+                std::shared_ptr<Image::Data> out = value;
+
+                // Images that were not reduced by the format are reduced here
+                // with a box filter.
+                if (out && p.proxyConvert && p.proxySize.isValid() &&
+                    (out->getWidth() > p.proxySize.w || out->getHeight() > p.proxySize.h))
+                {
+                    auto info = out->getInfo();
+                    info.size = p.proxySize;
+                    out = Image::Data::create(info);
+                    out->setPluginName(value->getPluginName());
+                    out->setTags(value->getTags());
+                    p.proxyConvert->process(*value, info, *out);
+                }
+                if (out && p.proxyConvert)
+                {
+                    out->setScale(getProxyScale(_options.proxy));
+                }
+                return out;
+            }
+
             void ISequenceRead::_finish()
             {
                 DJV_PRIVATE_PTR();
@@ -272,6 +427,18 @@ namespace djv
                     //! \todo How do we safely detach the thread here so we don't block?
                     p.thread.join();
                 }
+                if (_threadPool)
+                {
+                    _threadPool->cancel(p.cacheGroup);
+                }
+                for (auto& i : p.cacheFutures)
+                {
+                    if (i.second.valid())
+                    {
+                        i.second.wait();
+                    }
+                }
+                p.cacheFutures.clear();
             }
 
             bool ISequenceRead::_hasWork() const
@@ -288,27 +455,80 @@ namespace djv
                 return std::min(queueMax, threadCount);
             }
 
-            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(Math::Frame::Number i, std::string fileName)
+            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(
+                Math::Frame::Number i,
+                std::string fileName,
+                System::ThreadPool::Priority priority,
+                Core::UID group)
             {
-                return std::async(
-                    std::launch::async,
-                    [this, i, fileName]
+                const auto func = [this, i, fileName]
+                {
+                    Future out;
+                    out.frame = i;
+                    try
                     {
-                        Future out;
-                        out.frame = i;
-                        try
-                        {
-                            out.image = _readImage(fileName);
-                        }
-                        catch (const std::exception& e)
+                        out.image = _proxy(_readImage(fileName));
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _logSystem->log(
+                            "djv::AV::ISequenceRead",
+                            String::Format("{0}: {1}").arg(fileName).arg(e.what()),
+                            System::LogLevel::Error);
+                    }
+                    return out;
+                };
+                if (_hasAsyncRead())
+                {
+                    // The job only reads the file header, the image data is read
+                    // with the asynchronous I/O and the future is completed by
+                    // the callback. If the job is cancelled the promise is
+                    // destroyed and the future throws std::future_error.
+                    auto promise = std::make_shared<std::promise<Future> >();
+                    auto out = promise->get_future();
+                    auto logSystem = _logSystem;
+                    _threadPool->submit(
+                        [this, i, fileName, promise, logSystem]
                         {
-                            _logSystem->log(
-                                "djv::AV::ISequenceRead",
-                                String::Format("{0}: {1}").arg(fileName).arg(e.what()),
-                                System::LogLevel::Error);
-                        }
-                        return out;
-                    });
+                            const auto callback = [i, fileName, promise, logSystem](
+                                const std::shared_ptr<Image::Data>& image,
+                                const std::exception_ptr& error)
+                            {
+                                Future future;
+                                future.frame = i;
+                                future.image = image;
+                                if (error)
+                                {
+                                    try
+                                    {
+                                        std::rethrow_exception(error);
+                                    }
+                                    catch (const std::exception& e)
+                                    {
+                                        logSystem->log(
+                                            "djv::AV::ISequenceRead",
+                                            String::Format("{0}: {1}").arg(fileName).arg(e.what()),
+                                            System::LogLevel::Error);
+                                    }
+                                }
+                                promise->set_value(future);
+                            };
+                            try
+                            {
+                                _readImageAsync(fileName, callback);
+                            }
+                            catch (const std::exception&)
+                            {
+                                callback(nullptr, std::current_exception());
+                            }
+                        },
+                        priority,
+                        group);
+                    return out;
+                }
+                return _threadPool ?
+                    _threadPool->submit(func, priority, group) :
+                    std::async(std::launch::async, func);
             }
 
             size_t ISequenceRead::_readQueue(size_t count, bool loop, bool cacheEnabled)
@@ -334,13 +554,13 @@ namespace djv
                             {
                                 const Math::Frame::Number frameNumber = _sequence.getFrame(p.frame);
                                 const std::string fileName = _fileInfo.getFileName(frameNumber);
-                                futures.push_back(_getFuture(p.frame, fileName));
+                                futures.push_back(_getFuture(p.frame, fileName, System::ThreadPool::Priority::High, 0));
                             }
                         }
                         else
                         {
                             const std::string fileName = _fileInfo.getFileName();
-                            futures.push_back(_getFuture(p.frame, fileName));
+                            futures.push_back(_getFuture(p.frame, fileName, System::ThreadPool::Priority::High, 0));
                         }
                     }
 
@@ -370,7 +590,16 @@ namespace djv
                 // Get the results.
                 for (auto& future : futures)
                 {
-                    const auto result = future.get();
+                    Future result;
+                    try
+                    {
+                        result = future.get();
+                    }
+                    catch (const std::future_error&)
+                    {
+                        // The read was cancelled, the frame is dropped.
+                        continue;
+                    }
                     images.push_back(std::make_pair(result.frame, result.image));
                     if (cacheEnabled)
                     {
@@ -403,7 +632,7 @@ namespace djv
                 return futures.size();
             }
 
-            void ISequenceRead::_readCache(size_t count, const AV::IO::InOutPoints& inOutPoints)
+            void ISequenceRead::_readCache(size_t count)
             {
                 DJV_PRIVATE_PTR();
 
@@ -418,88 +647,163 @@ namespace djv
                 }
                 if (count > 0 && frame != Math::Frame::invalid)
                 {
-                    const size_t sequenceFrameCount = _sequence.getFrameCount();
-                    const auto range = inOutPoints.getRange(sequenceFrameCount);
                     _cache.setDirection(p.direction);
                     _cache.setCurrentFrame(frame);
-                    const size_t readBehind = _cache.getReadBehind();
-                    switch (p.direction)
-                    {
-                    case Direction::Forward:
+                    for (const auto i : _cache.getWindow())
                     {
-                        for (size_t i = 0; i < readBehind; ++i)
+                        if (p.cacheFutures.size() >= count)
                         {
-                            --frame;
-                            if (frame < range.getMin())
+                            break;
+                        }
+                        const auto j = std::find_if(
+                            p.cacheFutures.begin(),
+                            p.cacheFutures.end(),
+                            [i](const std::pair<Math::Frame::Index, std::future<Future> >& value)
                             {
-                                frame = range.getMax();
-                            }
+                                return i == value.first;
+                            });
+                        if (!_cache.contains(i) && j == p.cacheFutures.end())
+                        {
+                            const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(i));
+                            p.cacheFutures.push_back(std::make_pair(
+                                i,
+                                _getFuture(i, fileName, System::ThreadPool::Priority::Low, p.cacheGroup)));
                         }
-                        const size_t max = std::min(_cache.getMax(), sequenceFrameCount);
-                        for (size_t i = 0; i < max && p.cacheFutures.size() < count; ++i)
+                    }
+                }
+
+                // Get the results.
+                auto i = p.cacheFutures.begin();
+                while (i != p.cacheFutures.end())
+                {
+                    if (i->second.valid() &&
+                        i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        try
                         {
-                            if (!_cache.contains(frame))
-                            {
-                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
-                            }
-                            ++frame;
-                            if (frame > range.getMax())
-                            {
-                                frame = range.getMin();
-                            }
+                            const auto result = i->second.get();
+#if defined(DJV_MMAP)
+                            result.image->detach();
+#endif // DJV_MMAP
+                            _cache.add(result.frame, result.image);
                         }
-                        break;
+                        catch (const std::future_error&)
+                        {
+                            // The read was cancelled.
+                        }
+                        i = p.cacheFutures.erase(i);
                     }
-                    case Direction::Reverse:
+                    else
                     {
-                        for (size_t i = 0; i < readBehind; ++i)
+                        ++i;
+                    }
+                }
+            }
+
+            void ISequenceRead::_readAhead(size_t count, bool loop, const InOutPoints& inOutPoints)
+            {
+                DJV_PRIVATE_PTR();
+                const Math::Frame::Index sequenceFrameCount = static_cast<Math::Frame::Index>(_sequence.getFrameCount());
+                const auto range = inOutPoints.getRange(_sequence.getFrameCount());
+                Math::Frame::Index playhead = p.frame;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (_videoQueue.getCount())
+                    {
+                        playhead = _videoQueue.getFrame().frame;
+                    }
+                }
+                if (Math::Frame::invalid == playhead)
+                {
+                    return;
+                }
+
+                // Get the frames after the read position in the current
+                // direction.
+                std::set<Math::Frame::Index> frames;
+                Math::Frame::Index frame = p.frame;
+                for (size_t i = 0; i < count && frame >= range.getMin() && frame <= range.getMax(); ++i)
+                {
+                    frames.insert(frame);
+                    switch (p.direction)
+                    {
+                    case Direction::Forward:
+                        ++frame;
+                        if (loop && frame > range.getMax())
                         {
-                            ++frame;
-                            if (frame > range.getMax())
-                            {
-                                frame = range.getMin();
-                            }
+                            frame = range.getMin();
                         }
-                        const size_t max = std::min(_cache.getMax(), sequenceFrameCount);
-                        for (Math::Frame::Number i = 0; i < max && p.cacheFutures.size() < count; ++i)
+                        break;
+                    case Direction::Reverse:
+                        --frame;
+                        if (loop && frame < range.getMin())
                         {
-                            if (!_cache.contains(frame))
-                            {
-                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
-                            }
-                            --frame;
-                            if (frame < range.getMin())
-                            {
-                                frame = range.getMax();
-                            }
+                            frame = range.getMax();
                         }
                         break;
-                    }
                     default: break;
                     }
                 }
 
-                // Get the results.
-                auto i = p.cacheFutures.begin();
-                while (i != p.cacheFutures.end())
+                // Release the files that are no longer ahead of the read
+                // position and have fallen behind the cache read behind.
+                const Math::Frame::Index readBehind = static_cast<Math::Frame::Index>(_cache.getReadBehind());
+                std::vector<std::string> dontNeed;
+                auto i = p.readAheadFrames.begin();
+                while (i != p.readAheadFrames.end())
                 {
-                    if (i->valid() &&
-                        i->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    Math::Frame::Index behind = Direction::Forward == p.direction ? (playhead - *i) : (*i - playhead);
+                    if (loop)
                     {
-                        const auto result = i->get();
-#if defined(DJV_MMAP)
-                        result.image->detach();
-#endif // DJV_MMAP
-                        _cache.add(result.frame, result.image);
-                        i = p.cacheFutures.erase(i);
+                        behind = ((behind % sequenceFrameCount) + sequenceFrameCount) % sequenceFrameCount;
+                    }
+                    if (frames.find(*i) == frames.end() && (behind < 0 || behind > readBehind))
+                    {
+                        dontNeed.push_back(_fileInfo.getFileName(_sequence.getFrame(*i)));
+                        i = p.readAheadFrames.erase(i);
                     }
                     else
                     {
                         ++i;
                     }
                 }
+
+                // Files that have already been cached do not need to be read.
+                std::vector<std::string> willNeed;
+                for (const auto j : frames)
+                {
+                    if (p.readAheadFrames.find(j) == p.readAheadFrames.end())
+                    {
+                        p.readAheadFrames.insert(j);
+                        if (!_cache.contains(j))
+                        {
+                            willNeed.push_back(_fileInfo.getFileName(_sequence.getFrame(j)));
+                        }
+                    }
+                }
+
+                if (!dontNeed.empty() || !willNeed.empty())
+                {
+                    const auto func = [dontNeed, willNeed]
+                    {
+                        for (const auto& j : dontNeed)
+                        {
+                            adviseFile(j, System::File::Advice::DontNeed);
+                        }
+                        for (const auto& j : willNeed)
+                        {
+                            adviseFile(j, System::File::Advice::WillNeed);
+                        }
+                    };
+                    if (_threadPool)
+                    {
+                        _threadPool->submit(func, System::ThreadPool::Priority::Low);
+                    }
+                    else
+                    {
+                        func();
+                    }
+                }
             }
 
             struct ISequenceWrite::Private
@@ -508,6 +812,7 @@ namespace djv
                 Math::Frame::Number frameNumber = Math::Frame::invalid;
                 GLFWwindow * glfwWindow = nullptr;
                 std::shared_ptr<GL::ImageConvert> convert;
+                std::shared_ptr<Image::Convert> cpuConvert;
                 std::thread thread;
                 std::atomic<bool> running;
             };
@@ -540,26 +845,37 @@ namespace djv
                     }
                 }
 
+                if (options.gl)
+                {
 #if defined(DJV_GL_ES2)
-                glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+                    glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
 #else // DJV_GL_ES2
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-                glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-                glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+                    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+                    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #endif // DJV_GL_ES2
-                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-                int env = 0;
-                if (OS::getIntEnv("DJV_GL_DEBUG", env) && env != 0)
-                {
-                    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+                    int env = 0;
+                    if (OS::getIntEnv("DJV_GL_DEBUG", env) && env != 0)
+                    {
+                        glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                    }
+                    p.glfwWindow = glfwCreateWindow(100, 100, "djv::IO::ISequenceWrite", NULL, NULL);
+                    if (!p.glfwWindow)
+                    {
+                        _logSystem->log(
+                            "djv::AV::ISequenceWrite",
+                            _textSystem->getText(DJV_TEXT("error_glfw_window_creation")),
+                            System::LogLevel::Warning);
+                    }
                 }
-                p.glfwWindow = glfwCreateWindow(100, 100, "djv::IO::ISequenceWrite", NULL, NULL);
                 if (!p.glfwWindow)
                 {
-                    throw System::File::Error(_textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
+                    // Without an OpenGL context the images are converted on the CPU.
+                    p.cpuConvert = Image::Convert::create(_threadPool);
                 }
 
                 p.running = true;
@@ -569,17 +885,20 @@ namespace djv
                     DJV_PRIVATE_PTR();
                     try
                     {
-                        glfwMakeContextCurrent(p.glfwWindow);
+                        if (p.glfwWindow)
+                        {
+                            glfwMakeContextCurrent(p.glfwWindow);
 #if defined(DJV_GL_ES2)
-                        if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
+                            if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
 #else // DJV_GL_ES2
-                        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+                            if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
 #endif // DJV_GL_ES2
-                        {
-                            throw System::File::Error(_textSystem->getText(DJV_TEXT("error_glad_init")));
-                        }
+                            {
+                                throw System::File::Error(_textSystem->getText(DJV_TEXT("error_glad_init")));
+                            }
 
-                        p.convert = GL::ImageConvert::create(_textSystem, _resourceSystem);
+                            p.convert = GL::ImageConvert::create(_textSystem, _resourceSystem);
+                        }
 
                         const auto timeout = System::getTimerValue(System::TimerValue::VeryFast);
                         while (p.running)
@@ -635,26 +954,34 @@ namespace djv
                                         const Image::Info imageInfo(image->getSize(), imageType, imageLayout);
                                         auto tmp = Image::Data::create(imageInfo);
                                         tmp->setTags(image->getTags());
-                                        p.convert->process(*image, imageInfo, *tmp);
+                                        if (p.convert)
+                                        {
+                                            p.convert->process(*image, imageInfo, *tmp);
+                                        }
+                                        else
+                                        {
+                                            p.cpuConvert->process(*image, imageInfo, *tmp);
+                                        }
                                         image = tmp;
                                     }
-                                    futures.push_back(std::async(
-                                        std::launch::async,
-                                        [this, fileName, image]
+                                    const auto func = [this, fileName, image]
+                                    {
+                                        Future out;
+                                        out.fileName = fileName;
+                                        try
+                                        {
+                                            _write(fileName, image);
+                                        }
+                                        catch (const std::exception& e)
                                         {
-                                            Future out;
-                                            out.fileName = fileName;
-                                            try
-                                            {
-                                                _write(fileName, image);
-                                            }
-                                            catch (const std::exception& e)
-                                            {
-                                                out.error = true;
-                                                out.errorString = e.what();
-                                            }
-                                            return out;
-                                        }));
+                                            out.error = true;
+                                            out.errorString = e.what();
+                                        }
+                                        return out;
+                                    };
+                                    futures.push_back(_threadPool ?
+                                        _threadPool->submit(func) :
+                                        std::async(std::launch::async, func));
                                 }
                                 for (auto& future : futures)
                                 {
@@ -6,6 +6,10 @@
 
 #include <djvAV/IOPlugin.h>
 
+#include <djvSystem/ThreadPool.h>
+
+#include <functional>
+
 namespace djv
 {
     namespace AV
@@ -34,9 +38,48 @@ namespace djv
                 void seek(int64_t, Direction) override;
                 bool hasCache() const override;
 
+                //! This struct provides file read ahead statistics.
+                struct ReadAheadStats
+                {
+                    size_t willNeedCount = 0; //!< The total number of files hinted to be read ahead
+                    size_t dontNeedCount = 0; //!< The total number of files hinted to be released
+                };
+
+                //! Get the file read ahead statistics for all sequence readers.
+                static ReadAheadStats getReadAheadStats();
+
             protected:
                 virtual Info _readInfo(const std::string& fileName) = 0;
                 virtual std::shared_ptr<Image::Data> _readImage(const std::string& fileName) = 0;
+
+                //! This typedef provides a callback for asynchronous reads.
+                typedef std::function<void(const std::shared_ptr<Image::Data>&, const std::exception_ptr&)> ReadCallback;
+
+                //! Get whether images are read with the asynchronous I/O. These
+                //! readers can have more frames in flight than there are threads.
+                bool _hasAsyncRead() const;
+
+                //! Override this function for formats that can read their
+                //! image data directly with the asynchronous I/O.
+                virtual bool _canReadAsync() const;
+
+                //! Read an image asynchronously. The callback may be called
+                //! from another thread. The default implementation calls
+                //! _readImage().
+                virtual void _readImageAsync(const std::string& fileName, const ReadCallback&);
+
+                //! Read the image data from the current file position with the
+                //! asynchronous I/O. The function is applied to the image after
+                //! the data has been read, for example to convert the endian.
+                void _readDataAsync(
+                    const std::shared_ptr<System::File::IO>&,
+                    const std::shared_ptr<Image::Data>&,
+                    const std::function<void(Image::Data&)>&,
+                    const ReadCallback&);
+
+                //! Reduce an image to the proxy level if the format did not.
+                std::shared_ptr<Image::Data> _proxy(const std::shared_ptr<Image::Data>&) const;
+
                 void _finish();
 
                 Math::IntRational _speed;
@@ -46,9 +89,14 @@ namespace djv
                 bool _hasWork() const;
                 size_t _getQueueCount(size_t threadCount) const;
                 struct Future;
-                std::future<Future> _getFuture(Math::Frame::Number, std::string fileName);
+                std::future<Future> _getFuture(
+                    Math::Frame::Number,
+                    std::string fileName,
+                    System::ThreadPool::Priority,
+                    Core::UID group);
                 size_t _readQueue(size_t count, bool loop, bool cacheEnabled);
-                void _readCache(size_t count, const AV::IO::InOutPoints&);
+                void _readCache(size_t count);
+                void _readAhead(size_t count, bool loop, const InOutPoints&);
 
                 DJV_PRIVATE();
             };
@@ -67,6 +67,18 @@ namespace djv
                 private:
                     struct File;
                     Info _open(const std::string&, File&);
+                    void _readScanlines(
+                        const std::string&,
+                        File&,
+                        const Image::Info&,
+                        const Math::BBox2i&,
+                        Image::Data&);
+                    void _readBlocks(
+                        const std::string&,
+                        File&,
+                        const Image::Info&,
+                        const Math::BBox2i&,
+                        Image::Data&);
                 };
                 
                 //! This class provides the TIFF file writer.
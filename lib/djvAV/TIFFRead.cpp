@@ -4,13 +4,20 @@
 
 #include <djvAV/TIFF.h>
 
+#include <djvAV/IOFunc.h>
 #include <djvAV/TIFFFunc.h>
 
 #include <djvSystem/File.h>
 #include <djvSystem/FileIO.h>
 #include <djvSystem/TextSystem.h>
 
+#include <djvSystem/ThreadPool.h>
+
 #include <djvCore/StringFormat.h>
+#include <djvCore/UIDFunc.h>
+
+#include <atomic>
+#include <future>
 
 using namespace djv::Core;
 
@@ -33,10 +40,15 @@ namespace djv
                         }
                     }
 
-                    ::TIFF * f           = nullptr;
-                    bool     compression = false;
-                    bool     palette     = false;
-                    uint16 * colormap[3] = { nullptr, nullptr, nullptr };
+                    ::TIFF * f            = nullptr;
+                    bool     compression  = false;
+                    bool     palette      = false;
+                    uint16 * colormap[3]  = { nullptr, nullptr, nullptr };
+                    bool     contiguous   = true;
+                    bool     tiled        = false;
+                    uint32   rowsPerStrip = 0;
+                    uint32   tileWidth    = 0;
+                    uint32   tileHeight   = 0;
                 };
 
                 Read::Read()
@@ -70,11 +82,49 @@ namespace djv
                     std::shared_ptr<Image::Data> out;
                     File f;
                     const auto info = _open(fileName, f);
-                    out = Image::Data::create(info.video[0]);
+                    const auto& imageInfo = info.video[0];
+
+                    // Only the strips or tiles that cover the region of
+                    // interest are decoded. The region is flipped for images
+                    // that are not stored top to bottom.
+                    const Math::BBox2i roi = getROI(_options, imageInfo.size);
+                    Math::BBox2i bounds(0, 0, imageInfo.size.w, imageInfo.size.h);
+                    if (roi.isValid())
+                    {
+                        bounds = mirrorROI(imageInfo, roi);
+                        Image::Info roiInfo = imageInfo;
+                        roiInfo.size = Image::Size(roi.w(), roi.h());
+                        out = Image::Data::create(roiInfo);
+                        out->setOrigin(roi.min);
+                    }
+                    else
+                    {
+                        out = Image::Data::create(imageInfo);
+                    }
                     out->setPluginName(pluginName);
-                    for (uint16_t y = 0; y < info.video[0].size.h; ++y)
+                    if (f.contiguous)
                     {
-                        if (TIFFReadScanline(f.f, (tdata_t *)out->getData(y), y) == -1)
+                        _readBlocks(fileName, f, imageInfo, bounds, *out);
+                    }
+                    else
+                    {
+                        _readScanlines(fileName, f, imageInfo, bounds, *out);
+                    }
+                    return out;
+                }
+
+                void Read::_readScanlines(
+                    const std::string& fileName,
+                    File& f,
+                    const Image::Info& imageInfo,
+                    const Math::BBox2i& bounds,
+                    Image::Data& out)
+                {
+                    const size_t pixelByteCount = imageInfo.getPixelByteCount();
+                    std::vector<uint8_t> buf(imageInfo.getScanlineByteCount());
+                    for (uint16_t y = 0; y < out.getHeight(); ++y)
+                    {
+                        if (TIFFReadScanline(f.f, (tdata_t *)buf.data(), bounds.min.y + y) == -1)
                         {
                             throw System::File::Error(String::Format("{0}: {1}").
                                 arg(fileName).
@@ -83,13 +133,140 @@ namespace djv
                         if (f.palette)
                         {
                             readPalette(
-                                out->getData(y),
-                                info.video[0].size.w,
-                                static_cast<int>(Image::getChannelCount(info.video[0].type)),
+                                buf.data(),
+                                imageInfo.size.w,
+                                static_cast<int>(Image::getChannelCount(imageInfo.type)),
                                 f.colormap[0], f.colormap[1], f.colormap[2]);
                         }
+                        memcpy(out.getData(y), buf.data() + bounds.min.x * pixelByteCount, out.getWidth() * pixelByteCount);
+                    }
+                }
+
+                void Read::_readBlocks(
+                    const std::string& fileName,
+                    File& f,
+                    const Image::Info& imageInfo,
+                    const Math::BBox2i& bounds,
+                    Image::Data& out)
+                {
+                    // Get the strips or tiles that intersect the bounds. Strips
+                    // are handled as tiles that are the width of the image.
+                    const uint32 blockWidth = f.tiled ? f.tileWidth : imageInfo.size.w;
+                    const uint32 blockHeight = f.tiled ? f.tileHeight : std::min(f.rowsPerStrip, static_cast<uint32>(imageInfo.size.h));
+                    std::vector<Math::BBox2i> blocks;
+                    for (int y = bounds.min.y / blockHeight * blockHeight; y <= bounds.max.y; y += blockHeight)
+                    {
+                        for (int x = bounds.min.x / blockWidth * blockWidth; x <= bounds.max.x; x += blockWidth)
+                        {
+                            blocks.push_back(Math::BBox2i(x, y, blockWidth, blockHeight));
+                        }
+                    }
+
+                    // The blocks are decoded in parallel. Each thread needs its
+                    // own TIFF handle since a handle can only be used by one
+                    // thread at a time.
+                    const size_t pixelByteCount = imageInfo.getPixelByteCount();
+                    const int channelCount = static_cast<int>(Image::getChannelCount(imageInfo.type));
+                    std::atomic<size_t> block(0);
+                    const auto work = [&](::TIFF* tiff)
+                    {
+                        std::vector<uint8_t> buf(f.tiled ? TIFFTileSize(tiff) : TIFFStripSize(tiff));
+                        std::vector<uint8_t> paletteBuf(f.palette ? blockWidth * pixelByteCount : 0);
+                        const size_t rowByteCount = f.tiled ? TIFFTileRowSize(tiff) : TIFFScanlineSize(tiff);
+                        const size_t sourcePixelByteCount = rowByteCount / blockWidth;
+                        size_t i = 0;
+                        while ((i = block++) < blocks.size())
+                        {
+                            const Math::BBox2i& b = blocks[i];
+                            const tsize_t size = f.tiled ?
+                                TIFFReadEncodedTile(tiff, TIFFComputeTile(tiff, b.min.x, b.min.y, 0, 0), buf.data(), -1) :
+                                TIFFReadEncodedStrip(tiff, TIFFComputeStrip(tiff, b.min.y, 0), buf.data(), -1);
+                            if (-1 == size)
+                            {
+                                throw System::File::Error(String::Format("{0}: {1}").
+                                    arg(fileName).
+                                    arg(_textSystem->getText(DJV_TEXT("error_read_scanline"))));
+                            }
+                            const Math::BBox2i intersect = b.intersect(bounds);
+                            const size_t w = intersect.w();
+                            for (int y = intersect.min.y; y <= intersect.max.y; ++y)
+                            {
+                                const uint8_t* p = buf.data() +
+                                    (y - b.min.y) * rowByteCount +
+                                    (intersect.min.x - b.min.x) * sourcePixelByteCount;
+                                uint8_t* outP = out.getData(intersect.min.x - bounds.min.x, y - bounds.min.y);
+                                if (f.palette)
+                                {
+                                    memcpy(paletteBuf.data(), p, w * sourcePixelByteCount);
+                                    readPalette(
+                                        paletteBuf.data(),
+                                        static_cast<int>(w),
+                                        channelCount,
+                                        f.colormap[0], f.colormap[1], f.colormap[2]);
+                                    p = paletteBuf.data();
+                                }
+                                memcpy(outP, p, w * pixelByteCount);
+                            }
+                        }
+                    };
+
+                    // The calling thread also does the work, so the jobs that
+                    // have not started when it finishes are cancelled rather
+                    // than waited on.
+                    std::vector<std::future<void> > futures;
+                    const UID group = createUID();
+                    if (_threadPool && f.compression && blocks.size() > 1)
+                    {
+                        const size_t jobCount = std::min(_threadPool->getThreadCount(), blocks.size() - 1);
+                        for (size_t i = 0; i < jobCount; ++i)
+                        {
+                            futures.push_back(_threadPool->submit(
+                                [this, &fileName, &work]
+                                {
+                                    File jobFile;
+                                    jobFile.f = TIFFOpen(fileName.data(), "r");
+                                    if (!jobFile.f)
+                                    {
+                                        throw System::File::Error(String::Format("{0}: {1}").
+                                            arg(fileName).
+                                            arg(_textSystem->getText(DJV_TEXT("error_file_open"))));
+                                    }
+                                    work(jobFile.f);
+                                },
+                                System::ThreadPool::Priority::High,
+                                group));
+                        }
+                    }
+                    std::exception_ptr error;
+                    try
+                    {
+                        work(f.f);
+                    }
+                    catch (const std::exception&)
+                    {
+                        error = std::current_exception();
+                    }
+                    if (_threadPool)
+                    {
+                        _threadPool->cancel(group);
+                    }
+                    for (auto& future : futures)
+                    {
+                        try
+                        {
+                            future.get();
+                        }
+                        catch (const std::future_error&)
+                        {}
+                        catch (const std::exception&)
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+                    if (error)
+                    {
+                        std::rethrow_exception(error);
                     }
-                    return out;
                 }
 
                 Info Read::_open(const std::string& fileName, File& f)
@@ -168,6 +345,24 @@ namespace djv
 
                     f.compression = compression != COMPRESSION_NONE;
                     f.palette = PHOTOMETRIC_PALETTE == photometric;
+                    f.contiguous = channels != PLANARCONFIG_SEPARATE;
+                    f.tiled = TIFFIsTiled(f.f) != 0;
+                    if (f.tiled)
+                    {
+                        TIFFGetFieldDefaulted(f.f, TIFFTAG_TILEWIDTH, &f.tileWidth);
+                        TIFFGetFieldDefaulted(f.f, TIFFTAG_TILELENGTH, &f.tileHeight);
+                        if (!f.tileWidth || !f.tileHeight)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(fileName).
+                                arg(_textSystem->getText(DJV_TEXT("error_unsupported_image_type"))));
+                        }
+                    }
+                    else
+                    {
+                        TIFFGetFieldDefaulted(f.f, TIFFTAG_ROWSPERSTRIP, &f.rowsPerStrip);
+                        f.rowsPerStrip = std::max(f.rowsPerStrip, static_cast<uint32>(1));
+                    }
 
                     Image::Tags tags;
                     char * tag = 0;
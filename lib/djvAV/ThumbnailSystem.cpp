@@ -4,10 +4,13 @@
 
 #include <djvAV/ThumbnailSystem.h>
 
+#include <djvAV/IOFunc.h>
 #include <djvAV/IOSystem.h>
 
+#include <djvGL/GLFWSystem.h>
 #include <djvGL/ImageConvert.h>
 
+#include <djvImage/Convert.h>
 #include <djvImage/Data.h>
 
 #include <djvSystem/Context.h>
@@ -177,6 +180,7 @@ namespace djv
             std::shared_ptr<Observer::Value<bool> > ioOptionsObserver;
 
             GLFWwindow * glfwWindow = nullptr;
+            std::shared_ptr<Image::Convert> cpuConvert;
             std::shared_ptr<System::Timer> statsTimer;
             std::thread thread;
             std::atomic<bool> running;
@@ -198,26 +202,35 @@ namespace djv
             p.imageCachePercentage = 0.F;
             p.clearCache = false;
 
+            if (auto glfwSystem = context->getSystemT<GL::GLFW::GLFWSystem>())
+            {
+                addDependency(glfwSystem);
 #if defined(DJV_GL_ES2)
-            glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+                glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
 #else // DJV_GL_ES2
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+                glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+                glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #endif // DJV_GL_ES2
-            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-            int env = 0;
-            if (OS::getIntEnv("DJV_GL_DEBUG", env) && env != 0)
-            {
-                glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+                int env = 0;
+                if (OS::getIntEnv("DJV_GL_DEBUG", env) && env != 0)
+                {
+                    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                }
+                p.glfwWindow = glfwCreateWindow(100, 100, context->getName().c_str(), NULL, NULL);
+                if (!p.glfwWindow)
+                {
+                    _log(p.textSystem->getText(DJV_TEXT("error_glfw_window_creation")), System::LogLevel::Warning);
+                }
             }
-            p.glfwWindow = glfwCreateWindow(100, 100, context->getName().c_str(), NULL, NULL);
             if (!p.glfwWindow)
             {
-                throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
+                // Without an OpenGL context the thumbnails are converted on the CPU.
+                p.cpuConvert = Image::Convert::create(p.io->getThreadPool());
             }
 
             p.statsTimer = System::Timer::create(context);
@@ -244,17 +257,21 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 try
                 {
-                    glfwMakeContextCurrent(p.glfwWindow);
+                    std::shared_ptr<GL::ImageConvert> convert;
+                    if (p.glfwWindow)
+                    {
+                        glfwMakeContextCurrent(p.glfwWindow);
 #if defined(DJV_GL_ES2)
-                    if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
+                        if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
 #else // DJV_GL_ES2
-                    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+                        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
 #endif // DJV_GL_ES2
-                    {
-                        throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glad_init")));
-                    }
+                        {
+                            throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glad_init")));
+                        }
 
-                    auto convert = GL::ImageConvert::create(p.textSystem, resourceSystem);
+                        convert = GL::ImageConvert::create(p.textSystem, resourceSystem);
+                    }
 
                     const auto timeout = System::getTimerValue(System::TimerValue::Medium);
                     while (p.running)
@@ -547,7 +564,15 @@ namespace djv
                 {
                     try
                     {
-                        i.read = p.io->read(i.fileInfo);
+                        // Use a proxy level if the information for the file
+                        // is already known.
+                        IO::ReadOptions options;
+                        IO::Info cachedInfo;
+                        if (p.infoCache.get(getInfoCacheKey(i.fileInfo), cachedInfo) && cachedInfo.video.size() > 0)
+                        {
+                            options.proxy = IO::getProxy(cachedInfo.video[0].size, i.size);
+                        }
+                        i.read = p.io->read(i.fileInfo, options);
                         const auto info = i.read->getInfo().get();
                         if (info.video.size() > 0)
                         {
@@ -617,7 +642,14 @@ namespace djv
                             auto tmp = Image::Data::create(info);
                             tmp->setPluginName(image->getPluginName());
                             tmp->setTags(image->getTags());
-                            convert->process(*image, info, *tmp);
+                            if (convert)
+                            {
+                                convert->process(*image, info, *tmp);
+                            }
+                            else
+                            {
+                                p.cpuConvert->process(*image, info, *tmp);
+                            }
                             image = tmp;
                         }
                         p.imageCache.add(getImageCacheKey(i->fileInfo, i->size, i->type), image);
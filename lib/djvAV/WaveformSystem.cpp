@@ -0,0 +1,403 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/WaveformSystem.h>
+
+#include <djvAV/IOFunc.h>
+#include <djvAV/IOSystem.h>
+
+#include <djvAudio/Data.h>
+#include <djvAudio/Waveform.h>
+
+#include <djvSystem/Context.h>
+#include <djvSystem/FileInfo.h>
+#include <djvSystem/LogSystem.h>
+#include <djvSystem/PathFunc.h>
+#include <djvSystem/ResourceSystem.h>
+#include <djvSystem/TimerFunc.h>
+
+#include <djvCore/Cache.h>
+#include <djvCore/UIDFunc.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const size_t processMax = 2;
+            const size_t cacheMax   = 100;
+
+            //! The audio queue is large so that the decoder does not wait on
+            //! the system to drain it.
+            const size_t audioQueueSize = 1000;
+
+            struct Request
+            {
+                Request() :
+                    uid(createUID())
+                {}
+
+                Request(Request&& other) noexcept :
+                    uid(other.uid),
+                    fileInfo(other.fileInfo),
+                    read(std::move(other.read)),
+                    waveform(std::move(other.waveform)),
+                    promise(std::move(other.promise))
+                {}
+
+                ~Request()
+                {}
+
+                Request& operator = (Request&& other) noexcept
+                {
+                    if (this != &other)
+                    {
+                        uid = other.uid;
+                        fileInfo = other.fileInfo;
+                        read = std::move(other.read);
+                        waveform = std::move(other.waveform);
+                        promise = std::move(other.promise);
+                    }
+                    return *this;
+                }
+
+                UID uid = 0;
+                System::File::Info fileInfo;
+                std::shared_ptr<IO::IRead> read;
+                std::shared_ptr<Audio::Waveform> waveform;
+                std::promise<std::shared_ptr<Audio::Waveform> > promise;
+            };
+
+            //! The key includes the modification time and size of the file,
+            //! like the disk cache.
+            size_t getCacheKey(const System::File::Info& fileInfo)
+            {
+                size_t out = 0;
+                Memory::hashCombine(out, Audio::Waveform::getCacheFileName(fileInfo));
+                return out;
+            }
+
+        } // namespace
+
+        WaveformSystem::WaveformFuture::WaveformFuture()
+        {}
+
+        WaveformSystem::WaveformFuture::WaveformFuture(std::future<std::shared_ptr<Audio::Waveform> >& future, UID uid) :
+            future(std::move(future)),
+            uid(uid)
+        {}
+
+        struct WaveformSystem::Private
+        {
+            std::shared_ptr<IO::IOSystem> io;
+            System::File::Path cachePath;
+
+            std::list<Request> requests;
+            std::condition_variable requestCV;
+            std::mutex requestMutex;
+            std::set<UID> cancelledRequests;
+            std::list<Request> pendingRequests;
+
+            Memory::Cache<size_t, std::shared_ptr<Audio::Waveform> > cache;
+            std::atomic<bool> clearCache;
+
+            std::thread thread;
+            std::atomic<bool> running;
+        };
+
+        void WaveformSystem::_init(const std::shared_ptr<System::Context>& context)
+        {
+            ISystem::_init("djv::AV::WaveformSystem", context);
+
+            DJV_PRIVATE_PTR();
+
+            p.io = context->getSystemT<IO::IOSystem>();
+            addDependency(p.io);
+
+            auto resourceSystem = context->getSystemT<System::ResourceSystem>();
+            p.cachePath = System::File::Path(
+                resourceSystem->getPath(System::File::ResourcePath::Documents),
+                "Waveform");
+
+            p.cache.setMax(cacheMax);
+            p.clearCache = false;
+
+            auto logSystem = context->getSystemT<System::LogSystem>();
+            p.running = true;
+            p.thread = std::thread(
+                [this, logSystem]
+            {
+                DJV_PRIVATE_PTR();
+                try
+                {
+                    while (p.running)
+                    {
+                        if (p.clearCache)
+                        {
+                            p.clearCache = false;
+                            p.cache.clear();
+                        }
+
+                        // Drain the pending requests quickly so the decoders
+                        // are not stalled.
+                        const auto timeout = System::getTimerValue(p.pendingRequests.size() ?
+                            System::TimerValue::VeryFast :
+                            System::TimerValue::Medium);
+                        bool requests = p.pendingRequests.size();
+                        {
+                            std::unique_lock<std::mutex> lock(p.requestMutex);
+                            if (p.requestCV.wait_for(
+                                lock,
+                                std::chrono::milliseconds(timeout),
+                                [this]
+                            {
+                                return _p->requests.size();
+                            }))
+                            {
+                                requests = true;
+                            }
+                        }
+                        if (requests)
+                        {
+                            _handleRequests();
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    logSystem->log("djv::AV::WaveformSystem", e.what(), System::LogLevel::Error);
+                }
+            });
+
+            _logInitTime();
+        }
+
+        WaveformSystem::WaveformSystem() :
+            _p(new Private)
+        {}
+
+        WaveformSystem::~WaveformSystem()
+        {
+            DJV_PRIVATE_PTR();
+            p.running = false;
+            if (p.thread.joinable())
+            {
+                p.thread.join();
+            }
+        }
+
+        std::shared_ptr<WaveformSystem> WaveformSystem::create(const std::shared_ptr<System::Context>& context)
+        {
+            auto out = context->getSystemT<WaveformSystem>();
+            if (!out)
+            {
+                out = std::shared_ptr<WaveformSystem>(new WaveformSystem);
+                out->_init(context);
+            }
+            return out;
+        }
+
+        WaveformSystem::WaveformFuture WaveformSystem::getWaveform(const System::File::Info& fileInfo)
+        {
+            DJV_PRIVATE_PTR();
+            Request request;
+            request.fileInfo = fileInfo;
+            auto future = request.promise.get_future();
+            const UID uid = request.uid;
+            {
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                p.requests.push_back(std::move(request));
+            }
+            p.requestCV.notify_one();
+            return WaveformFuture(future, uid);
+        }
+
+        void WaveformSystem::cancelWaveform(UID uid)
+        {
+            DJV_PRIVATE_PTR();
+            {
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                const auto i = std::find_if(
+                    p.requests.rbegin(),
+                    p.requests.rend(),
+                    [uid](const Request& value)
+                {
+                    return value.uid == uid;
+                });
+                if (i != p.requests.rend())
+                {
+                    p.requests.erase(--(i.base()));
+                }
+                else
+                {
+                    // The request may already be decoding, it is removed
+                    // by the thread.
+                    p.cancelledRequests.insert(uid);
+                }
+            }
+        }
+
+        void WaveformSystem::clearCache()
+        {
+            _p->clearCache = true;
+        }
+
+        void WaveformSystem::_handleRequests()
+        {
+            DJV_PRIVATE_PTR();
+
+            // Process new requests.
+            while (p.pendingRequests.size() < processMax)
+            {
+                Request i;
+                {
+                    std::unique_lock<std::mutex> lock(p.requestMutex);
+                    if (p.requests.size())
+                    {
+                        i = std::move(p.requests.front());
+                        p.requests.pop_front();
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+                const System::File::Info fileInfo(i.fileInfo.getFileName());
+                const auto key = getCacheKey(fileInfo);
+                std::shared_ptr<Audio::Waveform> waveform;
+                p.cache.get(key, waveform);
+                if (waveform)
+                {
+                    i.promise.set_value(waveform);
+                    continue;
+                }
+                try
+                {
+                    // Use the disk cache if it is still valid.
+                    try
+                    {
+                        waveform = std::make_shared<Audio::Waveform>();
+                        waveform->read(
+                            System::File::Path(p.cachePath, Audio::Waveform::getCacheFileName(fileInfo)).get(),
+                            fileInfo,
+                            _getTextSystem());
+                        p.cache.add(key, waveform);
+                        i.promise.set_value(waveform);
+                        continue;
+                    }
+                    catch (const std::exception&)
+                    {}
+
+                    // Decode the audio without the video.
+                    IO::ReadOptions options;
+                    options.video = false;
+                    options.audioQueueSize = audioQueueSize;
+                    options.audioOutput = Audio::Info(0, Audio::Type::F32, 0);
+                    i.read = p.io->read(i.fileInfo, options);
+                    const auto info = i.read->getInfo().get();
+                    const auto audioInfo = IO::getAudioOutputInfo(info.audio, options.audioOutput);
+                    if (audioInfo.isValid())
+                    {
+                        i.waveform = std::make_shared<Audio::Waveform>(audioInfo.sampleRate);
+                        p.pendingRequests.push_back(std::move(i));
+                    }
+                    else
+                    {
+                        i.promise.set_value(nullptr);
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    try
+                    {
+                        i.promise.set_exception(std::current_exception());
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(e.what(), System::LogLevel::Error);
+                    }
+                }
+            }
+
+            // Remove cancelled requests.
+            std::set<UID> cancelledRequests;
+            {
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                cancelledRequests = std::move(p.cancelledRequests);
+                p.cancelledRequests.clear();
+            }
+            if (cancelledRequests.size())
+            {
+                p.pendingRequests.remove_if(
+                    [&cancelledRequests](const Request& value)
+                {
+                    return cancelledRequests.find(value.uid) != cancelledRequests.end();
+                });
+            }
+
+            // Process pending requests.
+            auto i = p.pendingRequests.begin();
+            while (i != p.pendingRequests.end())
+            {
+                std::vector<std::shared_ptr<Audio::Data> > data;
+                bool finished = false;
+                {
+                    std::lock_guard<std::mutex> lock(i->read->getMutex());
+                    auto& queue = i->read->getAudioQueue();
+                    while (!queue.isEmpty())
+                    {
+                        data.push_back(queue.popFrame().data);
+                    }
+                    finished = queue.isFinished();
+                }
+                for (const auto& j : data)
+                {
+                    if (j)
+                    {
+                        i->waveform->add(*j);
+                    }
+                }
+                if (finished)
+                {
+                    i->waveform->finish();
+                    const System::File::Info fileInfo(i->fileInfo.getFileName());
+                    try
+                    {
+                        if (!System::File::Info(p.cachePath).doesExist())
+                        {
+                            System::File::mkdir(p.cachePath);
+                        }
+                        i->waveform->write(
+                            System::File::Path(p.cachePath, Audio::Waveform::getCacheFileName(fileInfo)).get(),
+                            fileInfo);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(e.what(), System::LogLevel::Warning);
+                    }
+                    p.cache.add(getCacheKey(fileInfo), i->waveform);
+                    i->promise.set_value(i->waveform);
+                    i = p.pendingRequests.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+
+    } // namespace AV
+} // namespace djv
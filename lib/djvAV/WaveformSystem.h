@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvSystem/ISystem.h>
+
+#include <djvCore/UID.h>
+
+#include <future>
+
+namespace djv
+{
+    namespace System
+    {
+        namespace File
+        {
+            class Info;
+
+        } // namespace File
+    } // namespace System
+
+    namespace Audio
+    {
+        class Waveform;
+
+    } // namespace Audio
+
+    namespace AV
+    {
+        //! This class provides a system for building audio waveforms from
+        //! files. The audio is decoded in the background without the video,
+        //! and the waveforms are cached in memory and on disk.
+        class WaveformSystem : public System::ISystem
+        {
+            DJV_NON_COPYABLE(WaveformSystem);
+
+        protected:
+            void _init(const std::shared_ptr<System::Context>&);
+            WaveformSystem();
+
+        public:
+            ~WaveformSystem() override;
+
+            //! Create a new waveform system.
+            static std::shared_ptr<WaveformSystem> create(const std::shared_ptr<System::Context>&);
+
+            //! This structure provides a waveform. The waveform is null if
+            //! the file does not have audio.
+            struct WaveformFuture
+            {
+                WaveformFuture();
+                WaveformFuture(std::future<std::shared_ptr<Audio::Waveform> >&, Core::UID);
+                std::future<std::shared_ptr<Audio::Waveform> > future;
+                Core::UID uid = 0;
+            };
+
+            //! Get the waveform of a file.
+            WaveformFuture getWaveform(const System::File::Info&);
+
+            //! Cancel a waveform.
+            void cancelWaveform(Core::UID);
+
+            //! Clear the memory cache.
+            void clearCache();
+
+        private:
+            void _handleRequests();
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace AV
+} // namespace djv
@@ -17,6 +17,7 @@
 
 #include <rtaudio/RtAudio.h>
 
+#include <algorithm>
 #include <sstream>
 
 using namespace djv::Core;
@@ -246,6 +247,47 @@ namespace djv
             return out;
         }
 
+        Info AudioSystem::getDefaultOutputInfo()
+        {
+            DJV_PRIVATE_PTR();
+            Info out;
+            if (p.rtAudio)
+            {
+                try
+                {
+                    const RtAudio::DeviceInfo rtInfo = p.rtAudio->getDeviceInfo(getDefaultOutputDevice());
+                    if (rtInfo.probed && rtInfo.outputChannels > 0)
+                    {
+                        out.channelCount = static_cast<uint8_t>(std::min(rtInfo.outputChannels, 255U));
+                        out.sampleRate = rtInfo.preferredSampleRate;
+                        // RtAudio converts formats that are not native, so
+                        // fall back to floating point.
+                        if (rtInfo.nativeFormats & RTAUDIO_FLOAT32)
+                        {
+                            out.type = Type::F32;
+                        }
+                        else if (rtInfo.nativeFormats & RTAUDIO_SINT32)
+                        {
+                            out.type = Type::S32;
+                        }
+                        else if (rtInfo.nativeFormats & RTAUDIO_SINT16)
+                        {
+                            out.type = Type::S16;
+                        }
+                        else
+                        {
+                            out.type = Type::F32;
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), System::LogLevel::Error);
+                }
+            }
+            return out;
+        }
+
     } // namespace Audio
 } // namespace djv
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <djvAudio/Info.h>
+
 #include <djvSystem/ISystem.h>
 
 namespace djv
@@ -54,6 +56,12 @@ namespace djv
             unsigned int getDefaultInputDevice();
             unsigned int getDefaultOutputDevice();
 
+            //! Get the native format of the default output device: the
+            //! preferred sample rate, the output channel count, and a
+            //! native sample type. The information is not valid if there is
+            //! no output device.
+            Info getDefaultOutputInfo();
+
         private:
             DJV_PRIVATE();
         };
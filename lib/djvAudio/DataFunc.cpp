@@ -6,34 +6,798 @@
 
 #include <djvAudio/Data.h>
 
+#include <djvMath/MathFunc.h>
+
+#include <algorithm>
 #include <cstring>
+#include <limits>
 
-#define _CONVERT(a, b) \
-    { \
-        const a##_T * inP = reinterpret_cast<const a##_T *>(data->getData()); \
-        b##_T * outP = reinterpret_cast<b##_T *>(out->getData()); \
-        for (size_t i = 0; i < sampleCount * channelCount; ++i, ++inP, ++outP) \
-        { \
-            a##To##b(*inP, *outP); \
-        } \
-    }
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define DJV_AUDIO_X86
+#include <immintrin.h>
+#endif // __x86_64__
 
-#define _VOLUME(t) \
+// The SIMD kernels are compiled for their instruction sets with function
+// attributes so that the rest of the library does not require them.
+#if defined(__GNUC__) || defined(__clang__)
+#define DJV_AUDIO_SSE41 __attribute__((target("sse4.1")))
+#define DJV_AUDIO_AVX2 __attribute__((target("avx2,fma")))
+#else // __GNUC__
+#define DJV_AUDIO_SSE41
+#define DJV_AUDIO_AVX2
+#endif // __GNUC__
+
+#define _CONVERT(a, b, kernel) \
+    _convert<kernel##Kernel, a##_T, b##_T, a##To##b>( \
+        data->getData(), \
+        out->getData(), \
+        sampleCount * channelCount, \
+        simd)
+
+#define _REDUCE(t) \
     { \
         const t##_T* inP = reinterpret_cast<const t##_T*>(in); \
-        t##_T* outP = reinterpret_cast<t##_T*>(out); \
-        t##_T* const endP = outP + sampleCount * channelCount; \
-        for (; outP < endP; ++inP, ++outP) \
+        const t##_T* const endP = inP + sampleCount * channelCount; \
+        for (; inP < endP; ++inP) \
         { \
-            *outP = *inP * volume; \
+            F32_T v = 0.F; \
+            t##ToF32(*inP, v); \
+            min = std::min(min, v); \
+            max = std::max(max, v); \
+            sumSquares += v * v; \
         } \
     }
 
+#define _VOLUME(t) \
+    _volume<t##_T>(in, out, volume, sampleCount * channelCount, simd)
+
 namespace djv
 {
     namespace Audio
     {
-        void volume(const uint8_t* in, uint8_t* out, float volume, size_t sampleCount, uint8_t channelCount, Type type)
+        namespace
+        {
+            // The kernels process as many samples as fit in their registers
+            // and return the number processed, the rest are processed with
+            // the scalar code.
+            template<typename T>
+            struct VolumeKernel;
+            template<typename A, typename B>
+            struct IntToIntKernel;
+            template<typename A, typename B>
+            struct IntToF32Kernel;
+            template<typename A, typename B>
+            struct IntToF64Kernel;
+            template<typename A, typename B>
+            struct F32ToIntKernel;
+            template<typename A, typename B>
+            struct F64ToIntKernel;
+            template<typename A, typename B>
+            struct F32ToF64Kernel;
+            template<typename A, typename B>
+            struct F64ToF32Kernel;
+
+#if defined(DJV_AUDIO_X86)
+            //! \name SSE4.1
+            ///@{
+
+            // Integer samples are loaded into and stored from 32-bit lanes.
+            DJV_AUDIO_SSE41 inline __m128i loadSSE41(const S8_T* p)
+            {
+                int32_t v = 0;
+                memcpy(&v, p, sizeof(int32_t));
+                return _mm_cvtepi8_epi32(_mm_cvtsi32_si128(v));
+            }
+
+            DJV_AUDIO_SSE41 inline __m128i loadSSE41(const S16_T* p)
+            {
+                return _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+            }
+
+            DJV_AUDIO_SSE41 inline __m128i loadSSE41(const S32_T* p)
+            {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            }
+
+            DJV_AUDIO_SSE41 inline void storeSSE41(S8_T* p, __m128i v)
+            {
+                const __m128i s16 = _mm_packs_epi32(v, v);
+                const int32_t s8 = _mm_cvtsi128_si32(_mm_packs_epi16(s16, s16));
+                memcpy(p, &s8, sizeof(int32_t));
+            }
+
+            DJV_AUDIO_SSE41 inline void storeSSE41(S16_T* p, __m128i v)
+            {
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(v, v));
+            }
+
+            DJV_AUDIO_SSE41 inline void storeSSE41(S32_T* p, __m128i v)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+            }
+
+            DJV_AUDIO_SSE41 inline void toF64SSE41(__m128i v, __m128d& lo, __m128d& hi)
+            {
+                lo = _mm_cvtepi32_pd(v);
+                hi = _mm_cvtepi32_pd(_mm_unpackhi_epi64(v, v));
+            }
+
+            DJV_AUDIO_SSE41 inline __m128i fromF64SSE41(__m128d lo, __m128d hi)
+            {
+                return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+            }
+
+            ///@}
+
+            //! \name AVX2
+            ///@{
+
+            DJV_AUDIO_AVX2 inline __m256i loadAVX2(const S8_T* p)
+            {
+                return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+            }
+
+            DJV_AUDIO_AVX2 inline __m256i loadAVX2(const S16_T* p)
+            {
+                return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+            }
+
+            DJV_AUDIO_AVX2 inline __m256i loadAVX2(const S32_T* p)
+            {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            }
+
+            DJV_AUDIO_AVX2 inline void storeAVX2(S8_T* p, __m256i v)
+            {
+                const __m128i s16 = _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packs_epi16(s16, s16));
+            }
+
+            DJV_AUDIO_AVX2 inline void storeAVX2(S16_T* p, __m256i v)
+            {
+                _mm_storeu_si128(
+                    reinterpret_cast<__m128i*>(p),
+                    _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+            }
+
+            DJV_AUDIO_AVX2 inline void storeAVX2(S32_T* p, __m256i v)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+            }
+
+            DJV_AUDIO_AVX2 inline void toF64AVX2(__m256i v, __m256d& lo, __m256d& hi)
+            {
+                lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(v));
+                hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1));
+            }
+
+            DJV_AUDIO_AVX2 inline __m256i fromF64AVX2(__m256d lo, __m256d hi)
+            {
+                return _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm256_cvttpd_epi32(lo)),
+                    _mm256_cvttpd_epi32(hi),
+                    1);
+            }
+
+            ///@}
+
+            //! \name Volume
+            ///@{
+
+            // 8-bit and 16-bit samples are scaled in single precision and
+            // saturated to the range of the type.
+            template<typename T>
+            struct VolumeKernel
+            {
+                static DJV_AUDIO_SSE41 size_t sse41(const T* in, T* out, float volume, size_t count)
+                {
+                    const __m128 v = _mm_set1_ps(volume);
+                    const __m128 min = _mm_set1_ps(static_cast<float>(std::numeric_limits<T>::min()));
+                    const __m128 max = _mm_set1_ps(static_cast<float>(std::numeric_limits<T>::max()));
+                    size_t i = 0;
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        const __m128 f = _mm_mul_ps(_mm_cvtepi32_ps(loadSSE41(in + i)), v);
+                        storeSSE41(out + i, _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(f, min), max)));
+                    }
+                    return i;
+                }
+
+                static DJV_AUDIO_AVX2 size_t avx2(const T* in, T* out, float volume, size_t count)
+                {
+                    const __m256 v = _mm256_set1_ps(volume);
+                    const __m256 min = _mm256_set1_ps(static_cast<float>(std::numeric_limits<T>::min()));
+                    const __m256 max = _mm256_set1_ps(static_cast<float>(std::numeric_limits<T>::max()));
+                    size_t i = 0;
+                    for (; i + 8 <= count; i += 8)
+                    {
+                        const __m256 f = _mm256_mul_ps(_mm256_cvtepi32_ps(loadAVX2(in + i)), v);
+                        storeAVX2(out + i, _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(f, min), max)));
+                    }
+                    return i;
+                }
+            };
+
+            // 32-bit samples are scaled in double precision so that they do
+            // not lose precision.
+            template<>
+            struct VolumeKernel<S32_T>
+            {
+                static DJV_AUDIO_SSE41 size_t sse41(const S32_T* in, S32_T* out, float volume, size_t count)
+                {
+                    const __m128d v = _mm_set1_pd(volume);
+                    const __m128d min = _mm_set1_pd(S32Range.getMin());
+                    const __m128d max = _mm_set1_pd(S32Range.getMax());
+                    size_t i = 0;
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        __m128d lo;
+                        __m128d hi;
+                        toF64SSE41(loadSSE41(in + i), lo, hi);
+                        lo = _mm_min_pd(_mm_max_pd(_mm_mul_pd(lo, v), min), max);
+                        hi = _mm_min_pd(_mm_max_pd(_mm_mul_pd(hi, v), min), max);
+                        storeSSE41(out + i, fromF64SSE41(lo, hi));
+                    }
+                    return i;
+                }
+
+                static DJV_AUDIO_AVX2 size_t avx2(const S32_T* in, S32_T* out, float volume, size_t count)
+                {
+                    const __m256d v = _mm256_set1_pd(volume);
+                    const __m256d min = _mm256_set1_pd(S32Range.getMin());
+                    const __m256d max = _mm256_set1_pd(S32Range.getMax());
+                    size_t i = 0;
+                    for (; i + 8 <= count; i += 8)
+                    {
+                        __m256d lo;
+                        __m256d hi;
+                        toF64AVX2(loadAVX2(in + i), lo, hi);
+                        lo = _mm256_min_pd(_mm256_max_pd(_mm256_mul_pd(lo, v), min), max);
+                        hi = _mm256_min_pd(_mm256_max_pd(_mm256_mul_pd(hi, v), min), max);
+                        storeAVX2(out + i, fromF64AVX2(lo, hi));
+                    }
+                    return i;
+                }
+            };
+
+            template<>
+            struct VolumeKernel<F32_T>
+            {
+                static DJV_AUDIO_SSE41 size_t sse41(const F32_T* in, F32_T* out, float volume, size_t count)
+                {
+                    const __m128 v = _mm_set1_ps(volume);
+                    size_t i = 0;
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), v));
+                    }
+                    return i;
+                }
+
+                static DJV_AUDIO_AVX2 size_t avx2(const F32_T* in, F32_T* out, float volume, size_t count)
+                {
+                    const __m256 v = _mm256_set1_ps(volume);
+                    size_t i = 0;
+                    for (; i + 8 <= count; i += 8)
+                    {
+                        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(in + i), v));
+                    }
+                    return i;
+                }
+            };
+
+            template<>
+            struct VolumeKernel<F64_T>
+            {
+                static DJV_AUDIO_SSE41 size_t sse41(const F64_T* in, F64_T* out, float volume, size_t count)
+                {
+                    const __m128d v = _mm_set1_pd(volume);
+                    size_t i = 0;
+                    for (; i + 2 <= count; i += 2)
+                    {
+                        _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(in + i), v));
+                    }
+                    return i;
+                }
+
+                static DJV_AUDIO_AVX2 size_t avx2(const F64_T* in, F64_T* out, float volume, size_t count)
+                {
+                    const __m256d v = _mm256_set1_pd(volume);
+                    size_t i = 0;
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(in + i), v));
+                    }
+                    return i;
+                }
+            };
+
+            ///@}
+
+            //! \name Conversion
+            ///@{
+
+            // Integer samples are shifted, rounding towards zero like the
+            // division in the scalar code.
+            template<typename A, typename B>
+            struct IntToIntKernel
+            {
+                static DJV_AUDIO_SSE41 size_t sse41(const A* in, B* out, size_t count)
+                {
+                    const int shift = 8 * (static_cast<int>(sizeof(B)) - static_cast<int>(sizeof(A)));
+                    const __m128i left = _mm_cvtsi32_si128(shift > 0 ? shift : 0);
+                    const __m128i right = _mm_cvtsi32_si128(shift < 0 ? -shift : 0);
+                    const __m128i bias = _mm_set1_epi32(shift < 0 ? (1 << -shift) - 1 : 0);
+                    size_t i = 0;
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        __m128i v = loadSSE41(in + i);
+                        if (shift > 0)
+                        {
+                            v = _mm_sll_epi32(v, left);
+                        }
+                        else
+                        {
+                            v = _mm_sra_epi32(_mm_add_epi32(v, _mm_and_si128(_mm_srai_epi32(v, 31), bias)), right);
+                        }
+                        storeSSE41(out + i, v);
+                    }
+                    return i;
+                }
+
+                static DJV_AUDIO_AVX2 size_t avx2(const A* in, B* out, size_t count)
+                {
+                    const int shift = 8 * (static_cast<int>(sizeof(B)) - static_cast<int>(sizeof(A)));
+                    const __m128i left = _mm_cvtsi32_si128(shift > 0 ? shift : 0);
+                    const __m128i right = _mm_cvtsi32_si128(shift < 0 ? -shift : 0);
+                    const __m256i bias = _mm256_set1_epi32(shift < 0 ? (1 << -shift) - 1 : 0);
+                    size_t i = 0;
+                    for (; i + 8 <= count; i += 8)
+                    {
+                        __m256i v = loadAVX2(in + i);
+                        if (shift > 0)
+                        {
+                            v = _mm256_sll_epi32(v, left);
+                        }
+                        else
+                        {
+                            v = _mm256_sra_epi32(_mm256_add_epi32(v, _mm256_and_si256(_mm256_srai_epi32(v, 31), bias)), right);
+                        }
+                        storeAVX2(out + i, v);
+                    }
+                    return i;
+                }
+            };
+
+            template<typename A, typename B>
+            struct IntToF32Kernel
+            {
+                static DJV_AUDIO_SSE41 size_t sse41(const A* in, F32_T* out, size_t count)
+                {
+                    const __m128 max = _mm_set1_ps(static_cast<float>(std::numeric_limits<A>::max()));
+                    size_t i = 0;
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        _mm_storeu_ps(out + i, _mm_div_ps(_mm_cvtepi32_ps(loadSSE41(in + i)), max));
+                    }
+                    return i;
+                }
+
+                static DJV_AUDIO_AVX2 size_t avx2(const A* in, F32_T* out, size_t count)
+                {
+                    const __m256 max = _mm256_set1_ps(static_cast<float>(std::numeric_limits<A>::max()));
+                    size_t i = 0;
+                    for (; i + 8 <= count; i += 8)
+                    {
+                        _mm256_storeu_ps(out + i, _mm256_div_ps(_mm256_cvtepi32_ps(loadAVX2(in + i)), max));
+                    }
+                    return i;
+                }
+            };
+
+            template<typename A, typename B>
+            struct IntToF64Kernel
+            {
+                static DJV_AUDIO_SSE41 size_t sse41(const A* in, F64_T* out, size_t count)
+                {
+                    const __m128d max = _mm_set1_pd(static_cast<double>(std::numeric_limits<A>::max()));
+                    size_t i = 0;
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        __m128d lo;
+                        __m128d hi;
+                        toF64SSE41(loadSSE41(in + i), lo, hi);
+                        _mm_storeu_pd(out + i, _mm_div_pd(lo, max));
+                        _mm_storeu_pd(out + i + 2, _mm_div_pd(hi, max));
+                    }
+                    return i;
+                }
+
+                static DJV_AUDIO_AVX2 size_t avx2(const A* in, F64_T* out, size_t count)
+                {
+                    const __m256d max = _mm256_set1_pd(static_cast<double>(std::numeric_limits<A>::max()));
+                    size_t i = 0;
+                    for (; i + 8 <= count; i += 8)
+                    {
+                        __m256d lo;
+                        __m256d hi;
+                        toF64AVX2(loadAVX2(in + i), lo, hi);
+                        _mm256_storeu_pd(out + i, _mm256_div_pd(lo, max));
+                        _mm256_storeu_pd(out + i + 4, _mm256_div_pd(hi, max));
+                    }
+                    return i;
+                }
+            };
+
+            // Floating point samples are scaled, saturated, and truncated.
+            // Conversions to 32-bit samples use double precision.
+            template<typename A, typename B>
+            struct F32ToIntKernel
+            {
+                static DJV_AUDIO_SSE41 size_t sse41(const F32_T* in, B* out, size_t count)
+                {
+                    size_t i = 0;
+                    if (sizeof(B) < sizeof(S32_T))
+                    {
+                        const __m128 min = _mm_set1_ps(static_cast<float>(std::numeric_limits<B>::min()));
+                        const __m128 max = _mm_set1_ps(static_cast<float>(std::numeric_limits<B>::max()));
+                        for (; i + 4 <= count; i += 4)
+                        {
+                            const __m128 f = _mm_mul_ps(_mm_loadu_ps(in + i), max);
+                            storeSSE41(out + i, _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(f, min), max)));
+                        }
+                    }
+                    else
+                    {
+                        const __m128d min = _mm_set1_pd(static_cast<double>(std::numeric_limits<B>::min()));
+                        const __m128d max = _mm_set1_pd(static_cast<double>(std::numeric_limits<B>::max()));
+                        for (; i + 4 <= count; i += 4)
+                        {
+                            const __m128 f = _mm_loadu_ps(in + i);
+                            const __m128d lo = _mm_mul_pd(_mm_cvtps_pd(f), max);
+                            const __m128d hi = _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(f, f)), max);
+                            storeSSE41(out + i, fromF64SSE41(
+                                _mm_min_pd(_mm_max_pd(lo, min), max),
+                                _mm_min_pd(_mm_max_pd(hi, min), max)));
+                        }
+                    }
+                    return i;
+                }
+
+                static DJV_AUDIO_AVX2 size_t avx2(const F32_T* in, B* out, size_t count)
+                {
+                    size_t i = 0;
+                    if (sizeof(B) < sizeof(S32_T))
+                    {
+                        const __m256 min = _mm256_set1_ps(static_cast<float>(std::numeric_limits<B>::min()));
+                        const __m256 max = _mm256_set1_ps(static_cast<float>(std::numeric_limits<B>::max()));
+                        for (; i + 8 <= count; i += 8)
+                        {
+                            const __m256 f = _mm256_mul_ps(_mm256_loadu_ps(in + i), max);
+                            storeAVX2(out + i, _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(f, min), max)));
+                        }
+                    }
+                    else
+                    {
+                        const __m256d min = _mm256_set1_pd(static_cast<double>(std::numeric_limits<B>::min()));
+                        const __m256d max = _mm256_set1_pd(static_cast<double>(std::numeric_limits<B>::max()));
+                        for (; i + 8 <= count; i += 8)
+                        {
+                            const __m256d lo = _mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(in + i)), max);
+                            const __m256d hi = _mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(in + i + 4)), max);
+                            storeAVX2(out + i, fromF64AVX2(
+                                _mm256_min_pd(_mm256_max_pd(lo, min), max),
+                                _mm256_min_pd(_mm256_max_pd(hi, min), max)));
+                        }
+                    }
+                    return i;
+                }
+            };
+
+            template<typename A, typename B>
+            struct F64ToIntKernel
+            {
+                static DJV_AUDIO_SSE41 size_t sse41(const F64_T* in, B* out, size_t count)
+                {
+                    const __m128d min = _mm_set1_pd(static_cast<double>(std::numeric_limits<B>::min()));
+                    const __m128d max = _mm_set1_pd(static_cast<double>(std::numeric_limits<B>::max()));
+                    size_t i = 0;
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        const __m128d lo = _mm_mul_pd(_mm_loadu_pd(in + i), max);
+                        const __m128d hi = _mm_mul_pd(_mm_loadu_pd(in + i + 2), max);
+                        storeSSE41(out + i, fromF64SSE41(
+                            _mm_min_pd(_mm_max_pd(lo, min), max),
+                            _mm_min_pd(_mm_max_pd(hi, min), max)));
+                    }
+                    return i;
+                }
+
+                static DJV_AUDIO_AVX2 size_t avx2(const F64_T* in, B* out, size_t count)
+                {
+                    const __m256d min = _mm256_set1_pd(static_cast<double>(std::numeric_limits<B>::min()));
+                    const __m256d max = _mm256_set1_pd(static_cast<double>(std::numeric_limits<B>::max()));
+                    size_t i = 0;
+                    for (; i + 8 <= count; i += 8)
+                    {
+                        const __m256d lo = _mm256_mul_pd(_mm256_loadu_pd(in + i), max);
+                        const __m256d hi = _mm256_mul_pd(_mm256_loadu_pd(in + i + 4), max);
+                        storeAVX2(out + i, fromF64AVX2(
+                            _mm256_min_pd(_mm256_max_pd(lo, min), max),
+                            _mm256_min_pd(_mm256_max_pd(hi, min), max)));
+                    }
+                    return i;
+                }
+            };
+
+            template<typename A, typename B>
+            struct F32ToF64Kernel
+            {
+                static DJV_AUDIO_SSE41 size_t sse41(const F32_T* in, F64_T* out, size_t count)
+                {
+                    size_t i = 0;
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        const __m128 f = _mm_loadu_ps(in + i);
+                        _mm_storeu_pd(out + i, _mm_cvtps_pd(f));
+                        _mm_storeu_pd(out + i + 2, _mm_cvtps_pd(_mm_movehl_ps(f, f)));
+                    }
+                    return i;
+                }
+
+                static DJV_AUDIO_AVX2 size_t avx2(const F32_T* in, F64_T* out, size_t count)
+                {
+                    size_t i = 0;
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        _mm256_storeu_pd(out + i, _mm256_cvtps_pd(_mm_loadu_ps(in + i)));
+                    }
+                    return i;
+                }
+            };
+
+            template<typename A, typename B>
+            struct F64ToF32Kernel
+            {
+                static DJV_AUDIO_SSE41 size_t sse41(const F64_T* in, F32_T* out, size_t count)
+                {
+                    size_t i = 0;
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        _mm_storeu_ps(out + i, _mm_movelh_ps(
+                            _mm_cvtpd_ps(_mm_loadu_pd(in + i)),
+                            _mm_cvtpd_ps(_mm_loadu_pd(in + i + 2))));
+                    }
+                    return i;
+                }
+
+                static DJV_AUDIO_AVX2 size_t avx2(const F64_T* in, F32_T* out, size_t count)
+                {
+                    size_t i = 0;
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_loadu_pd(in + i)));
+                    }
+                    return i;
+                }
+            };
+
+            ///@}
+
+            //! \name Interleaving
+            ///@{
+
+            // Get the byte shuffles that gather the even samples of 16 bytes
+            // into the low half and the odd samples into the high half, and
+            // the opposite.
+            void getShuffles(size_t byteCount, uint8_t deinterleave[16], uint8_t interleave[16])
+            {
+                for (size_t i = 0; i < 16; ++i)
+                {
+                    const size_t sample = (i % 8) / byteCount;
+                    deinterleave[i] = static_cast<uint8_t>((sample * 2 + i / 8) * byteCount + i % byteCount);
+                    const size_t channelSample = i / byteCount;
+                    interleave[i] = static_cast<uint8_t>((channelSample % 2) * 8 + (channelSample / 2) * byteCount + i % byteCount);
+                }
+            }
+
+            DJV_AUDIO_SSE41 size_t planarInterleaveSSE41(
+                const uint8_t* in0,
+                const uint8_t* in1,
+                uint8_t* out,
+                size_t sampleCount,
+                size_t byteCount)
+            {
+                uint8_t deinterleave[16];
+                uint8_t interleave[16];
+                getShuffles(byteCount, deinterleave, interleave);
+                const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(interleave));
+                const size_t n = 16 / byteCount;
+                size_t i = 0;
+                for (; i + n <= sampleCount; i += n)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in0 + i * byteCount));
+                    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in1 + i * byteCount));
+                    __m128i* outP = reinterpret_cast<__m128i*>(out + i * byteCount * 2);
+                    _mm_storeu_si128(outP, _mm_shuffle_epi8(_mm_unpacklo_epi64(a, b), shuffle));
+                    _mm_storeu_si128(outP + 1, _mm_shuffle_epi8(_mm_unpackhi_epi64(a, b), shuffle));
+                }
+                return i;
+            }
+
+            DJV_AUDIO_AVX2 size_t planarInterleaveAVX2(
+                const uint8_t* in0,
+                const uint8_t* in1,
+                uint8_t* out,
+                size_t sampleCount,
+                size_t byteCount)
+            {
+                uint8_t deinterleave[16];
+                uint8_t interleave[16];
+                getShuffles(byteCount, deinterleave, interleave);
+                const __m256i shuffle = _mm256_broadcastsi128_si256(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(interleave)));
+                const size_t n = 32 / byteCount;
+                size_t i = 0;
+                for (; i + n <= sampleCount; i += n)
+                {
+                    // Order the 64-bit blocks so that the shuffles stay
+                    // within the 128-bit lanes.
+                    const __m256i a = _mm256_permute4x64_epi64(
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in0 + i * byteCount)), 0xD8);
+                    const __m256i b = _mm256_permute4x64_epi64(
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in1 + i * byteCount)), 0xD8);
+                    __m256i* outP = reinterpret_cast<__m256i*>(out + i * byteCount * 2);
+                    _mm256_storeu_si256(outP, _mm256_shuffle_epi8(_mm256_unpacklo_epi64(a, b), shuffle));
+                    _mm256_storeu_si256(outP + 1, _mm256_shuffle_epi8(_mm256_unpackhi_epi64(a, b), shuffle));
+                }
+                return i;
+            }
+
+            DJV_AUDIO_SSE41 size_t planarDeinterleaveSSE41(
+                const uint8_t* in,
+                uint8_t* out0,
+                uint8_t* out1,
+                size_t sampleCount,
+                size_t byteCount)
+            {
+                uint8_t deinterleave[16];
+                uint8_t interleave[16];
+                getShuffles(byteCount, deinterleave, interleave);
+                const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(deinterleave));
+                const size_t n = 16 / byteCount;
+                size_t i = 0;
+                for (; i + n <= sampleCount; i += n)
+                {
+                    const __m128i* inP = reinterpret_cast<const __m128i*>(in + i * byteCount * 2);
+                    const __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(inP), shuffle);
+                    const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(inP + 1), shuffle);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out0 + i * byteCount), _mm_unpacklo_epi64(a, b));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out1 + i * byteCount), _mm_unpackhi_epi64(a, b));
+                }
+                return i;
+            }
+
+            DJV_AUDIO_AVX2 size_t planarDeinterleaveAVX2(
+                const uint8_t* in,
+                uint8_t* out0,
+                uint8_t* out1,
+                size_t sampleCount,
+                size_t byteCount)
+            {
+                uint8_t deinterleave[16];
+                uint8_t interleave[16];
+                getShuffles(byteCount, deinterleave, interleave);
+                const __m256i shuffle = _mm256_broadcastsi128_si256(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(deinterleave)));
+                const size_t n = 32 / byteCount;
+                size_t i = 0;
+                for (; i + n <= sampleCount; i += n)
+                {
+                    const __m256i* inP = reinterpret_cast<const __m256i*>(in + i * byteCount * 2);
+                    const __m256i a = _mm256_permute4x64_epi64(
+                        _mm256_shuffle_epi8(_mm256_loadu_si256(inP), shuffle), 0xD8);
+                    const __m256i b = _mm256_permute4x64_epi64(
+                        _mm256_shuffle_epi8(_mm256_loadu_si256(inP + 1), shuffle), 0xD8);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out0 + i * byteCount), _mm256_permute2x128_si256(a, b, 0x20));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out1 + i * byteCount), _mm256_permute2x128_si256(a, b, 0x31));
+                }
+                return i;
+            }
+
+            ///@}
+#endif // DJV_AUDIO_X86
+
+            inline void scaleVolume(S8_T in, float volume, S8_T& out) noexcept
+            {
+                out = static_cast<S8_T>(Math::clamp(
+                    in * volume,
+                    static_cast<float>(S8Range.getMin()),
+                    static_cast<float>(S8Range.getMax())));
+            }
+
+            inline void scaleVolume(S16_T in, float volume, S16_T& out) noexcept
+            {
+                out = static_cast<S16_T>(Math::clamp(
+                    in * volume,
+                    static_cast<float>(S16Range.getMin()),
+                    static_cast<float>(S16Range.getMax())));
+            }
+
+            inline void scaleVolume(S32_T in, float volume, S32_T& out) noexcept
+            {
+                out = static_cast<S32_T>(Math::clamp(
+                    in * static_cast<double>(volume),
+                    static_cast<double>(S32Range.getMin()),
+                    static_cast<double>(S32Range.getMax())));
+            }
+
+            inline void scaleVolume(F32_T in, float volume, F32_T& out) noexcept
+            {
+                out = in * volume;
+            }
+
+            inline void scaleVolume(F64_T in, float volume, F64_T& out) noexcept
+            {
+                out = in * volume;
+            }
+
+            template<typename T>
+            void _volume(const uint8_t* in, uint8_t* out, float volume, size_t count, Core::OS::SIMD simd)
+            {
+                const T* inP = reinterpret_cast<const T*>(in);
+                T* outP = reinterpret_cast<T*>(out);
+                size_t i = 0;
+                simd = std::min(simd, Core::OS::getSIMD());
+#if defined(DJV_AUDIO_X86)
+                if (simd >= Core::OS::SIMD::AVX2)
+                {
+                    i = VolumeKernel<T>::avx2(inP, outP, volume, count);
+                }
+                else if (simd >= Core::OS::SIMD::SSE41)
+                {
+                    i = VolumeKernel<T>::sse41(inP, outP, volume, count);
+                }
+#endif // DJV_AUDIO_X86
+                for (; i < count; ++i)
+                {
+                    scaleVolume(inP[i], volume, outP[i]);
+                }
+            }
+
+            template<template<typename, typename> class K, typename A, typename B, void (*F)(A, B&)>
+            void _convert(const uint8_t* in, uint8_t* out, size_t count, Core::OS::SIMD simd)
+            {
+                const A* inP = reinterpret_cast<const A*>(in);
+                B* outP = reinterpret_cast<B*>(out);
+                size_t i = 0;
+                simd = std::min(simd, Core::OS::getSIMD());
+#if defined(DJV_AUDIO_X86)
+                if (simd >= Core::OS::SIMD::AVX2)
+                {
+                    i = K<A, B>::avx2(inP, outP, count);
+                }
+                else if (simd >= Core::OS::SIMD::SSE41)
+                {
+                    i = K<A, B>::sse41(inP, outP, count);
+                }
+#endif // DJV_AUDIO_X86
+                for (; i < count; ++i)
+                {
+                    F(inP[i], outP[i]);
+                }
+            }
+
+        } // namespace
+
+        void volume(
+            const uint8_t* in,
+            uint8_t* out,
+            float volume,
+            size_t sampleCount,
+            uint8_t channelCount,
+            Type type,
+            Core::OS::SIMD simd)
         {
             switch (type)
             {
@@ -46,7 +810,111 @@ namespace djv
             }
         }
 
-        std::shared_ptr<Data> convert(const std::shared_ptr<Data>& data, Type type)
+        namespace
+        {
+            void reduceF32(const F32_T* in, size_t count, float& min, float& max, float& sumSquares)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const F32_T v = in[i];
+                    min = std::min(min, v);
+                    max = std::max(max, v);
+                    sumSquares += v * v;
+                }
+            }
+
+#if defined(DJV_AUDIO_X86)
+            DJV_AUDIO_SSE41 void reduceF32SSE41(const F32_T* in, size_t count, float& min, float& max, float& sumSquares)
+            {
+                __m128 minV = _mm_set1_ps(min);
+                __m128 maxV = _mm_set1_ps(max);
+                __m128 sumV = _mm_setzero_ps();
+                size_t i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    const __m128 v = _mm_loadu_ps(in + i);
+                    minV = _mm_min_ps(minV, v);
+                    maxV = _mm_max_ps(maxV, v);
+                    sumV = _mm_add_ps(sumV, _mm_mul_ps(v, v));
+                }
+                float tmp[4];
+                _mm_storeu_ps(tmp, minV);
+                min = std::min(std::min(tmp[0], tmp[1]), std::min(tmp[2], tmp[3]));
+                _mm_storeu_ps(tmp, maxV);
+                max = std::max(std::max(tmp[0], tmp[1]), std::max(tmp[2], tmp[3]));
+                _mm_storeu_ps(tmp, sumV);
+                sumSquares += (tmp[0] + tmp[1]) + (tmp[2] + tmp[3]);
+                reduceF32(in + i, count - i, min, max, sumSquares);
+            }
+
+            DJV_AUDIO_AVX2 void reduceF32AVX2(const F32_T* in, size_t count, float& min, float& max, float& sumSquares)
+            {
+                __m256 minV = _mm256_set1_ps(min);
+                __m256 maxV = _mm256_set1_ps(max);
+                __m256 sumV = _mm256_setzero_ps();
+                size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m256 v = _mm256_loadu_ps(in + i);
+                    minV = _mm256_min_ps(minV, v);
+                    maxV = _mm256_max_ps(maxV, v);
+                    sumV = _mm256_fmadd_ps(v, v, sumV);
+                }
+                float tmp[8];
+                _mm256_storeu_ps(tmp, minV);
+                min = *std::min_element(tmp, tmp + 8);
+                _mm256_storeu_ps(tmp, maxV);
+                max = *std::max_element(tmp, tmp + 8);
+                _mm256_storeu_ps(tmp, sumV);
+                sumSquares += ((tmp[0] + tmp[1]) + (tmp[2] + tmp[3])) + ((tmp[4] + tmp[5]) + (tmp[6] + tmp[7]));
+                reduceF32(in + i, count - i, min, max, sumSquares);
+            }
+#endif // DJV_AUDIO_X86
+
+        } // namespace
+
+        void reduce(
+            const uint8_t* in,
+            size_t sampleCount,
+            uint8_t channelCount,
+            Type type,
+            float& min,
+            float& max,
+            float& sumSquares,
+            Core::OS::SIMD simd)
+        {
+            switch (type)
+            {
+            case Type::S8:  _REDUCE(S8);  break;
+            case Type::S16: _REDUCE(S16); break;
+            case Type::S32: _REDUCE(S32); break;
+            case Type::F32:
+            {
+                const F32_T* inP = reinterpret_cast<const F32_T*>(in);
+                const size_t count = sampleCount * channelCount;
+                simd = std::min(simd, Core::OS::getSIMD());
+#if defined(DJV_AUDIO_X86)
+                if (simd >= Core::OS::SIMD::AVX2)
+                {
+                    reduceF32AVX2(inP, count, min, max, sumSquares);
+                }
+                else if (simd >= Core::OS::SIMD::SSE41)
+                {
+                    reduceF32SSE41(inP, count, min, max, sumSquares);
+                }
+                else
+#endif // DJV_AUDIO_X86
+                {
+                    reduceF32(inP, count, min, max, sumSquares);
+                }
+                break;
+            }
+            case Type::F64: _REDUCE(F64); break;
+            default: break;
+            }
+        }
+
+        std::shared_ptr<Data> convert(const std::shared_ptr<Data>& data, Type type, Core::OS::SIMD simd)
         {
             const Type dataType = data->getType();
             const size_t sampleCount = data->getSampleCount();
@@ -63,50 +931,50 @@ namespace djv
                     case Type::S8:
                         switch (type)
                         {
-                        case Type::S16: _CONVERT(S8, S16); break;
-                        case Type::S32: _CONVERT(S8, S32); break;
-                        case Type::F32: _CONVERT(S8, F32); break;
-                        case Type::F64: _CONVERT(S8, F64); break;
+                        case Type::S16: _CONVERT(S8, S16, IntToInt); break;
+                        case Type::S32: _CONVERT(S8, S32, IntToInt); break;
+                        case Type::F32: _CONVERT(S8, F32, IntToF32); break;
+                        case Type::F64: _CONVERT(S8, F64, IntToF64); break;
                         default: break;
                         }
                         break;
                     case Type::S16:
                         switch (type)
                         {
-                        case Type::S8:  _CONVERT(S16, S8);  break;
-                        case Type::S32: _CONVERT(S16, S32); break;
-                        case Type::F32: _CONVERT(S16, F32); break;
-                        case Type::F64: _CONVERT(S16, F64); break;
+                        case Type::S8:  _CONVERT(S16, S8,  IntToInt); break;
+                        case Type::S32: _CONVERT(S16, S32, IntToInt); break;
+                        case Type::F32: _CONVERT(S16, F32, IntToF32); break;
+                        case Type::F64: _CONVERT(S16, F64, IntToF64); break;
                         default: break;
                         }
                         break;
                     case Type::S32:
                         switch (type)
                         {
-                        case Type::S8:  _CONVERT(S32, S8);  break;
-                        case Type::S16: _CONVERT(S32, S16); break;
-                        case Type::F32: _CONVERT(S32, F32); break;
-                        case Type::F64: _CONVERT(S32, F64); break;
+                        case Type::S8:  _CONVERT(S32, S8,  IntToInt); break;
+                        case Type::S16: _CONVERT(S32, S16, IntToInt); break;
+                        case Type::F32: _CONVERT(S32, F32, IntToF32); break;
+                        case Type::F64: _CONVERT(S32, F64, IntToF64); break;
                         default: break;
                         }
                         break;
                     case Type::F32:
                         switch (type)
                         {
-                        case Type::S8:  _CONVERT(F32, S8);  break;
-                        case Type::S16: _CONVERT(F32, S16); break;
-                        case Type::S32: _CONVERT(F32, S32); break;
-                        case Type::F64: _CONVERT(F32, F64); break;
+                        case Type::S8:  _CONVERT(F32, S8,  F32ToInt); break;
+                        case Type::S16: _CONVERT(F32, S16, F32ToInt); break;
+                        case Type::S32: _CONVERT(F32, S32, F32ToInt); break;
+                        case Type::F64: _CONVERT(F32, F64, F32ToF64); break;
                         default: break;
                         }
                         break;
                     case Type::F64:
                         switch (type)
                         {
-                        case Type::S8:  _CONVERT(F64, S8);  break;
-                        case Type::S16: _CONVERT(F64, S16); break;
-                        case Type::S32: _CONVERT(F64, S32); break;
-                        case Type::F32: _CONVERT(F64, F32); break;
+                        case Type::S8:  _CONVERT(F64, S8,  F64ToInt); break;
+                        case Type::S16: _CONVERT(F64, S16, F64ToInt); break;
+                        case Type::S32: _CONVERT(F64, S32, F64ToInt); break;
+                        case Type::F32: _CONVERT(F64, F32, F64ToF32); break;
                         default: break;
                         }
                         break;
@@ -116,6 +984,66 @@ namespace djv
             return out;
         }
 
+        void planarInterleave(
+            const uint8_t* in0,
+            const uint8_t* in1,
+            uint8_t* out,
+            size_t sampleCount,
+            size_t byteCount,
+            Core::OS::SIMD simd)
+        {
+            size_t i = 0;
+            simd = std::min(simd, Core::OS::getSIMD());
+#if defined(DJV_AUDIO_X86)
+            if (1 == byteCount || 2 == byteCount || 4 == byteCount || 8 == byteCount)
+            {
+                if (simd >= Core::OS::SIMD::AVX2)
+                {
+                    i = planarInterleaveAVX2(in0, in1, out, sampleCount, byteCount);
+                }
+                else if (simd >= Core::OS::SIMD::SSE41)
+                {
+                    i = planarInterleaveSSE41(in0, in1, out, sampleCount, byteCount);
+                }
+            }
+#endif // DJV_AUDIO_X86
+            for (; i < sampleCount; ++i)
+            {
+                memcpy(out + i * byteCount * 2, in0 + i * byteCount, byteCount);
+                memcpy(out + i * byteCount * 2 + byteCount, in1 + i * byteCount, byteCount);
+            }
+        }
+
+        void planarDeinterleave(
+            const uint8_t* in,
+            uint8_t* out0,
+            uint8_t* out1,
+            size_t sampleCount,
+            size_t byteCount,
+            Core::OS::SIMD simd)
+        {
+            size_t i = 0;
+            simd = std::min(simd, Core::OS::getSIMD());
+#if defined(DJV_AUDIO_X86)
+            if (1 == byteCount || 2 == byteCount || 4 == byteCount || 8 == byteCount)
+            {
+                if (simd >= Core::OS::SIMD::AVX2)
+                {
+                    i = planarDeinterleaveAVX2(in, out0, out1, sampleCount, byteCount);
+                }
+                else if (simd >= Core::OS::SIMD::SSE41)
+                {
+                    i = planarDeinterleaveSSE41(in, out0, out1, sampleCount, byteCount);
+                }
+            }
+#endif // DJV_AUDIO_X86
+            for (; i < sampleCount; ++i)
+            {
+                memcpy(out0 + i * byteCount, in + i * byteCount * 2, byteCount);
+                memcpy(out1 + i * byteCount, in + i * byteCount * 2 + byteCount, byteCount);
+            }
+        }
+
         namespace
         {
             template<typename U>
@@ -135,11 +1063,23 @@ namespace djv
             }
         }
 
-        std::shared_ptr<Data> planarInterleave(const std::shared_ptr<Data>& data)
+        std::shared_ptr<Data> planarInterleave(const std::shared_ptr<Data>& data, Core::OS::SIMD simd)
         {
             const size_t sampleCount = data->getSampleCount();
             const size_t channelCount = data->getChannelCount();
             auto out = Data::create(data->getInfo(), sampleCount);
+            if (2 == channelCount)
+            {
+                const size_t byteCount = Audio::getByteCount(data->getType());
+                planarInterleave(
+                    data->getData(),
+                    data->getData() + sampleCount * byteCount,
+                    out->getData(),
+                    sampleCount,
+                    byteCount,
+                    simd);
+                return out;
+            }
             switch (data->getType())
             {
             case Type::S8:
@@ -180,11 +1120,23 @@ namespace djv
             }
         }
 
-        std::shared_ptr<Data> planarDeinterleave(const std::shared_ptr<Data>& data)
+        std::shared_ptr<Data> planarDeinterleave(const std::shared_ptr<Data>& data, Core::OS::SIMD simd)
         {
             const uint8_t channelCount = data->getChannelCount();
             const size_t sampleCount = data->getSampleCount();
             auto out = Data::create(data->getInfo(), sampleCount);
+            if (2 == channelCount)
+            {
+                const size_t byteCount = Audio::getByteCount(data->getType());
+                planarDeinterleave(
+                    data->getData(),
+                    out->getData(),
+                    out->getData() + sampleCount * byteCount,
+                    sampleCount,
+                    byteCount,
+                    simd);
+                return out;
+            }
             switch (data->getType())
             {
             case Type::S8:
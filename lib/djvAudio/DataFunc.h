@@ -4,6 +4,8 @@
 
 #include <djvAudio/Type.h>
 
+#include <djvCore/OSFunc.h>
+
 #include <memory>
 
 namespace djv
@@ -15,14 +17,16 @@ namespace djv
         //! \name Utility
         ///@{
 
-        //! Adjust the volume of audio data.
+        //! Adjust the volume of audio data. Integer samples are saturated to
+        //! the range of the type. SIMD is used up to the given level.
         void volume(
             const uint8_t*,
             uint8_t*,
             float volume,
             size_t sampleCount,
             uint8_t channelCount,
-            Type);
+            Type,
+            Core::OS::SIMD = Core::OS::getSIMD());
 
         //! Extract audio channels.
         template<typename T>
@@ -33,23 +37,66 @@ namespace djv
             uint8_t inChannelCount,
             uint8_t outChannelCount);
 
+        //! Reduce audio data to the minimum, maximum, and sum of the squares
+        //! of the values of all the channels, converted to floating point.
+        //! The results are combined with the values that are passed in.
+        //! 32-bit floating point data uses SIMD up to the given level.
+        void reduce(
+            const uint8_t*,
+            size_t sampleCount,
+            uint8_t channelCount,
+            Type,
+            float& min,
+            float& max,
+            float& sumSquares,
+            Core::OS::SIMD = Core::OS::getSIMD());
+
         ///@}
         
         //! \name Conversion
         ///@{
         
-        //! Convert audio data.
-        std::shared_ptr<Data> convert(const std::shared_ptr<Data>&, Type);
+        //! Convert audio data. SIMD is used up to the given level.
+        std::shared_ptr<Data> convert(
+            const std::shared_ptr<Data>&,
+            Type,
+            Core::OS::SIMD = Core::OS::getSIMD());
 
-        //! Interleave audio data.
-        std::shared_ptr<Data> planarInterleave(const std::shared_ptr<Data>&);
+        //! Interleave audio data. SIMD is used up to the given level for
+        //! two channels.
+        std::shared_ptr<Data> planarInterleave(
+            const std::shared_ptr<Data>&,
+            Core::OS::SIMD = Core::OS::getSIMD());
 
         //! Interleave audio data.
         template<typename T>
         void planarInterleave(const T**, T*, uint8_t channelCount, size_t sampleCount);
 
-        //! De-interleave audio data.
-        std::shared_ptr<Data> planarDeinterleave(const std::shared_ptr<Data>&);
+        //! Interleave two channels of audio data. The samples are copied as
+        //! blocks of bytes, SIMD is used when the size is 1, 2, 4, or 8.
+        void planarInterleave(
+            const uint8_t*,
+            const uint8_t*,
+            uint8_t*,
+            size_t sampleCount,
+            size_t byteCount,
+            Core::OS::SIMD = Core::OS::getSIMD());
+
+        //! De-interleave audio data. SIMD is used up to the given level for
+        //! two channels.
+        std::shared_ptr<Data> planarDeinterleave(
+            const std::shared_ptr<Data>&,
+            Core::OS::SIMD = Core::OS::getSIMD());
+
+        //! De-interleave two channels of audio data. The samples are copied
+        //! as blocks of bytes, SIMD is used when the size is 1, 2, 4, or 8.
+        void planarDeinterleave(
+            const uint8_t*,
+            uint8_t*,
+            uint8_t*,
+            size_t sampleCount,
+            size_t byteCount,
+            Core::OS::SIMD = Core::OS::getSIMD());
 
         ///@}
         
@@ -55,18 +55,13 @@ namespace djv
                 memcpy(out, value[0], sampleCount * channelCount * sizeof(T));
                 break;
             case 2:
-            {
-                const T* inP0 = value[0];
-                const T* inP1 = value[1];
-                T* outP = out;
-                T* const endP = out + sampleCount * channelCount;
-                for (; outP < endP; outP += 2, ++inP0, ++inP1)
-                {
-                    outP[0] = inP0[0];
-                    outP[1] = inP1[0];
-                }
+                planarInterleave(
+                    reinterpret_cast<const uint8_t*>(value[0]),
+                    reinterpret_cast<const uint8_t*>(value[1]),
+                    reinterpret_cast<uint8_t*>(out),
+                    sampleCount,
+                    sizeof(T));
                 break;
-            }
             default:
                 for (uint8_t c = 0; c < channelCount; ++c)
                 {
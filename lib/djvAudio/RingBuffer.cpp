@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAudio/RingBuffer.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace djv
+{
+    namespace Audio
+    {
+        void RingBuffer::_init(const Info& info, size_t sampleCount)
+        {
+            _info = info;
+            _sampleCount = sampleCount;
+            _sampleByteCount = info.getByteCount();
+            _data.resize(_sampleCount * _sampleByteCount);
+        }
+
+        RingBuffer::RingBuffer() :
+            _writePos(0),
+            _readPos(0),
+            _flushPos(0),
+            _finished(false),
+            _underrunCount(0),
+            _overrunCount(0)
+        {}
+
+        std::shared_ptr<RingBuffer> RingBuffer::create(const Info& info, size_t sampleCount)
+        {
+            auto out = std::shared_ptr<RingBuffer>(new RingBuffer);
+            out->_init(info, sampleCount);
+            return out;
+        }
+
+        size_t RingBuffer::getReadAvailable() const
+        {
+            const size_t writePos = _writePos;
+            return writePos - _getReadPos(writePos);
+        }
+
+        size_t RingBuffer::getWriteAvailable() const
+        {
+            const size_t writePos = _writePos;
+            return _sampleCount - (writePos - _getReadPos(writePos));
+        }
+
+        size_t RingBuffer::write(const uint8_t* data, size_t sampleCount)
+        {
+            const size_t writePos = _writePos;
+            const size_t available = _sampleCount - (writePos - _getReadPos(writePos));
+            const size_t out = std::min(sampleCount, available);
+            if (out > 0)
+            {
+                const size_t offset = writePos % _sampleCount;
+                const size_t size = std::min(out, _sampleCount - offset);
+                memcpy(_data.data() + offset * _sampleByteCount, data, size * _sampleByteCount);
+                if (size < out)
+                {
+                    memcpy(_data.data(), data + size * _sampleByteCount, (out - size) * _sampleByteCount);
+                }
+                _writePos = writePos + out;
+            }
+            if (out < sampleCount)
+            {
+                ++_overrunCount;
+            }
+            return out;
+        }
+
+        void RingBuffer::flush()
+        {
+            _flushPos = _writePos.load();
+        }
+
+        void RingBuffer::setFinished(bool value)
+        {
+            _finished = value;
+        }
+
+        size_t RingBuffer::read(uint8_t* data, size_t sampleCount)
+        {
+            const size_t writePos = _writePos;
+            const size_t readPos = _getReadPos(writePos);
+            const size_t out = std::min(sampleCount, writePos - readPos);
+            if (out > 0)
+            {
+                _copy(data, readPos, out);
+            }
+            _readPos = readPos + out;
+            if (out < sampleCount && !_finished)
+            {
+                ++_underrunCount;
+            }
+            return out;
+        }
+
+        size_t RingBuffer::_getReadPos(size_t writePos) const
+        {
+            // Skip the samples that have been flushed. The flush position is
+            // only used when it is between the read and write positions, it
+            // can be newer than the write position that was passed in.
+            const size_t readPos = _readPos;
+            const size_t flushPos = _flushPos;
+            return flushPos - readPos <= writePos - readPos ? flushPos : readPos;
+        }
+
+        void RingBuffer::_copy(uint8_t* data, size_t pos, size_t sampleCount) const
+        {
+            const size_t offset = pos % _sampleCount;
+            const size_t size = std::min(sampleCount, _sampleCount - offset);
+            memcpy(data, _data.data() + offset * _sampleByteCount, size * _sampleByteCount);
+            if (size < sampleCount)
+            {
+                memcpy(data + size * _sampleByteCount, _data.data(), (sampleCount - size) * _sampleByteCount);
+            }
+        }
+
+    } // namespace Audio
+} // namespace djv
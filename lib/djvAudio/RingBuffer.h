@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAudio/Info.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace Audio
+    {
+        //! This class provides a lock-free ring buffer of audio samples for a
+        //! single producer and a single consumer, for example a reader thread
+        //! and the audio device callback. Memory is only allocated when the
+        //! buffer is created, and the producer and consumer never block.
+        class RingBuffer
+        {
+            DJV_NON_COPYABLE(RingBuffer);
+
+        protected:
+            void _init(const Info&, size_t sampleCount);
+            RingBuffer();
+
+        public:
+            static std::shared_ptr<RingBuffer> create(const Info&, size_t sampleCount);
+
+            //! \name Information
+            ///@{
+
+            const Info& getInfo() const;
+            size_t getSampleCount() const;
+
+            //! Get the number of samples that can be read.
+            size_t getReadAvailable() const;
+
+            //! Get the number of samples that can be written.
+            size_t getWriteAvailable() const;
+
+            ///@}
+
+            //! \name Producer
+            ///@{
+
+            //! Write samples and return the number of samples written. The
+            //! samples that do not fit are not written and are counted as an
+            //! overrun; the producer should keep them and write them again.
+            size_t write(const uint8_t*, size_t sampleCount);
+
+            //! Discard the samples that have been written, for example after
+            //! seeking. The space is given back to the producer immediately,
+            //! so this should not be called while the consumer is reading.
+            void flush();
+
+            bool isFinished() const;
+
+            //! Set whether the producer has finished, reads that come up
+            //! short are then not counted as underruns.
+            void setFinished(bool);
+
+            ///@}
+
+            //! \name Consumer
+            ///@{
+
+            //! Read samples and return the number of samples read. Reading
+            //! fewer samples than requested is counted as an underrun.
+            size_t read(uint8_t*, size_t sampleCount);
+
+            ///@}
+
+            //! \name Statistics
+            ///@{
+
+            size_t getUnderrunCount() const;
+            size_t getOverrunCount() const;
+
+            ///@}
+
+        private:
+            size_t _getReadPos(size_t writePos) const;
+            void _copy(uint8_t*, size_t pos, size_t sampleCount) const;
+
+            Info _info;
+            size_t _sampleCount = 0;
+            size_t _sampleByteCount = 0;
+            std::vector<uint8_t> _data;
+
+            // The positions are sample counters that only increase, the
+            // position in the buffer is the counter modulo the size.
+            std::atomic<size_t> _writePos;
+            std::atomic<size_t> _readPos;
+            std::atomic<size_t> _flushPos;
+            std::atomic<bool> _finished;
+            std::atomic<size_t> _underrunCount;
+            std::atomic<size_t> _overrunCount;
+        };
+
+    } // namespace Audio
+} // namespace djv
+
+#include <djvAudio/RingBufferInline.h>
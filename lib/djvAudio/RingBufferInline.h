@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace Audio
+    {
+        inline const Info& RingBuffer::getInfo() const
+        {
+            return _info;
+        }
+
+        inline size_t RingBuffer::getSampleCount() const
+        {
+            return _sampleCount;
+        }
+
+        inline bool RingBuffer::isFinished() const
+        {
+            return _finished;
+        }
+
+        inline size_t RingBuffer::getUnderrunCount() const
+        {
+            return _underrunCount;
+        }
+
+        inline size_t RingBuffer::getOverrunCount() const
+        {
+            return _overrunCount;
+        }
+
+    } // namespace Audio
+} // namespace djv
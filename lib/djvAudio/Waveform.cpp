@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAudio/Waveform.h>
+
+#include <djvAudio/Data.h>
+#include <djvAudio/DataFunc.h>
+
+#include <djvSystem/File.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/FileInfo.h>
+#include <djvSystem/TextSystem.h>
+
+#include <djvCore/StringFormat.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace Audio
+    {
+        namespace
+        {
+            const char     cacheMagic[]     = "djvWaveform";
+            const uint32_t cacheVersion     = 1;
+            const char     cacheExtension[] = ".djvwf";
+
+            Waveform::Bin combine(const Waveform::Bin& a, const Waveform::Bin& b)
+            {
+                Waveform::Bin out;
+                out.min = std::min(a.min, b.min);
+                out.max = std::max(a.max, b.max);
+                out.rms = sqrtf((a.rms * a.rms + b.rms * b.rms) / 2.F);
+                return out;
+            }
+
+        } // namespace
+
+        Waveform::Waveform()
+        {}
+
+        Waveform::Waveform(size_t sampleRate, size_t binSampleCount) :
+            _sampleRate(sampleRate),
+            _binSampleCount(std::max(binSampleCount, static_cast<size_t>(1)))
+        {}
+
+        void Waveform::add(const Data& data)
+        {
+            if (_levels.empty())
+            {
+                _levels.resize(1);
+            }
+            const uint8_t channelCount = data.getChannelCount();
+            const Type type = data.getType();
+            const size_t sampleByteCount = data.getInfo().getByteCount();
+            const uint8_t* p = data.getData();
+            size_t sampleCount = data.getSampleCount();
+            while (sampleCount > 0)
+            {
+                if (0 == _binSamples)
+                {
+                    _binMin = std::numeric_limits<float>::max();
+                    _binMax = std::numeric_limits<float>::lowest();
+                    _binSumSquares = 0.F;
+                }
+                const size_t size = std::min(sampleCount, _binSampleCount - _binSamples);
+                reduce(p, size, channelCount, type, _binMin, _binMax, _binSumSquares);
+                _binSamples += size;
+                _binValues += size * channelCount;
+                _sampleCount += size;
+                p += size * sampleByteCount;
+                sampleCount -= size;
+                if (_binSamples == _binSampleCount)
+                {
+                    _addBin();
+                }
+            }
+        }
+
+        void Waveform::finish()
+        {
+            if (_binSamples > 0)
+            {
+                _addBin();
+            }
+            _buildLevels();
+        }
+
+        std::vector<Waveform::Bin> Waveform::getBins(size_t start, size_t end, size_t count) const
+        {
+            std::vector<Bin> out(count);
+            if (_levels.empty() || end <= start || 0 == count)
+            {
+                return out;
+            }
+
+            // Find the level with the largest bins that are not wider than a
+            // column.
+            const double samplesPerColumn = (end - start) / static_cast<double>(count);
+            size_t level = 0;
+            size_t binSampleCount = _binSampleCount;
+            while (level + 1 < _levels.size() && binSampleCount * 2 <= samplesPerColumn)
+            {
+                ++level;
+                binSampleCount *= 2;
+            }
+
+            const auto& bins = _levels[level];
+            for (size_t i = 0; i < count; ++i)
+            {
+                const size_t s0 = start + static_cast<size_t>(i * samplesPerColumn);
+                const size_t s1 = start + static_cast<size_t>((i + 1) * samplesPerColumn);
+                const size_t b0 = s0 / binSampleCount;
+                const size_t b1 = std::min(
+                    std::max(b0 + 1, (s1 + binSampleCount - 1) / binSampleCount),
+                    bins.size());
+                if (b0 < b1)
+                {
+                    Bin bin = bins[b0];
+                    float sumSquares = bin.rms * bin.rms;
+                    for (size_t j = b0 + 1; j < b1; ++j)
+                    {
+                        bin.min = std::min(bin.min, bins[j].min);
+                        bin.max = std::max(bin.max, bins[j].max);
+                        sumSquares += bins[j].rms * bins[j].rms;
+                    }
+                    bin.rms = sqrtf(sumSquares / (b1 - b0));
+                    out[i] = bin;
+                }
+            }
+            return out;
+        }
+
+        std::string Waveform::getCacheFileName(const System::File::Info& fileInfo)
+        {
+            std::stringstream ss;
+            ss << fileInfo.getFileName() << ":" << fileInfo.getTime() << ":" << fileInfo.getSize();
+            std::stringstream out;
+            out << std::hex << std::setfill('0') << std::setw(16) << std::hash<std::string>()(ss.str());
+            out << cacheExtension;
+            return out.str();
+        }
+
+        void Waveform::read(
+            const std::string& fileName,
+            const System::File::Info& fileInfo,
+            const std::shared_ptr<System::TextSystem>& textSystem)
+        {
+            auto io = System::File::IO::create();
+            io->open(fileName, System::File::Mode::Read);
+            char magic[sizeof(cacheMagic)];
+            io->read(magic, sizeof(cacheMagic));
+            uint32_t version = 0;
+            io->readU32(&version);
+            uint64_t size = 0;
+            io->read(&size, 1, sizeof(uint64_t));
+            int64_t time = 0;
+            io->read(&time, 1, sizeof(int64_t));
+            if (memcmp(magic, cacheMagic, sizeof(cacheMagic)) != 0 ||
+                version != cacheVersion ||
+                size != fileInfo.getSize() ||
+                time != static_cast<int64_t>(fileInfo.getTime()))
+            {
+                throw System::File::Error(String::Format("{0}: {1}").
+                    arg(fileName).
+                    arg(textSystem->getText(DJV_TEXT("error_waveform_cache"))));
+            }
+            uint64_t sampleRate = 0;
+            io->read(&sampleRate, 1, sizeof(uint64_t));
+            uint64_t binSampleCount = 0;
+            io->read(&binSampleCount, 1, sizeof(uint64_t));
+            uint64_t sampleCount = 0;
+            io->read(&sampleCount, 1, sizeof(uint64_t));
+            uint64_t count = 0;
+            io->read(&count, 1, sizeof(uint64_t));
+            if (0 == binSampleCount ||
+                count != (sampleCount + binSampleCount - 1) / binSampleCount ||
+                count > (io->getSize() - io->getPos()) / (sizeof(float) * 3))
+            {
+                throw System::File::Error(String::Format("{0}: {1}").
+                    arg(fileName).
+                    arg(textSystem->getText(DJV_TEXT("error_waveform_cache"))));
+            }
+            std::vector<Bin> bins(count);
+            for (auto& i : bins)
+            {
+                io->readF32(&i.min);
+                io->readF32(&i.max);
+                io->readF32(&i.rms);
+            }
+            _sampleRate = sampleRate;
+            _binSampleCount = binSampleCount;
+            _sampleCount = sampleCount;
+            _levels.clear();
+            _levels.push_back(std::move(bins));
+            _binSamples = 0;
+            _binValues = 0;
+            _buildLevels();
+        }
+
+        void Waveform::write(const std::string& fileName, const System::File::Info& fileInfo) const
+        {
+            auto io = System::File::IO::create();
+            io->open(fileName, System::File::Mode::Write);
+            io->write(cacheMagic, sizeof(cacheMagic));
+            io->writeU32(cacheVersion);
+            const uint64_t size = fileInfo.getSize();
+            io->write(&size, 1, sizeof(uint64_t));
+            const int64_t time = fileInfo.getTime();
+            io->write(&time, 1, sizeof(int64_t));
+            const uint64_t sampleRate = _sampleRate;
+            io->write(&sampleRate, 1, sizeof(uint64_t));
+            const uint64_t binSampleCount = _binSampleCount;
+            io->write(&binSampleCount, 1, sizeof(uint64_t));
+            const uint64_t sampleCount = _sampleCount;
+            io->write(&sampleCount, 1, sizeof(uint64_t));
+            const uint64_t count = _levels.size() ? _levels[0].size() : 0;
+            io->write(&count, 1, sizeof(uint64_t));
+            if (count > 0)
+            {
+                for (const auto& i : _levels[0])
+                {
+                    io->writeF32(i.min);
+                    io->writeF32(i.max);
+                    io->writeF32(i.rms);
+                }
+            }
+        }
+
+        void Waveform::_addBin()
+        {
+            Bin bin;
+            bin.min = _binMin;
+            bin.max = _binMax;
+            bin.rms = _binValues > 0 ? sqrtf(_binSumSquares / _binValues) : 0.F;
+            _levels[0].push_back(bin);
+            _binSamples = 0;
+            _binValues = 0;
+        }
+
+        void Waveform::_buildLevels()
+        {
+            if (_levels.empty())
+            {
+                return;
+            }
+            _levels.resize(1);
+            while (_levels.back().size() > 1)
+            {
+                const auto& bins = _levels.back();
+                std::vector<Bin> level((bins.size() + 1) / 2);
+                for (size_t i = 0; i < level.size(); ++i)
+                {
+                    level[i] = 2 * i + 1 < bins.size() ?
+                        combine(bins[2 * i], bins[2 * i + 1]) :
+                        bins[2 * i];
+                }
+                _levels.push_back(std::move(level));
+            }
+        }
+
+    } // namespace Audio
+} // namespace djv
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAudio/Type.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace djv
+{
+    namespace System
+    {
+        class TextSystem;
+
+        namespace File
+        {
+            class Info;
+
+        } // namespace File
+    } // namespace System
+
+    namespace Audio
+    {
+        class Data;
+
+        //! This class provides a multi-resolution overview of audio for
+        //! drawing waveforms. The samples of all the channels are reduced to
+        //! their minimum, maximum, and RMS values in bins of a fixed number of
+        //! samples. Each level of the pyramid combines pairs of bins from the
+        //! level below, so any range can be drawn from the level that matches
+        //! the zoom without going back to the samples.
+        class Waveform
+        {
+        public:
+            Waveform();
+            explicit Waveform(size_t sampleRate, size_t binSampleCount = 512);
+
+            //! This struct provides the values of a bin.
+            struct Bin
+            {
+                float min = 0.F;
+                float max = 0.F;
+                float rms = 0.F;
+
+                bool operator == (const Bin&) const;
+            };
+
+            //! \name Information
+            ///@{
+
+            size_t getSampleRate() const;
+            size_t getBinSampleCount() const;
+            size_t getSampleCount() const;
+            size_t getLevelCount() const;
+            const std::vector<Bin>& getLevel(size_t) const;
+
+            ///@}
+
+            //! \name Building
+            ///@{
+
+            //! Add audio data. The data is added to the end of the waveform.
+            void add(const Data&);
+
+            //! Finish adding audio data and build the levels.
+            void finish();
+
+            ///@}
+
+            //! \name Drawing
+            ///@{
+
+            //! Get the bins for a range of samples divided into a number of
+            //! columns, for example the pixels of a widget. The level with the
+            //! largest bins that are not wider than a column is used, so the
+            //! cost only depends on the number of columns.
+            std::vector<Bin> getBins(size_t start, size_t end, size_t count) const;
+
+            ///@}
+
+            //! \name Cache
+            ///@{
+
+            //! Get the name of the cache file for a media file. The name is
+            //! made from the path, modification time, and size of the file.
+            static std::string getCacheFileName(const System::File::Info&);
+
+            //! Read the waveform from a cache file.
+            //! Throws:
+            //! - System::File::Error
+            void read(
+                const std::string& fileName,
+                const System::File::Info&,
+                const std::shared_ptr<System::TextSystem>&);
+
+            //! Write the waveform to a cache file. Only the first level is
+            //! written, the others are built again when it is read.
+            //! Throws:
+            //! - System::File::Error
+            void write(const std::string& fileName, const System::File::Info&) const;
+
+            ///@}
+
+        private:
+            void _addBin();
+            void _buildLevels();
+
+            size_t _sampleRate = 0;
+            size_t _binSampleCount = 512;
+            size_t _sampleCount = 0;
+            std::vector<std::vector<Bin> > _levels;
+
+            float  _binMin = 0.F;
+            float  _binMax = 0.F;
+            float  _binSumSquares = 0.F;
+            size_t _binSamples = 0;
+            size_t _binValues = 0;
+        };
+
+    } // namespace Audio
+} // namespace djv
+
+#include <djvAudio/WaveformInline.h>
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace Audio
+    {
+        inline size_t Waveform::getSampleRate() const
+        {
+            return _sampleRate;
+        }
+
+        inline size_t Waveform::getBinSampleCount() const
+        {
+            return _binSampleCount;
+        }
+
+        inline size_t Waveform::getSampleCount() const
+        {
+            return _sampleCount;
+        }
+
+        inline size_t Waveform::getLevelCount() const
+        {
+            return _levels.size();
+        }
+
+        inline const std::vector<Waveform::Bin>& Waveform::getLevel(size_t value) const
+        {
+            return _levels[value];
+        }
+
+        inline bool Waveform::Bin::operator == (const Bin& other) const
+        {
+            return
+                min == other.min &&
+                max == other.max &&
+                rms == other.rms;
+        }
+
+    } // namespace Audio
+} // namespace djv
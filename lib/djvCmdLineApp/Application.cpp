@@ -39,7 +39,7 @@ namespace djv
             int exit = 0;
         };
 
-        void Application::_init(std::list<std::string>& args)
+        void Application::_init(std::list<std::string>& args, bool gl)
         {
             std::string argv0;
             if (args.size())
@@ -78,7 +78,7 @@ namespace djv
             }
 
             // Create the systems.
-            AV::AVSystem::create(shared_from_this());
+            AV::AVSystem::create(shared_from_this(), gl);
         }
 
         Application::Application() :
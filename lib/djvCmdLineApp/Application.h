@@ -26,7 +26,9 @@ namespace djv
             DJV_NON_COPYABLE(Application);
 
         protected:
-            void _init(std::list<std::string>&);
+            //! Applications that do not render can disable OpenGL so that they
+            //! run without a display.
+            void _init(std::list<std::string>&, bool gl = true);
             Application();
 
         public:
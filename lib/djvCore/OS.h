@@ -20,6 +20,18 @@ namespace djv
                 Unix,
                 Windows
             };
+
+            //! This enumeration provides the SIMD instruction sets used for
+            //! optimized code paths, each level includes the previous ones.
+            enum class SIMD
+            {
+                None,
+                SSE41,  //!< SSE4.1
+                AVX2,   //!< AVX2, FMA, and F16C
+
+                Count,
+                First = None
+            };
             
         } // namespace OS
     } // namespace Core
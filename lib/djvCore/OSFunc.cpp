@@ -6,6 +6,15 @@
 
 #include <djvCore/StringFunc.h>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+#include <algorithm>
+
 //#pragma optimize("", off)
 
 namespace djv
@@ -14,6 +23,83 @@ namespace djv
     {
         namespace OS
         {
+            namespace
+            {
+                SIMD getCPUSIMD()
+                {
+                    SIMD out = SIMD::None;
+                    unsigned int info[4] = { 0, 0, 0, 0 };
+                    unsigned int info7[4] = { 0, 0, 0, 0 };
+                    bool ymm = false;
+#if defined(__x86_64__) || defined(__i386__)
+                    if (__get_cpuid(1, &info[0], &info[1], &info[2], &info[3]))
+                    {
+                        __get_cpuid_count(7, 0, &info7[0], &info7[1], &info7[2], &info7[3]);
+                        if (info[2] & (1 << 27))
+                        {
+                            // Check that the operating system saves the AVX registers.
+                            unsigned int eax = 0;
+                            unsigned int edx = 0;
+                            __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+                            ymm = (eax & 0x6) == 0x6;
+                        }
+                    }
+#elif defined(_M_X64) || defined(_M_IX86)
+                    int tmp[4] = { 0, 0, 0, 0 };
+                    __cpuid(tmp, 1);
+                    for (size_t i = 0; i < 4; ++i)
+                    {
+                        info[i] = static_cast<unsigned int>(tmp[i]);
+                    }
+                    __cpuidex(tmp, 7, 0);
+                    for (size_t i = 0; i < 4; ++i)
+                    {
+                        info7[i] = static_cast<unsigned int>(tmp[i]);
+                    }
+                    if (info[2] & (1 << 27))
+                    {
+                        ymm = (_xgetbv(0) & 0x6) == 0x6;
+                    }
+#endif
+                    if (info[2] & (1 << 19))
+                    {
+                        out = SIMD::SSE41;
+                        const bool avx = (info[2] & (1 << 28)) != 0;
+                        const bool fma = (info[2] & (1 << 12)) != 0;
+                        const bool f16c = (info[2] & (1 << 29)) != 0;
+                        const bool avx2 = (info7[1] & (1 << 5)) != 0;
+                        if (ymm && avx && fma && f16c && avx2)
+                        {
+                            out = SIMD::AVX2;
+                        }
+                    }
+                    return out;
+                }
+
+            } // namespace
+
+            SIMD getSIMD()
+            {
+                static const SIMD out = []
+                {
+                    SIMD simd = getCPUSIMD();
+                    try
+                    {
+                        int env = 0;
+                        if (getIntEnv("DJV_SIMD", env))
+                        {
+                            simd = static_cast<SIMD>(std::min(
+                                static_cast<int>(simd),
+                                std::max(env, static_cast<int>(SIMD::None))));
+                        }
+                    }
+                    catch (const std::exception&)
+                    {}
+                    return simd;
+                }();
+                return out;
+            }
+
             bool getStringListEnv(const std::string& name, std::vector<std::string>& out)
             {
                 std::string value;
@@ -33,6 +33,11 @@ namespace djv
             //! Get the width of the terminal.
             int getTerminalWidth();
 
+            //! Get the SIMD instruction set supported by the CPU. The
+            //! DJV_SIMD environment variable can be used to lower the level,
+            //! for example setting it to zero disables the SIMD code paths.
+            SIMD getSIMD();
+
             ///@}
 
             //! \name Environment Variables
@@ -145,9 +145,10 @@ namespace djv
 
             p.vao->draw(GL_TRIANGLES, 0, 6);
 
-            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            glPixelStorei(GL_PACK_ALIGNMENT, out.getLayout().alignment);
 #if !defined(DJV_GL_ES2)
             glPixelStorei(GL_PACK_SWAP_BYTES, info.layout.endian != Memory::getEndian());
+            glPixelStorei(GL_PACK_ROW_LENGTH, out.getInfo().getGLRowLength());
 #endif // DJV_GL_ES2
             glReadPixels(
                 0, 0, info.size.w, info.size.h,
@@ -126,16 +126,36 @@ namespace djv
 #if defined(DJV_GL_ES2)
             glBindTexture(GL_TEXTURE_2D, _id);
             glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
-            glTexSubImage2D(
-                GL_TEXTURE_2D,
-                0,
-                0,
-                0,
-                info.size.w,
-                info.size.h,
-                info.getGLFormat(),
-                info.getGLType(),
-                data.getData());
+            if (info.layout.rowPadding)
+            {
+                // OpenGL ES 2 does not support GL_UNPACK_ROW_LENGTH.
+                for (uint16_t i = 0; i < info.size.h; ++i)
+                {
+                    glTexSubImage2D(
+                        GL_TEXTURE_2D,
+                        0,
+                        0,
+                        0 + i,
+                        info.size.w,
+                        1,
+                        info.getGLFormat(),
+                        info.getGLType(),
+                        data.getData(i));
+                }
+            }
+            else
+            {
+                glTexSubImage2D(
+                    GL_TEXTURE_2D,
+                    0,
+                    0,
+                    0,
+                    info.size.w,
+                    info.size.h,
+                    info.getGLFormat(),
+                    info.getGLType(),
+                    data.getData());
+            }
 #else // DJV_GL_ES2
 
 #if defined(DJV_GL_PBO)
@@ -152,6 +172,7 @@ namespace djv
             glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != Memory::getEndian());
             glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
             glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, info.getGLRowLength());
             glTexSubImage2D(
                 GL_TEXTURE_2D,
                 0,
@@ -178,16 +199,36 @@ namespace djv
 #if defined(DJV_GL_ES2)
             glBindTexture(GL_TEXTURE_2D, _id);
             glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
-            glTexSubImage2D(
-                GL_TEXTURE_2D,
-                0,
-                x,
-                y,
-                info.size.w,
-                info.size.h,
-                info.getGLFormat(),
-                info.getGLType(),
-                data.getData());
+            if (info.layout.rowPadding)
+            {
+                // OpenGL ES 2 does not support GL_UNPACK_ROW_LENGTH.
+                for (uint16_t i = 0; i < info.size.h; ++i)
+                {
+                    glTexSubImage2D(
+                        GL_TEXTURE_2D,
+                        0,
+                        x,
+                        y + i,
+                        info.size.w,
+                        1,
+                        info.getGLFormat(),
+                        info.getGLType(),
+                        data.getData(i));
+                }
+            }
+            else
+            {
+                glTexSubImage2D(
+                    GL_TEXTURE_2D,
+                    0,
+                    x,
+                    y,
+                    info.size.w,
+                    info.size.h,
+                    info.getGLFormat(),
+                    info.getGLType(),
+                    data.getData());
+            }
 #else // DJV_GL_ES2
 
 #if defined(DJV_GL_PBO)
@@ -204,6 +245,7 @@ namespace djv
             glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != Memory::getEndian());
             glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
             glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, info.getGLRowLength());
             glTexSubImage2D(
                 GL_TEXTURE_2D,
                 0,
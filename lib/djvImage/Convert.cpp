@@ -0,0 +1,598 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImage/Convert.h>
+
+#include <djvImage/Data.h>
+#include <djvImage/TypeFunc.h>
+
+#include <djvSystem/ThreadPool.h>
+
+#include <djvCore/MemoryFunc.h>
+#include <djvCore/OSFunc.h>
+#include <djvCore/UIDFunc.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define DJV_IMAGE_CONVERT_X86
+#include <immintrin.h>
+#endif // __x86_64__
+
+// The SIMD kernels are compiled for their instruction sets with function
+// attributes so that the rest of the library does not require them.
+#if defined(__GNUC__) || defined(__clang__)
+#define DJV_IMAGE_CONVERT_SSE41 __attribute__((target("sse4.1")))
+#define DJV_IMAGE_CONVERT_AVX2 __attribute__((target("avx2,fma,f16c")))
+#else // __GNUC__
+#define DJV_IMAGE_CONVERT_SSE41
+#define DJV_IMAGE_CONVERT_AVX2
+#endif // __GNUC__
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace Image
+    {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const size_t chunkByteCount = 256 * 1024;
+
+            typedef void (*Kernel)(const uint8_t*, uint8_t*, size_t);
+
+            // Unlike the scalar conversions these clamp values that are
+            // negative or not a number to zero, to match the SIMD kernels.
+            inline U8_T clampU8(float value)
+            {
+                return value > 0.F ?
+                    (value < U8Range.getMax() ? static_cast<U8_T>(value) : U8Range.getMax()) :
+                    U8Range.getMin();
+            }
+
+            inline U16_T clampU16(float value)
+            {
+                return value > 0.F ?
+                    (value < U16Range.getMax() ? static_cast<U16_T>(value) : U16Range.getMax()) :
+                    U16Range.getMin();
+            }
+
+#if defined(DJV_IMAGE_CONVERT_X86)
+            DJV_IMAGE_CONVERT_SSE41 void convertU8F32SSE41(const uint8_t* in, uint8_t* out, size_t count)
+            {
+                const U8_T* inP = in;
+                F32_T* outP = reinterpret_cast<F32_T*>(out);
+                const __m128 scale = _mm_set1_ps(static_cast<float>(U8Range.getMax()));
+                size_t i = 0;
+                for (; i + 16 <= count; i += 16)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    _mm_storeu_ps(outP + i, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(v)), scale));
+                    _mm_storeu_ps(outP + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 4))), scale));
+                    _mm_storeu_ps(outP + i + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 8))), scale));
+                    _mm_storeu_ps(outP + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 12))), scale));
+                }
+                for (; i < count; ++i)
+                {
+                    convert_U8_F32(inP[i], outP[i]);
+                }
+            }
+
+            DJV_IMAGE_CONVERT_SSE41 void convertF32U8SSE41(const uint8_t* in, uint8_t* out, size_t count)
+            {
+                const F32_T* inP = reinterpret_cast<const F32_T*>(in);
+                U8_T* outP = out;
+                const __m128 scale = _mm_set1_ps(static_cast<float>(U8Range.getMax()));
+                const __m128 zero = _mm_setzero_ps();
+                size_t i = 0;
+                for (; i + 16 <= count; i += 16)
+                {
+                    __m128i v[4];
+                    for (size_t j = 0; j < 4; ++j)
+                    {
+                        const __m128 f = _mm_mul_ps(_mm_loadu_ps(inP + i + j * 4), scale);
+                        v[j] = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(f, zero), scale));
+                    }
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(outP + i),
+                        _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3])));
+                }
+                for (; i < count; ++i)
+                {
+                    outP[i] = clampU8(inP[i] * U8Range.getMax());
+                }
+            }
+
+            DJV_IMAGE_CONVERT_SSE41 void convertU16F32SSE41(const uint8_t* in, uint8_t* out, size_t count)
+            {
+                const U16_T* inP = reinterpret_cast<const U16_T*>(in);
+                F32_T* outP = reinterpret_cast<F32_T*>(out);
+                const __m128 scale = _mm_set1_ps(static_cast<float>(U16Range.getMax()));
+                size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    _mm_storeu_ps(outP + i, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu16_epi32(v)), scale));
+                    _mm_storeu_ps(outP + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_srli_si128(v, 8))), scale));
+                }
+                for (; i < count; ++i)
+                {
+                    convert_U16_F32(inP[i], outP[i]);
+                }
+            }
+
+            DJV_IMAGE_CONVERT_SSE41 void convertF32U16SSE41(const uint8_t* in, uint8_t* out, size_t count)
+            {
+                const F32_T* inP = reinterpret_cast<const F32_T*>(in);
+                U16_T* outP = reinterpret_cast<U16_T*>(out);
+                const __m128 scale = _mm_set1_ps(static_cast<float>(U16Range.getMax()));
+                const __m128 zero = _mm_setzero_ps();
+                size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m128 f0 = _mm_mul_ps(_mm_loadu_ps(inP + i), scale);
+                    const __m128 f1 = _mm_mul_ps(_mm_loadu_ps(inP + i + 4), scale);
+                    const __m128i v0 = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(f0, zero), scale));
+                    const __m128i v1 = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(f1, zero), scale));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i), _mm_packus_epi32(v0, v1));
+                }
+                for (; i < count; ++i)
+                {
+                    outP[i] = clampU16(inP[i] * U16Range.getMax());
+                }
+            }
+
+            DJV_IMAGE_CONVERT_SSE41 void convertU16U8SSE41(const uint8_t* in, uint8_t* out, size_t count)
+            {
+                const U16_T* inP = reinterpret_cast<const U16_T*>(in);
+                U8_T* outP = out;
+                size_t i = 0;
+                for (; i + 16 <= count; i += 16)
+                {
+                    const __m128i v0 = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i)), 8);
+                    const __m128i v1 = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i + 8)), 8);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i), _mm_packus_epi16(v0, v1));
+                }
+                for (; i < count; ++i)
+                {
+                    convert_U16_U8(inP[i], outP[i]);
+                }
+            }
+
+            DJV_IMAGE_CONVERT_SSE41 void convertU8U16SSE41(const uint8_t* in, uint8_t* out, size_t count)
+            {
+                const U8_T* inP = in;
+                U16_T* outP = reinterpret_cast<U16_T*>(out);
+                size_t i = 0;
+                for (; i + 16 <= count; i += 16)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(outP + i),
+                        _mm_slli_epi16(_mm_cvtepu8_epi16(v), 8));
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(outP + i + 8),
+                        _mm_slli_epi16(_mm_cvtepu8_epi16(_mm_srli_si128(v, 8)), 8));
+                }
+                for (; i < count; ++i)
+                {
+                    convert_U8_U16(inP[i], outP[i]);
+                }
+            }
+
+            DJV_IMAGE_CONVERT_AVX2 void convertU8F32AVX2(const uint8_t* in, uint8_t* out, size_t count)
+            {
+                const U8_T* inP = in;
+                F32_T* outP = reinterpret_cast<F32_T*>(out);
+                const __m256 scale = _mm256_set1_ps(static_cast<float>(U8Range.getMax()));
+                size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(inP + i));
+                    _mm256_storeu_ps(outP + i, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v)), scale));
+                }
+                for (; i < count; ++i)
+                {
+                    convert_U8_F32(inP[i], outP[i]);
+                }
+            }
+
+            DJV_IMAGE_CONVERT_AVX2 void convertF32U8AVX2(const uint8_t* in, uint8_t* out, size_t count)
+            {
+                const F32_T* inP = reinterpret_cast<const F32_T*>(in);
+                U8_T* outP = out;
+                const __m256 scale = _mm256_set1_ps(static_cast<float>(U8Range.getMax()));
+                const __m256 zero = _mm256_setzero_ps();
+                const __m256i permute = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+                size_t i = 0;
+                for (; i + 32 <= count; i += 32)
+                {
+                    __m256i v[4];
+                    for (size_t j = 0; j < 4; ++j)
+                    {
+                        const __m256 f = _mm256_mul_ps(_mm256_loadu_ps(inP + i + j * 8), scale);
+                        v[j] = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(f, zero), scale));
+                    }
+                    // The packing works within each 128-bit lane so the
+                    // result is put back in order with a permute.
+                    const __m256i packed = _mm256_packus_epi16(
+                        _mm256_packs_epi32(v[0], v[1]),
+                        _mm256_packs_epi32(v[2], v[3]));
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i*>(outP + i),
+                        _mm256_permutevar8x32_epi32(packed, permute));
+                }
+                for (; i < count; ++i)
+                {
+                    outP[i] = clampU8(inP[i] * U8Range.getMax());
+                }
+            }
+
+            DJV_IMAGE_CONVERT_AVX2 void convertU16F32AVX2(const uint8_t* in, uint8_t* out, size_t count)
+            {
+                const U16_T* inP = reinterpret_cast<const U16_T*>(in);
+                F32_T* outP = reinterpret_cast<F32_T*>(out);
+                const __m256 scale = _mm256_set1_ps(static_cast<float>(U16Range.getMax()));
+                size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    _mm256_storeu_ps(outP + i, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(v)), scale));
+                }
+                for (; i < count; ++i)
+                {
+                    convert_U16_F32(inP[i], outP[i]);
+                }
+            }
+
+            DJV_IMAGE_CONVERT_AVX2 void convertF32U16AVX2(const uint8_t* in, uint8_t* out, size_t count)
+            {
+                const F32_T* inP = reinterpret_cast<const F32_T*>(in);
+                U16_T* outP = reinterpret_cast<U16_T*>(out);
+                const __m256 scale = _mm256_set1_ps(static_cast<float>(U16Range.getMax()));
+                const __m256 zero = _mm256_setzero_ps();
+                size_t i = 0;
+                for (; i + 16 <= count; i += 16)
+                {
+                    const __m256 f0 = _mm256_mul_ps(_mm256_loadu_ps(inP + i), scale);
+                    const __m256 f1 = _mm256_mul_ps(_mm256_loadu_ps(inP + i + 8), scale);
+                    const __m256i v0 = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(f0, zero), scale));
+                    const __m256i v1 = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(f1, zero), scale));
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i*>(outP + i),
+                        _mm256_permute4x64_epi64(_mm256_packus_epi32(v0, v1), _MM_SHUFFLE(3, 1, 2, 0)));
+                }
+                for (; i < count; ++i)
+                {
+                    outP[i] = clampU16(inP[i] * U16Range.getMax());
+                }
+            }
+
+            DJV_IMAGE_CONVERT_AVX2 void convertF16F32AVX2(const uint8_t* in, uint8_t* out, size_t count)
+            {
+                const F16_T* inP = reinterpret_cast<const F16_T*>(in);
+                F32_T* outP = reinterpret_cast<F32_T*>(out);
+                size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    _mm256_storeu_ps(outP + i, _mm256_cvtph_ps(v));
+                }
+                for (; i < count; ++i)
+                {
+                    convert_F16_F32(inP[i], outP[i]);
+                }
+            }
+
+            DJV_IMAGE_CONVERT_AVX2 void convertF32F16AVX2(const uint8_t* in, uint8_t* out, size_t count)
+            {
+                const F32_T* inP = reinterpret_cast<const F32_T*>(in);
+                F16_T* outP = reinterpret_cast<F16_T*>(out);
+                size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(outP + i),
+                        _mm256_cvtps_ph(_mm256_loadu_ps(inP + i), _MM_FROUND_TO_NEAREST_INT));
+                }
+                for (; i < count; ++i)
+                {
+                    convert_F32_F16(inP[i], outP[i]);
+                }
+            }
+#endif // DJV_IMAGE_CONVERT_X86
+
+            Kernel getKernel(DataType in, DataType out, OS::SIMD simd)
+            {
+                Kernel kernel = nullptr;
+#if defined(DJV_IMAGE_CONVERT_X86)
+                if (simd >= OS::SIMD::AVX2)
+                {
+                    if (DataType::U8 == in && DataType::F32 == out)
+                        kernel = convertU8F32AVX2;
+                    else if (DataType::F32 == in && DataType::U8 == out)
+                        kernel = convertF32U8AVX2;
+                    else if (DataType::U16 == in && DataType::F32 == out)
+                        kernel = convertU16F32AVX2;
+                    else if (DataType::F32 == in && DataType::U16 == out)
+                        kernel = convertF32U16AVX2;
+                    else if (DataType::F16 == in && DataType::F32 == out)
+                        kernel = convertF16F32AVX2;
+                    else if (DataType::F32 == in && DataType::F16 == out)
+                        kernel = convertF32F16AVX2;
+                }
+                if (!kernel && simd >= OS::SIMD::SSE41)
+                {
+                    if (DataType::U8 == in && DataType::F32 == out)
+                        kernel = convertU8F32SSE41;
+                    else if (DataType::F32 == in && DataType::U8 == out)
+                        kernel = convertF32U8SSE41;
+                    else if (DataType::U16 == in && DataType::F32 == out)
+                        kernel = convertU16F32SSE41;
+                    else if (DataType::F32 == in && DataType::U16 == out)
+                        kernel = convertF32U16SSE41;
+                    else if (DataType::U16 == in && DataType::U8 == out)
+                        kernel = convertU16U8SSE41;
+                    else if (DataType::U8 == in && DataType::U16 == out)
+                        kernel = convertU8U16SSE41;
+                }
+#endif // DJV_IMAGE_CONVERT_X86
+                return kernel;
+            }
+
+            void convertRow(const uint8_t* in, Type inType, uint8_t* out, Type outType, size_t width, OS::SIMD simd)
+            {
+                if (inType == outType)
+                {
+                    memcpy(out, in, width * getByteCount(inType));
+                }
+                else
+                {
+                    // The SIMD kernels only change the data type, conversions
+                    // between channels use the scalar functions.
+                    Kernel kernel = nullptr;
+                    if (getChannelCount(inType) == getChannelCount(outType))
+                    {
+                        kernel = getKernel(getDataType(inType), getDataType(outType), simd);
+                    }
+                    if (kernel)
+                    {
+                        kernel(in, out, width * getChannelCount(inType));
+                    }
+                    else
+                    {
+                        convert(in, inType, out, outType, width);
+                    }
+                }
+            }
+
+            size_t getEndianWordSize(Type value)
+            {
+                // The 10-bit data is packed into 32-bit words.
+                return DataType::U10 == getDataType(value) ?
+                    getByteCount(value) :
+                    getByteCount(getDataType(value));
+            }
+
+            void mirrorRow(uint8_t* data, size_t width, size_t pixelByteCount)
+            {
+                uint8_t tmp[16];
+                uint8_t* a = data;
+                uint8_t* b = data + (width - 1) * pixelByteCount;
+                for (; a < b; a += pixelByteCount, b -= pixelByteCount)
+                {
+                    memcpy(tmp, a, pixelByteCount);
+                    memcpy(a, b, pixelByteCount);
+                    memcpy(b, tmp, pixelByteCount);
+                }
+            }
+
+        } // namespace
+
+        struct Convert::Private
+        {
+            std::shared_ptr<System::ThreadPool> threadPool;
+            OS::SIMD simd = OS::SIMD::None;
+        };
+
+        void Convert::_init(const std::shared_ptr<System::ThreadPool>& threadPool)
+        {
+            DJV_PRIVATE_PTR();
+            p.threadPool = threadPool;
+            p.simd = OS::getSIMD();
+        }
+
+        Convert::Convert() :
+            _p(new Private)
+        {}
+
+        Convert::~Convert()
+        {}
+
+        std::shared_ptr<Convert> Convert::create(const std::shared_ptr<System::ThreadPool>& threadPool)
+        {
+            auto out = std::shared_ptr<Convert>(new Convert);
+            out->_init(threadPool);
+            return out;
+        }
+
+        OS::SIMD Convert::getSIMD() const
+        {
+            return _p->simd;
+        }
+
+        void Convert::setSIMD(OS::SIMD value)
+        {
+            _p->simd = std::min(value, OS::getSIMD());
+        }
+
+        void Convert::process(const Data& data, const Info& info, Data& out)
+        {
+            DJV_PRIVATE_PTR();
+            const Info& inInfo = data.getInfo();
+            if (!inInfo.isValid() || !info.isValid())
+            {
+                return;
+            }
+
+            const OS::SIMD simd = p.simd;
+            const size_t inW = inInfo.size.w;
+            const size_t inH = inInfo.size.h;
+            const size_t outW = info.size.w;
+            const size_t outH = info.size.h;
+            const bool resize = inW != outW || inH != outH;
+            const bool mirrorX = inInfo.layout.mirror.x != info.layout.mirror.x;
+            const bool mirrorY = inInfo.layout.mirror.y != info.layout.mirror.y;
+            const size_t inWordSize = getEndianWordSize(inInfo.type);
+            const size_t outWordSize = getEndianWordSize(info.type);
+            const bool inEndian = inWordSize > 1 && inInfo.layout.endian != Memory::getEndian();
+            const bool outEndian = outWordSize > 1 && info.layout.endian != Memory::getEndian();
+            const size_t inPixelByteCount = inInfo.getPixelByteCount();
+            const size_t outPixelByteCount = info.getPixelByteCount();
+
+            // Resizing is done with a box filter on 32-bit float data that
+            // already has the output channels.
+            const uint8_t channelCount = getChannelCount(info.type);
+            const Type floatType = getFloatType(channelCount, 32);
+
+            const size_t rowsPerChunk = std::max(
+                static_cast<size_t>(1),
+                chunkByteCount / std::max(inInfo.getScanlineByteCount(), info.getScanlineByteCount()));
+            const size_t chunkCount = (outH + rowsPerChunk - 1) / rowsPerChunk;
+            std::atomic<size_t> chunk(0);
+            const auto work = [&]
+            {
+                std::vector<uint8_t> swapRow(inEndian ? inW * inPixelByteCount : 0);
+                std::vector<float> floatRow(resize ? inW * channelCount : 0);
+                std::vector<float> accumRow(resize ? inW * channelCount : 0);
+                std::vector<float> resizeRow(resize ? outW * channelCount : 0);
+                size_t i = 0;
+                while ((i = chunk.fetch_add(1)) < chunkCount)
+                {
+                    const size_t y0 = i * rowsPerChunk;
+                    const size_t y1 = std::min(y0 + rowsPerChunk, outH);
+                    for (size_t y = y0; y < y1; ++y)
+                    {
+                        uint8_t* outRow = out.getData(static_cast<uint16_t>(y));
+                        if (!resize)
+                        {
+                            const uint8_t* inRow = data.getData(static_cast<uint16_t>(mirrorY ? (inH - 1 - y) : y));
+                            if (inEndian)
+                            {
+                                Memory::endian(inRow, swapRow.data(), inW * inPixelByteCount / inWordSize, inWordSize);
+                                inRow = swapRow.data();
+                            }
+                            convertRow(inRow, inInfo.type, outRow, info.type, outW, simd);
+                        }
+                        else
+                        {
+                            const size_t sy0 = y * inH / outH;
+                            const size_t sy1 = std::max(sy0 + 1, (y + 1) * inH / outH);
+                            std::fill(accumRow.begin(), accumRow.end(), 0.F);
+                            for (size_t sy = sy0; sy < sy1; ++sy)
+                            {
+                                const uint8_t* inRow = data.getData(static_cast<uint16_t>(mirrorY ? (inH - 1 - sy) : sy));
+                                if (inEndian)
+                                {
+                                    Memory::endian(inRow, swapRow.data(), inW * inPixelByteCount / inWordSize, inWordSize);
+                                    inRow = swapRow.data();
+                                }
+                                convertRow(
+                                    inRow,
+                                    inInfo.type,
+                                    reinterpret_cast<uint8_t*>(floatRow.data()),
+                                    floatType,
+                                    inW,
+                                    simd);
+                                for (size_t j = 0; j < accumRow.size(); ++j)
+                                {
+                                    accumRow[j] += floatRow[j];
+                                }
+                            }
+                            for (size_t x = 0; x < outW; ++x)
+                            {
+                                const size_t sx0 = x * inW / outW;
+                                const size_t sx1 = std::max(sx0 + 1, (x + 1) * inW / outW);
+                                const float scale = 1.F / ((sy1 - sy0) * (sx1 - sx0));
+                                for (size_t c = 0; c < channelCount; ++c)
+                                {
+                                    float sum = 0.F;
+                                    for (size_t sx = sx0; sx < sx1; ++sx)
+                                    {
+                                        sum += accumRow[sx * channelCount + c];
+                                    }
+                                    resizeRow[x * channelCount + c] = sum * scale;
+                                }
+                            }
+                            convertRow(
+                                reinterpret_cast<const uint8_t*>(resizeRow.data()),
+                                floatType,
+                                outRow,
+                                info.type,
+                                outW,
+                                simd);
+                        }
+                        if (mirrorX)
+                        {
+                            mirrorRow(outRow, outW, outPixelByteCount);
+                        }
+                        if (outEndian)
+                        {
+                            Memory::endian(outRow, outW * outPixelByteCount / outWordSize, outWordSize);
+                        }
+                    }
+                }
+            };
+
+            // The calling thread also does the work, so the jobs that have
+            // not started when it finishes are cancelled rather than waited on.
+            std::vector<std::future<void> > futures;
+            const UID group = createUID();
+            if (p.threadPool && chunkCount > 1)
+            {
+                const size_t jobCount = std::min(p.threadPool->getThreadCount(), chunkCount - 1);
+                for (size_t i = 0; i < jobCount; ++i)
+                {
+                    futures.push_back(p.threadPool->submit(work, System::ThreadPool::Priority::High, group));
+                }
+            }
+            std::exception_ptr error;
+            try
+            {
+                work();
+            }
+            catch (const std::exception&)
+            {
+                error = std::current_exception();
+            }
+            if (p.threadPool)
+            {
+                p.threadPool->cancel(group);
+            }
+            for (auto& future : futures)
+            {
+                try
+                {
+                    future.get();
+                }
+                catch (const std::future_error&)
+                {}
+                catch (const std::exception&)
+                {
+                    error = std::current_exception();
+                }
+            }
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+    } // namespace Image
+} // namespace djv
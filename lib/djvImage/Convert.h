@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+#include <djvCore/OS.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace System
+    {
+        class ThreadPool;
+
+    } // namespace System
+
+    namespace Image
+    {
+        class Data;
+        class Info;
+
+        //! This class provides image conversion on the CPU.
+        //!
+        //! This is an alternative to GL::ImageConvert for when there is no
+        //! OpenGL context. The conversion handles every pair of image types,
+        //! the endian, mirroring, alignment, and row padding of the layouts,
+        //! and resizing with a box filter. The common data type conversions
+        //! use SSE4.1 or AVX2 kernels when the CPU supports them, and the
+        //! scanlines are split across the thread pool.
+        class Convert
+        {
+            DJV_NON_COPYABLE(Convert);
+            void _init(const std::shared_ptr<System::ThreadPool>&);
+            Convert();
+
+        public:
+            ~Convert();
+
+            //! Create a new image converter. If the thread pool is not set
+            //! the conversion runs on the calling thread.
+            static std::shared_ptr<Convert> create(const std::shared_ptr<System::ThreadPool>& = nullptr);
+
+            //! \name SIMD
+            ///@{
+
+            //! Get the SIMD instruction set used for the conversion. This
+            //! defaults to Core::OS::getSIMD().
+            Core::OS::SIMD getSIMD() const;
+
+            //! Set the SIMD instruction set. Levels above what the CPU
+            //! supports are clamped.
+            void setSIMD(Core::OS::SIMD);
+
+            ///@}
+
+            //! \name Conversion
+            ///@{
+
+            //! Convert the image data to the given information. The output
+            //! data must have been created with the same information.
+            void process(const Data&, const Info&, Data&);
+
+            ///@}
+
+        private:
+            DJV_PRIVATE();
+        };
+
+    } // namespace Image
+} // namespace djv
@@ -4,6 +4,8 @@
 
 #include <djvImage/Data.h>
 
+#include <djvImage/DataPool.h>
+
 #include <djvCore/UIDFunc.h>
 
 namespace djv
@@ -19,7 +21,8 @@ namespace djv
             _dataByteCount = info.getDataByteCount();
             if (_dataByteCount)
             {
-                _data = new uint8_t[_dataByteCount];
+                _pool = DataPool::getGlobal();
+                _data = _pool->get(_dataByteCount, _bufferByteCount);
                 _p = _data;
             }
         }
@@ -29,7 +32,10 @@ namespace djv
 
         Data::~Data()
         {
-            delete[] _data;
+            if (_pool)
+            {
+                _pool->release(_data, _bufferByteCount);
+            }
         }
 
         std::shared_ptr<Data> Data::create(const Info& info)
@@ -49,6 +55,16 @@ namespace djv
             _tags = value;
         }
 
+        void Data::setOrigin(const glm::ivec2& value)
+        {
+            _origin = value;
+        }
+
+        void Data::setScale(uint16_t value)
+        {
+            _scale = value;
+        }
+
         void Data::zero()
         {
             memset(_data, 0, _dataByteCount);
@@ -58,9 +74,7 @@ namespace djv
         {
             if (other._info == _info)
             {
-#if defined(DJV_GL_ES2)
-                return 0 == memcmp(other._p, _p, _dataByteCount);
-#else
+#if !defined(DJV_GL_ES2)
                 if (GL_UNSIGNED_INT_10_10_10_2 == _info.getGLType())
                 {
                     for (uint16_t y = 0; y < _info.size.h; ++y)
@@ -77,11 +91,21 @@ namespace djv
                     }
                     return true;
                 }
-                else
+#endif // DJV_GL_ES2
+                if (_info.layout.rowPadding)
                 {
-                    return 0 == memcmp(other._p, _p, _dataByteCount);
+                    // Don't compare the padding.
+                    const size_t byteCount = _info.size.w * static_cast<size_t>(_pixelByteCount);
+                    for (uint16_t y = 0; y < _info.size.h; ++y)
+                    {
+                        if (memcmp(other.getData(y), getData(y), byteCount) != 0)
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
                 }
-#endif
+                return 0 == memcmp(other._p, _p, _dataByteCount);
             }
             return false;
         }
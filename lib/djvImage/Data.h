@@ -9,13 +9,22 @@
 
 #include <djvCore/UID.h>
 
+#include <glm/vec2.hpp>
+
 #include <memory>
 
 namespace djv
 {
     namespace Image
     {
+        class DataPool;
+
         //! This class provides image data.
+        //!
+        //! The image memory is taken from the global DataPool and returned
+        //! to it when the data is destroyed. The memory is aligned to
+        //! Image::dataAlignment, the scanlines are also aligned when the
+        //! layout uses row padding.
         class Data
         {
             DJV_NON_COPYABLE(Data);
@@ -77,6 +86,28 @@ namespace djv
 
             ///@}
 
+            //! \name Origin
+            ///@{
+
+            //! Get the position of the data in the full image. This is set
+            //! when only a region of the image was read.
+            const glm::ivec2& getOrigin() const;
+
+            void setOrigin(const glm::ivec2&);
+
+            ///@}
+
+            //! \name Scale
+            ///@{
+
+            //! Get the scale of the full image relative to the data. This is
+            //! set when the image was read at a reduced resolution.
+            uint16_t getScale() const;
+
+            void setScale(uint16_t);
+
+            ///@}
+
             //! \name Utility
             ///@{
 
@@ -94,9 +125,13 @@ namespace djv
             size_t _scanlineByteCount = 0;
             size_t _dataByteCount = 0;
             std::string _pluginName;
+            std::shared_ptr<DataPool> _pool;
+            size_t _bufferByteCount = 0;
             uint8_t* _data = nullptr;
             const uint8_t* _p = nullptr;
             Tags _tags;
+            glm::ivec2 _origin = glm::ivec2(0, 0);
+            uint16_t _scale = 1;
         };
 
     } // namespace Image
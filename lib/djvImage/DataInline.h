@@ -118,5 +118,15 @@ namespace djv
             return _tags;
         }
 
+        inline const glm::ivec2& Data::getOrigin() const
+        {
+            return _origin;
+        }
+
+        inline uint16_t Data::getScale() const
+        {
+            return _scale;
+        }
+
     } // namespace Image
 } // namespace djv
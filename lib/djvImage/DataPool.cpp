@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImage/DataPool.h>
+
+#include <djvImage/Info.h>
+
+#include <djvCore/Memory.h>
+
+#include <list>
+#include <mutex>
+#include <new>
+
+#if defined(DJV_PLATFORM_WINDOWS)
+#include <malloc.h>
+#else // DJV_PLATFORM_WINDOWS
+#include <stdlib.h>
+#include <sys/mman.h>
+#endif // DJV_PLATFORM_WINDOWS
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace Image
+    {
+        namespace
+        {
+            struct Buffer
+            {
+                uint8_t* data = nullptr;
+                size_t byteCount = 0;
+            };
+
+            //! The alignment used for huge pages.
+            const size_t hugePageSize = 2 * Memory::megabyte;
+
+            uint8_t* allocateBuffer(size_t byteCount, bool hugePages)
+            {
+                void* out = nullptr;
+#if defined(DJV_PLATFORM_WINDOWS)
+                out = _aligned_malloc(byteCount, dataAlignment);
+                if (!out)
+                {
+                    throw std::bad_alloc();
+                }
+#else // DJV_PLATFORM_WINDOWS
+                if (posix_memalign(&out, hugePages ? hugePageSize : dataAlignment, byteCount) != 0)
+                {
+                    throw std::bad_alloc();
+                }
+#if defined(MADV_HUGEPAGE)
+                if (hugePages)
+                {
+                    madvise(out, byteCount, MADV_HUGEPAGE);
+                }
+#endif // MADV_HUGEPAGE
+#endif // DJV_PLATFORM_WINDOWS
+                return static_cast<uint8_t*>(out);
+            }
+
+            void freeBuffer(uint8_t* value)
+            {
+#if defined(DJV_PLATFORM_WINDOWS)
+                _aligned_free(value);
+#else // DJV_PLATFORM_WINDOWS
+                ::free(value);
+#endif // DJV_PLATFORM_WINDOWS
+            }
+
+        } // namespace
+
+        const size_t DataPool::defaultMaxByteCount = 256 * Memory::megabyte;
+        const size_t DataPool::minByteCount = 64 * Memory::kilobyte;
+
+        struct DataPool::Private
+        {
+            mutable std::mutex mutex;
+            size_t maxByteCount = 0;
+            size_t hugePageByteCount = 0;
+            //! The most recently released buffers are at the front.
+            std::list<Buffer> buffers;
+            Stats stats;
+        };
+
+        void DataPool::_init(size_t maxByteCount)
+        {
+            _p->maxByteCount = maxByteCount;
+        }
+
+        DataPool::DataPool() :
+            _p(new Private)
+        {}
+
+        DataPool::~DataPool()
+        {
+            clear();
+        }
+
+        std::shared_ptr<DataPool> DataPool::create(size_t maxByteCount)
+        {
+            auto out = std::shared_ptr<DataPool>(new DataPool);
+            out->_init(maxByteCount);
+            return out;
+        }
+
+        const std::shared_ptr<DataPool>& DataPool::getGlobal()
+        {
+            static const std::shared_ptr<DataPool> out = DataPool::create();
+            return out;
+        }
+
+        size_t DataPool::getMaxByteCount() const
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return p.maxByteCount;
+        }
+
+        DataPool::Stats DataPool::getStats() const
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return p.stats;
+        }
+
+        void DataPool::setMaxByteCount(size_t value)
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            p.maxByteCount = value;
+            _free(0);
+        }
+
+        size_t DataPool::getHugePageByteCount() const
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return p.hugePageByteCount;
+        }
+
+        void DataPool::setHugePageByteCount(size_t value)
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            p.hugePageByteCount = value;
+        }
+
+        void DataPool::clear()
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            for (const auto& i : p.buffers)
+            {
+                freeBuffer(i.data);
+            }
+            p.buffers.clear();
+            p.stats.count = 0;
+            p.stats.byteCount = 0;
+        }
+
+        size_t DataPool::getSizeClass(size_t value)
+        {
+            size_t out = value;
+            if (value >= minByteCount)
+            {
+                // Round up to an eighth of the largest power of two, this
+                // wastes at most 12.5% of the buffer.
+                size_t powerOfTwo = 1;
+                while (powerOfTwo <= value / 2)
+                {
+                    powerOfTwo *= 2;
+                }
+                const size_t step = powerOfTwo / 8;
+                out = ((value + step - 1) / step) * step;
+            }
+            return out;
+        }
+
+        uint8_t* DataPool::get(size_t byteCount, size_t& bufferByteCount)
+        {
+            DJV_PRIVATE_PTR();
+            uint8_t* out = nullptr;
+            bufferByteCount = getSizeClass(byteCount);
+            bool hugePages = false;
+            if (bufferByteCount >= minByteCount)
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                hugePages = p.hugePageByteCount > 0 && bufferByteCount >= p.hugePageByteCount;
+                for (auto i = p.buffers.begin(); i != p.buffers.end(); ++i)
+                {
+                    if (bufferByteCount == i->byteCount)
+                    {
+                        out = i->data;
+                        p.buffers.erase(i);
+                        --p.stats.count;
+                        p.stats.byteCount -= bufferByteCount;
+                        ++p.stats.hitCount;
+                        break;
+                    }
+                }
+                if (!out)
+                {
+                    ++p.stats.missCount;
+                }
+            }
+            if (!out && bufferByteCount > 0)
+            {
+                out = allocateBuffer(bufferByteCount, hugePages);
+            }
+            return out;
+        }
+
+        void DataPool::release(uint8_t* data, size_t bufferByteCount)
+        {
+            DJV_PRIVATE_PTR();
+            if (data)
+            {
+                bool pooled = false;
+                if (bufferByteCount >= minByteCount)
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    if (bufferByteCount <= p.maxByteCount)
+                    {
+                        _free(bufferByteCount);
+                        Buffer buffer;
+                        buffer.data = data;
+                        buffer.byteCount = bufferByteCount;
+                        p.buffers.push_front(buffer);
+                        ++p.stats.count;
+                        p.stats.byteCount += bufferByteCount;
+                        ++p.stats.releaseCount;
+                        pooled = true;
+                    }
+                }
+                if (!pooled)
+                {
+                    freeBuffer(data);
+                }
+            }
+        }
+
+        void DataPool::_free(size_t byteCount)
+        {
+            DJV_PRIVATE_PTR();
+            while (!p.buffers.empty() && p.stats.byteCount + byteCount > p.maxByteCount)
+            {
+                const auto& buffer = p.buffers.back();
+                freeBuffer(buffer.data);
+                --p.stats.count;
+                p.stats.byteCount -= buffer.byteCount;
+                ++p.stats.freeCount;
+                p.buffers.pop_back();
+            }
+        }
+
+    } // namespace Image
+} // namespace djv
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace Image
+    {
+        //! This class provides a pool of image buffers.
+        //!
+        //! Buffers are grouped into size classes so that images with the
+        //! same size can reuse each other's memory instead of returning it
+        //! to the operating system. Released buffers are kept up to a maximum
+        //! number of bytes, the least recently released buffers are freed
+        //! first. Small buffers are not pooled.
+        //!
+        //! Buffers are aligned to Image::dataAlignment. Large buffers can
+        //! optionally be backed by transparent huge pages where the operating
+        //! system supports them, which reduces TLB misses when scanning large
+        //! images.
+        class DataPool : public std::enable_shared_from_this<DataPool>
+        {
+            DJV_NON_COPYABLE(DataPool);
+            void _init(size_t maxByteCount);
+            DataPool();
+
+        public:
+            ~DataPool();
+
+            static std::shared_ptr<DataPool> create(size_t maxByteCount = defaultMaxByteCount);
+
+            //! Get the pool used by Image::Data.
+            static const std::shared_ptr<DataPool>& getGlobal();
+
+            //! The default maximum number of bytes kept in the pool.
+            static const size_t defaultMaxByteCount;
+
+            //! Buffers smaller than this are not pooled.
+            static const size_t minByteCount;
+
+            //! This struct provides pool statistics.
+            struct Stats
+            {
+                size_t hitCount     = 0; //!< The total number of buffers taken from the pool
+                size_t missCount    = 0; //!< The total number of buffers allocated
+                size_t releaseCount = 0; //!< The total number of buffers returned to the pool
+                size_t freeCount    = 0; //!< The total number of buffers freed to keep the pool under the maximum
+                size_t count        = 0; //!< The number of buffers in the pool
+                size_t byteCount    = 0; //!< The number of bytes in the pool
+            };
+
+            //! \name Size
+            ///@{
+
+            size_t getMaxByteCount() const;
+            Stats getStats() const;
+
+            void setMaxByteCount(size_t);
+
+            ///@}
+
+            //! \name Huge Pages
+            ///@{
+
+            //! Get the minimum size of buffers backed by huge pages. A value
+            //! of zero disables huge pages.
+            size_t getHugePageByteCount() const;
+
+            void setHugePageByteCount(size_t);
+
+            //! \name Buffers
+            ///@{
+
+            //! Get the size class for the given number of bytes.
+            static size_t getSizeClass(size_t);
+
+            //! Get a buffer with at least the given number of bytes. The
+            //! size of the buffer is returned in the second argument and must
+            //! be passed back to release().
+            uint8_t* get(size_t byteCount, size_t& bufferByteCount);
+
+            //! Return a buffer to the pool.
+            void release(uint8_t*, size_t bufferByteCount);
+
+            //! Free all of the buffers in the pool.
+            void clear();
+
+            ///@}
+
+        private:
+            void _free(size_t byteCount);
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace Image
+} // namespace djv
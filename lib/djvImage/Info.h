@@ -32,17 +32,29 @@ namespace djv
             constexpr bool operator != (const Mirror&) const noexcept;
         };
 
+        //! This constant provides the alignment of image data and padded
+        //! scanlines in bytes.
+        const size_t dataAlignment = 64;
+
         //! This class provides information about the image data layout.
         class Layout
         {
         public:
             Layout() noexcept;
-            constexpr Layout(const Mirror&, GLint alignment = 1, Core::Memory::Endian = Core::Memory::getEndian()) noexcept;
+            constexpr Layout(
+                const Mirror&,
+                GLint alignment = 1,
+                Core::Memory::Endian = Core::Memory::getEndian(),
+                bool rowPadding = false) noexcept;
 
             Mirror                  mirror;
             GLint                   alignment   = 1;
             Core::Memory::Endian    endian      = Core::Memory::getEndian();
 
+            //! Pad the scanlines to a multiple of the data alignment. The
+            //! padded scanlines are always a whole number of pixels.
+            bool                    rowPadding  = false;
+
             constexpr bool operator == (const Layout&) const noexcept;
             constexpr bool operator != (const Layout&) const noexcept;
         };
@@ -89,6 +101,10 @@ namespace djv
             size_t getScanlineByteCount() const noexcept;
             size_t getDataByteCount() const noexcept;
 
+            //! Get the number of pixels in a padded scanline for use with
+            //! GL_UNPACK_ROW_LENGTH, or zero if the scanlines are not padded.
+            GLint getGLRowLength() const noexcept;
+
             bool operator == (const Info&) const;
             bool operator != (const Info&) const;
         };
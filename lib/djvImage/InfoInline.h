@@ -26,15 +26,20 @@ namespace djv
             return !(other == *this);
         }
 
-        constexpr Layout::Layout(const Mirror& mirror, GLint alignment, Core::Memory::Endian endian) noexcept :
+        constexpr Layout::Layout(const Mirror& mirror, GLint alignment, Core::Memory::Endian endian, bool rowPadding) noexcept :
             mirror(mirror),
             alignment(alignment),
-            endian(endian)
+            endian(endian),
+            rowPadding(rowPadding)
         {}
 
         constexpr bool Layout::operator == (const Layout& other) const noexcept
         {
-            return other.mirror == mirror && other.alignment == alignment && other.endian == endian;
+            return
+                other.mirror == mirror &&
+                other.alignment == alignment &&
+                other.endian == endian &&
+                other.rowPadding == rowPadding;
         }
 
         constexpr bool Layout::operator != (const Layout& other) const noexcept
@@ -89,10 +94,26 @@ namespace djv
 
         inline size_t Info::getScanlineByteCount() const noexcept
         {
-            const size_t byteCount = static_cast<size_t>(size.w) * djv::Image::getByteCount(type);
-            const size_t q = byteCount / layout.alignment * layout.alignment;
+            const size_t pixelByteCount = djv::Image::getByteCount(type);
+            const size_t byteCount = static_cast<size_t>(size.w) * pixelByteCount;
+            size_t alignment = layout.alignment;
+            if (layout.rowPadding && pixelByteCount > 0)
+            {
+                // Use the least common multiple of the data alignment and
+                // the pixel size.
+                size_t a = dataAlignment;
+                size_t b = pixelByteCount;
+                while (b)
+                {
+                    const size_t tmp = a % b;
+                    a = b;
+                    b = tmp;
+                }
+                alignment = dataAlignment / a * pixelByteCount;
+            }
+            const size_t q = byteCount / alignment * alignment;
             const size_t r = byteCount - q;
-            return q + (r ? layout.alignment : 0);
+            return q + (r ? alignment : 0);
         }
 
         inline size_t Info::getDataByteCount() const noexcept
@@ -100,6 +121,14 @@ namespace djv
             return size.h * getScanlineByteCount();
         }
 
+        inline GLint Info::getGLRowLength() const noexcept
+        {
+            const size_t pixelByteCount = djv::Image::getByteCount(type);
+            return layout.rowPadding && pixelByteCount > 0 ?
+                static_cast<GLint>(getScanlineByteCount() / pixelByteCount) :
+                0;
+        }
+
         inline bool Info::operator == (const Info& other) const
         {
             return
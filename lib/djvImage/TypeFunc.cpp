@@ -301,7 +301,7 @@
     { \
         const U10_S * inP = reinterpret_cast<const U10_S *>(in); \
         B##_T * outP = reinterpret_cast<B##_T *>(out); \
-        for (size_t i = 0; i < size; ++i, ++inP, outP += 3) \
+        for (size_t i = 0; i < size; ++i, ++inP, outP += 4) \
         { \
             convert_U10_##B(inP->r, outP[0]); \
             convert_U10_##B(inP->g, outP[1]); \
@@ -0,0 +1,569 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvSystem/FileAsyncIO.h>
+
+#include <djvSystem/File.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/ThreadPool.h>
+
+#include <djvCore/StringFormat.h>
+
+#if defined(DJV_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#endif // DJV_IO_URING
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace System
+    {
+        namespace File
+        {
+            namespace
+            {
+                struct Request
+                {
+                    ReadRequest request;
+                    std::function<void(const std::exception_ptr&)> callback;
+#if defined(DJV_IO_URING)
+                    size_t byteCount = 0;
+                    struct iovec iov;
+#endif // DJV_IO_URING
+                };
+
+                std::exception_ptr getReadError(const ReadRequest& request)
+                {
+                    //! \todo How can we translate this?
+                    return std::make_exception_ptr(Error(String::Format("{0}: Cannot read.").
+                        arg(request.io ? request.io->getFileName() : std::string())));
+                }
+
+#if defined(DJV_IO_URING)
+                //! This class provides a minimal io_uring wrapper using the
+                //! kernel interface directly.
+                class URing
+                {
+                public:
+                    ~URing()
+                    {
+                        close();
+                    }
+
+                    bool open(unsigned entries)
+                    {
+                        struct io_uring_params params;
+                        memset(&params, 0, sizeof(struct io_uring_params));
+                        _fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+                        if (_fd < 0)
+                        {
+                            return false;
+                        }
+
+                        _sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                        _cqSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+                        const bool singleMMap = params.features & IORING_FEAT_SINGLE_MMAP;
+                        if (singleMMap)
+                        {
+                            _sqSize = _cqSize = std::max(_sqSize, _cqSize);
+                        }
+                        _sq = mmap(0, _sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+                        if (MAP_FAILED == _sq)
+                        {
+                            _sq = nullptr;
+                            close();
+                            return false;
+                        }
+                        if (singleMMap)
+                        {
+                            _cq = _sq;
+                        }
+                        else
+                        {
+                            _cq = mmap(0, _cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+                            if (MAP_FAILED == _cq)
+                            {
+                                _cq = nullptr;
+                                close();
+                                return false;
+                            }
+                        }
+                        _sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+                        void* sqes = mmap(0, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+                        if (MAP_FAILED == sqes)
+                        {
+                            close();
+                            return false;
+                        }
+                        _sqes = reinterpret_cast<struct io_uring_sqe*>(sqes);
+
+                        uint8_t* sq = reinterpret_cast<uint8_t*>(_sq);
+                        _sqTail  = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+                        _sqMask  = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+                        _sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+                        uint8_t* cq = reinterpret_cast<uint8_t*>(_cq);
+                        _cqHead  = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+                        _cqTail  = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+                        _cqMask  = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+                        _cqes    = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+                        _entries = params.sq_entries;
+                        return true;
+                    }
+
+                    void close()
+                    {
+                        if (_sqes)
+                        {
+                            munmap(_sqes, _sqesSize);
+                            _sqes = nullptr;
+                        }
+                        if (_cq && _cq != _sq)
+                        {
+                            munmap(_cq, _cqSize);
+                        }
+                        _cq = nullptr;
+                        if (_sq)
+                        {
+                            munmap(_sq, _sqSize);
+                            _sq = nullptr;
+                        }
+                        if (_fd != -1)
+                        {
+                            ::close(_fd);
+                            _fd = -1;
+                        }
+                    }
+
+                    unsigned getEntries() const
+                    {
+                        return _entries;
+                    }
+
+                    //! Add a read to the submission queue. This function is
+                    //! not thread safe.
+                    void prepareRead(int fd, uint64_t pos, struct iovec* iov, uint64_t userData)
+                    {
+                        auto sqe = _getSQE();
+                        sqe->opcode    = IORING_OP_READV;
+                        sqe->fd        = fd;
+                        sqe->off       = pos;
+                        sqe->addr      = reinterpret_cast<uint64_t>(iov);
+                        sqe->len       = 1;
+                        sqe->user_data = userData;
+                    }
+
+                    //! Add a no-op to the submission queue, used to wake up the
+                    //! completion thread. This function is not thread safe.
+                    void prepareNop(uint64_t userData)
+                    {
+                        auto sqe = _getSQE();
+                        sqe->opcode    = IORING_OP_NOP;
+                        sqe->fd        = -1;
+                        sqe->user_data = userData;
+                    }
+
+                    //! Submit the queued entries with a single system call.
+                    //! Entries that could not be submitted are retried on the
+                    //! next call. This function is not thread safe.
+                    void submit()
+                    {
+                        while (_unsubmitted > 0)
+                        {
+                            const int r = static_cast<int>(syscall(__NR_io_uring_enter, _fd, _unsubmitted, 0, 0, nullptr, 0));
+                            if (r > 0)
+                            {
+                                _unsubmitted -= r;
+                            }
+                            else if (r < 0 && EINTR == errno)
+                            {
+                                continue;
+                            }
+                            else
+                            {
+                                break;
+                            }
+                        }
+                    }
+
+                    //! Wait for at least one completion.
+                    void wait()
+                    {
+                        while (syscall(__NR_io_uring_enter, _fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 &&
+                            EINTR == errno)
+                            ;
+                    }
+
+                    //! Get the next completion.
+                    bool getCompletion(uint64_t& userData, int32_t& result)
+                    {
+                        const unsigned head = *_cqHead;
+                        if (head == __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE))
+                        {
+                            return false;
+                        }
+                        const auto& cqe = _cqes[head & *_cqMask];
+                        userData = cqe.user_data;
+                        result = cqe.res;
+                        __atomic_store_n(_cqHead, head + 1, __ATOMIC_RELEASE);
+                        return true;
+                    }
+
+                private:
+                    struct io_uring_sqe* _getSQE()
+                    {
+                        const unsigned tail = *_sqTail;
+                        const unsigned index = tail & *_sqMask;
+                        auto sqe = &_sqes[index];
+                        memset(sqe, 0, sizeof(struct io_uring_sqe));
+                        _sqArray[index] = index;
+                        __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+                        ++_unsubmitted;
+                        return sqe;
+                    }
+
+                    int _fd = -1;
+                    unsigned _entries = 0;
+                    unsigned _unsubmitted = 0;
+                    void* _sq = nullptr;
+                    void* _cq = nullptr;
+                    size_t _sqSize = 0;
+                    size_t _cqSize = 0;
+                    size_t _sqesSize = 0;
+                    struct io_uring_sqe* _sqes = nullptr;
+                    unsigned* _sqTail = nullptr;
+                    unsigned* _sqMask = nullptr;
+                    unsigned* _sqArray = nullptr;
+                    unsigned* _cqHead = nullptr;
+                    unsigned* _cqTail = nullptr;
+                    unsigned* _cqMask = nullptr;
+                    struct io_uring_cqe* _cqes = nullptr;
+                };
+#endif // DJV_IO_URING
+
+            } // namespace
+
+            ReadRequest::ReadRequest()
+            {}
+
+            ReadRequest::ReadRequest(const std::shared_ptr<IO>& io, size_t pos, size_t size, void* data) :
+                io(io),
+                pos(pos),
+                size(size),
+                data(data)
+            {}
+
+            struct AsyncIO::Private
+            {
+                AsyncIOBackend backend = AsyncIOBackend::ThreadPool;
+                size_t queueDepth = 0;
+                std::shared_ptr<ThreadPool> threadPool;
+                std::atomic<size_t> submitted;
+                std::atomic<size_t> completed;
+                std::atomic<size_t> byteCount;
+                std::mutex mutex;
+                std::condition_variable cv;
+#if defined(DJV_IO_URING)
+                URing uring;
+                size_t uringCount = 0;
+                std::deque<Request*> uringPending;
+                std::thread uringThread;
+
+                void uringSubmit(Request*);
+                void uringRun();
+#endif // DJV_IO_URING
+
+                void submit(const std::vector<Request*>&);
+                void finish(Request*, const std::exception_ptr&);
+            };
+
+            void AsyncIO::Private::submit(const std::vector<Request*>& requests)
+            {
+                submitted += requests.size();
+                std::vector<Request*> valid;
+                for (auto request : requests)
+                {
+                    const auto& io = request->request.io;
+                    if (io && io->isOpen() && request->request.pos + request->request.size <= io->getSize())
+                    {
+                        valid.push_back(request);
+                    }
+                    else
+                    {
+                        const auto error = getReadError(request->request);
+                        threadPool->submit(
+                            [this, request, error]
+                            {
+                                finish(request, error);
+                            });
+                    }
+                }
+                switch (backend)
+                {
+#if defined(DJV_IO_URING)
+                case AsyncIOBackend::IOURing:
+                {
+                    // Submit as many requests as the queue depth allows with a
+                    // single system call, the rest are submitted as the
+                    // requests in flight are completed.
+                    std::lock_guard<std::mutex> lock(mutex);
+                    for (auto request : valid)
+                    {
+                        if (uringCount < queueDepth)
+                        {
+                            uringSubmit(request);
+                        }
+                        else
+                        {
+                            uringPending.push_back(request);
+                        }
+                    }
+                    uring.submit();
+                    break;
+                }
+#endif // DJV_IO_URING
+                default:
+                    for (auto request : valid)
+                    {
+                        threadPool->submit(
+                            [this, request]
+                            {
+                                std::exception_ptr error;
+                                try
+                                {
+                                    request->request.io->readAt(
+                                        request->request.pos,
+                                        request->request.data,
+                                        request->request.size);
+                                }
+                                catch (const std::exception&)
+                                {
+                                    error = std::current_exception();
+                                }
+                                finish(request, error);
+                            });
+                    }
+                    break;
+                }
+            }
+
+            void AsyncIO::Private::finish(Request* request, const std::exception_ptr& error)
+            {
+                if (!error)
+                {
+                    byteCount += request->request.size;
+                }
+                if (request->callback)
+                {
+                    request->callback(error);
+                }
+                delete request;
+                // Notify while holding the mutex, the destructor may wake up as
+                // soon as the last request is completed and destroy the
+                // condition variable.
+                std::lock_guard<std::mutex> lock(mutex);
+                ++completed;
+                cv.notify_all();
+            }
+
+#if defined(DJV_IO_URING)
+            void AsyncIO::Private::uringSubmit(Request* request)
+            {
+                request->iov.iov_base = reinterpret_cast<uint8_t*>(request->request.data) + request->byteCount;
+                request->iov.iov_len = request->request.size - request->byteCount;
+                uring.prepareRead(
+                    request->request.io->getFD(),
+                    request->request.pos + request->byteCount,
+                    &request->iov,
+                    reinterpret_cast<uint64_t>(request));
+                ++uringCount;
+            }
+
+            void AsyncIO::Private::uringRun()
+            {
+                bool running = true;
+                while (running)
+                {
+                    uring.wait();
+                    std::vector<std::pair<Request*, std::exception_ptr> > done;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        uint64_t userData = 0;
+                        int32_t result = 0;
+                        while (uring.getCompletion(userData, result))
+                        {
+                            if (0 == userData)
+                            {
+                                running = false;
+                                continue;
+                            }
+                            --uringCount;
+                            Request* request = reinterpret_cast<Request*>(userData);
+                            if (result <= 0)
+                            {
+                                done.push_back(std::make_pair(request, getReadError(request->request)));
+                                continue;
+                            }
+                            request->byteCount += result;
+                            if (request->byteCount < request->request.size)
+                            {
+                                // Submit the remainder of a short read.
+                                uringPending.push_front(request);
+                            }
+                            else
+                            {
+                                done.push_back(std::make_pair(request, std::exception_ptr()));
+                            }
+                        }
+                        while (uringPending.size() && uringCount < queueDepth)
+                        {
+                            uringSubmit(uringPending.front());
+                            uringPending.pop_front();
+                        }
+                        uring.submit();
+                    }
+                    for (const auto& i : done)
+                    {
+                        finish(i.first, i.second);
+                    }
+                }
+            }
+#endif // DJV_IO_URING
+
+            void AsyncIO::_init(const std::shared_ptr<ThreadPool>& threadPool, size_t queueDepth)
+            {
+                DJV_PRIVATE_PTR();
+                p.queueDepth = std::max(queueDepth, static_cast<size_t>(1));
+                p.threadPool = threadPool ? threadPool : ThreadPool::create();
+                p.submitted = 0;
+                p.completed = 0;
+                p.byteCount = 0;
+#if defined(DJV_IO_URING) && !defined(DJV_MMAP)
+                if (p.uring.open(static_cast<unsigned>(p.queueDepth)))
+                {
+                    p.backend = AsyncIOBackend::IOURing;
+                    p.queueDepth = std::min(p.queueDepth, static_cast<size_t>(p.uring.getEntries()));
+                    p.uringThread = std::thread(
+                        [this]
+                        {
+                            _p->uringRun();
+                        });
+                }
+#endif // DJV_IO_URING
+            }
+
+            AsyncIO::AsyncIO() :
+                _p(new Private)
+            {}
+
+            AsyncIO::~AsyncIO()
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return _p->completed == _p->submitted;
+                        });
+                }
+#if defined(DJV_IO_URING)
+                if (p.uringThread.joinable())
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(p.mutex);
+                        p.uring.prepareNop(0);
+                        p.uring.submit();
+                    }
+                    p.uringThread.join();
+                }
+#endif // DJV_IO_URING
+            }
+
+            std::shared_ptr<AsyncIO> AsyncIO::create(const std::shared_ptr<ThreadPool>& threadPool, size_t queueDepth)
+            {
+                auto out = std::shared_ptr<AsyncIO>(new AsyncIO);
+                out->_init(threadPool, queueDepth);
+                return out;
+            }
+
+            AsyncIOBackend AsyncIO::getBackend() const
+            {
+                return _p->backend;
+            }
+
+            size_t AsyncIO::getQueueDepth() const
+            {
+                return _p->queueDepth;
+            }
+
+            AsyncIO::Stats AsyncIO::getStats() const
+            {
+                DJV_PRIVATE_PTR();
+                Stats out;
+                out.completed = p.completed;
+                out.submitted = std::max(static_cast<size_t>(p.submitted), out.completed);
+                out.inFlight = out.submitted - out.completed;
+                out.byteCount = p.byteCount;
+                return out;
+            }
+
+            void AsyncIO::read(
+                const ReadRequest& value,
+                const std::function<void(const std::exception_ptr&)>& callback)
+            {
+                Request* request = new Request;
+                request->request = value;
+                request->callback = callback;
+                _p->submit({ request });
+            }
+
+            std::future<void> AsyncIO::read(const ReadRequest& value)
+            {
+                return std::move(read(std::vector<ReadRequest>({ value }))[0]);
+            }
+
+            std::vector<std::future<void> > AsyncIO::read(const std::vector<ReadRequest>& value)
+            {
+                std::vector<std::future<void> > out;
+                std::vector<Request*> requests;
+                for (const auto& i : value)
+                {
+                    auto promise = std::make_shared<std::promise<void> >();
+                    out.push_back(promise->get_future());
+                    Request* request = new Request;
+                    request->request = i;
+                    request->callback = [promise](const std::exception_ptr& error)
+                    {
+                        if (error)
+                        {
+                            promise->set_exception(error);
+                        }
+                        else
+                        {
+                            promise->set_value();
+                        }
+                    };
+                    requests.push_back(request);
+                }
+                _p->submit(requests);
+                return out;
+            }
+
+        } // namespace File
+    } // namespace System
+} // namespace djv
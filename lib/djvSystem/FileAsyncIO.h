@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace System
+    {
+        class ThreadPool;
+
+        namespace File
+        {
+            class IO;
+
+            //! This struct provides an asynchronous read request.
+            struct ReadRequest
+            {
+                ReadRequest();
+                ReadRequest(const std::shared_ptr<IO>&, size_t pos, size_t size, void* data);
+
+                std::shared_ptr<IO> io;
+                size_t              pos     = 0;
+                size_t              size    = 0;
+                void*               data    = nullptr;
+            };
+
+            //! This enumeration provides the asynchronous I/O backends.
+            enum class AsyncIOBackend
+            {
+                ThreadPool,
+                IOURing,
+
+                Count,
+                First = ThreadPool
+            };
+
+            //! This class provides asynchronous file reads.
+            //!
+            //! Many read requests can be submitted at once without blocking
+            //! a thread for each of them. On Linux the requests are submitted
+            //! with io_uring when it is available, otherwise they are read
+            //! with positional reads on a thread pool.
+            class AsyncIO : public std::enable_shared_from_this<AsyncIO>
+            {
+                DJV_NON_COPYABLE(AsyncIO);
+                void _init(const std::shared_ptr<ThreadPool>&, size_t queueDepth);
+                AsyncIO();
+
+            public:
+                ~AsyncIO();
+
+                //! Create a new asynchronous I/O object. If the thread pool is
+                //! not set a new one is created for the fallback backend.
+                static std::shared_ptr<AsyncIO> create(
+                    const std::shared_ptr<ThreadPool>& = nullptr,
+                    size_t queueDepth = 64);
+
+                //! This struct provides asynchronous I/O statistics.
+                struct Stats
+                {
+                    size_t submitted = 0; //!< The total number of requests submitted
+                    size_t completed = 0; //!< The total number of requests completed
+                    size_t inFlight  = 0; //!< The number of requests waiting to complete
+                    size_t byteCount = 0; //!< The total number of bytes read
+                };
+
+                //! \name Information
+                ///@{
+
+                AsyncIOBackend getBackend() const;
+
+                size_t getQueueDepth() const;
+
+                Stats getStats() const;
+
+                ///@}
+
+                //! \name Read
+                ///@{
+
+                //! Submit a read request. The callback is called from another
+                //! thread when the request is complete, the exception is set if
+                //! the read failed. The I/O object is kept open until the
+                //! request is complete.
+                void read(
+                    const ReadRequest&,
+                    const std::function<void(const std::exception_ptr&)>&);
+
+                //! Submit a read request. The future throws Error if the read
+                //! failed.
+                std::future<void> read(const ReadRequest&);
+
+                //! Submit a batch of read requests.
+                std::vector<std::future<void> > read(const std::vector<ReadRequest>&);
+
+                ///@}
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace File
+    } // namespace System
+} // namespace djv
@@ -17,6 +17,16 @@ namespace djv
     {
         namespace File
         {
+            //! This enumeration provides hints for how a file will be accessed.
+            enum class Advice
+            {
+                WillNeed, //!< The file will be read soon
+                DontNeed, //!< The file will not be read again soon
+
+                Count,
+                First = WillNeed
+            };
+
             //! \name Utility
             ///@{
 
@@ -25,6 +35,12 @@ namespace djv
             //! - std::exception
             FILE* fopen(const std::string& fileName, const std::string& mode);
 
+            //! Give the operating system a hint about how the file will be
+            //! accessed, for example to start reading it into the page cache.
+            //! Returns false if the hint is not supported or the file cannot
+            //! be opened.
+            bool advise(const std::string& fileName, Advice);
+
             ///@}
 
         } // namespace File
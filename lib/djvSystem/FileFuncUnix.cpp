@@ -4,7 +4,12 @@
 
 #include <djvSystem/FileFunc.h>
 
+#include <algorithm>
+#include <limits>
+
+#include <fcntl.h>
 #include <stdio.h>
+#include <unistd.h>
 
 namespace djv
 {
@@ -17,6 +22,38 @@ namespace djv
                 return ::fopen(fileName.c_str(), mode.c_str());
             }
 
+            bool advise(const std::string& fileName, Advice value)
+            {
+                bool out = false;
+                const int fd = ::open(fileName.c_str(), O_RDONLY);
+                if (fd != -1)
+                {
+#if defined(POSIX_FADV_WILLNEED)
+                    switch (value)
+                    {
+                    case Advice::WillNeed: out = 0 == posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED); break;
+                    case Advice::DontNeed: out = 0 == posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED); break;
+                    default: break;
+                    }
+#elif defined(F_RDADVISE)
+                    // macOS only supports read ahead hints.
+                    if (Advice::WillNeed == value)
+                    {
+                        const off_t size = lseek(fd, 0, SEEK_END);
+                        if (size > 0)
+                        {
+                            struct radvisory r;
+                            r.ra_offset = 0;
+                            r.ra_count = static_cast<int>(std::min(size, static_cast<off_t>(std::numeric_limits<int>::max())));
+                            out = fcntl(fd, F_RDADVISE, &r) != -1;
+                        }
+                    }
+#endif
+                    ::close(fd);
+                }
+                return out;
+            }
+
         } // namespace File
     } // namespace System
 } // namespace djv
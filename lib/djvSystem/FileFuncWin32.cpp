@@ -21,6 +21,11 @@ namespace djv
                 return out;
             }
 
+            bool advise(const std::string&, Advice)
+            {
+                return false;
+            }
+
         } // namespace File
     } // namespace System
 } // namespace djv
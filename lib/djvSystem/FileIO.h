@@ -85,6 +85,11 @@ namespace djv
                 //! Get the file size.
                 size_t getSize() const;
 
+#if !defined(DJV_PLATFORM_WINDOWS)
+                //! Get the file descriptor.
+                int getFD() const;
+#endif // DJV_PLATFORM_WINDOWS
+
                 ///@}
 
                 //! \name Position
@@ -119,6 +124,11 @@ namespace djv
                 void readU32(uint32_t*, size_t = 1);
                 void readF32(float*, size_t = 1);
 
+                //! Read data at the given position without changing the
+                //! current file position. This function may be called from
+                //! multiple threads and does not perform endian conversion.
+                void readAt(size_t pos, void*, size_t);
+
                 ///@}
 
                 //! \name Write
@@ -18,6 +18,13 @@ namespace djv
                 return _size;
             }
 
+#if !defined(DJV_PLATFORM_WINDOWS)
+            inline int IO::getFD() const
+            {
+                return _f;
+            }
+#endif // DJV_PLATFORM_WINDOWS
+
             inline size_t IO::getPos() const
             {
                 return _pos;
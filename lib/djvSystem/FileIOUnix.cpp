@@ -319,6 +319,37 @@ namespace djv
                 _pos += size * wordSize;
             }
 
+            void IO::readAt(size_t pos, void* in, size_t size)
+            {
+                if (-1 == _f || pos + size > _size)
+                {
+                    throw Error(getErrorMessage(ErrorType::Read, _fileName));
+                }
+#if defined(DJV_MMAP)
+                if (Mode::Read == _mode)
+                {
+                    memcpy(in, _mmapStart + pos, size);
+                    return;
+                }
+#endif // DJV_MMAP
+                uint8_t* p = reinterpret_cast<uint8_t*>(in);
+                while (size > 0)
+                {
+                    const ssize_t r = ::pread(_f, p, size, pos);
+                    if (-1 == r && EINTR == errno)
+                    {
+                        continue;
+                    }
+                    if (r <= 0)
+                    {
+                        throw Error(getErrorMessage(ErrorType::Read, _fileName));
+                    }
+                    p += r;
+                    pos += r;
+                    size -= r;
+                }
+            }
+
             void IO::write(const void* in, size_t size, size_t wordSize)
             {
                 if (-1 == _f)
@@ -384,6 +384,43 @@ namespace djv
                 _pos += size * wordSize;
             }
 
+            void IO::readAt(size_t pos, void* in, size_t size)
+            {
+                if (!_f || pos + size > _size)
+                {
+                    throw Error(getErrorMessage(ErrorType::Read, _fileName));
+                }
+#if defined(DJV_MMAP)
+                if (Mode::Read == _mode)
+                {
+                    memcpy(in, _mmapStart + pos, size);
+                    return;
+                }
+                HANDLE h = _f;
+#else // DJV_MMAP
+                //! \todo ReadFile() moves the file pointer of synchronous
+                //! handles, so this should not be mixed with read().
+                HANDLE h = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(_f)));
+#endif // DJV_MMAP
+                uint8_t* p = reinterpret_cast<uint8_t*>(in);
+                while (size > 0)
+                {
+                    OVERLAPPED overlapped;
+                    memset(&overlapped, 0, sizeof(OVERLAPPED));
+                    overlapped.Offset = static_cast<DWORD>(pos);
+                    overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(pos) >> 32);
+                    DWORD n = 0;
+                    const DWORD count = static_cast<DWORD>(std::min(size, static_cast<size_t>(1 << 30)));
+                    if (!::ReadFile(h, p, count, &n, &overlapped) || 0 == n)
+                    {
+                        throw Error(getErrorMessage(ErrorType::Read, _fileName));
+                    }
+                    p += n;
+                    pos += n;
+                    size -= n;
+                }
+            }
+
             void IO::write(const void * in, size_t size, size_t wordSize)
             {
                 if (!_f)
@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvSystem/ThreadPool.h>
+
+#include <djvSystem/TimerFunc.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace System
+    {
+        namespace
+        {
+            struct Job
+            {
+                std::function<void(void)> func;
+                Core::UID group = 0;
+            };
+
+            struct Worker
+            {
+                std::mutex mutex;
+                std::array<std::deque<Job>, static_cast<size_t>(ThreadPool::Priority::Count)> queues;
+                std::thread thread;
+            };
+
+            //! The pool and worker index of the current thread, used to keep
+            //! jobs submitted from inside a job on the same worker.
+            thread_local const void* currentPool = nullptr;
+            thread_local size_t currentWorker = 0;
+
+        } // namespace
+
+        struct ThreadPool::Private
+        {
+            std::vector<std::unique_ptr<Worker> > workers;
+            std::atomic<size_t> nextWorker;
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::atomic<size_t> queueCount;
+            std::atomic<size_t> activeCount;
+            std::atomic<size_t> completed;
+            std::atomic<size_t> cancelled;
+            std::atomic<size_t> stolen;
+            std::atomic<uint64_t> busyTime;
+            std::mutex statsMutex;
+            std::chrono::steady_clock::time_point statsTime;
+            uint64_t statsBusyTime = 0;
+            std::atomic<bool> running;
+
+            bool pop(size_t index, Job&);
+        };
+
+        bool ThreadPool::Private::pop(size_t index, Job& out)
+        {
+            const size_t workerCount = workers.size();
+            for (int priority = static_cast<int>(Priority::Count) - 1; priority >= 0; --priority)
+            {
+                // Take the oldest job from our own queue.
+                {
+                    auto& worker = *workers[index];
+                    std::lock_guard<std::mutex> lock(worker.mutex);
+                    auto& queue = worker.queues[priority];
+                    if (!queue.empty())
+                    {
+                        out = std::move(queue.front());
+                        queue.pop_front();
+                        --queueCount;
+                        return true;
+                    }
+                }
+
+                // Steal the newest job from another worker.
+                for (size_t i = 1; i < workerCount; ++i)
+                {
+                    auto& worker = *workers[(index + i) % workerCount];
+                    std::lock_guard<std::mutex> lock(worker.mutex);
+                    auto& queue = worker.queues[priority];
+                    if (!queue.empty())
+                    {
+                        out = std::move(queue.back());
+                        queue.pop_back();
+                        --queueCount;
+                        ++stolen;
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        void ThreadPool::_init(size_t threadCount)
+        {
+            DJV_PRIVATE_PTR();
+            if (0 == threadCount)
+            {
+                threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+            }
+            p.nextWorker = 0;
+            p.queueCount = 0;
+            p.activeCount = 0;
+            p.completed = 0;
+            p.cancelled = 0;
+            p.stolen = 0;
+            p.busyTime = 0;
+            p.statsTime = std::chrono::steady_clock::now();
+            p.running = true;
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                p.workers.emplace_back(new Worker);
+            }
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                p.workers[i]->thread = std::thread(
+                    [this, i]
+                    {
+                        _run(i);
+                    });
+            }
+        }
+
+        ThreadPool::ThreadPool() :
+            _p(new Private)
+        {}
+
+        ThreadPool::~ThreadPool()
+        {
+            DJV_PRIVATE_PTR();
+            p.running = false;
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+            }
+            p.cv.notify_all();
+            for (auto& i : p.workers)
+            {
+                if (i->thread.joinable())
+                {
+                    i->thread.join();
+                }
+            }
+        }
+
+        std::shared_ptr<ThreadPool> ThreadPool::create(size_t threadCount)
+        {
+            auto out = std::shared_ptr<ThreadPool>(new ThreadPool);
+            out->_init(threadCount);
+            return out;
+        }
+
+        size_t ThreadPool::getThreadCount() const
+        {
+            return _p->workers.size();
+        }
+
+        ThreadPool::Stats ThreadPool::getStats()
+        {
+            DJV_PRIVATE_PTR();
+            Stats out;
+            out.threadCount = p.workers.size();
+            out.queueCount = p.queueCount;
+            out.activeCount = p.activeCount;
+            out.completed = p.completed;
+            out.cancelled = p.cancelled;
+            out.stolen = p.stolen;
+            {
+                std::lock_guard<std::mutex> lock(p.statsMutex);
+                const auto now = std::chrono::steady_clock::now();
+                const uint64_t busyTime = p.busyTime;
+                const std::chrono::duration<double> delta = now - p.statsTime;
+                const double available = delta.count() * out.threadCount;
+                if (available > 0.0)
+                {
+                    const double busy = (busyTime - p.statsBusyTime) / 1000000.0;
+                    out.utilization = static_cast<float>(std::min(busy / available, 1.0) * 100.0);
+                }
+                p.statsTime = now;
+                p.statsBusyTime = busyTime;
+            }
+            return out;
+        }
+
+        size_t ThreadPool::cancel(Core::UID group)
+        {
+            DJV_PRIVATE_PTR();
+            size_t out = 0;
+            if (0 == group)
+                return out;
+            for (auto& worker : p.workers)
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+                for (auto& queue : worker->queues)
+                {
+                    const auto i = std::remove_if(
+                        queue.begin(),
+                        queue.end(),
+                        [group](const Job& value)
+                        {
+                            return value.group == group;
+                        });
+                    const size_t count = std::distance(i, queue.end());
+                    queue.erase(i, queue.end());
+                    p.queueCount -= count;
+                    out += count;
+                }
+            }
+            p.cancelled += out;
+            return out;
+        }
+
+        void ThreadPool::_submit(const std::function<void(void)>& func, Priority priority, Core::UID group)
+        {
+            DJV_PRIVATE_PTR();
+            const size_t index = this == currentPool ?
+                currentWorker :
+                (p.nextWorker++ % p.workers.size());
+            {
+                auto& worker = *p.workers[index];
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                Job job;
+                job.func = func;
+                job.group = group;
+                worker.queues[static_cast<size_t>(priority)].push_back(std::move(job));
+                ++p.queueCount;
+            }
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+            }
+            p.cv.notify_one();
+        }
+
+        void ThreadPool::_run(size_t index)
+        {
+            DJV_PRIVATE_PTR();
+            currentPool = this;
+            currentWorker = index;
+            const auto timeout = getTimerValue(TimerValue::Medium);
+            while (p.running)
+            {
+                Job job;
+                if (p.pop(index, job))
+                {
+                    ++p.activeCount;
+                    const auto start = std::chrono::steady_clock::now();
+                    job.func();
+                    const auto end = std::chrono::steady_clock::now();
+                    p.busyTime += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+                    --p.activeCount;
+                    ++p.completed;
+                }
+                else
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    p.cv.wait_for(
+                        lock,
+                        std::chrono::milliseconds(timeout),
+                        [this]
+                        {
+                            return !_p->running || _p->queueCount > 0;
+                        });
+                }
+            }
+        }
+
+    } // namespace System
+} // namespace djv
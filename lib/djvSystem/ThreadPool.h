@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/UID.h>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+namespace djv
+{
+    namespace System
+    {
+        //! This class provides a work-stealing thread pool.
+        //!
+        //! Each worker thread has its own job queues. Workers take jobs from
+        //! their own queues first and steal from the other workers when they
+        //! run out of work. Higher priority jobs are always taken before lower
+        //! priority jobs.
+        class ThreadPool : public std::enable_shared_from_this<ThreadPool>
+        {
+            DJV_NON_COPYABLE(ThreadPool);
+            void _init(size_t threadCount);
+            ThreadPool();
+
+        public:
+            ~ThreadPool();
+
+            //! Create a new thread pool. If the thread count is zero the
+            //! hardware concurrency is used.
+            static std::shared_ptr<ThreadPool> create(size_t threadCount = 0);
+
+            //! This enumeration provides job priorities.
+            enum class Priority
+            {
+                Low,
+                Normal,
+                High,
+
+                Count,
+                First = Low
+            };
+
+            //! This struct provides thread pool statistics.
+            struct Stats
+            {
+                size_t threadCount = 0;
+                size_t queueCount  = 0;   //!< The number of jobs waiting to run
+                size_t activeCount = 0;   //!< The number of jobs running
+                float  utilization = 0.F; //!< Worker utilization percentage since the previous call to getStats()
+                size_t completed   = 0;   //!< The total number of jobs completed
+                size_t cancelled   = 0;   //!< The total number of jobs cancelled
+                size_t stolen      = 0;   //!< The total number of jobs stolen by other workers
+            };
+
+            //! \name Information
+            ///@{
+
+            size_t getThreadCount() const;
+
+            Stats getStats();
+
+            ///@}
+
+            //! \name Jobs
+            ///@{
+
+            //! Submit a job. Jobs submitted with the same group ID can be
+            //! cancelled together, a group ID of zero means the job cannot be
+            //! cancelled.
+            template<typename T>
+            std::future<typename std::result_of<T()>::type> submit(
+                const T&,
+                Priority = Priority::Normal,
+                Core::UID group = 0);
+
+            //! Cancel the jobs in the given group that have not started yet.
+            //! The futures of cancelled jobs throw std::future_error. Returns
+            //! the number of jobs cancelled.
+            size_t cancel(Core::UID group);
+
+            ///@}
+
+        private:
+            void _submit(const std::function<void(void)>&, Priority, Core::UID group);
+            void _run(size_t);
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace System
+} // namespace djv
+
+#include <djvSystem/ThreadPoolInline.h>
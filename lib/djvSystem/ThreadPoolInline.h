@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace System
+    {
+        template<typename T>
+        inline std::future<typename std::result_of<T()>::type> ThreadPool::submit(
+            const T& func,
+            Priority priority,
+            Core::UID group)
+        {
+            typedef typename std::result_of<T()>::type Result;
+            auto task = std::make_shared<std::packaged_task<Result(void)> >(func);
+            auto out = task->get_future();
+            _submit(
+                [task]
+                {
+                    (*task)();
+                },
+                priority,
+                group);
+            return out;
+        }
+
+    } // namespace System
+} // namespace djv
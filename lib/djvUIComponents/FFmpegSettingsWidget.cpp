@@ -4,6 +4,7 @@
 
 #include <djvUIComponents/FFmpegSettingsWidget.h>
 
+#include <djvUI/ComboBox.h>
 #include <djvUI/FormLayout.h>
 #include <djvUI/GroupBox.h>
 #include <djvUI/IntSlider.h>
@@ -24,6 +25,11 @@ namespace djv
             struct FFmpegWidget::Private
             {
                 std::shared_ptr<UI::Numeric::IntSlider> threadCountSlider;
+                std::shared_ptr<UI::ComboBox> threadTypeComboBox;
+                std::shared_ptr<UI::ComboBox> codecComboBox;
+                std::shared_ptr<UI::ComboBox> proResProfileComboBox;
+                std::shared_ptr<UI::ComboBox> dnxhrProfileComboBox;
+                std::shared_ptr<UI::Numeric::IntSlider> h264CRFSlider;
                 std::shared_ptr<UI::FormLayout> layout;
             };
 
@@ -37,8 +43,21 @@ namespace djv
                 p.threadCountSlider = UI::Numeric::IntSlider::create(context);
                 p.threadCountSlider->setRange(Math::IntRange(1, 16));
 
+                p.threadTypeComboBox = UI::ComboBox::create(context);
+
+                p.codecComboBox = UI::ComboBox::create(context);
+                p.proResProfileComboBox = UI::ComboBox::create(context);
+                p.dnxhrProfileComboBox = UI::ComboBox::create(context);
+                p.h264CRFSlider = UI::Numeric::IntSlider::create(context);
+                p.h264CRFSlider->setRange(Math::IntRange(0, 51));
+
                 p.layout = UI::FormLayout::create(context);
                 p.layout->addChild(p.threadCountSlider);
+                p.layout->addChild(p.threadTypeComboBox);
+                p.layout->addChild(p.codecComboBox);
+                p.layout->addChild(p.proResProfileComboBox);
+                p.layout->addChild(p.dnxhrProfileComboBox);
+                p.layout->addChild(p.h264CRFSlider);
                 addChild(p.layout);
 
                 _widgetUpdate();
@@ -62,6 +81,96 @@ namespace djv
                             }
                         }
                     });
+
+                p.threadTypeComboBox->setCallback(
+                    [weak, contextWeak](int value)
+                    {
+                        if (auto context = contextWeak.lock())
+                        {
+                            if (auto widget = weak.lock())
+                            {
+                                auto io = context->getSystemT<AV::IO::IOSystem>();
+                                AV::IO::FFmpeg::Options options;
+                                rapidjson::Document document;
+                                auto& allocator = document.GetAllocator();
+                                fromJSON(io->getOptions(AV::IO::FFmpeg::pluginName, allocator), options);
+                                options.threadType = static_cast<AV::IO::FFmpeg::ThreadType>(value);
+                                io->setOptions(AV::IO::FFmpeg::pluginName, toJSON(options, allocator));
+                            }
+                        }
+                    });
+
+                p.codecComboBox->setCallback(
+                    [weak, contextWeak](int value)
+                    {
+                        if (auto context = contextWeak.lock())
+                        {
+                            if (auto widget = weak.lock())
+                            {
+                                auto io = context->getSystemT<AV::IO::IOSystem>();
+                                AV::IO::FFmpeg::Options options;
+                                rapidjson::Document document;
+                                auto& allocator = document.GetAllocator();
+                                fromJSON(io->getOptions(AV::IO::FFmpeg::pluginName, allocator), options);
+                                options.codec = static_cast<AV::IO::FFmpeg::Codec>(value);
+                                io->setOptions(AV::IO::FFmpeg::pluginName, toJSON(options, allocator));
+                            }
+                        }
+                    });
+
+                p.proResProfileComboBox->setCallback(
+                    [weak, contextWeak](int value)
+                    {
+                        if (auto context = contextWeak.lock())
+                        {
+                            if (auto widget = weak.lock())
+                            {
+                                auto io = context->getSystemT<AV::IO::IOSystem>();
+                                AV::IO::FFmpeg::Options options;
+                                rapidjson::Document document;
+                                auto& allocator = document.GetAllocator();
+                                fromJSON(io->getOptions(AV::IO::FFmpeg::pluginName, allocator), options);
+                                options.proResProfile = static_cast<AV::IO::FFmpeg::ProResProfile>(value);
+                                io->setOptions(AV::IO::FFmpeg::pluginName, toJSON(options, allocator));
+                            }
+                        }
+                    });
+
+                p.dnxhrProfileComboBox->setCallback(
+                    [weak, contextWeak](int value)
+                    {
+                        if (auto context = contextWeak.lock())
+                        {
+                            if (auto widget = weak.lock())
+                            {
+                                auto io = context->getSystemT<AV::IO::IOSystem>();
+                                AV::IO::FFmpeg::Options options;
+                                rapidjson::Document document;
+                                auto& allocator = document.GetAllocator();
+                                fromJSON(io->getOptions(AV::IO::FFmpeg::pluginName, allocator), options);
+                                options.dnxhrProfile = static_cast<AV::IO::FFmpeg::DNxHRProfile>(value);
+                                io->setOptions(AV::IO::FFmpeg::pluginName, toJSON(options, allocator));
+                            }
+                        }
+                    });
+
+                p.h264CRFSlider->setValueCallback(
+                    [weak, contextWeak](int value)
+                    {
+                        if (auto context = contextWeak.lock())
+                        {
+                            if (auto widget = weak.lock())
+                            {
+                                auto io = context->getSystemT<AV::IO::IOSystem>();
+                                AV::IO::FFmpeg::Options options;
+                                rapidjson::Document document;
+                                auto& allocator = document.GetAllocator();
+                                fromJSON(io->getOptions(AV::IO::FFmpeg::pluginName, allocator), options);
+                                options.h264CRF = value;
+                                io->setOptions(AV::IO::FFmpeg::pluginName, toJSON(options, allocator));
+                            }
+                        }
+                    });
             }
 
             FFmpegWidget::FFmpegWidget() :
@@ -97,6 +206,12 @@ namespace djv
                 if (event.getData().text)
                 {
                     p.layout->setText(p.threadCountSlider, _getText(DJV_TEXT("settings_io_ffmpeg_thread_count")) + ":");
+                    p.layout->setText(p.threadTypeComboBox, _getText(DJV_TEXT("settings_io_ffmpeg_thread_type")) + ":");
+                    p.layout->setText(p.codecComboBox, _getText(DJV_TEXT("settings_io_ffmpeg_codec")) + ":");
+                    p.layout->setText(p.proResProfileComboBox, _getText(DJV_TEXT("settings_io_ffmpeg_prores_profile")) + ":");
+                    p.layout->setText(p.dnxhrProfileComboBox, _getText(DJV_TEXT("settings_io_ffmpeg_dnxhr_profile")) + ":");
+                    p.layout->setText(p.h264CRFSlider, _getText(DJV_TEXT("settings_io_ffmpeg_h264_crf")) + ":");
+                    _widgetUpdate();
                 }
             }
 
@@ -111,6 +226,48 @@ namespace djv
                     auto& allocator = document.GetAllocator();
                     fromJSON(io->getOptions(AV::IO::FFmpeg::pluginName, allocator), options);
                     p.threadCountSlider->setValue(options.threadCount);
+
+                    std::vector<std::string> items;
+                    for (auto i : AV::IO::FFmpeg::getThreadTypeEnums())
+                    {
+                        std::stringstream ss;
+                        ss << i;
+                        items.push_back(_getText(ss.str()));
+                    }
+                    p.threadTypeComboBox->setItems(items);
+                    p.threadTypeComboBox->setCurrentItem(static_cast<int>(options.threadType));
+
+                    items.clear();
+                    for (auto i : AV::IO::FFmpeg::getCodecEnums())
+                    {
+                        std::stringstream ss;
+                        ss << i;
+                        items.push_back(_getText(ss.str()));
+                    }
+                    p.codecComboBox->setItems(items);
+                    p.codecComboBox->setCurrentItem(static_cast<int>(options.codec));
+
+                    items.clear();
+                    for (auto i : AV::IO::FFmpeg::getProResProfileEnums())
+                    {
+                        std::stringstream ss;
+                        ss << i;
+                        items.push_back(_getText(ss.str()));
+                    }
+                    p.proResProfileComboBox->setItems(items);
+                    p.proResProfileComboBox->setCurrentItem(static_cast<int>(options.proResProfile));
+
+                    items.clear();
+                    for (auto i : AV::IO::FFmpeg::getDNxHRProfileEnums())
+                    {
+                        std::stringstream ss;
+                        ss << i;
+                        items.push_back(_getText(ss.str()));
+                    }
+                    p.dnxhrProfileComboBox->setItems(items);
+                    p.dnxhrProfileComboBox->setCurrentItem(static_cast<int>(options.dnxhrProfile));
+
+                    p.h264CRFSlider->setValue(options.h264CRF);
                 }
             }
 
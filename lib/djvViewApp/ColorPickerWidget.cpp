@@ -489,13 +489,18 @@ namespace djv
                     const float z = p.data.sampleSize / 2.F;
                     m = glm::translate(m, glm::vec2(z, z));
                     m = glm::translate(m, p.imagePos / p.imageZoom);
+                    const float scale = p.image->getScale();
                     m *= UI::ImageWidget::getXForm(
                         p.image,
                         p.imageData.rotate,
-                        glm::vec2(1.F, 1.F),
+                        glm::vec2(scale, scale),
                         p.imageData.aspectRatio);
                     pixelPos = glm::inverse(glm::translate(m, glm::vec2(-.5F, -.5F))) * pixelPos;
 
+                    // Report the position in the full image for proxies.
+                    pixelPos.x *= scale;
+                    pixelPos.y *= scale;
+
                     const size_t sampleSize = std::max(p.data.sampleSize, bufferSizeMin);
                     const Image::Size size(sampleSize, sampleSize);
                     const Image::Type type = p.data.lockType != Image::Type::None ? p.data.lockType : p.image->getType();
@@ -19,12 +19,22 @@
 #include <djvRender2D/FontSystem.h>
 #include <djvRender2D/Render.h>
 
+#if defined(FFmpeg_FOUND)
+#include <djvAV/FFmpeg.h>
+#endif
 #include <djvAV/IO.h>
+#include <djvAV/IOSystem.h>
+#include <djvAV/SequenceIO.h>
 #include <djvAV/ThumbnailSystem.h>
 
+#include <djvImage/DataPool.h>
+
 #include <djvSystem/Context.h>
+#include <djvSystem/ThreadPool.h>
 #include <djvSystem/TimerFunc.h>
 
+#include <djvCore/MemoryFunc.h>
+
 using namespace djv::Core;
 
 namespace djv
@@ -139,6 +149,21 @@ namespace djv
                 _textBlocks["IconCache"] = UI::Text::Block::create(context);
                 _thermometerWidgets["IconCache"] = UIComponents::ThermometerWidget::create(context);
 
+                _textBlocks["IOThreadPoolQueue"] = UI::Text::Block::create(context);
+                _lineGraphs["IOThreadPoolQueue"] = UIComponents::LineGraphWidget::create(context);
+                _lineGraphs["IOThreadPoolQueue"]->setPrecision(0);
+
+                _textBlocks["IOThreadPoolUtilization"] = UI::Text::Block::create(context);
+                _thermometerWidgets["IOThreadPoolUtilization"] = UIComponents::ThermometerWidget::create(context);
+
+                _textBlocks["IOFileReadAhead"] = UI::Text::Block::create(context);
+#if defined(FFmpeg_FOUND)
+                _textBlocks["IOFFmpegSeek"] = UI::Text::Block::create(context);
+#endif
+
+                _textBlocks["ImageDataPool"] = UI::Text::Block::create(context);
+                _thermometerWidgets["ImageDataPool"] = UIComponents::ThermometerWidget::create(context);
+
                 for (auto& i : _textBlocks)
                 {
                     i.second->setFontFamily(Render2D::Font::familyMono);
@@ -168,6 +193,16 @@ namespace djv
                 _layout->addChild(_thermometerWidgets["ThumbnailImageCache"]);
                 _layout->addChild(_textBlocks["IconCache"]);
                 _layout->addChild(_thermometerWidgets["IconCache"]);
+                _layout->addChild(_textBlocks["IOThreadPoolQueue"]);
+                _layout->addChild(_lineGraphs["IOThreadPoolQueue"]);
+                _layout->addChild(_textBlocks["IOThreadPoolUtilization"]);
+                _layout->addChild(_thermometerWidgets["IOThreadPoolUtilization"]);
+                _layout->addChild(_textBlocks["IOFileReadAhead"]);
+#if defined(FFmpeg_FOUND)
+                _layout->addChild(_textBlocks["IOFFmpegSeek"]);
+#endif
+                _layout->addChild(_textBlocks["ImageDataPool"]);
+                _layout->addChild(_thermometerWidgets["ImageDataPool"]);
                 addChild(_layout);
 
                 _timer = System::Timer::create(context);
@@ -223,6 +258,19 @@ namespace djv
                     const float thumbnailImageCachePercentage = thumbnailSystem->getImageCachePercentage();
                     auto iconSystem = context->getSystemT<UI::IconSystem>();
                     const float iconCachePercentage = iconSystem->getCachePercentage();
+                    auto ioSystem = context->getSystemT<AV::IO::IOSystem>();
+                    const auto threadPoolStats = ioSystem->getThreadPool()->getStats();
+                    const size_t fileReadAhead = ioSystem->getFileReadAhead();
+                    const auto readAheadStats = AV::IO::ISequenceRead::getReadAheadStats();
+#if defined(FFmpeg_FOUND)
+                    const auto ffmpegSeekStats = AV::IO::FFmpeg::Read::getSeekStats();
+#endif
+                    const auto& dataPool = Image::DataPool::getGlobal();
+                    const size_t dataPoolMaxByteCount = dataPool->getMaxByteCount();
+                    const auto dataPoolStats = dataPool->getStats();
+                    const float dataPoolPercentage = dataPoolMaxByteCount > 0 ?
+                        (dataPoolStats.byteCount / static_cast<float>(dataPoolMaxByteCount) * 100.F) :
+                        0.F;
 
                     _lineGraphs["FPS"]->addSample(fps);
                     _lineGraphs["TotalSystemTime"]->addSample(totalSystemTime.count());
@@ -233,6 +281,9 @@ namespace djv
                     _thermometerWidgets["ThumbnailImageCache"]->setPercentage(thumbnailImageCachePercentage);
                     _thermometerWidgets["IconCache"]->setPercentage(iconCachePercentage);
                     _thermometerWidgets["GlyphCache"]->setPercentage(glyphCachePercentage);
+                    _lineGraphs["IOThreadPoolQueue"]->addSample(threadPoolStats.queueCount);
+                    _thermometerWidgets["IOThreadPoolUtilization"]->setPercentage(threadPoolStats.utilization);
+                    _thermometerWidgets["ImageDataPool"]->setPercentage(dataPoolPercentage);
 
                     {
                         std::stringstream ss;
@@ -325,6 +376,42 @@ namespace djv
                         ss << std::fixed << iconCachePercentage << "%";
                         _textBlocks["IconCache"]->setText(ss.str());
                     }
+                    {
+                        std::stringstream ss;
+                        ss << _getText(DJV_TEXT("debug_general_io_thread_pool_queue")) << ": ";
+                        ss << threadPoolStats.queueCount << ", " << threadPoolStats.activeCount << "/" << threadPoolStats.threadCount;
+                        _textBlocks["IOThreadPoolQueue"]->setText(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << _getText(DJV_TEXT("debug_general_io_thread_pool_utilization")) << ": ";
+                        ss.precision(2);
+                        ss << std::fixed << threadPoolStats.utilization << "%";
+                        _textBlocks["IOThreadPoolUtilization"]->setText(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << _getText(DJV_TEXT("debug_general_io_file_read_ahead")) << ": ";
+                        ss << fileReadAhead << ", " << readAheadStats.willNeedCount << "/" << readAheadStats.dontNeedCount;
+                        _textBlocks["IOFileReadAhead"]->setText(ss.str());
+                    }
+#if defined(FFmpeg_FOUND)
+                    {
+                        std::stringstream ss;
+                        ss << _getText(DJV_TEXT("debug_general_io_ffmpeg_seek")) << ": ";
+                        ss << ffmpegSeekStats.count << ", " << ffmpegSeekStats.indexedCount << ", ";
+                        ss.precision(2);
+                        ss << std::fixed << ffmpegSeekStats.lastLatency << "/" << ffmpegSeekStats.averageLatency;
+                        _textBlocks["IOFFmpegSeek"]->setText(ss.str());
+                    }
+#endif
+                    {
+                        std::stringstream ss;
+                        ss << _getText(DJV_TEXT("debug_general_image_data_pool")) << ": ";
+                        ss << dataPoolStats.hitCount << "/" << dataPoolStats.missCount << ", ";
+                        ss << Memory::getSizeLabel(dataPoolStats.byteCount);
+                        _textBlocks["ImageDataPool"]->setText(ss.str());
+                    }
                 }
             }
 
@@ -471,6 +558,8 @@ namespace djv
                 size_t _videoQueueCount = 0;
                 size_t _audioQueueMax = 0;
                 size_t _audioQueueCount = 0;
+                size_t _audioUnderrunCount = 0;
+                size_t _audioOverrunCount = 0;
                 std::map<std::string, std::shared_ptr<UI::Text::Block> > _textBlocks;
                 std::map<std::string, std::shared_ptr<UIComponents::LineGraphWidget> > _lineGraphs;
                 std::shared_ptr<UI::VerticalLayout> _layout;
@@ -481,6 +570,8 @@ namespace djv
                 std::shared_ptr<Observer::Value<size_t> > _videoQueueCountObserver;
                 std::shared_ptr<Observer::Value<size_t> > _audioQueueMaxObserver;
                 std::shared_ptr<Observer::Value<size_t> > _audioQueueCountObserver;
+                std::shared_ptr<Observer::Value<size_t> > _audioUnderrunCountObserver;
+                std::shared_ptr<Observer::Value<size_t> > _audioOverrunCountObserver;
             };
 
             void MediaDebugWidget::_init(const std::shared_ptr<System::Context>& context)
@@ -499,6 +590,8 @@ namespace djv
                 _lineGraphs["AudioQueue"] = UIComponents::LineGraphWidget::create(context);
                 _lineGraphs["AudioQueue"]->setPrecision(0);
 
+                _textBlocks["AudioRuns"] = UI::Text::Block::create(context);
+
                 for (auto& i : _textBlocks)
                 {
                     i.second->setFontFamily(Render2D::Font::familyMono);
@@ -511,6 +604,7 @@ namespace djv
                 _layout->addChild(_lineGraphs["VideoQueue"]);
                 _layout->addChild(_textBlocks["AudioQueue"]);
                 _layout->addChild(_lineGraphs["AudioQueue"]);
+                _layout->addChild(_textBlocks["AudioRuns"]);
                 addChild(_layout);
 
                 auto weak = std::weak_ptr<MediaDebugWidget>(std::dynamic_pointer_cast<MediaDebugWidget>(shared_from_this()));
@@ -591,6 +685,26 @@ namespace djv
                                         widget->_widgetUpdate();
                                     }
                                 });
+                                widget->_audioUnderrunCountObserver = Observer::Value<size_t>::create(
+                                    value->observeAudioUnderrunCount(),
+                                    [weak](size_t value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        widget->_audioUnderrunCount = value;
+                                        widget->_widgetUpdate();
+                                    }
+                                });
+                                widget->_audioOverrunCountObserver = Observer::Value<size_t>::create(
+                                    value->observeAudioOverrunCount(),
+                                    [weak](size_t value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        widget->_audioOverrunCount = value;
+                                        widget->_widgetUpdate();
+                                    }
+                                });
                             }
                             else
                             {
@@ -600,12 +714,16 @@ namespace djv
                                 widget->_videoQueueCount = 0;
                                 widget->_audioQueueMax = 0;
                                 widget->_audioQueueCount = 0;
+                                widget->_audioUnderrunCount = 0;
+                                widget->_audioOverrunCount = 0;
                                 widget->_sequenceObserver.reset();
                                 widget->_currentFrameObserver.reset();
                                 widget->_videoQueueMaxObserver.reset();
                                 widget->_videoQueueCountObserver.reset();
                                 widget->_audioQueueMaxObserver.reset();
                                 widget->_audioQueueCountObserver.reset();
+                                widget->_audioUnderrunCountObserver.reset();
+                                widget->_audioOverrunCountObserver.reset();
                                 widget->_widgetUpdate();
                             }
                         }
@@ -659,6 +777,12 @@ namespace djv
                     ss << _currentFrame << " / " << _sequence.getFrameCount();
                     _textBlocks["CurrentFrame"]->setText(ss.str());
                 }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("debug_media_audio_underruns_overruns")) << ": ";
+                    ss << _audioUnderrunCount << " / " << _audioOverrunCount;
+                    _textBlocks["AudioRuns"]->setText(ss.str());
+                }
             }
 
         } // namespace
@@ -31,6 +31,7 @@ namespace djv
             std::shared_ptr<Observer::ValueSubject<bool> > sequencesFirstFrame;
             std::shared_ptr<Observer::ValueSubject<bool> > cacheEnabled;
             std::shared_ptr<Observer::ValueSubject<int> > cacheSize;
+            std::shared_ptr<Observer::ValueSubject<size_t> > cacheReadAhead;
         };
 
         void FileSettings::_init(const std::shared_ptr<System::Context>& context)
@@ -44,6 +45,7 @@ namespace djv
             p.sequencesFirstFrame = Observer::ValueSubject<bool>::create(true);
             p.cacheEnabled = Observer::ValueSubject<bool>::create(true);
             p.cacheSize = Observer::ValueSubject<int>::create(4);
+            p.cacheReadAhead = Observer::ValueSubject<size_t>::create(8);
             _load();
         }
 
@@ -135,6 +137,11 @@ namespace djv
             return _p->cacheSize;
         }
 
+        std::shared_ptr<Observer::IValueSubject<size_t> > FileSettings::observeCacheReadAhead() const
+        {
+            return _p->cacheReadAhead;
+        }
+
         void FileSettings::setCacheEnabled(bool value)
         {
             _p->cacheEnabled->setIfChanged(value);
@@ -145,6 +152,11 @@ namespace djv
             _p->cacheSize->setIfChanged(value);
         }
 
+        void FileSettings::setCacheReadAhead(size_t value)
+        {
+            _p->cacheReadAhead->setIfChanged(value);
+        }
+
         void FileSettings::load(const rapidjson::Value & value)
         {
             if (value.IsObject())
@@ -171,6 +183,7 @@ namespace djv
                 UI::Settings::read("SequencesFirstFrame", value, p.sequencesFirstFrame);
                 UI::Settings::read("CacheEnabled", value, p.cacheEnabled);
                 UI::Settings::read("CacheSize", value, p.cacheSize);
+                UI::Settings::read("CacheReadAhead", value, p.cacheReadAhead);
             }
         }
 
@@ -185,6 +198,7 @@ namespace djv
             UI::Settings::write("SequencesFirstFrame", p.sequencesFirstFrame->get(), out, allocator);
             UI::Settings::write("CacheEnabled", p.cacheEnabled->get(), out, allocator);
             UI::Settings::write("CacheSize", p.cacheSize->get(), out, allocator);
+            UI::Settings::write("CacheReadAhead", p.cacheReadAhead->get(), out, allocator);
             return out;
         }
 
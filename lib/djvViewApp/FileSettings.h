@@ -78,8 +78,13 @@ namespace djv
             std::shared_ptr<Core::Observer::IValueSubject<bool> > observeCacheEnabled() const;
             std::shared_ptr<Core::Observer::IValueSubject<int> > observeCacheSize() const;
 
+            //! Observe the number of frame files that the operating system is
+            //! asked to read ahead for image sequences.
+            std::shared_ptr<Core::Observer::IValueSubject<size_t> > observeCacheReadAhead() const;
+
             void setCacheEnabled(bool);
             void setCacheSize(int);
+            void setCacheReadAhead(size_t);
 
             ///@}
 
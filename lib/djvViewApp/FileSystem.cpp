@@ -24,9 +24,12 @@
 #include <djvUI/ToolBar.h>
 
 #include <djvAV/AVSystem.h>
+#include <djvAV/FrameCache.h>
 #include <djvAV/IOSystem.h>
 #include <djvAV/TimeFunc.h>
 
+#include <djvImage/DataPool.h>
+
 #include <djvSystem/Context.h>
 #include <djvSystem/FileInfoFunc.h>
 #include <djvSystem/LogSystem.h>
@@ -41,6 +44,8 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+
 using namespace djv::Core;
 
 namespace djv
@@ -74,6 +79,7 @@ namespace djv
             std::shared_ptr<Observer::Value<size_t> > threadCountObserver;
             std::shared_ptr<Observer::Value<bool> > cacheEnabledObserver;
             std::shared_ptr<Observer::Value<int> > cacheSizeObserver;
+            std::shared_ptr<Observer::Value<size_t> > cacheReadAheadObserver;
             std::shared_ptr<System::Timer> cacheTimer;
 
             typedef std::pair<System::File::Info, std::string> FileInfoAndNumber;
@@ -344,6 +350,19 @@ namespace djv
                     }
                 });
 
+            p.cacheReadAheadObserver = Observer::Value<size_t>::create(
+                p.settings->observeCacheReadAhead(),
+                [contextWeak](size_t value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        // The read ahead is used by the media opened after
+                        // the change.
+                        auto io = context->getSystemT<AV::IO::IOSystem>();
+                        io->setFileReadAhead(value);
+                    }
+                });
+
             auto settingsSystem = context->getSystemT<UI::Settings::SettingsSystem>();
             auto ioSettings = settingsSystem->getSettingsT<UIComponents::Settings::IO>();
             p.threadCountObserver = Observer::Value<size_t>::create(
@@ -369,20 +388,17 @@ namespace djv
                 {
                     if (auto system = weak.lock())
                     {
-                        size_t cacheMaxByteCount  = 0;
-                        size_t cacheByteCount = 0;
-                        for (const auto& i : system->_p->media->get())
+                        if (auto context = system->getContext().lock())
                         {
-                            if (i->hasCache())
-                            {
-                                cacheMaxByteCount  += i->getCacheMaxByteCount();
-                                cacheByteCount += i->getCacheByteCount();
-                            }
+                            auto io = context->getSystemT<AV::IO::IOSystem>();
+                            const auto& frameCache = io->getFrameCache();
+                            const size_t cacheMaxByteCount = frameCache->getMaxByteCount();
+                            const size_t cacheByteCount = frameCache->getByteCount();
+                            const float percentage = cacheMaxByteCount ?
+                                (cacheByteCount / static_cast<float>(cacheMaxByteCount) * 100.F) :
+                                0.F;
+                            system->_p->cachePercentage->setIfChanged(percentage);
                         }
-                        const float percentage = cacheMaxByteCount ?
-                            (cacheByteCount / static_cast<float>(cacheMaxByteCount) * 100.F) :
-                            0.F;
-                        system->_p->cachePercentage->setIfChanged(percentage);
                     }
                 });
 
@@ -593,6 +609,7 @@ namespace djv
             if (p.currentMedia->setIfChanged(media))
             {
                 _actionsUpdate();
+                _cacheUpdate();
             }
         }
 
@@ -669,22 +686,29 @@ namespace djv
         void FileSystem::_cacheUpdate()
         {
             DJV_PRIVATE_PTR();
-            size_t cacheCount = 0;
             const auto& media = p.media->get();
-            for (const auto& i : media)
-            {
-                if (i->hasCache())
-                {
-                    ++cacheCount;
-                }
-            }
             const bool cacheEnabled = p.settings->observeCacheEnabled()->get();
             const size_t cacheMaxByteCount = p.settings->observeCacheSize()->get() * Memory::gigabyte;
-            const size_t mediaCacheSizeByteCount = cacheCount > 0 ? (cacheMaxByteCount / cacheCount) : 0;
+            if (auto context = getContext().lock())
+            {
+                // All of the media share the frame cache, the current media
+                // is given priority and the others get what is left over.
+                auto io = context->getSystemT<AV::IO::IOSystem>();
+                io->getFrameCache()->setMaxByteCount(cacheEnabled ? cacheMaxByteCount : 0);
+
+                // The image buffer pool holds the frames released by the
+                // frame cache until they are reused, so it grows with the
+                // size of the cache.
+                Image::DataPool::getGlobal()->setMaxByteCount(cacheEnabled ?
+                    std::max(Image::DataPool::defaultMaxByteCount, cacheMaxByteCount / 8) :
+                    Image::DataPool::defaultMaxByteCount);
+            }
+            const auto currentMedia = p.currentMedia->get();
             for (const auto& i : media)
             {
                 i->setCacheEnabled(cacheEnabled);
-                i->setCacheMaxByteCount(mediaCacheSizeByteCount);
+                i->setCacheMaxByteCount(cacheMaxByteCount);
+                i->setCacheActive(i == currentMedia);
             }
         }
 
@@ -272,7 +272,8 @@ namespace djv
                     glm::mat3x3 m(1.F);
                     m = glm::translate(m, glm::vec2(g.w() / 2.F, g.h() / 2.F) - glm::vec2(_magnifyPos.x * magnify, _magnifyPos.y * magnify));
                     m = glm::translate(m, g.min + glm::vec2(_imagePos.x * magnify, _imagePos.y * magnify));
-                    m *= UI::ImageWidget::getXForm(_image, _imageData.rotate, glm::vec2(_imageZoom * magnify, _imageZoom * magnify), _imageData.aspectRatio);
+                    const float scale = _imageZoom * magnify * _image->getScale();
+                    m *= UI::ImageWidget::getXForm(_image, _imageData.rotate, glm::vec2(scale, scale), _imageData.aspectRatio);
                     render->pushTransform(m);
                     Render2D::ImageOptions options;
                     options.channelDisplay = _imageData.channelDisplay;
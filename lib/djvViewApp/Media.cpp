@@ -8,11 +8,13 @@
 #include <djvViewApp/EditSystem.h>
 
 #include <djvAV/AVSystem.h>
+#include <djvAV/IOFunc.h>
 #include <djvAV/IOSystem.h>
 #include <djvAV/TimeFunc.h>
 
 #include <djvAudio/AudioSystem.h>
 #include <djvAudio/DataFunc.h>
+#include <djvAudio/RingBuffer.h>
 
 #include <djvSystem/Context.h>
 #include <djvSystem/FileInfoFunc.h>
@@ -26,6 +28,8 @@
 #include <djvCore/StringFunc.h>
 #include <djvCore/UndoStack.h>
 
+#include <atomic>
+
 using namespace djv::Core;
 
 namespace djv
@@ -61,6 +65,7 @@ namespace djv
             std::shared_ptr<Observer::ValueSubject<Math::Frame::Sequence> > sequence;
             std::shared_ptr<Observer::ValueSubject<Math::Frame::Index> > currentFrame;
             std::shared_ptr<Observer::ValueSubject<std::shared_ptr<Image::Data> > > currentImage;
+            AV::IO::Proxy proxy = AV::IO::Proxy::None;
             std::shared_ptr<Observer::ValueSubject<Playback> > playback;
             std::shared_ptr<Observer::ValueSubject<PlaybackMode> > playbackMode;
             std::shared_ptr<Observer::ValueSubject<AV::IO::InOutPoints> > inOutPoints;
@@ -72,6 +77,7 @@ namespace djv
             std::shared_ptr<Observer::ValueSubject<Math::Frame::Sequence> > cachedFrames;
             bool cacheEnabled = false;
             size_t cacheMaxByteCount = 0;
+            bool cacheActive = false;
             std::shared_ptr<Observer::ListSubject<std::shared_ptr<AnnotatePrimitive> > > annotations;
             std::shared_ptr<Command::UndoStack> undoStack;
 
@@ -79,13 +85,14 @@ namespace djv
             std::shared_ptr<Observer::ValueSubject<size_t> > videoQueueCount;
             std::shared_ptr<Observer::ValueSubject<size_t> > audioQueueMax;
             std::shared_ptr<Observer::ValueSubject<size_t> > audioQueueCount;
+            std::shared_ptr<Observer::ValueSubject<size_t> > audioUnderrunCount;
+            std::shared_ptr<Observer::ValueSubject<size_t> > audioOverrunCount;
             std::shared_ptr<AV::IO::IRead> read;
 
             AV::IO::Direction ioDirection = AV::IO::Direction::Forward;
             std::unique_ptr<RtAudio> rtAudio;
-            std::shared_ptr<Audio::Data> audioData;
-            size_t audioDataSamplesOffset = 0;
-            size_t audioDataSamplesCount = 0;
+            std::shared_ptr<Audio::RingBuffer> audioRingBuffer;
+            std::atomic<size_t> audioDataSamplesCount;
             Math::Frame::Index frameOffset = 0;
             Time::Duration currentTime = Time::Duration::zero();
             std::chrono::steady_clock::time_point playbackTime;
@@ -136,6 +143,9 @@ namespace djv
             p.audioQueueMax = Observer::ValueSubject<size_t>::create();
             p.videoQueueCount = Observer::ValueSubject<size_t>::create();
             p.audioQueueCount = Observer::ValueSubject<size_t>::create();
+            p.audioUnderrunCount = Observer::ValueSubject<size_t>::create();
+            p.audioOverrunCount = Observer::ValueSubject<size_t>::create();
+            p.audioDataSamplesCount = 0;
 
             p.playbackTimer = System::Timer::create(context);
             p.playbackTimer->setRepeating(true);
@@ -280,6 +290,16 @@ namespace djv
             return _p->currentImage;
         }
 
+        void Media::setProxy(AV::IO::Proxy value)
+        {
+            DJV_PRIVATE_PTR();
+            if (value != p.proxy)
+            {
+                p.proxy = value;
+                _open();
+            }
+        }
+
         std::shared_ptr<Observer::IValueSubject<Math::IntRational> > Media::observeSpeed() const
         {
             return _p->speed;
@@ -677,6 +697,16 @@ namespace djv
                 p.read->setCacheMaxByteCount(p.cacheMaxByteCount);
             }
         }
+
+        void Media::setCacheActive(bool value)
+        {
+            DJV_PRIVATE_PTR();
+            p.cacheActive = value;
+            if (p.read)
+            {
+                p.read->setCacheActive(p.cacheActive);
+            }
+        }
             
         std::shared_ptr<Core::Observer::IListSubject<std::shared_ptr<AnnotatePrimitive> > > Media::observeAnnotations() const
         {
@@ -747,6 +777,16 @@ namespace djv
             return _p->audioQueueCount;
         }
 
+        std::shared_ptr<Observer::IValueSubject<size_t> > Media::observeAudioUnderrunCount() const
+        {
+            return _p->audioUnderrunCount;
+        }
+
+        std::shared_ptr<Observer::IValueSubject<size_t> > Media::observeAudioOverrunCount() const
+        {
+            return _p->audioOverrunCount;
+        }
+
         bool Media::_hasAudio() const
         {
             DJV_PRIVATE_PTR();
@@ -779,13 +819,20 @@ namespace djv
 
                     AV::IO::ReadOptions options;
                     options.layer = p.layers->get().second;
+                    options.proxy = p.proxy;
                     options.videoQueueSize = videoQueueSize;
                     auto io = context->getSystemT<AV::IO::IOSystem>();
+                    options.frameCache = io->getFrameCache();
+                    options.fileReadAhead = io->getFileReadAhead();
+                    auto audioSystem = context->getSystemT<Audio::AudioSystem>();
+                    options.audioOutput = audioSystem->getDefaultOutputInfo();
+                    options.audioRingBuffer = true;
                     p.read = io->read(p.fileInfo, options);
                     p.read->setThreadCount(p.threadCount->get());
                     p.read->setLoop(true);
                     p.read->setCacheEnabled(p.cacheEnabled);
                     p.read->setCacheMaxByteCount(p.cacheMaxByteCount);
+                    p.read->setCacheActive(p.cacheActive);
 
                     const auto info = p.read->getInfo().get();
                     p.info->setIfChanged(info);
@@ -793,7 +840,7 @@ namespace djv
                     p.layers->setIfChanged(std::make_pair(info.video, currentLayer));
                     Math::IntRational speed = info.videoSpeed;
                     Math::Frame::Sequence sequence = info.videoSequence;
-                    p.audioInfo = info.audio;
+                    p.audioInfo = AV::IO::getAudioOutputInfo(info.audio, options.audioOutput);
                     {
                         std::stringstream ss;
                         ss << "Open: " << p.fileInfo << ", sequence: " << sequence;
@@ -822,8 +869,8 @@ namespace djv
                         {
                             p.rtAudio->closeStream();
                         }
+                        p.audioRingBuffer = p.read->getAudioRingBuffer();
                         RtAudio::StreamParameters rtParameters;
-                        auto audioSystem = context->getSystemT<Audio::AudioSystem>();
                         rtParameters.deviceId = audioSystem->getDefaultOutputDevice();
                         rtParameters.nChannels = p.audioInfo.channelCount;
                         unsigned int rtBufferFrames = audioBufferFrameCount;
@@ -897,12 +944,25 @@ namespace djv
                                             audioQueueCount = audioQueue.getCount();
                                         }
                                     }
+                                    // The audio goes through the ring buffer
+                                    // instead of the queue when it is available.
+                                    size_t audioUnderrunCount = 0;
+                                    size_t audioOverrunCount  = 0;
+                                    if (const auto& audioRingBuffer = media->_p->audioRingBuffer)
+                                    {
+                                        audioQueueMax      = audioRingBuffer->getSampleCount();
+                                        audioQueueCount    = audioRingBuffer->getReadAvailable();
+                                        audioUnderrunCount = audioRingBuffer->getUnderrunCount();
+                                        audioOverrunCount  = audioRingBuffer->getOverrunCount();
+                                    }
                                     if (valid)
                                     {
                                         media->_p->videoQueueMax->setAlways(videoQueueMax);
                                         media->_p->videoQueueCount->setAlways(videoQueueCount);
                                         media->_p->audioQueueMax->setAlways(audioQueueMax);
                                         media->_p->audioQueueCount->setAlways(audioQueueCount);
+                                        media->_p->audioUnderrunCount->setIfChanged(audioUnderrunCount);
+                                        media->_p->audioOverrunCount->setIfChanged(audioOverrunCount);
                                     }
                                 }
                             }
@@ -1007,19 +1067,19 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (auto context = p.context.lock())
             {
+                // The audio stream is stopped before seeking so that the ring
+                // buffer is not read while it is flushed.
+                _stopAudioStream();
                 if (p.read)
                 {
                     p.read->seek(value, p.ioDirection);
                 }
-                p.audioData.reset();
-                p.audioDataSamplesOffset = 0;
                 p.audioDataSamplesCount = 0;
                 p.frameOffset = p.currentFrame->get();
                 p.currentTime = Time::Duration::zero();
                 p.realSpeedTime = std::chrono::steady_clock::now();
                 p.realSpeedFrameCount = 0;
                 p.playEveryFrameTime = Time::Duration::zero();
-                _stopAudioStream();
             }
         }
 
@@ -1050,8 +1110,6 @@ namespace djv
                     }
                     p.ioDirection = forward ? AV::IO::Direction::Forward : AV::IO::Direction::Reverse;
                     _seek(p.currentFrame->get());
-                    p.audioData.reset();
-                    p.audioDataSamplesOffset = 0;
                     p.audioDataSamplesCount = 0;
                     p.frameOffset = p.currentFrame->get();
                     p.currentTime = Time::Duration::zero();
@@ -1097,11 +1155,12 @@ namespace djv
                 const auto& speed = p.speed->get();
                 if (_hasAudioSyncPlayback())
                 {
-                    if (p.audioDataSamplesCount)
+                    const size_t audioDataSamplesCount = p.audioDataSamplesCount;
+                    if (audioDataSamplesCount)
                     {
                         Math::Frame::Index frame = p.frameOffset +
                             AV::Time::scale(
-                                p.audioDataSamplesCount,
+                                audioDataSamplesCount,
                                 Math::IntRational(1, static_cast<int>(p.audioInfo.sampleRate)),
                                 speed.swap());
                         _setCurrentFrame(frame);
@@ -1240,15 +1299,11 @@ namespace djv
                     }
                 }
 
-                // Update the audio queue.
-                if (_hasAudio() && !_hasAudioSyncPlayback())
+                // Discard the audio while playing without it, the audio
+                // stream is stopped so the ring buffer is not being read.
+                if (_hasAudio() && !_hasAudioSyncPlayback() && p.audioRingBuffer && playback != Playback::Stop)
                 {
-                    std::lock_guard<std::mutex> lock(p.read->getMutex());
-                    auto& queue = p.read->getAudioQueue();
-                    while (queue.getCount() > queue.getMax())
-                    {
-                        queue.popFrame();
-                    }
+                    p.audioRingBuffer->flush();
                 }
             }
         }
@@ -1261,89 +1316,31 @@ namespace djv
             RtAudioStreamStatus status,
             void* userData)
         {
+            // The samples are read from the ring buffer, the callback does
+            // not lock or allocate memory.
             Media* media = reinterpret_cast<Media*>(userData);
             const auto& info = media->_p->audioInfo;
-
-            size_t outputSampleCount = static_cast<size_t>(nFrames);
-            size_t sampleCount = 0;
-            const size_t sampleByteCount = info.channelCount * Audio::getByteCount(info.type);
-            const float volume = !media->_p->mute->get() ? media->_p->volume->get() : 0.F;
-
-            if (media->_p->audioData)
-            {
-                sampleCount += media->_p->audioData->getSampleCount() - media->_p->audioDataSamplesOffset;
-            }
-
-            // Get audio frames from the read queue.
-            std::vector<AV::IO::AudioFrame> frames;
-            {
-                std::lock_guard<std::mutex> lock(media->_p->read->getMutex());
-                auto& queue = media->_p->read->getAudioQueue();
-                while (!queue.isEmpty() && sampleCount < outputSampleCount)
-                {
-                    auto frame = queue.getFrame();
-                    frames.push_back(frame);
-                    queue.popFrame();
-                    sampleCount += frame.data->getSampleCount();
-                }
-            }
-
-            // Use the remaining data from the frame.
+            const size_t sampleByteCount = info.getByteCount();
             uint8_t* p = reinterpret_cast<uint8_t*>(outputBuffer);
-            if (media->_p->audioData)
+            size_t sampleCount = 0;
+            if (const auto& audioRingBuffer = media->_p->audioRingBuffer)
             {
-                const size_t size = std::min(
-                    media->_p->audioData->getSampleCount() - media->_p->audioDataSamplesOffset,
-                    outputSampleCount);
-                //memcpy(
-                //    p,
-                //    media->_p->audioData->getData() + media->_p->audioDataSamplesOffset * sampleByteCount,
-                //    size * sampleByteCount);
+                sampleCount = audioRingBuffer->read(p, nFrames);
+                const float volume = !media->_p->mute->get() ? media->_p->volume->get() : 0.F;
                 Audio::volume(
-                    media->_p->audioData->getData() + media->_p->audioDataSamplesOffset * sampleByteCount,
                     p,
-                    volume,
-                    size,
-                    info.channelCount,
-                    info.type);
-                p += size * sampleByteCount;
-                media->_p->audioDataSamplesOffset += size;
-                media->_p->audioDataSamplesCount += size;
-                outputSampleCount -= size;
-                if (media->_p->audioDataSamplesOffset >= media->_p->audioData->getSampleCount())
-                {
-                    media->_p->audioData.reset();
-                    media->_p->audioDataSamplesOffset = 0;
-                }
-            }
-
-            // Process the frames.
-            for (const auto& i : frames)
-            {
-                media->_p->audioData = i.data;
-                size_t size = std::min(i.data->getSampleCount(), outputSampleCount);
-                //memcpy(
-                //    p,
-                //    i.audio->getData(),
-                //    size * sampleByteCount);
-                Audio::volume(
-                    i.data->getData(),
                     p,
                     volume,
-                    size,
+                    sampleCount,
                     info.channelCount,
                     info.type);
-                p += size * sampleByteCount;
-                media->_p->audioDataSamplesOffset = size;
-                media->_p->audioDataSamplesCount += size;
-                outputSampleCount -= size;
+                media->_p->audioDataSamplesCount += sampleCount;
             }
 
-            const size_t zero = (nFrames * sampleByteCount) - (p - reinterpret_cast<uint8_t*>(outputBuffer));
+            const size_t zero = (nFrames - sampleCount) * sampleByteCount;
             if (zero)
             {
-                //! \todo Is this the correct way to clear the audio data?
-                memset(p, 0, zero);
+                memset(p + sampleCount * sampleByteCount, 0, zero);
             }
 
             return 0;
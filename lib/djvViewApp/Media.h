@@ -94,6 +94,10 @@ namespace djv
 
             std::shared_ptr<Core::Observer::IValueSubject<std::shared_ptr<Image::Data> > > observeCurrentImage() const;
 
+            //! Set the proxy level used to read the images. The media is
+            //! reopened when the level changes.
+            void setProxy(AV::IO::Proxy);
+
             ///@}
 
             //! \name Playback
@@ -165,6 +169,10 @@ namespace djv
             void setCacheEnabled(bool);
             void setCacheMaxByteCount(size_t);
 
+            //! Set whether this media is given priority in the shared frame
+            //! cache.
+            void setCacheActive(bool);
+
             ///@}
 
             //! \name Annotations
@@ -197,6 +205,8 @@ namespace djv
             std::shared_ptr<Core::Observer::IValueSubject<size_t> > observeAudioQueueMax() const;
             std::shared_ptr<Core::Observer::IValueSubject<size_t> > observeVideoQueueCount() const;
             std::shared_ptr<Core::Observer::IValueSubject<size_t> > observeAudioQueueCount() const;
+            std::shared_ptr<Core::Observer::IValueSubject<size_t> > observeAudioUnderrunCount() const;
+            std::shared_ptr<Core::Observer::IValueSubject<size_t> > observeAudioOverrunCount() const;
 
             ///@}
 
@@ -200,10 +200,92 @@ namespace djv
             }
         }
 
+        namespace
+        {
+            //! The maximum number of frame files to read ahead.
+            const int readAheadMax = 64;
+
+        } // namespace
+
+        struct MemoryCacheReadAheadWidget::Private
+        {
+            std::shared_ptr<UI::Numeric::IntSlider> slider;
+
+            std::shared_ptr<Observer::Value<size_t> > readAheadObserver;
+        };
+
+        void MemoryCacheReadAheadWidget::_init(const std::shared_ptr<System::Context>& context)
+        {
+            Widget::_init(context);
+            DJV_PRIVATE_PTR();
+            setClassName("djv::ViewApp::MemoryCacheReadAheadWidget");
+
+            p.slider = UI::Numeric::IntSlider::create(context);
+            p.slider->setRange(Math::IntRange(0, readAheadMax));
+            addChild(p.slider);
+
+            auto contextWeak = std::weak_ptr<System::Context>(context);
+            p.slider->setValueCallback(
+                [contextWeak](int value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        auto settingsSystem = context->getSystemT<UI::Settings::SettingsSystem>();
+                        if (auto fileSettings = settingsSystem->getSettingsT<FileSettings>())
+                        {
+                            fileSettings->setCacheReadAhead(static_cast<size_t>(value));
+                        }
+                    }
+                });
+
+            auto weak = std::weak_ptr<MemoryCacheReadAheadWidget>(
+                std::dynamic_pointer_cast<MemoryCacheReadAheadWidget>(shared_from_this()));
+            auto settingsSystem = context->getSystemT<UI::Settings::SettingsSystem>();
+            if (auto fileSettings = settingsSystem->getSettingsT<FileSettings>())
+            {
+                p.readAheadObserver = Observer::Value<size_t>::create(
+                    fileSettings->observeCacheReadAhead(),
+                    [weak](size_t value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->slider->setValue(static_cast<int>(value));
+                        }
+                    });
+            }
+        }
+
+        MemoryCacheReadAheadWidget::MemoryCacheReadAheadWidget() :
+            _p(new Private)
+        {}
+
+        MemoryCacheReadAheadWidget::~MemoryCacheReadAheadWidget()
+        {}
+
+        std::shared_ptr<MemoryCacheReadAheadWidget> MemoryCacheReadAheadWidget::create(const std::shared_ptr<System::Context>& context)
+        {
+            auto out = std::shared_ptr<MemoryCacheReadAheadWidget>(new MemoryCacheReadAheadWidget);
+            out->_init(context);
+            return out;
+        }
+
+        void MemoryCacheReadAheadWidget::_preLayoutEvent(System::Event::PreLayout&)
+        {
+            const auto& style = _getStyle();
+            _setMinimumSize(_p->slider->getMinimumSize() + getMargin().getSize(style));
+        }
+
+        void MemoryCacheReadAheadWidget::_layoutEvent(System::Event::Layout&)
+        {
+            const auto& style = _getStyle();
+            _p->slider->setGeometry(getMargin().bbox(getGeometry(), style));
+        }
+
         struct MemorySettingsWidget::Private
         {
             std::shared_ptr<MemoryCacheEnabledWidget> enabledWidget;
             std::shared_ptr<MemoryCacheSizeWidget> sizeWidget;
+            std::shared_ptr<MemoryCacheReadAheadWidget> readAheadWidget;
             std::shared_ptr<UI::FormLayout> layout;
         };
 
@@ -216,11 +298,13 @@ namespace djv
 
             p.enabledWidget = MemoryCacheEnabledWidget::create(context);
             p.sizeWidget = MemoryCacheSizeWidget::create(context);
+            p.readAheadWidget = MemoryCacheReadAheadWidget::create(context);
 
             p.layout = UI::FormLayout::create(context);
             p.layout->setSpacing(UI::MetricsRole::None);
             p.layout->addChild(p.enabledWidget);
             p.layout->addChild(p.sizeWidget);
+            p.layout->addChild(p.readAheadWidget);
             addChild(p.layout);
         }
 
@@ -253,6 +337,7 @@ namespace djv
             {
                 p.layout->setText(p.enabledWidget, _getText(DJV_TEXT("settings_memory_cache_enabled")) + ":");
                 p.layout->setText(p.sizeWidget, _getText(DJV_TEXT("settings_memory_cache_size")) + ":");
+                p.layout->setText(p.readAheadWidget, _getText(DJV_TEXT("settings_memory_cache_read_ahead")) + ":");
             }
         }
 
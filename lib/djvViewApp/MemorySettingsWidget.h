@@ -56,6 +56,28 @@ namespace djv
             DJV_PRIVATE();
         };
 
+        //! This class provides a memory cache file read ahead widget.
+        class MemoryCacheReadAheadWidget : public UI::Widget
+        {
+            DJV_NON_COPYABLE(MemoryCacheReadAheadWidget);
+
+        protected:
+            void _init(const std::shared_ptr<System::Context>&);
+            MemoryCacheReadAheadWidget();
+
+        public:
+            ~MemoryCacheReadAheadWidget() override;
+
+            static std::shared_ptr<MemoryCacheReadAheadWidget> create(const std::shared_ptr<System::Context>&);
+
+        protected:
+            void _preLayoutEvent(System::Event::PreLayout&) override;
+            void _layoutEvent(System::Event::Layout&) override;
+
+        private:
+            DJV_PRIVATE();
+        };
+
         //! This class provides a memory settings widget.
         class MemorySettingsWidget : public UIComponents::Settings::IWidget
         {
@@ -22,6 +22,9 @@
 #include <djvAV/AVSystem.h>
 #include <djvAV/IOSystem.h>
 #include <djvAV/TimeFunc.h>
+#include <djvAV/WaveformSystem.h>
+
+#include <djvAudio/Waveform.h>
 
 #include <djvSystem/Context.h>
 #include <djvSystem/Timer.h>
@@ -37,7 +40,10 @@ namespace djv
         struct TimelineSlider::Private
         {
             std::shared_ptr<Render2D::Font::FontSystem> fontSystem;
+            std::shared_ptr<AV::WaveformSystem> waveformSystem;
             std::shared_ptr<Media> media;
+            AV::WaveformSystem::WaveformFuture waveformFuture;
+            std::shared_ptr<Audio::Waveform> waveform;
             Math::IntRational speed;
             Math::Frame::Sequence sequence;
             Math::Frame::Index currentFrame = 0;
@@ -93,6 +99,7 @@ namespace djv
             setBackgroundRole(UI::ColorRole::Trough);
 
             p.fontSystem = context->getSystemT<Render2D::Font::FontSystem>();
+            p.waveformSystem = context->getSystemT<AV::WaveformSystem>();
 
             p.pipWidget = TimelinePIPWidget::create(context);
             p.pipOverlay = UI::Layout::Overlay::create(context);
@@ -151,6 +158,12 @@ namespace djv
             if (value == p.media)
                 return;
             p.media = value;
+            if (p.waveformFuture.future.valid())
+            {
+                p.waveformSystem->cancelWaveform(p.waveformFuture.uid);
+                p.waveformFuture = AV::WaveformSystem::WaveformFuture();
+            }
+            p.waveform.reset();
             if (p.media)
             {
                 auto weak = std::weak_ptr<TimelineSlider>(std::dynamic_pointer_cast<TimelineSlider>(shared_from_this()));
@@ -161,6 +174,16 @@ namespace djv
                     if (auto widget = weak.lock())
                     {
                         widget->_p->speed = value.videoSpeed;
+                        if (value.audio.isValid() &&
+                            !widget->_p->waveformFuture.future.valid() &&
+                            !widget->_p->waveform &&
+                            widget->_p->media)
+                        {
+                            // Only request a waveform once the media is known
+                            // to have audio.
+                            widget->_p->waveformFuture = widget->_p->waveformSystem->getWaveform(
+                                widget->_p->media->getFileInfo());
+                        }
                         widget->_textUpdate();
                         widget->_currentFrameUpdate();
                     }
@@ -366,11 +389,49 @@ namespace djv
                 const float m = style->getMetric(UI::MetricsRole::MarginSmall);
                 const float b = style->getMetric(UI::MetricsRole::Border);
                 const Math::BBox2f& hg = _getHandleGeometry();
+                const auto& render = _getRender();
+
+                // Draw the audio waveform. The peaks are drawn first and the
+                // RMS values on top of them.
+                const float speedF = p.speed.toFloat();
+                const size_t w = static_cast<size_t>(g.w());
+                if (p.waveform && speedF > 0.F && w > 0)
+                {
+                    const size_t sampleCount = static_cast<size_t>(
+                        p.sequence.getFrameCount() / speedF * p.waveform->getSampleRate());
+                    const auto bins = p.waveform->getBins(0, sampleCount, w);
+                    const float y0 = g.min.y + p.fontMetrics.lineHeight;
+                    const float y1 = g.max.y - b * 6.F;
+                    const float cy = floorf((y0 + y1) / 2.F);
+                    const float h = (y1 - y0) / 2.F;
+                    std::vector<Math::BBox2f> peakRects;
+                    std::vector<Math::BBox2f> rmsRects;
+                    for (size_t i = 0; i < bins.size(); ++i)
+                    {
+                        const auto& bin = bins[i];
+                        const float x = g.min.x + i;
+                        const float max = Math::clamp(bin.max, -1.F, 1.F);
+                        const float min = Math::clamp(bin.min, -1.F, 1.F);
+                        const float rms = std::min(bin.rms, 1.F);
+                        peakRects.emplace_back(Math::BBox2f(x, floorf(cy - max * h), 1.F, ceilf(std::max((max - min) * h, 1.F))));
+                        if (rms > 0.F)
+                        {
+                            rmsRects.emplace_back(Math::BBox2f(x, floorf(cy - rms * h), 1.F, ceilf(rms * h * 2.F)));
+                        }
+                    }
+                    auto color = style->getColor(UI::ColorRole::Foreground);
+                    color.setF32(color.getF32(3) * .2F, 3);
+                    render->setFillColor(color);
+                    render->drawRects(peakRects);
+                    color = style->getColor(UI::ColorRole::Foreground);
+                    color.setF32(color.getF32(3) * .3F, 3);
+                    render->setFillColor(color);
+                    render->drawRects(rmsRects);
+                }
 
                 // Draw the time ticks.
                 auto color = style->getColor(UI::ColorRole::Foreground);
                 color.setF32(color.getF32(3) * .4F, 3);
-                const auto& render = _getRender();
                 render->setFillColor(color);
                 std::vector<Math::BBox2f> rects;
                 for (const auto& tick : p.timeTicks)
@@ -577,6 +638,19 @@ namespace djv
         void TimelineSlider::_updateEvent(System::Event::Update & event)
         {
             DJV_PRIVATE_PTR();
+            if (p.waveformFuture.future.valid() &&
+                p.waveformFuture.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                try
+                {
+                    p.waveform = p.waveformFuture.future.get();
+                    _redraw();
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), System::LogLevel::Error);
+                }
+            }
             if (p.fontMetricsFuture.valid() &&
                 p.fontMetricsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
             {
@@ -22,6 +22,7 @@
 #include <djvRender2D/Render.h>
 
 #include <djvAV/AVSystem.h>
+#include <djvAV/IOFunc.h>
 #include <djvAV/TimeFunc.h>
 
 #include <djvOCIO/OCIOSystem.h>
@@ -29,6 +30,7 @@
 #include <djvSystem/Animation.h>
 #include <djvSystem/Context.h>
 #include <djvSystem/FileInfo.h>
+#include <djvSystem/TimerFunc.h>
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/matrix_transform_2d.hpp>
@@ -87,6 +89,7 @@ namespace djv
             std::shared_ptr<Observer::List<std::shared_ptr<AnnotatePrimitive> > > annotationsObserver;
 
             std::shared_ptr<System::Animation::Animation> zoomAnimation;
+            std::shared_ptr<System::Timer> proxyTimer;
         };
 
         void ViewWidget::_init(
@@ -212,6 +215,7 @@ namespace djv
                     if (auto widget = weak.lock())
                     {
                         widget->_hudUpdate();
+                        widget->_proxyUpdate();
                     }
                 });
             p.speedObserver = Observer::Value<Math::IntRational>::create(
@@ -267,6 +271,8 @@ namespace djv
 
             p.zoomAnimation = System::Animation::Animation::create(context);
             p.zoomAnimation->setType(System::Animation::Type::SmoothStep);
+
+            p.proxyTimer = System::Timer::create(context);
         }
 
         ViewWidget::ViewWidget() :
@@ -470,7 +476,8 @@ namespace djv
             {
                 glm::mat3x3 m(1.F);
                 m = glm::translate(m, g.min + p.imagePos->get());
-                m *= UI::ImageWidget::getXForm(image, p.imageData.rotate, glm::vec2(zoom, zoom), p.imageData.aspectRatio);
+                const float scale = zoom * image->getScale();
+                m *= UI::ImageWidget::getXForm(image, p.imageData.rotate, glm::vec2(scale, scale), p.imageData.aspectRatio);
                 render->pushTransform(m);
                 render->setFillColor(Image::Color(1.F, 1.F, 1.F));
                 Render2D::ImageOptions options;
@@ -500,7 +507,7 @@ namespace djv
                 options.softClipEnabled = p.imageData.softClipEnabled;
                 options.softClip = p.imageData.softClip;
                 options.cache = Render2D::ImageCache::Dynamic;
-                render->drawImage(image, glm::vec2(0.F, 0.F), options);
+                render->drawImage(image, glm::vec2(image->getOrigin()), options);
                 render->popTransform();
             }
 
@@ -526,6 +533,7 @@ namespace djv
             std::vector<glm::vec3> out;
             if (auto image = p.image->get())
             {
+                // Proxy images are scaled up to the size of the full image.
                 const Image::Size& size = image->getSize();
                 out.resize(4);
                 out[0].x = 0.F;
@@ -547,11 +555,12 @@ namespace djv
                     const Math::BBox2f& g = getMargin().bbox(getGeometry(), style);
                     m = glm::translate(m, g.min + p.imagePos->get());
                 }
-                const float zoom = p.imageZoom->get();
+                const float zoom = posAndZoom ? p.imageZoom->get() : 1.F;
+                const float scale = zoom * image->getScale();
                 m *= UI::ImageWidget::getXForm(
                     image,
                     p.imageData.rotate,
-                    posAndZoom ? glm::vec2(zoom, zoom) : glm::vec2(1.F, 1.F),
+                    glm::vec2(scale, scale),
                     p.imageData.aspectRatio);
                 for (auto& i : out)
                 {
@@ -634,6 +643,7 @@ namespace djv
             if (p.imageZoom->setIfChanged(std::max(0.F, zoom)))
             {
                 _resize();
+                _proxyUpdate();
             }
             p.gridOverlay->setImagePosAndZoom(p.imagePos->get(), p.imageZoom->get());
             p.gridOverlay->setImageBBox(getImageBBox());
@@ -654,6 +664,35 @@ namespace djv
             _resize();
         }
 
+        void ViewWidget::_proxyUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            const auto& layers = p.media->observeLayers()->get();
+            if (layers.second >= 0 && layers.second < static_cast<int>(layers.first.size()))
+            {
+                // Use the lowest resolution proxy level that still covers the
+                // zoomed image. The level is set once the zoom has settled so
+                // the media is not reopened while zooming.
+                const Image::Size& size = layers.first[layers.second].size;
+                const float zoom = std::min(p.imageZoom->get(), 1.F);
+                const AV::IO::Proxy proxy = AV::IO::getProxy(
+                    size,
+                    Image::Size(
+                        static_cast<uint16_t>(ceilf(size.w * zoom)),
+                        static_cast<uint16_t>(ceilf(size.h * zoom))));
+                auto weak = std::weak_ptr<ViewWidget>(std::dynamic_pointer_cast<ViewWidget>(shared_from_this()));
+                p.proxyTimer->start(
+                    System::getTimerDuration(System::TimerValue::Medium),
+                    [weak, proxy](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->media->setProxy(proxy);
+                        }
+                    });
+            }
+        }
+
         void ViewWidget::_hudUpdate()
         {
             DJV_PRIVATE_PTR();
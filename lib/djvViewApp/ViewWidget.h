@@ -80,6 +80,7 @@ namespace djv
             void _setPosAndZoom(const glm::vec2&, float);
 
             void _gridUpdate();
+            void _proxyUpdate();
             void _hudUpdate();
 
             DJV_PRIVATE();
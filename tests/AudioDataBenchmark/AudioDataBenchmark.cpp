@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAudio/Data.h>
+#include <djvAudio/DataFunc.h>
+
+#include <djvCore/ErrorFunc.h>
+#include <djvCore/OSFunc.h>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+
+using namespace djv;
+
+// Ten seconds of 16 channel audio at 96kHz.
+const uint8_t channelCount = 16;
+const size_t sampleRate = 96000;
+const size_t sampleCount = sampleRate * 10;
+const size_t iterations = 10;
+
+const std::vector<Core::OS::SIMD> simdLevels =
+{
+    Core::OS::SIMD::None,
+    Core::OS::SIMD::SSE41,
+    Core::OS::SIMD::AVX2
+};
+
+std::string getSIMDLabel(Core::OS::SIMD value)
+{
+    std::string out;
+    switch (value)
+    {
+    case Core::OS::SIMD::None:  out = "None"; break;
+    case Core::OS::SIMD::SSE41: out = "SSE4.1"; break;
+    case Core::OS::SIMD::AVX2:  out = "AVX2"; break;
+    default: break;
+    }
+    return out;
+}
+
+double time(const std::function<void(void)>& value)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        value();
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const std::chrono::duration<double, std::milli> diff = t1 - t0;
+    return diff.count() / iterations;
+}
+
+void print(const std::string& name, const std::function<void(Core::OS::SIMD)>& value)
+{
+    std::cout << std::left << std::setw(44) << name;
+    double scalar = 0.0;
+    for (const auto simd : simdLevels)
+    {
+        if (simd <= Core::OS::getSIMD())
+        {
+            const double t = time([value, simd] { value(simd); });
+            if (Core::OS::SIMD::None == simd)
+            {
+                scalar = t;
+            }
+            std::cout << std::right << std::setw(8) << getSIMDLabel(simd) << ": " <<
+                std::fixed << std::setprecision(2) << std::setw(8) << t << "ms";
+            if (simd != Core::OS::SIMD::None && t > 0.0)
+            {
+                std::cout << " (" << std::setprecision(1) << scalar / t << "x)";
+            }
+        }
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    int r = 1;
+    try
+    {
+        std::cout << "Channels: " << static_cast<int>(channelCount) << std::endl;
+        std::cout << "Sample rate: " << sampleRate << std::endl;
+        std::cout << "Samples: " << sampleCount << std::endl;
+        std::cout << "SIMD: " << getSIMDLabel(Core::OS::getSIMD()) << std::endl;
+
+        for (auto i : Audio::getTypeEnums())
+        {
+            if (Audio::Type::None == i)
+                continue;
+            const Audio::Info info(channelCount, i, sampleRate);
+            auto data = Audio::Data::create(info, sampleCount);
+            data->zero();
+            auto out = Audio::Data::create(info, sampleCount);
+
+            std::stringstream ss;
+            ss << "Volume " << i;
+            print(ss.str(), [data, out](Core::OS::SIMD simd)
+                {
+                    Audio::volume(data->getData(), out->getData(), .5F, sampleCount, channelCount, data->getType(), simd);
+                });
+
+            for (auto j : Audio::getTypeEnums())
+            {
+                if (Audio::Type::None == j || i == j)
+                    continue;
+                std::stringstream ss;
+                ss << "Convert " << i << " to " << j;
+                print(ss.str(), [data, j](Core::OS::SIMD simd)
+                    {
+                        Audio::convert(data, j, simd);
+                    });
+            }
+
+            const Audio::Info stereoInfo(2, i, sampleRate);
+            auto stereo = Audio::Data::create(stereoInfo, sampleCount * channelCount / 2);
+            stereo->zero();
+            ss.str(std::string());
+            ss << "Interleave " << i;
+            print(ss.str(), [stereo](Core::OS::SIMD simd)
+                {
+                    Audio::planarInterleave(stereo, simd);
+                });
+            ss.str(std::string());
+            ss << "Deinterleave " << i;
+            print(ss.str(), [stereo](Core::OS::SIMD simd)
+                {
+                    Audio::planarDeinterleave(stereo, simd);
+                });
+        }
+        r = 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
@@ -5,10 +5,17 @@
 #include <djvAVTest/AVSystemTest.h>
 
 #include <djvAV/AVSystem.h>
+#include <djvAV/IOSystem.h>
 #include <djvAV/SpeedFunc.h>
+#include <djvAV/ThumbnailSystem.h>
 #include <djvAV/TimeFunc.h>
 
+#include <djvGL/GLFWSystem.h>
+
+#include <djvImage/Data.h>
+
 #include <djvSystem/Context.h>
+#include <djvSystem/FileInfo.h>
 
 #include <djvCore/ValueObserver.h>
 
@@ -51,6 +58,36 @@ namespace djv
                 system->setTimeUnits(AV::Time::Units::Frames);
                 system->setDefaultSpeed(FPS::_60);
             }
+            _headless();
+        }
+
+        void AVSystemTest::_headless()
+        {
+            auto context = System::Context::create("djvAVSystemTest");
+            auto system = AVSystem::create(context, false);
+            DJV_ASSERT(!context->getSystemT<GL::GLFW::GLFWSystem>());
+            DJV_ASSERT(context->getSystemT<ThumbnailSystem>());
+            auto io = context->getSystemT<IO::IOSystem>();
+            DJV_ASSERT(io);
+
+            // The DPX writer needs the image converted to big endian, which
+            // is done on the CPU without OpenGL.
+            const Image::Info imageInfo(Image::Size(16, 8), Image::Type::RGB_U16);
+            auto image = Image::Data::create(imageInfo);
+            image->zero();
+            const System::File::Path path(getTempPath(), "AVSystemTest.dpx");
+            IO::Info info;
+            info.video.push_back(imageInfo);
+            auto write = io->write(System::File::Info(path), info);
+            {
+                std::lock_guard<std::mutex> lock(write->getMutex());
+                auto& writeQueue = write->getVideoQueue();
+                writeQueue.addFrame(IO::VideoFrame(0, image));
+                writeQueue.setFinished(true);
+            }
+            while (write->isRunning())
+            {}
+            DJV_ASSERT(System::File::Info(path).doesExist());
         }
 
     } // namespace AVTest
@@ -5,10 +5,12 @@
 #include <djvAVTest/DPXFuncTest.h>
 
 #include <djvAV/DPXFunc.h>
+#include <djvAV/IOSystem.h>
 
 #include <djvSystem/Context.h>
 #include <djvSystem/FileIO.h>
 #include <djvSystem/TextSystem.h>
+#include <djvSystem/TimerFunc.h>
 
 #include <djvCore/ErrorFunc.h>
 #include <djvCore/Memory.h>
@@ -34,6 +36,8 @@ namespace djv
         {
             _enum();
             _header();
+            _headerTemplate();
+            _roi();
             _serialize();
         }
         
@@ -400,6 +404,127 @@ namespace djv
             }
         }
 
+        void DPXFuncTest::_headerTemplate()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto textSystem = context->getSystemT<System::TextSystem>();
+
+                auto write = [this](const std::string& fileName, Image::Type type, const std::string& frame)
+                {
+                    auto io = System::File::IO::create();
+                    io->open(System::File::Path(getTempPath(), fileName).get(), System::File::Mode::Write);
+                    Info info;
+                    info.video.push_back(Image::Info(0, 0, type));
+                    info.tags.set("Film Frame", frame);
+                    DPX::write(io, info, DPX::Version::_2_0, DPX::Endian::Auto, DPX::Transfer::First);
+                };
+                write("template1.dpx", Image::Type::RGB_U10, "1");
+                write("template2.dpx", Image::Type::RGB_U10, "2");
+                write("template3.dpx", Image::Type::RGB_U16, "3");
+
+                auto io = System::File::IO::create();
+                io->open(System::File::Path(getTempPath(), "template1.dpx").get(), System::File::Mode::Read);
+                Info info;
+                info.video.push_back(Image::Info());
+                DPX::Transfer transfer = DPX::Transfer::First;
+                DPX::read(io, info, transfer, textSystem);
+                const auto headerTemplate = DPX::createHeaderTemplate(io, info, transfer);
+                DJV_ASSERT(headerTemplate.info.tags.isEmpty());
+
+                {
+                    io->open(System::File::Path(getTempPath(), "template2.dpx").get(), System::File::Mode::Read);
+                    DPX::Header header;
+                    Info info2;
+                    DPX::Transfer transfer2 = DPX::Transfer::First;
+                    DJV_ASSERT(DPX::read(io, headerTemplate, header, info2, transfer2));
+                    DJV_ASSERT(info2.video[0] == info.video[0]);
+                    DJV_ASSERT("2" == info2.tags.get("Film Frame"));
+                    DJV_ASSERT(transfer == transfer2);
+                }
+
+                {
+                    io->open(System::File::Path(getTempPath(), "template3.dpx").get(), System::File::Mode::Read);
+                    DPX::Header header;
+                    Info info2;
+                    DPX::Transfer transfer2 = DPX::Transfer::First;
+                    DJV_ASSERT(!DPX::read(io, headerTemplate, header, info2, transfer2));
+                    DJV_ASSERT(0 == io->getPos());
+                }
+            }
+        }
+
+        void DPXFuncTest::_roi()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto textSystem = context->getSystemT<System::TextSystem>();
+                auto ioSystem = context->getSystemT<IOSystem>();
+
+                // Write an image where each scanline is filled with its
+                // index in the file.
+                const System::File::Path path(getTempPath(), "roi.dpx");
+                const Image::Info imageInfo(16, 16, Image::Type::L_U8);
+                {
+                    auto io = System::File::IO::create();
+                    io->open(path.get(), System::File::Mode::Write);
+                    Info info;
+                    info.video.push_back(imageInfo);
+                    DPX::write(io, info, DPX::Version::_2_0, DPX::Endian::Auto, DPX::Transfer::Linear);
+                    for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                    {
+                        const std::vector<uint8_t> scanline(imageInfo.size.w, static_cast<uint8_t>(y));
+                        io->write(scanline.data(), scanline.size());
+                    }
+                    DPX::writeFinish(io);
+                }
+
+                // Change the orientation to bottom to top.
+                {
+                    auto io = System::File::IO::create();
+                    io->open(path.get(), System::File::Mode::Read);
+                    Info info;
+                    DPX::Transfer transfer = DPX::Transfer::First;
+                    DPX::Header header = DPX::read(io, info, transfer, textSystem);
+                    header.image.orient = static_cast<uint16_t>(DPX::Orient::LeftRightBottomTop);
+                    io->open(path.get(), System::File::Mode::ReadWrite);
+                    io->write(&header.file, sizeof(DPX::Header::File));
+                    io->write(&header.image, sizeof(DPX::Header::Image));
+                }
+
+                ReadOptions options;
+                options.roi = Math::BBox2i(2, 3, 4, 5);
+                auto read = ioSystem->read(System::File::Info(path), options);
+                std::shared_ptr<Image::Data> roiImage;
+                while (!roiImage)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(read->getMutex());
+                        auto& readQueue = read->getVideoQueue();
+                        if (!readQueue.isEmpty())
+                        {
+                            roiImage = readQueue.popFrame().data;
+                        }
+                        else if (readQueue.isFinished())
+                        {
+                            break;
+                        }
+                    }
+                    std::this_thread::sleep_for(System::getTimerDuration(System::TimerValue::Fast));
+                }
+                DJV_ASSERT(roiImage);
+                DJV_ASSERT(Image::Size(4, 5) == roiImage->getSize());
+                DJV_ASSERT(glm::ivec2(2, 3) == roiImage->getOrigin());
+                DJV_ASSERT(roiImage->getLayout().mirror.y);
+
+                // The displayed rows 3-7 are the rows 12-8 of the file.
+                for (uint16_t y = 0; y < roiImage->getHeight(); ++y)
+                {
+                    DJV_ASSERT(8 + y == *roiImage->getData(0, y));
+                }
+            }
+        }
+
         void DPXFuncTest::_serialize()
         {
             {
@@ -28,6 +28,8 @@ namespace djv
                 AV::IO::DPX::Version = AV::IO::DPX::Version::_2_0,
                 AV::IO::DPX::Endian = AV::IO::DPX::Endian::Auto,
                 AV::IO::DPX::Transfer = AV::IO::DPX::Transfer::First);
+            void _headerTemplate();
+            void _roi();
             void _serialize();
         };
         
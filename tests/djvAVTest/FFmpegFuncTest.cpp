@@ -6,6 +6,15 @@
 
 #include <djvAV/FFmpegFunc.h>
 
+#include <djvAudio/TypeFunc.h>
+
+#include <djvImage/TypeFunc.h>
+
+#include <djvSystem/Context.h>
+#include <djvSystem/FileInfo.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/TextSystem.h>
+
 #include <djvCore/ErrorFunc.h>
 
 #include <libavutil/error.h>
@@ -28,6 +37,7 @@ namespace djv
         {
             _convert();
             _serialize();
+            _keyframeIndex();
         }
         
         void FFmpegFuncTest::_convert()
@@ -97,12 +107,96 @@ namespace djv
             {
                 _print("Error: " + FFmpeg::getErrorString(i));
             }
+
+            {
+                DJV_ASSERT(Image::Type::RGB_U8 == FFmpeg::getImageType(AV_PIX_FMT_YUV420P));
+                DJV_ASSERT(Image::Type::RGB_U16 == FFmpeg::getImageType(AV_PIX_FMT_YUV422P10));
+                DJV_ASSERT(Image::Type::RGBA_U16 == FFmpeg::getImageType(AV_PIX_FMT_YUVA444P12));
+                DJV_ASSERT(Image::Type::L_U8 == FFmpeg::getImageType(AV_PIX_FMT_GRAY8));
+                DJV_ASSERT(Image::Type::RGBA_U8 == FFmpeg::getImageType(AV_PIX_FMT_RGBA));
+                for (const auto i : Image::getTypeEnums())
+                {
+                    const AVPixelFormat format = FFmpeg::toFFmpeg(i);
+                    if (format != AV_PIX_FMT_NONE)
+                    {
+                        DJV_ASSERT(i == FFmpeg::getImageType(format));
+                    }
+                }
+            }
+
+            for (const auto i : FFmpeg::getThreadTypeEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                _print("Thread type: " + _getText(ss.str()));
+            }
+            DJV_ASSERT(FF_THREAD_FRAME == FFmpeg::toFFmpeg(FFmpeg::ThreadType::Frame));
+            DJV_ASSERT((FF_THREAD_SLICE | FF_THREAD_FRAME) == FFmpeg::toFFmpeg(FFmpeg::ThreadType::SliceAndFrame));
+
+            {
+                FFmpeg::Options options;
+                options.threadType = FFmpeg::ThreadType::Slice;
+                options.codecThreadTypes["prores"] = FFmpeg::ThreadType::Frame;
+                DJV_ASSERT(FFmpeg::ThreadType::Frame == FFmpeg::getThreadType(options, "prores"));
+                DJV_ASSERT(FFmpeg::ThreadType::Slice == FFmpeg::getThreadType(options, "h264"));
+            }
+
+            for (const auto i : Audio::getTypeEnums())
+            {
+                const AVSampleFormat format = FFmpeg::toFFmpeg(i);
+                if (format != AV_SAMPLE_FMT_NONE)
+                {
+                    DJV_ASSERT(i == FFmpeg::toAudioType(format));
+                }
+            }
+
+            for (const auto i : FFmpeg::getCodecEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                _print("Codec: " + _getText(ss.str()));
+            }
+            for (const auto i : FFmpeg::getProResProfileEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                _print("ProRes profile: " + _getText(ss.str()) + " " + FFmpeg::getProfileName(i));
+            }
+            for (const auto i : FFmpeg::getDNxHRProfileEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                _print("DNxHR profile: " + _getText(ss.str()) + " " + FFmpeg::getProfileName(i));
+            }
+
+            {
+                FFmpeg::Options options;
+                options.codec = FFmpeg::Codec::ProRes;
+                options.proResProfile = FFmpeg::ProResProfile::HQ;
+                DJV_ASSERT(AV_PIX_FMT_YUV422P10 == FFmpeg::getPixelFormat(options, true));
+                options.proResProfile = FFmpeg::ProResProfile::_4444;
+                DJV_ASSERT(AV_PIX_FMT_YUVA444P10 == FFmpeg::getPixelFormat(options, true));
+                DJV_ASSERT(AV_PIX_FMT_YUV444P10 == FFmpeg::getPixelFormat(options, false));
+                options.codec = FFmpeg::Codec::DNxHR;
+                options.dnxhrProfile = FFmpeg::DNxHRProfile::SQ;
+                DJV_ASSERT(AV_PIX_FMT_YUV422P == FFmpeg::getPixelFormat(options, false));
+                options.dnxhrProfile = FFmpeg::DNxHRProfile::HQX;
+                DJV_ASSERT(AV_PIX_FMT_YUV422P10 == FFmpeg::getPixelFormat(options, false));
+                options.codec = FFmpeg::Codec::H264;
+                DJV_ASSERT(AV_PIX_FMT_YUV420P == FFmpeg::getPixelFormat(options, true));
+            }
         }
         
         void FFmpegFuncTest::_serialize()
         {
             {
                 FFmpeg::Options options;
+                options.threadType = FFmpeg::ThreadType::Frame;
+                options.codecThreadTypes["hevc"] = FFmpeg::ThreadType::Slice;
+                options.codec = FFmpeg::Codec::DNxHR;
+                options.proResProfile = FFmpeg::ProResProfile::_4444XQ;
+                options.dnxhrProfile = FFmpeg::DNxHRProfile::HQX;
+                options.h264CRF = 23;
                 rapidjson::Document document;
                 auto& allocator = document.GetAllocator();
                 auto json = toJSON(options, allocator);
@@ -124,6 +218,88 @@ namespace djv
             }
         }
         
+        void FFmpegFuncTest::_keyframeIndex()
+        {
+            {
+                FFmpeg::KeyframeIndex index;
+                DJV_ASSERT(0 == index.getCount());
+                DJV_ASSERT(!index.isComplete());
+                int64_t keyframe = 0;
+                DJV_ASSERT(!index.getKeyframe(0, keyframe));
+                index.add(0);
+                index.add(48);
+                index.add(24);
+                index.add(24);
+                DJV_ASSERT(3 == index.getCount());
+                DJV_ASSERT(index.getKeyframe(0, keyframe));
+                DJV_ASSERT(0 == keyframe);
+                DJV_ASSERT(index.getKeyframe(30, keyframe));
+                DJV_ASSERT(24 == keyframe);
+                DJV_ASSERT(!index.getKeyframe(-1, keyframe));
+
+                // Seeking past the end of a partial index.
+                keyframe = -1;
+                DJV_ASSERT(!index.getKeyframe(48, keyframe));
+                DJV_ASSERT(!index.getKeyframe(100, keyframe));
+                DJV_ASSERT(-1 == keyframe);
+                index.add(72);
+                DJV_ASSERT(index.getKeyframe(48, keyframe));
+                DJV_ASSERT(48 == keyframe);
+                DJV_ASSERT(!index.getKeyframe(100, keyframe));
+                index.setComplete(true);
+                DJV_ASSERT(index.getKeyframe(100, keyframe));
+                DJV_ASSERT(72 == keyframe);
+            }
+            
+            if (auto context = getContext().lock())
+            {
+                auto textSystem = context->getSystemT<System::TextSystem>();
+                const System::File::Path path(getTempPath(), "FFmpegFuncTest.mov");
+                {
+                    auto io = System::File::IO::create();
+                    io->open(path.get(), System::File::Mode::Write);
+                    io->writeU32(0);
+                }
+                const System::File::Info fileInfo(path);
+                const std::string cacheFileName = FFmpeg::KeyframeIndex::getCacheFileName(fileInfo);
+                _print("Keyframe index cache: " + cacheFileName);
+                DJV_ASSERT(!cacheFileName.empty());
+                DJV_ASSERT(cacheFileName == FFmpeg::KeyframeIndex::getCacheFileName(fileInfo));
+
+                FFmpeg::KeyframeIndex index;
+                for (int64_t i = 0; i < 10; ++i)
+                {
+                    index.add(i * 12);
+                }
+                index.setComplete(true);
+                const std::string fileName = System::File::Path(getTempPath(), cacheFileName).get();
+                index.write(fileName, fileInfo);
+                FFmpeg::KeyframeIndex index2;
+                index2.read(fileName, fileInfo, textSystem);
+                DJV_ASSERT(10 == index2.getCount());
+                DJV_ASSERT(index2.isComplete());
+                int64_t keyframe = 0;
+                DJV_ASSERT(index2.getKeyframe(100, keyframe));
+                DJV_ASSERT(96 == keyframe);
+                
+                try
+                {
+                    auto io = System::File::IO::create();
+                    io->open(path.get(), System::File::Mode::Write);
+                    io->writeU32(0);
+                    io->writeU32(0);
+                    io.reset();
+                    FFmpeg::KeyframeIndex index3;
+                    index3.read(fileName, System::File::Info(path), textSystem);
+                    DJV_ASSERT(false);
+                }
+                catch (const std::exception& e)
+                {
+                    _print(Error::format(e.what()));
+                }
+            }
+        }
+        
     } // namespace AVTest
 } // namespace djv
 
@@ -20,6 +20,7 @@ namespace djv
         private:
             void _convert();
             void _serialize();
+            void _keyframeIndex();
         };
         
     } // namespace AVTest
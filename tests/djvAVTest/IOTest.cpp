@@ -4,6 +4,8 @@
 
 #include <djvAVTest/IOTest.h>
 
+#include <djvAV/FrameCache.h>
+#include <djvAV/IOFunc.h>
 #include <djvAV/IOSystem.h>
 #include <djvAV/PPMFunc.h>
 #include <djvAV/SpeedFunc.h>
@@ -19,6 +21,8 @@
 #include <djvCore/ErrorFunc.h>
 #include <djvCore/StringFunc.h>
 
+#include <algorithm>
+
 using namespace djv::Core;
 using namespace djv::AV;
 using namespace djv::AV::IO;
@@ -45,6 +49,10 @@ namespace djv
             _audioQueue();
             _inOutPoints();
             _cache();
+            _frameCache();
+            _proxy();
+            _roi();
+            _audioOutput();
             _plugin();
             _io();
             _system();
@@ -190,7 +198,8 @@ namespace djv
         {
             {
                 const Cache cache;
-                DJV_ASSERT(0 == cache.getMax());
+                DJV_ASSERT(0 == cache.getMaxByteCount());
+                DJV_ASSERT(0 == cache.getCount());
                 DJV_ASSERT(0 == cache.getTotalByteCount());
                 DJV_ASSERT(Math::Frame::Sequence() == cache.getFrames());
                 DJV_ASSERT(Math::Frame::Sequence() == cache.getSequence());
@@ -200,9 +209,10 @@ namespace djv
             }
             
             {
+                const size_t byteCount = Image::Info(1, 2, Image::Type::RGB_U8).getDataByteCount();
                 Cache cache;
-                cache.setMax(10);
-                DJV_ASSERT(10 == cache.getMax());
+                cache.setMaxByteCount(byteCount * 10);
+                DJV_ASSERT(byteCount * 10 == cache.getMaxByteCount());
                 cache.setCurrentFrame(1);
                 cache.setCurrentFrame(1);
                 cache.setSequenceSize(10);
@@ -236,9 +246,309 @@ namespace djv
                     ss << "Cache sequence: " << cache.getSequence();
                     _print(ss.str());
                 }
+                DJV_ASSERT(cache.getTotalByteCount() <= cache.getMaxByteCount());
+            }
+
+            {
+                const Image::Info small(16, 16, Image::Type::RGB_U8);
+                const Image::Info large(64, 64, Image::Type::RGBA_F32);
+                Cache cache;
+                cache.setMaxByteCount(large.getDataByteCount() * 4);
+                cache.setByteCountEstimate(small.getDataByteCount());
+                cache.setSequenceSize(100);
+                DJV_ASSERT(!cache.getWindow().empty());
+                DJV_ASSERT(0 == cache.getWindow()[0]);
+                for (Math::Frame::Index i = 0; i < 100; ++i)
+                {
+                    cache.add(i, Image::Data::create(i % 2 ? large : small));
+                    DJV_ASSERT(cache.getTotalByteCount() <= cache.getMaxByteCount());
+                }
+                DJV_ASSERT(cache.contains(0));
+                cache.setMaxByteCount(large.getDataByteCount());
+                DJV_ASSERT(cache.getTotalByteCount() <= cache.getMaxByteCount());
+                DJV_ASSERT(cache.contains(0));
+                cache.setMaxByteCount(0);
+                DJV_ASSERT(0 == cache.getCount());
+                DJV_ASSERT(0 == cache.getTotalByteCount());
+                DJV_ASSERT(cache.getWindow().empty());
+            }
+
+            {
+                // The frames ahead do not push out the frames behind.
+                const size_t byteCount = Image::Info(1, 2, Image::Type::RGB_U8).getDataByteCount();
+                Cache cache;
+                cache.setMaxByteCount(byteCount * 20);
+                cache.setByteCountEstimate(byteCount);
+                cache.setSequenceSize(100);
+                cache.setCurrentFrame(50);
+                const auto& window = cache.getWindow();
+                DJV_ASSERT(20 == window.size());
+                DJV_ASSERT(50 == window[0]);
+                for (Math::Frame::Index i = 40; i < 60; ++i)
+                {
+                    DJV_ASSERT(std::find(window.begin(), window.end(), i) != window.end());
+                }
             }
         }
         
+        void IOTest::_frameCache()
+        {
+            {
+                auto frameCache = FrameCache::create();
+                DJV_ASSERT(0 == frameCache->getMaxByteCount());
+                DJV_ASSERT(0 == frameCache->getByteCount());
+                DJV_ASSERT(0 == frameCache->getCount());
+                DJV_ASSERT(!frameCache->contains(FrameCache::Key("image.ppm", 0, 0, std::string())));
+            }
+
+            {
+                const Image::Info info(16, 16, Image::Type::RGB_U8);
+                const size_t byteCount = info.getDataByteCount();
+                auto frameCache = FrameCache::create();
+                frameCache->setMaxByteCount(byteCount * 10);
+                const UID active = frameCache->addClient();
+                const UID inactive = frameCache->addClient();
+                frameCache->setEnabled(active, true);
+                frameCache->setEnabled(inactive, true);
+                frameCache->setActive(active, true);
+                DJV_ASSERT(byteCount * 10 == frameCache->getMaxByteCount(active));
+                DJV_ASSERT(byteCount * 10 == frameCache->getMaxByteCount(inactive));
+
+                for (Math::Frame::Index i = 0; i < 5; ++i)
+                {
+                    frameCache->add(inactive, FrameCache::Key("a.ppm", 0, i, std::string()), Image::Data::create(info));
+                }
+                DJV_ASSERT(byteCount * 5 == frameCache->getByteCount(inactive));
+                for (Math::Frame::Index i = 0; i < 8; ++i)
+                {
+                    frameCache->add(active, FrameCache::Key("b.ppm", 0, i, std::string()), Image::Data::create(info));
+                }
+                DJV_ASSERT(byteCount * 10 == frameCache->getByteCount());
+                DJV_ASSERT(byteCount * 8 == frameCache->getByteCount(active));
+                DJV_ASSERT(byteCount * 2 == frameCache->getByteCount(inactive));
+                DJV_ASSERT(byteCount * 2 == frameCache->getMaxByteCount(inactive));
+
+                frameCache->setPlayhead(inactive, 4);
+                DJV_ASSERT(!frameCache->contains(FrameCache::Key("a.ppm", 0, 0, std::string())));
+                DJV_ASSERT(frameCache->contains(FrameCache::Key("a.ppm", 0, 4, std::string())));
+
+                frameCache->setPlayhead(active, 0);
+                frameCache->setMaxByteCount(byteCount * 4);
+                DJV_ASSERT(0 == frameCache->getByteCount(inactive));
+                DJV_ASSERT(frameCache->contains(FrameCache::Key("b.ppm", 0, 7, std::string())));
+                DJV_ASSERT(!frameCache->contains(FrameCache::Key("b.ppm", 0, 0, std::string())));
+
+                std::shared_ptr<Image::Data> image;
+                DJV_ASSERT(frameCache->get(inactive, FrameCache::Key("b.ppm", 0, 7, std::string()), image));
+                DJV_ASSERT(image);
+                DJV_ASSERT(byteCount == frameCache->getByteCount(inactive));
+                frameCache->remove(active, FrameCache::Key("b.ppm", 0, 7, std::string()));
+                DJV_ASSERT(frameCache->contains(FrameCache::Key("b.ppm", 0, 7, std::string())));
+                frameCache->removeClient(inactive);
+                DJV_ASSERT(!frameCache->contains(FrameCache::Key("b.ppm", 0, 7, std::string())));
+                frameCache->clear(active);
+                DJV_ASSERT(0 == frameCache->getByteCount());
+            }
+
+            {
+                const Image::Info info(16, 16, Image::Type::RGB_U8);
+                auto frameCache = FrameCache::create();
+                frameCache->setMaxByteCount(info.getDataByteCount() * 100);
+                const UID client = frameCache->addClient();
+                Cache cache;
+                cache.setFrameCache(frameCache, client, "image.ppm", 0, std::string());
+                cache.setMaxByteCount(info.getDataByteCount() * 10);
+                cache.setSequenceSize(100);
+                for (Math::Frame::Index i = 0; i < 20; ++i)
+                {
+                    cache.add(i, Image::Data::create(info));
+                }
+                DJV_ASSERT(cache.getCount() > 0);
+                DJV_ASSERT(cache.getCount() == frameCache->getCount());
+                DJV_ASSERT(cache.getTotalByteCount() == frameCache->getByteCount());
+                cache.clear();
+                DJV_ASSERT(0 == frameCache->getCount());
+            }
+        }
+
+        void IOTest::_proxy()
+        {
+            {
+                DJV_ASSERT(1 == getProxyScale(Proxy::None));
+                DJV_ASSERT(8 == getProxyScale(Proxy::_1_8));
+                DJV_ASSERT(Image::Size(100, 50) == getProxySize(Image::Size(100, 50), Proxy::None));
+                DJV_ASSERT(Image::Size(50, 25) == getProxySize(Image::Size(100, 50), Proxy::_1_2));
+                DJV_ASSERT(Image::Size(25, 13) == getProxySize(Image::Size(100, 50), Proxy::_1_4));
+                DJV_ASSERT(Proxy::None == getProxy(Image::Size(100, 50), Image::Size(100, 50)));
+                DJV_ASSERT(Proxy::_1_2 == getProxy(Image::Size(100, 50), Image::Size(40, 20)));
+                DJV_ASSERT(Proxy::_1_8 == getProxy(Image::Size(1000, 500), Image::Size(64, 32)));
+            }
+
+            {
+                const Image::Info info(16, 16, Image::Type::RGB_U8);
+                auto frameCache = FrameCache::create();
+                frameCache->setMaxByteCount(info.getDataByteCount() * 10);
+                const UID client = frameCache->addClient();
+                frameCache->setEnabled(client, true);
+                frameCache->add(client, FrameCache::Key("image.ppm", 0, 0, std::string(), Proxy::_1_2), Image::Data::create(info));
+                DJV_ASSERT(frameCache->contains(FrameCache::Key("image.ppm", 0, 0, std::string(), Proxy::_1_2)));
+                DJV_ASSERT(!frameCache->contains(FrameCache::Key("image.ppm", 0, 0, std::string())));
+            }
+
+            if (auto context = getContext().lock())
+            {
+                // PPM files are read with decimated reads, PNG files are
+                // reduced with the box filter.
+                auto io = context->getSystemT<IOSystem>();
+                for (const auto& extension : { ".ppm", ".png" })
+                {
+                    const Image::Info imageInfo(32, 32, Image::Type::RGB_U8);
+                    auto image = Image::Data::create(imageInfo);
+                    image->zero();
+                    const System::File::Path path(getTempPath(), std::string("proxy") + extension);
+                    Info info;
+                    info.video.push_back(imageInfo);
+                    auto write = io->write(System::File::Info(path), info);
+                    {
+                        std::lock_guard<std::mutex> lock(write->getMutex());
+                        auto& writeQueue = write->getVideoQueue();
+                        writeQueue.addFrame(VideoFrame(0, image));
+                        writeQueue.setFinished(true);
+                    }
+                    while (write->isRunning())
+                    {}
+
+                    ReadOptions options;
+                    options.proxy = Proxy::_1_4;
+                    auto read = io->read(System::File::Info(path), options);
+                    DJV_ASSERT(Image::Size(32, 32) == read->getInfo().get().video[0].size);
+                    std::shared_ptr<Image::Data> proxyImage;
+                    while (!proxyImage)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(read->getMutex());
+                            auto& readQueue = read->getVideoQueue();
+                            if (!readQueue.isEmpty())
+                            {
+                                proxyImage = readQueue.popFrame().data;
+                            }
+                            else if (readQueue.isFinished())
+                            {
+                                break;
+                            }
+                        }
+                        std::this_thread::sleep_for(System::getTimerDuration(System::TimerValue::Fast));
+                    }
+                    DJV_ASSERT(proxyImage);
+                    DJV_ASSERT(Image::Size(8, 8) == proxyImage->getSize());
+                }
+            }
+        }
+
+        void IOTest::_roi()
+        {
+            {
+                ReadOptions options;
+                DJV_ASSERT(!getROI(options, Image::Size(100, 50)).isValid());
+                options.roi = Math::BBox2i(0, 0, 100, 50);
+                DJV_ASSERT(!getROI(options, Image::Size(100, 50)).isValid());
+                options.roi = Math::BBox2i(90, 40, 20, 20);
+                DJV_ASSERT(Math::BBox2i(90, 40, 10, 10) == getROI(options, Image::Size(100, 50)));
+                options.proxy = Proxy::_1_2;
+                DJV_ASSERT(!getROI(options, Image::Size(100, 50)).isValid());
+            }
+
+            {
+                Image::Info info(100, 50, Image::Type::RGB_U8);
+                const Math::BBox2i roi(10, 20, 30, 5);
+                DJV_ASSERT(roi == mirrorROI(info, roi));
+                info.layout.mirror.y = true;
+                DJV_ASSERT(Math::BBox2i(10, 25, 30, 5) == mirrorROI(info, roi));
+                info.layout.mirror.x = true;
+                DJV_ASSERT(Math::BBox2i(60, 25, 30, 5) == mirrorROI(info, roi));
+            }
+
+            {
+                const Image::Info info(16, 16, Image::Type::RGB_U8);
+                auto frameCache = FrameCache::create();
+                frameCache->setMaxByteCount(info.getDataByteCount() * 10);
+                const UID client = frameCache->addClient();
+                frameCache->setEnabled(client, true);
+                const Math::BBox2i roi(4, 4, 8, 8);
+                frameCache->add(client, FrameCache::Key("image.ppm", 0, 0, std::string(), Proxy::None, roi), Image::Data::create(info));
+                DJV_ASSERT(frameCache->contains(FrameCache::Key("image.ppm", 0, 0, std::string(), Proxy::None, roi)));
+                DJV_ASSERT(!frameCache->contains(FrameCache::Key("image.ppm", 0, 0, std::string())));
+            }
+
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IOSystem>();
+                const Image::Info imageInfo(32, 32, Image::Type::RGB_U8);
+                auto image = Image::Data::create(imageInfo);
+                image->zero();
+                const System::File::Path path(getTempPath(), "roi.ppm");
+                Info info;
+                info.video.push_back(imageInfo);
+                auto write = io->write(System::File::Info(path), info);
+                {
+                    std::lock_guard<std::mutex> lock(write->getMutex());
+                    auto& writeQueue = write->getVideoQueue();
+                    writeQueue.addFrame(VideoFrame(0, image));
+                    writeQueue.setFinished(true);
+                }
+                while (write->isRunning())
+                {}
+
+                ReadOptions options;
+                options.roi = Math::BBox2i(4, 8, 10, 6);
+                auto read = io->read(System::File::Info(path), options);
+                std::shared_ptr<Image::Data> roiImage;
+                while (!roiImage)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(read->getMutex());
+                        auto& readQueue = read->getVideoQueue();
+                        if (!readQueue.isEmpty())
+                        {
+                            roiImage = readQueue.popFrame().data;
+                        }
+                        else if (readQueue.isFinished())
+                        {
+                            break;
+                        }
+                    }
+                    std::this_thread::sleep_for(System::getTimerDuration(System::TimerValue::Fast));
+                }
+                DJV_ASSERT(roiImage);
+                DJV_ASSERT(Image::Size(10, 6) == roiImage->getSize());
+                DJV_ASSERT(glm::ivec2(4, 8) == roiImage->getOrigin());
+            }
+        }
+
+        void IOTest::_audioOutput()
+        {
+            {
+                const Audio::Info info(2, Audio::Type::S16, 48000);
+                DJV_ASSERT(info == getAudioOutputInfo(info, Audio::Info()));
+                const Audio::Info output = getAudioOutputInfo(info, Audio::Info(8, Audio::Type::F32, 44100));
+                DJV_ASSERT(2 == output.channelCount);
+                DJV_ASSERT(Audio::Type::F32 == output.type);
+                DJV_ASSERT(44100 == output.sampleRate);
+            }
+
+            {
+                const Audio::Info info(6, Audio::Type::F32, 44100);
+                const Audio::Info output = getAudioOutputInfo(info, Audio::Info(2, Audio::Type::None, 0));
+                DJV_ASSERT(2 == output.channelCount);
+                DJV_ASSERT(Audio::Type::F32 == output.type);
+                DJV_ASSERT(44100 == output.sampleRate);
+            }
+
+            {
+                DJV_ASSERT(!getAudioOutputInfo(Audio::Info(), Audio::Info(2, Audio::Type::F32, 48000)).isValid());
+            }
+        }
+
         void IOTest::_plugin()
         {
             if (auto context = getContext().lock())
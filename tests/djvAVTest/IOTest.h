@@ -27,6 +27,10 @@ namespace djv
             void _audioQueue();
             void _inOutPoints();
             void _cache();
+            void _frameCache();
+            void _proxy();
+            void _roi();
+            void _audioOutput();
             void _plugin();
             void _io();
             void _io(
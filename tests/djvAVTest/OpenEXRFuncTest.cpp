@@ -6,6 +6,8 @@
 
 #include <djvAV/OpenEXRFunc.h>
 
+#include <djvImage/Data.h>
+
 #include <djvCore/ErrorFunc.h>
 
 #include <ImfStandardAttributes.h>
@@ -29,6 +31,7 @@ namespace djv
             _enum();
             _data();
             _serialize();
+            _tileCache();
         }
 
         void OpenEXRFuncTest::_enum()
@@ -304,6 +307,39 @@ namespace djv
             }
         }
         
+        void OpenEXRFuncTest::_tileCache()
+        {
+            const Image::Info info(64, 64, Image::Type::RGBA_F16);
+            auto tileCache = OpenEXR::TileCache::create();
+            tileCache->setMaxByteCount(info.getDataByteCount() * 2);
+            DJV_ASSERT(info.getDataByteCount() * 2 == tileCache->getMaxByteCount());
+            OpenEXR::TileCache::Key key;
+            key.fileName = "render.0001.exr";
+            DJV_ASSERT(!tileCache->get(key));
+            for (int i = 0; i < 3; ++i)
+            {
+                key.x = i;
+                tileCache->add(key, Image::Data::create(info));
+            }
+            DJV_ASSERT(2 == tileCache->getCount());
+            DJV_ASSERT(info.getDataByteCount() * 2 == tileCache->getByteCount());
+            key.x = 0;
+            DJV_ASSERT(!tileCache->get(key));
+            key.x = 2;
+            DJV_ASSERT(tileCache->get(key));
+            key.time = 1;
+            DJV_ASSERT(!tileCache->get(key));
+            key.time = 0;
+            key.size = 1;
+            DJV_ASSERT(!tileCache->get(key));
+            key.size = 0;
+            key.level = 1;
+            DJV_ASSERT(!tileCache->get(key));
+            tileCache->clear();
+            DJV_ASSERT(0 == tileCache->getCount());
+            DJV_ASSERT(0 == tileCache->getByteCount());
+        }
+
     } // namespace AVTest
 } // namespace djv
 
@@ -21,6 +21,7 @@ namespace djv
             void _enum();
             void _data();
             void _serialize();
+            void _tileCache();
         };
         
     } // namespace AVTest
@@ -4,10 +4,17 @@
 
 #include <djvAVTest/TIFFFuncTest.h>
 
+#include <djvAV/IOSystem.h>
 #include <djvAV/TIFFFunc.h>
 
+#include <djvSystem/Context.h>
+#include <djvSystem/TimerFunc.h>
+
 #include <djvCore/ErrorFunc.h>
 
+#include <cstring>
+#include <thread>
+
 using namespace djv::Core;
 using namespace djv::AV;
 using namespace djv::AV::IO;
@@ -25,6 +32,7 @@ namespace djv
         void TIFFFuncTest::run()
         {
             _serialize();
+            _readBlocks();
         }
 
         void TIFFFuncTest::_serialize()
@@ -52,6 +60,200 @@ namespace djv
             }
         }
 
+        namespace
+        {
+            const uint32 width  = 100;
+            const uint32 height = 70;
+
+            uint8_t getPixel(uint32 x, uint32 y, uint32 c)
+            {
+                return static_cast<uint8_t>((x * 7 + y * 13 + c * 31) & 0xff);
+            }
+
+            //! Write a RGB image with strips or tiles.
+            void writeTIFF(const std::string& fileName, bool tiled, uint16 compression)
+            {
+                ::TIFF* f = TIFFOpen(fileName.c_str(), "w");
+                DJV_ASSERT(f);
+                TIFFSetField(f, TIFFTAG_IMAGEWIDTH, width);
+                TIFFSetField(f, TIFFTAG_IMAGELENGTH, height);
+                TIFFSetField(f, TIFFTAG_BITSPERSAMPLE, 8);
+                TIFFSetField(f, TIFFTAG_SAMPLESPERPIXEL, 3);
+                TIFFSetField(f, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_UINT);
+                TIFFSetField(f, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_RGB);
+                TIFFSetField(f, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+                TIFFSetField(f, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
+                TIFFSetField(f, TIFFTAG_COMPRESSION, compression);
+                if (tiled)
+                {
+                    const uint32 tileSize = 32;
+                    TIFFSetField(f, TIFFTAG_TILEWIDTH, tileSize);
+                    TIFFSetField(f, TIFFTAG_TILELENGTH, tileSize);
+                    std::vector<uint8_t> tile(TIFFTileSize(f));
+                    for (uint32 tileY = 0; tileY < height; tileY += tileSize)
+                    {
+                        for (uint32 tileX = 0; tileX < width; tileX += tileSize)
+                        {
+                            memset(tile.data(), 0, tile.size());
+                            for (uint32 y = 0; y < tileSize && tileY + y < height; ++y)
+                            {
+                                for (uint32 x = 0; x < tileSize && tileX + x < width; ++x)
+                                {
+                                    for (uint32 c = 0; c < 3; ++c)
+                                    {
+                                        tile[(y * tileSize + x) * 3 + c] = getPixel(tileX + x, tileY + y, c);
+                                    }
+                                }
+                            }
+                            DJV_ASSERT(TIFFWriteTile(f, tile.data(), tileX, tileY, 0, 0) != -1);
+                        }
+                    }
+                }
+                else
+                {
+                    TIFFSetField(f, TIFFTAG_ROWSPERSTRIP, 8);
+                    std::vector<uint8_t> scanline(width * 3);
+                    for (uint32 y = 0; y < height; ++y)
+                    {
+                        for (uint32 x = 0; x < width; ++x)
+                        {
+                            for (uint32 c = 0; c < 3; ++c)
+                            {
+                                scanline[x * 3 + c] = getPixel(x, y, c);
+                            }
+                        }
+                        DJV_ASSERT(TIFFWriteScanline(f, scanline.data(), y) != -1);
+                    }
+                }
+                TIFFClose(f);
+            }
+
+            //! Decode an image serially.
+            std::vector<uint8_t> readTIFFSerial(const std::string& fileName)
+            {
+                std::vector<uint8_t> out(width * height * 3);
+                ::TIFF* f = TIFFOpen(fileName.c_str(), "r");
+                DJV_ASSERT(f);
+                if (TIFFIsTiled(f))
+                {
+                    uint32 tileWidth = 0;
+                    uint32 tileHeight = 0;
+                    TIFFGetField(f, TIFFTAG_TILEWIDTH, &tileWidth);
+                    TIFFGetField(f, TIFFTAG_TILELENGTH, &tileHeight);
+                    std::vector<uint8_t> tile(TIFFTileSize(f));
+                    for (uint32 tileY = 0; tileY < height; tileY += tileHeight)
+                    {
+                        for (uint32 tileX = 0; tileX < width; tileX += tileWidth)
+                        {
+                            DJV_ASSERT(TIFFReadTile(f, tile.data(), tileX, tileY, 0, 0) != -1);
+                            for (uint32 y = 0; y < tileHeight && tileY + y < height; ++y)
+                            {
+                                const uint32 w = std::min(tileWidth, width - tileX);
+                                memcpy(
+                                    out.data() + ((tileY + y) * width + tileX) * 3,
+                                    tile.data() + y * tileWidth * 3,
+                                    w * 3);
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    for (uint32 y = 0; y < height; ++y)
+                    {
+                        DJV_ASSERT(TIFFReadScanline(f, out.data() + y * width * 3, y) != -1);
+                    }
+                }
+                TIFFClose(f);
+                return out;
+            }
+
+            std::shared_ptr<Image::Data> readImage(
+                const std::shared_ptr<IOSystem>& io,
+                const std::string& fileName,
+                const ReadOptions& options = ReadOptions())
+            {
+                std::shared_ptr<Image::Data> out;
+                auto read = io->read(System::File::Info(fileName), options);
+                while (!out)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(read->getMutex());
+                        auto& readQueue = read->getVideoQueue();
+                        if (!readQueue.isEmpty())
+                        {
+                            out = readQueue.popFrame().data;
+                        }
+                        else if (readQueue.isFinished())
+                        {
+                            break;
+                        }
+                    }
+                    std::this_thread::sleep_for(System::getTimerDuration(System::TimerValue::Fast));
+                }
+                return out;
+            }
+
+            bool compare(
+                const std::shared_ptr<Image::Data>& image,
+                const std::vector<uint8_t>& serial,
+                const Math::BBox2i& bounds)
+            {
+                for (int y = bounds.min.y; y <= bounds.max.y; ++y)
+                {
+                    if (memcmp(
+                        image->getData(0, y - bounds.min.y),
+                        serial.data() + (y * width + bounds.min.x) * 3,
+                        bounds.w() * 3) != 0)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+        } // namespace
+
+        void TIFFFuncTest::_readBlocks()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IOSystem>();
+                const Math::BBox2i bounds(0, 0, width, height);
+                const struct
+                {
+                    std::string name;
+                    bool        tiled;
+                    uint16      compression;
+                }
+                files[] =
+                {
+                    { "tiled.tif", true, COMPRESSION_ADOBE_DEFLATE },
+                    { "strips.tif", false, COMPRESSION_LZW }
+                };
+                for (const auto& i : files)
+                {
+                    const std::string fileName = System::File::Path(getTempPath(), i.name).get();
+                    writeTIFF(fileName, i.tiled, i.compression);
+                    const std::vector<uint8_t> serial = readTIFFSerial(fileName);
+
+                    auto image = readImage(io, fileName);
+                    DJV_ASSERT(image);
+                    DJV_ASSERT(Image::Size(width, height) == image->getSize());
+                    DJV_ASSERT(Image::Type::RGB_U8 == image->getType());
+                    DJV_ASSERT(compare(image, serial, bounds));
+
+                    // A region that does not start on a block boundary.
+                    ReadOptions options;
+                    options.roi = Math::BBox2i(20, 10, 50, 45);
+                    image = readImage(io, fileName, options);
+                    DJV_ASSERT(image);
+                    DJV_ASSERT(Image::Size(50, 45) == image->getSize());
+                    DJV_ASSERT(compare(image, serial, options.roi));
+                }
+            }
+        }
+
     } // namespace AVTest
 } // namespace djv
 
@@ -19,6 +19,7 @@ namespace djv
         
         private:
             void _serialize();
+            void _readBlocks();
         };
         
     } // namespace AVTest
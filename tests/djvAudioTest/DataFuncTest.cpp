@@ -7,6 +7,8 @@
 #include <djvAudio/Data.h>
 #include <djvAudio/DataFunc.h>
 
+#include <cstring>
+
 using namespace djv::Core;
 using namespace djv::Audio;
 
@@ -66,6 +68,116 @@ namespace djv
                     info.type);
             }
             
+            for (auto i : Audio::getTypeEnums())
+            {
+                const Audio::Info info(2, i, 44000);
+                auto data = Audio::Data::create(info, 100);
+                data->zero();
+                float min = 0.F;
+                float max = 0.F;
+                float sumSquares = 0.F;
+                Audio::reduce(data->getData(), data->getSampleCount(), info.channelCount, info.type, min, max, sumSquares);
+                DJV_ASSERT(0.F == min);
+                DJV_ASSERT(0.F == max);
+                DJV_ASSERT(0.F == sumSquares);
+            }
+
+            {
+                // The SIMD code paths should give the same results as the
+                // scalar code, including the values left over at the end.
+                const size_t count = 1001;
+                std::vector<Audio::F32_T> data(count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    data[i] = ((i * 7919) % 2001) / 1000.F - 1.F;
+                }
+                for (const auto simd : { OS::SIMD::None, OS::SIMD::SSE41, OS::SIMD::AVX2 })
+                {
+                    float min = 1.F;
+                    float max = -1.F;
+                    float sumSquares = 0.F;
+                    Audio::reduce(
+                        reinterpret_cast<const uint8_t*>(data.data()),
+                        count,
+                        1,
+                        Audio::Type::F32,
+                        min,
+                        max,
+                        sumSquares,
+                        simd);
+                    DJV_ASSERT(-1.F == min);
+                    DJV_ASSERT(1.F == max);
+                    DJV_ASSERT(sumSquares > 0.F);
+                }
+            }
+
+            for (auto i : Audio::getTypeEnums())
+            {
+                // The SIMD code paths should give the same results as the
+                // scalar code for conversion and volume, including the
+                // samples left over at the end and volumes that saturate.
+                const Audio::Info info(1, i, 44000);
+                const size_t count = 1001;
+                auto data = Audio::Data::create(info, count);
+                const float step = 4.F / count;
+                for (size_t j = 0; j < count; ++j)
+                {
+                    const float value = -2.F + j * step;
+                    uint8_t* p = data->getData() + j * Audio::getByteCount(i);
+                    switch (i)
+                    {
+                    case Audio::Type::S8:  Audio::F32ToS8(value, *reinterpret_cast<Audio::S8_T*>(p)); break;
+                    case Audio::Type::S16: Audio::F32ToS16(value, *reinterpret_cast<Audio::S16_T*>(p)); break;
+                    case Audio::Type::S32: Audio::F32ToS32(value, *reinterpret_cast<Audio::S32_T*>(p)); break;
+                    case Audio::Type::F32: *reinterpret_cast<Audio::F32_T*>(p) = value; break;
+                    case Audio::Type::F64: *reinterpret_cast<Audio::F64_T*>(p) = value; break;
+                    default: break;
+                    }
+                }
+                for (auto j : Audio::getTypeEnums())
+                {
+                    const auto scalar = Audio::convert(data, j, OS::SIMD::None);
+                    for (const auto simd : { OS::SIMD::SSE41, OS::SIMD::AVX2 })
+                    {
+                        const auto data2 = Audio::convert(data, j, simd);
+                        DJV_ASSERT(0 == memcmp(scalar->getData(), data2->getData(), scalar->getByteCount()));
+                    }
+                }
+                for (const float v : { 0.F, .5F, 1.F, 3.F })
+                {
+                    auto scalar = Audio::Data::create(info, count);
+                    Audio::volume(data->getData(), scalar->getData(), v, count, 1, i, OS::SIMD::None);
+                    for (const auto simd : { OS::SIMD::SSE41, OS::SIMD::AVX2 })
+                    {
+                        auto data2 = Audio::Data::create(info, count);
+                        Audio::volume(data->getData(), data2->getData(), v, count, 1, i, simd);
+                        DJV_ASSERT(0 == memcmp(scalar->getData(), data2->getData(), scalar->getByteCount()));
+                    }
+                }
+            }
+
+            for (auto i : Audio::getTypeEnums())
+            {
+                const Audio::Info info(2, i, 44000);
+                const size_t count = 1001;
+                auto data = Audio::Data::create(info, count);
+                for (size_t j = 0; j < data->getByteCount(); ++j)
+                {
+                    data->getData()[j] = static_cast<uint8_t>(j * 31);
+                }
+                const auto interleaved = Audio::planarInterleave(data, OS::SIMD::None);
+                const auto deinterleaved = Audio::planarDeinterleave(data, OS::SIMD::None);
+                for (const auto simd : { OS::SIMD::SSE41, OS::SIMD::AVX2 })
+                {
+                    const auto data2 = Audio::planarInterleave(data, simd);
+                    DJV_ASSERT(0 == memcmp(interleaved->getData(), data2->getData(), data->getByteCount()));
+                    const auto data3 = Audio::planarDeinterleave(data, simd);
+                    DJV_ASSERT(0 == memcmp(deinterleaved->getData(), data3->getData(), data->getByteCount()));
+                    const auto data4 = Audio::planarDeinterleave(data2, simd);
+                    DJV_ASSERT(0 == memcmp(data->getData(), data4->getData(), data->getByteCount()));
+                }
+            }
+
             {
                 const std::vector<int8_t> data = {
                     0,
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAudioTest/RingBufferTest.h>
+
+#include <djvAudio/RingBuffer.h>
+
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::Audio;
+
+namespace djv
+{
+    namespace AudioTest
+    {
+        RingBufferTest::RingBufferTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::AudioTest::RingBufferTest", tempPath, context)
+        {}
+        
+        void RingBufferTest::run()
+        {
+            _info();
+            _readWrite();
+            _flush();
+            _threads();
+        }
+        
+        void RingBufferTest::_info()
+        {
+            {
+                const Audio::Info info(2, Audio::Type::S16, 44100);
+                auto ringBuffer = Audio::RingBuffer::create(info, 100);
+                DJV_ASSERT(info == ringBuffer->getInfo());
+                DJV_ASSERT(100 == ringBuffer->getSampleCount());
+                DJV_ASSERT(0 == ringBuffer->getReadAvailable());
+                DJV_ASSERT(100 == ringBuffer->getWriteAvailable());
+                DJV_ASSERT(!ringBuffer->isFinished());
+                DJV_ASSERT(0 == ringBuffer->getUnderrunCount());
+                DJV_ASSERT(0 == ringBuffer->getOverrunCount());
+            }
+        }
+
+        void RingBufferTest::_readWrite()
+        {
+            {
+                const Audio::Info info(1, Audio::Type::S8, 44100);
+                auto ringBuffer = Audio::RingBuffer::create(info, 8);
+                const uint8_t in[] = { 1, 2, 3, 4, 5, 6 };
+                DJV_ASSERT(6 == ringBuffer->write(in, 6));
+                DJV_ASSERT(6 == ringBuffer->getReadAvailable());
+                DJV_ASSERT(2 == ringBuffer->getWriteAvailable());
+
+                uint8_t out[8] = {};
+                DJV_ASSERT(4 == ringBuffer->read(out, 4));
+                DJV_ASSERT(1 == out[0] && 4 == out[3]);
+
+                // Wrap around the end of the buffer.
+                DJV_ASSERT(6 == ringBuffer->write(in, 6));
+                DJV_ASSERT(8 == ringBuffer->getReadAvailable());
+                DJV_ASSERT(8 == ringBuffer->read(out, 8));
+                DJV_ASSERT(5 == out[0]);
+                DJV_ASSERT(6 == out[1]);
+                DJV_ASSERT(1 == out[2]);
+                DJV_ASSERT(6 == out[7]);
+                DJV_ASSERT(0 == ringBuffer->getUnderrunCount());
+                DJV_ASSERT(0 == ringBuffer->getOverrunCount());
+            }
+
+            {
+                const Audio::Info info(1, Audio::Type::S8, 44100);
+                auto ringBuffer = Audio::RingBuffer::create(info, 4);
+                const uint8_t in[] = { 1, 2, 3, 4, 5, 6 };
+                DJV_ASSERT(4 == ringBuffer->write(in, 6));
+                DJV_ASSERT(1 == ringBuffer->getOverrunCount());
+
+                uint8_t out[8] = {};
+                DJV_ASSERT(4 == ringBuffer->read(out, 8));
+                DJV_ASSERT(1 == ringBuffer->getUnderrunCount());
+                ringBuffer->setFinished(true);
+                DJV_ASSERT(ringBuffer->isFinished());
+                DJV_ASSERT(0 == ringBuffer->read(out, 8));
+                DJV_ASSERT(1 == ringBuffer->getUnderrunCount());
+            }
+        }
+
+        void RingBufferTest::_flush()
+        {
+            {
+                const Audio::Info info(1, Audio::Type::S8, 44100);
+                auto ringBuffer = Audio::RingBuffer::create(info, 4);
+                const uint8_t in[] = { 1, 2, 3, 4 };
+                ringBuffer->write(in, 4);
+                ringBuffer->flush();
+                DJV_ASSERT(0 == ringBuffer->getReadAvailable());
+                DJV_ASSERT(4 == ringBuffer->getWriteAvailable());
+
+                const uint8_t in2[] = { 5, 6 };
+                DJV_ASSERT(2 == ringBuffer->write(in2, 2));
+                uint8_t out[4] = {};
+                DJV_ASSERT(2 == ringBuffer->read(out, 2));
+                DJV_ASSERT(5 == out[0]);
+                DJV_ASSERT(6 == out[1]);
+            }
+        }
+
+        void RingBufferTest::_threads()
+        {
+            {
+                const Audio::Info info(1, Audio::Type::S32, 44100);
+                auto ringBuffer = Audio::RingBuffer::create(info, 64);
+                const int32_t count = 100000;
+                std::thread thread(
+                    [ringBuffer, count]
+                    {
+                        int32_t i = 0;
+                        while (i < count)
+                        {
+                            if (ringBuffer->write(reinterpret_cast<const uint8_t*>(&i), 1))
+                            {
+                                ++i;
+                            }
+                            else
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+                    });
+                bool ordered = true;
+                int32_t i = 0;
+                while (i < count)
+                {
+                    int32_t value = 0;
+                    if (ringBuffer->read(reinterpret_cast<uint8_t*>(&value), 1))
+                    {
+                        ordered &= value == i;
+                        ++i;
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                thread.join();
+                DJV_ASSERT(ordered);
+            }
+        }
+        
+    } // namespace AudioTest
+} // namespace djv
@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAudioTest/WaveformTest.h>
+
+#include <djvAudio/Data.h>
+#include <djvAudio/Waveform.h>
+
+#include <djvSystem/Context.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/FileInfo.h>
+#include <djvSystem/TextSystem.h>
+
+#include <djvCore/ErrorFunc.h>
+
+using namespace djv::Core;
+using namespace djv::Audio;
+
+namespace djv
+{
+    namespace AudioTest
+    {
+        WaveformTest::WaveformTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::AudioTest::WaveformTest", tempPath, context)
+        {}
+        
+        void WaveformTest::run()
+        {
+            _info();
+            _bins();
+            _levels();
+            _cache();
+        }
+        
+        void WaveformTest::_info()
+        {
+            {
+                const Audio::Waveform waveform;
+                DJV_ASSERT(0 == waveform.getSampleRate());
+                DJV_ASSERT(0 == waveform.getSampleCount());
+                DJV_ASSERT(0 == waveform.getLevelCount());
+                DJV_ASSERT(waveform.getBins(0, 100, 10).size() == 10);
+            }
+
+            {
+                const Audio::Waveform waveform(44100, 256);
+                DJV_ASSERT(44100 == waveform.getSampleRate());
+                DJV_ASSERT(256 == waveform.getBinSampleCount());
+            }
+        }
+
+        void WaveformTest::_bins()
+        {
+            {
+                // Add the data in pieces that do not line up with the bins.
+                const Audio::Info info(2, Audio::Type::F32, 44100);
+                Audio::Waveform waveform(info.sampleRate, 4);
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    auto data = Audio::Data::create(info, 3);
+                    auto dataP = reinterpret_cast<Audio::F32_T*>(data->getData());
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        dataP[j * 2] = .5F;
+                        dataP[j * 2 + 1] = -.5F;
+                    }
+                    waveform.add(*data);
+                }
+                waveform.finish();
+                DJV_ASSERT(9 == waveform.getSampleCount());
+                const auto& level = waveform.getLevel(0);
+                DJV_ASSERT(3 == level.size());
+                for (const auto& bin : level)
+                {
+                    DJV_ASSERT(-.5F == bin.min);
+                    DJV_ASSERT(.5F == bin.max);
+                    DJV_ASSERT(.5F == bin.rms);
+                }
+            }
+
+            {
+                const Audio::Info info(1, Audio::Type::S16, 44100);
+                Audio::Waveform waveform(info.sampleRate, 2);
+                auto data = Audio::Data::create(info, 4);
+                auto dataP = reinterpret_cast<Audio::S16_T*>(data->getData());
+                dataP[0] = 0;
+                dataP[1] = Audio::S16Range.getMax();
+                dataP[2] = 0;
+                dataP[3] = 0;
+                waveform.add(*data);
+                waveform.finish();
+                const auto bins = waveform.getBins(0, 4, 2);
+                DJV_ASSERT(2 == bins.size());
+                DJV_ASSERT(bins[0].max > .99F);
+                DJV_ASSERT(0.F == bins[1].max);
+            }
+        }
+
+        void WaveformTest::_levels()
+        {
+            {
+                const Audio::Info info(1, Audio::Type::F32, 44100);
+                Audio::Waveform waveform(info.sampleRate, 1);
+                auto data = Audio::Data::create(info, 5);
+                auto dataP = reinterpret_cast<Audio::F32_T*>(data->getData());
+                for (size_t i = 0; i < 5; ++i)
+                {
+                    dataP[i] = i / 4.F;
+                }
+                waveform.add(*data);
+                waveform.finish();
+                DJV_ASSERT(4 == waveform.getLevelCount());
+                DJV_ASSERT(5 == waveform.getLevel(0).size());
+                DJV_ASSERT(3 == waveform.getLevel(1).size());
+                DJV_ASSERT(2 == waveform.getLevel(2).size());
+                DJV_ASSERT(1 == waveform.getLevel(3).size());
+                DJV_ASSERT(0.F == waveform.getLevel(3)[0].min);
+                DJV_ASSERT(1.F == waveform.getLevel(3)[0].max);
+
+                // A single column covers all of the samples.
+                const auto bins = waveform.getBins(0, 5, 1);
+                DJV_ASSERT(1 == bins.size());
+                DJV_ASSERT(0.F == bins[0].min);
+                DJV_ASSERT(1.F == bins[0].max);
+            }
+        }
+
+        void WaveformTest::_cache()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto textSystem = context->getSystemT<System::TextSystem>();
+
+                // The cache is checked against the file the waveform is for.
+                const std::string mediaFileName = System::File::Path(getTempPath(), "WaveformTest.wav").get();
+                {
+                    auto io = System::File::IO::create();
+                    io->open(mediaFileName, System::File::Mode::Write);
+                    io->writeU32(0);
+                }
+                const System::File::Info mediaFileInfo(mediaFileName);
+                const std::string fileName = System::File::Path(
+                    getTempPath(),
+                    Audio::Waveform::getCacheFileName(mediaFileInfo)).get();
+
+                const Audio::Info info(1, Audio::Type::F32, 44100);
+                Audio::Waveform waveform(info.sampleRate, 2);
+                auto data = Audio::Data::create(info, 5);
+                auto dataP = reinterpret_cast<Audio::F32_T*>(data->getData());
+                for (size_t i = 0; i < 5; ++i)
+                {
+                    dataP[i] = i / 4.F - .5F;
+                }
+                waveform.add(*data);
+                waveform.finish();
+                waveform.write(fileName, mediaFileInfo);
+
+                {
+                    Audio::Waveform waveform2;
+                    waveform2.read(fileName, mediaFileInfo, textSystem);
+                    DJV_ASSERT(waveform.getSampleRate() == waveform2.getSampleRate());
+                    DJV_ASSERT(waveform.getBinSampleCount() == waveform2.getBinSampleCount());
+                    DJV_ASSERT(waveform.getSampleCount() == waveform2.getSampleCount());
+                    DJV_ASSERT(waveform.getLevelCount() == waveform2.getLevelCount());
+                    for (size_t i = 0; i < waveform.getLevelCount(); ++i)
+                    {
+                        DJV_ASSERT(waveform.getLevel(i) == waveform2.getLevel(i));
+                    }
+                }
+
+                try
+                {
+                    Audio::Waveform waveform2;
+                    waveform2.read(fileName, System::File::Info(), textSystem);
+                    DJV_ASSERT(false);
+                }
+                catch (const std::exception& e)
+                {
+                    _print(Error::format(e));
+                }
+            }
+        }
+
+    } // namespace AudioTest
+} // namespace djv
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImageTest/ConvertTest.h>
+
+#include <djvImage/Convert.h>
+#include <djvImage/Data.h>
+#include <djvImage/TypeFunc.h>
+
+#include <djvSystem/ThreadPool.h>
+
+#include <djvCore/MemoryFunc.h>
+#include <djvCore/OSFunc.h>
+
+#include <cstring>
+#include <sstream>
+
+using namespace djv::Core;
+using namespace djv::Image;
+
+namespace djv
+{
+    namespace ImageTest
+    {
+        ConvertTest::ConvertTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::ImageTest::ConvertTest", tempPath, context)
+        {}
+        
+        void ConvertTest::run()
+        {
+            _types();
+            _layout();
+            _resize();
+        }
+
+        void ConvertTest::_types()
+        {
+            {
+                std::stringstream ss;
+                ss << "SIMD: " << static_cast<int>(OS::getSIMD());
+                _print(ss.str());
+            }
+            auto threadPool = System::ThreadPool::create(4);
+            const Size size(317, 71);
+            for (const auto inType : getTypeEnums())
+            {
+                if (Type::None == inType)
+                    continue;
+
+                // Fill the input with values that are in range for every type.
+                const Info floatInfo(size, getFloatType(getChannelCount(inType), 32));
+                auto floatData = Data::create(floatInfo);
+                F32_T* floatP = reinterpret_cast<F32_T*>(floatData->getData());
+                const size_t count = floatInfo.getDataByteCount() / sizeof(F32_T);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    floatP[i] = (i % 1021) / 1020.F;
+                }
+                const Info inInfo(size, inType);
+                auto in = Data::create(inInfo);
+                convert(floatData->getData(), floatInfo.type, in->getData(), inType, size.w * size.h);
+
+                for (const auto outType : getTypeEnums())
+                {
+                    if (Type::None == outType)
+                        continue;
+
+                    // Compare the results with the scalar conversion.
+                    const Info outInfo(size, outType);
+                    auto scalar = Data::create(outInfo);
+                    convert(in->getData(), inType, scalar->getData(), outType, size.w * size.h);
+                    for (const auto simd : { OS::SIMD::None, OS::SIMD::SSE41, OS::SIMD::AVX2 })
+                    {
+                        auto imageConvert = Convert::create(threadPool);
+                        imageConvert->setSIMD(simd);
+                        DJV_ASSERT(imageConvert->getSIMD() <= OS::getSIMD());
+                        auto out = Data::create(outInfo);
+                        imageConvert->process(*in, outInfo, *out);
+                        DJV_ASSERT(*out == *scalar);
+                    }
+                }
+            }
+        }
+
+        void ConvertTest::_layout()
+        {
+            const Info info(Size(33, 5), Type::RGB_U16);
+            auto data = Data::create(info);
+            for (size_t i = 0; i < data->getDataByteCount(); ++i)
+            {
+                data->getData()[i] = static_cast<uint8_t>(i * 7);
+            }
+            const Info layoutInfo(
+                Size(33, 5),
+                Type::RGB_U16,
+                Layout(Mirror(true, true), 4, Memory::opposite(Memory::getEndian()), true));
+            auto layoutData = Data::create(layoutInfo);
+            auto imageConvert = Convert::create();
+            imageConvert->process(*data, layoutInfo, *layoutData);
+
+            // The first pixel becomes the last, byte swapped.
+            const uint8_t* p = data->getData(0, 0);
+            const uint8_t* layoutP = layoutData->getData(32, 4);
+            DJV_ASSERT(p[0] == layoutP[1]);
+            DJV_ASSERT(p[1] == layoutP[0]);
+
+            auto out = Data::create(info);
+            imageConvert->process(*layoutData, info, *out);
+            DJV_ASSERT(*out == *data);
+        }
+
+        void ConvertTest::_resize()
+        {
+            auto data = Data::create(Info(Size(4, 2), Type::L_U8));
+            const uint8_t values[] = { 0, 100, 200, 255, 50, 100, 0, 255 };
+            memcpy(data->getData(), values, sizeof(values));
+            auto imageConvert = Convert::create();
+            {
+                const Info info(Size(2, 1), Type::L_U8);
+                auto out = Data::create(info);
+                imageConvert->process(*data, info, *out);
+                DJV_ASSERT(62 == out->getData()[0]);
+                DJV_ASSERT(177 == out->getData()[1]);
+            }
+            {
+                const Info info(Size(8, 4), Type::L_U8);
+                auto out = Data::create(info);
+                imageConvert->process(*data, info, *out);
+                DJV_ASSERT(0 == out->getData(0)[0]);
+                DJV_ASSERT(0 == out->getData(0)[1]);
+                DJV_ASSERT(255 == out->getData(3)[7]);
+                DJV_ASSERT(50 == out->getData(3)[0]);
+            }
+        }
+        
+    } // namespace ImageTest
+} // namespace djv
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace ImageTest
+    {
+        class ConvertTest : public Test::ITest
+        {
+        public:
+            ConvertTest(
+                const System::File::Path& tempPath,
+                const std::shared_ptr<System::Context>&);
+            
+            void run() override;
+        
+        private:
+            void _types();
+            void _layout();
+            void _resize();
+        };
+        
+    } // namespace ImageTest
+} // namespace djv
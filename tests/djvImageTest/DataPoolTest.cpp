@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImageTest/DataPoolTest.h>
+
+#include <djvImage/Data.h>
+#include <djvImage/DataPool.h>
+#include <djvImage/Info.h>
+
+#include <sstream>
+
+using namespace djv::Core;
+using namespace djv::Image;
+
+namespace djv
+{
+    namespace ImageTest
+    {
+        DataPoolTest::DataPoolTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::ImageTest::DataPoolTest", tempPath, context)
+        {}
+        
+        void DataPoolTest::run()
+        {
+            _sizeClass();
+            _pool();
+            _maxByteCount();
+            _data();
+        }
+
+        void DataPoolTest::_sizeClass()
+        {
+            DJV_ASSERT(1 == DataPool::getSizeClass(1));
+            DJV_ASSERT(DataPool::minByteCount == DataPool::getSizeClass(DataPool::minByteCount));
+            for (size_t i : { DataPool::minByteCount + 1, static_cast<size_t>(1000000), static_cast<size_t>(3840 * 2160 * 4 * 2) })
+            {
+                const size_t sizeClass = DataPool::getSizeClass(i);
+                std::stringstream ss;
+                ss << "size class " << i << ": " << sizeClass;
+                _print(ss.str());
+                DJV_ASSERT(sizeClass >= i);
+                DJV_ASSERT(sizeClass - i <= i / 8);
+                DJV_ASSERT(sizeClass == DataPool::getSizeClass(sizeClass));
+            }
+        }
+        
+        void DataPoolTest::_pool()
+        {
+            auto pool = DataPool::create();
+            const size_t byteCount = DataPool::minByteCount * 3;
+            size_t bufferByteCount = 0;
+            uint8_t* data = pool->get(byteCount, bufferByteCount);
+            DJV_ASSERT(data);
+            DJV_ASSERT(bufferByteCount >= byteCount);
+            DJV_ASSERT(0 == pool->getStats().hitCount);
+            DJV_ASSERT(1 == pool->getStats().missCount);
+
+            pool->release(data, bufferByteCount);
+            DJV_ASSERT(1 == pool->getStats().count);
+            DJV_ASSERT(bufferByteCount == pool->getStats().byteCount);
+
+            size_t bufferByteCount2 = 0;
+            uint8_t* data2 = pool->get(byteCount - 1, bufferByteCount2);
+            DJV_ASSERT(data == data2);
+            DJV_ASSERT(bufferByteCount == bufferByteCount2);
+            DJV_ASSERT(1 == pool->getStats().hitCount);
+            DJV_ASSERT(0 == pool->getStats().count);
+            pool->release(data2, bufferByteCount2);
+
+            // Small buffers are not pooled.
+            data = pool->get(1, bufferByteCount);
+            DJV_ASSERT(data);
+            pool->release(data, bufferByteCount);
+            DJV_ASSERT(1 == pool->getStats().count);
+
+            pool->clear();
+            DJV_ASSERT(0 == pool->getStats().count);
+            DJV_ASSERT(0 == pool->getStats().byteCount);
+
+            pool->setHugePageByteCount(byteCount);
+            DJV_ASSERT(byteCount == pool->getHugePageByteCount());
+            data = pool->get(byteCount, bufferByteCount);
+            DJV_ASSERT(0 == reinterpret_cast<uintptr_t>(data) % dataAlignment);
+            pool->release(data, bufferByteCount);
+        }
+        
+        void DataPoolTest::_maxByteCount()
+        {
+            const size_t byteCount = DataPool::minByteCount;
+            auto pool = DataPool::create(byteCount * 2);
+            DJV_ASSERT(byteCount * 2 == pool->getMaxByteCount());
+            std::vector<std::pair<uint8_t*, size_t> > buffers;
+            for (size_t i = 0; i < 3; ++i)
+            {
+                size_t bufferByteCount = 0;
+                uint8_t* data = pool->get(byteCount, bufferByteCount);
+                buffers.push_back(std::make_pair(data, bufferByteCount));
+            }
+            for (const auto& i : buffers)
+            {
+                pool->release(i.first, i.second);
+            }
+            DJV_ASSERT(2 == pool->getStats().count);
+            DJV_ASSERT(1 == pool->getStats().freeCount);
+
+            pool->setMaxByteCount(0);
+            DJV_ASSERT(0 == pool->getStats().count);
+        }
+        
+        void DataPoolTest::_data()
+        {
+            const auto& pool = DataPool::getGlobal();
+            pool->clear();
+            const Info info(512, 512, Type::RGBA_U8);
+            const auto stats = pool->getStats();
+            {
+                auto data = Data::create(info);
+            }
+            for (size_t i = 0; i < 10; ++i)
+            {
+                auto data = Data::create(info);
+                DJV_ASSERT(data->getData());
+                DJV_ASSERT(0 == reinterpret_cast<uintptr_t>(data->getData()) % dataAlignment);
+            }
+            DJV_ASSERT(stats.missCount + 1 == pool->getStats().missCount);
+            DJV_ASSERT(stats.hitCount + 10 == pool->getStats().hitCount);
+        }
+        
+    } // namespace ImageTest
+} // namespace djv
@@ -51,6 +51,7 @@ namespace djv
                 const Image::Layout layout;
                 DJV_ASSERT(1 == layout.alignment);
                 DJV_ASSERT(Memory::getEndian() == layout.endian);
+                DJV_ASSERT(!layout.rowPadding);
             }
 
             {
@@ -64,6 +65,12 @@ namespace djv
                 DJV_ASSERT(4 == layout.alignment);
                 DJV_ASSERT(endian == layout.endian);
             }
+
+            {
+                const Image::Layout layout(Image::Mirror(), 1, Memory::getEndian(), true);
+                DJV_ASSERT(layout.rowPadding);
+                DJV_ASSERT(layout != Image::Layout());
+            }
         }
         
         void InfoTest::_size()
@@ -184,6 +191,22 @@ namespace djv
                     _print(ss.str());
                 }
             }
+
+            {
+                Image::Layout layout;
+                layout.rowPadding = true;
+                for (auto type : { Image::Type::L_U8, Image::Type::RGB_U8, Image::Type::RGB_U16, Image::Type::RGB_F32, Image::Type::RGBA_F32 })
+                {
+                    const Image::Info info(101, 2, type, layout);
+                    const size_t scanlineByteCount = info.getScanlineByteCount();
+                    DJV_ASSERT(scanlineByteCount >= info.size.w * info.getPixelByteCount());
+                    DJV_ASSERT(0 == scanlineByteCount % Image::dataAlignment);
+                    DJV_ASSERT(0 == scanlineByteCount % info.getPixelByteCount());
+                    DJV_ASSERT(scanlineByteCount / info.getPixelByteCount() == static_cast<size_t>(info.getGLRowLength()));
+                    DJV_ASSERT(info.size.h * scanlineByteCount == info.getDataByteCount());
+                }
+                DJV_ASSERT(0 == Image::Info(101, 2, Image::Type::RGB_U8).getGLRowLength());
+            }
         }
 
     } // namespace ImageTest
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvSystemTest/FileAsyncIOTest.h>
+
+#include <djvSystem/FileAsyncIO.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/Path.h>
+#include <djvSystem/ThreadPool.h>
+
+#include <djvCore/ErrorFunc.h>
+
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+using namespace djv::Core;
+using namespace djv::System;
+
+namespace djv
+{
+    namespace SystemTest
+    {
+        namespace
+        {
+            const size_t blockSize  = 4096;
+            const size_t blockCount = 256;
+
+        } // namespace
+
+        FileAsyncIOTest::FileAsyncIOTest(
+            const File::Path& tempPath,
+            const std::shared_ptr<Context>& context) :
+            ITest(
+                "djv::SystemTest::FileAsyncIOTest",
+                File::Path(tempPath, "FileAsyncIOTest"),
+                context)
+        {}
+                
+        void FileAsyncIOTest::run()
+        {
+            _read();
+            _callback();
+            _error();
+        }
+
+        void FileAsyncIOTest::_read()
+        {
+            std::vector<uint8_t> data(blockSize * blockCount);
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                data[i] = static_cast<uint8_t>(i * 7);
+            }
+            const std::string fileName = File::Path(getTempPath(), "read.bin").get();
+            auto io = File::IO::create();
+            io->open(fileName, File::Mode::Write);
+            io->write(data.data(), data.size());
+            io->open(fileName, File::Mode::Read);
+
+            {
+                std::vector<uint8_t> buf(blockSize);
+                io->readAt(blockSize, buf.data(), blockSize);
+                DJV_ASSERT(0 == memcmp(buf.data(), data.data() + blockSize, blockSize));
+                DJV_ASSERT(0 == io->getPos());
+            }
+
+            for (size_t queueDepth : { 1, 8, 64 })
+            {
+                auto threadPool = ThreadPool::create(2);
+                auto asyncIO = File::AsyncIO::create(threadPool, queueDepth);
+                {
+                    std::stringstream ss;
+                    ss << "backend: " << static_cast<int>(asyncIO->getBackend());
+                    _print(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << "queue depth: " << asyncIO->getQueueDepth();
+                    _print(ss.str());
+                }
+                DJV_ASSERT(asyncIO->getQueueDepth() <= queueDepth);
+
+                std::vector<std::vector<uint8_t> > bufs(blockCount, std::vector<uint8_t>(blockSize));
+                std::vector<File::ReadRequest> requests;
+                for (size_t i = 0; i < blockCount; ++i)
+                {
+                    requests.push_back(File::ReadRequest(io, i * blockSize, blockSize, bufs[i].data()));
+                }
+                auto futures = asyncIO->read(requests);
+                DJV_ASSERT(blockCount == futures.size());
+                for (size_t i = 0; i < blockCount; ++i)
+                {
+                    futures[i].get();
+                    DJV_ASSERT(0 == memcmp(bufs[i].data(), data.data() + i * blockSize, blockSize));
+                }
+
+                const auto stats = asyncIO->getStats();
+                DJV_ASSERT(blockCount == stats.submitted);
+                DJV_ASSERT(blockCount == stats.completed);
+                DJV_ASSERT(0 == stats.inFlight);
+                DJV_ASSERT(data.size() == stats.byteCount);
+            }
+        }
+
+        void FileAsyncIOTest::_callback()
+        {
+            const std::string fileName = File::Path(getTempPath(), "callback.bin").get();
+            auto io = File::IO::create();
+            io->open(fileName, File::Mode::Write);
+            const std::string text = "Hello world!";
+            io->write(text);
+            io->open(fileName, File::Mode::Read);
+
+            std::atomic<size_t> count(0);
+            std::vector<char> buf(text.size());
+            {
+                auto asyncIO = File::AsyncIO::create();
+                asyncIO->read(
+                    File::ReadRequest(io, 0, text.size(), buf.data()),
+                    [&count](const std::exception_ptr& error)
+                    {
+                        if (!error)
+                        {
+                            ++count;
+                        }
+                    });
+            }
+            DJV_ASSERT(1 == count);
+            DJV_ASSERT(text == std::string(buf.data(), buf.size()));
+        }
+
+        void FileAsyncIOTest::_error()
+        {
+            const std::string fileName = File::Path(getTempPath(), "error.bin").get();
+            auto io = File::IO::create();
+            io->open(fileName, File::Mode::Write);
+            io->write(std::string("Hello world!"));
+            io->open(fileName, File::Mode::Read);
+
+            auto asyncIO = File::AsyncIO::create();
+            std::vector<uint8_t> buf(100);
+            try
+            {
+                asyncIO->read(File::ReadRequest(io, 0, buf.size(), buf.data())).get();
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(Error::format(e));
+            }
+            try
+            {
+                asyncIO->read(File::ReadRequest(nullptr, 0, buf.size(), buf.data())).get();
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(Error::format(e));
+            }
+        }
+        
+    } // namespace SystemTest
+} // namespace djv
+
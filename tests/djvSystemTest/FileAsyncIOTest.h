@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace SystemTest
+    {
+        class FileAsyncIOTest : public Test::ITest
+        {
+        public:
+            FileAsyncIOTest(
+                const System::File::Path& tempPath,
+                const std::shared_ptr<System::Context>&);
+            
+            void run() override;
+
+        private:
+            void _read();
+            void _callback();
+            void _error();
+        };
+        
+    } // namespace SystemTest
+} // namespace djv
+
@@ -7,6 +7,8 @@
 #include <djvSystem/FileFunc.h>
 #include <djvSystem/Path.h>
 
+#include <sstream>
+
 using namespace djv::Core;
 using namespace djv::System;
 
@@ -25,9 +27,21 @@ namespace djv
         
         void FileFuncTest::run()
         {
-            FILE* f = File::fopen(File::Path(getTempPath(), "file.txt").get().c_str(), "w");
+            const std::string fileName = File::Path(getTempPath(), "file.txt").get();
+            FILE* f = File::fopen(fileName.c_str(), "w");
             DJV_ASSERT(f);
             fclose(f);
+            
+            {
+                for (auto i : { File::Advice::WillNeed, File::Advice::DontNeed })
+                {
+                    const bool r = File::advise(fileName, i);
+                    std::stringstream ss;
+                    ss << "advise: " << r;
+                    _print(ss.str());
+                }
+                DJV_ASSERT(!File::advise(File::Path(getTempPath(), "missing.txt").get(), File::Advice::WillNeed));
+            }
         }
         
     } // namespace SystemTest
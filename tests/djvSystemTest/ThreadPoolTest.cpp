@@ -0,0 +1,211 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvSystemTest/ThreadPoolTest.h>
+
+#include <djvSystem/ThreadPool.h>
+
+#include <djvCore/UIDFunc.h>
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace djv::Core;
+using namespace djv::System;
+
+namespace djv
+{
+    namespace SystemTest
+    {
+        ThreadPoolTest::ThreadPoolTest(
+            const File::Path& tempPath,
+            const std::shared_ptr<Context>& context) :
+            ITest("djv::SystemTest::ThreadPoolTest", tempPath, context)
+        {}
+                
+        void ThreadPoolTest::run()
+        {
+            _submit();
+            _priority();
+            _cancel();
+            _stats();
+        }
+
+        void ThreadPoolTest::_submit()
+        {
+            {
+                auto threadPool = ThreadPool::create();
+                DJV_ASSERT(threadPool->getThreadCount() > 0);
+            }
+
+            {
+                auto threadPool = ThreadPool::create(4);
+                DJV_ASSERT(4 == threadPool->getThreadCount());
+                std::vector<std::future<int> > futures;
+                for (int i = 0; i < 100; ++i)
+                {
+                    futures.push_back(threadPool->submit(
+                        [i]
+                        {
+                            return i * 2;
+                        }));
+                }
+                for (int i = 0; i < 100; ++i)
+                {
+                    DJV_ASSERT(i * 2 == futures[i].get());
+                }
+            }
+
+            {
+                // Submit jobs from inside a job.
+                auto threadPool = ThreadPool::create(2);
+                auto threadPoolPtr = threadPool.get();
+                auto future = threadPool->submit(
+                    [threadPoolPtr]
+                    {
+                        return threadPoolPtr->submit(
+                            []
+                            {
+                                return 1;
+                            });
+                    });
+                DJV_ASSERT(1 == future.get().get());
+            }
+        }
+
+        void ThreadPoolTest::_priority()
+        {
+            auto threadPool = ThreadPool::create(1);
+
+            // Block the worker so the following jobs are queued.
+            std::atomic<bool> block(true);
+            auto blockFuture = threadPool->submit(
+                [&block]
+                {
+                    while (block)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                });
+            while (threadPool->getStats().activeCount < 1)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            std::mutex mutex;
+            std::vector<ThreadPool::Priority> order;
+            std::vector<std::future<void> > futures;
+            for (auto priority : { ThreadPool::Priority::Low, ThreadPool::Priority::Normal, ThreadPool::Priority::High })
+            {
+                futures.push_back(threadPool->submit(
+                    [&mutex, &order, priority]
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        order.push_back(priority);
+                    },
+                    priority));
+            }
+            block = false;
+            blockFuture.get();
+            for (auto& i : futures)
+            {
+                i.get();
+            }
+            DJV_ASSERT(3 == order.size());
+            DJV_ASSERT(ThreadPool::Priority::High == order[0]);
+            DJV_ASSERT(ThreadPool::Priority::Normal == order[1]);
+            DJV_ASSERT(ThreadPool::Priority::Low == order[2]);
+        }
+
+        void ThreadPoolTest::_cancel()
+        {
+            auto threadPool = ThreadPool::create(1);
+
+            std::atomic<bool> block(true);
+            auto blockFuture = threadPool->submit(
+                [&block]
+                {
+                    while (block)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                });
+            while (threadPool->getStats().activeCount < 1)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            const UID group = createUID();
+            std::vector<std::future<int> > futures;
+            for (int i = 0; i < 10; ++i)
+            {
+                futures.push_back(threadPool->submit(
+                    [i]
+                    {
+                        return i;
+                    },
+                    ThreadPool::Priority::Normal,
+                    group));
+            }
+            auto future = threadPool->submit(
+                []
+                {
+                    return 1;
+                });
+            DJV_ASSERT(0 == threadPool->cancel(0));
+            DJV_ASSERT(10 == threadPool->cancel(group));
+            block = false;
+            blockFuture.get();
+            for (auto& i : futures)
+            {
+                try
+                {
+                    i.get();
+                    DJV_ASSERT(false);
+                }
+                catch (const std::future_error&)
+                {}
+            }
+            DJV_ASSERT(1 == future.get());
+            DJV_ASSERT(10 == threadPool->getStats().cancelled);
+        }
+
+        void ThreadPoolTest::_stats()
+        {
+            auto threadPool = ThreadPool::create(2);
+            std::vector<std::future<void> > futures;
+            for (int i = 0; i < 10; ++i)
+            {
+                futures.push_back(threadPool->submit(
+                    []
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    }));
+            }
+            for (auto& i : futures)
+            {
+                i.get();
+            }
+            const auto stats = threadPool->getStats();
+            DJV_ASSERT(2 == stats.threadCount);
+            DJV_ASSERT(0 == stats.queueCount);
+            DJV_ASSERT(stats.completed <= 10);
+            DJV_ASSERT(stats.utilization >= 0.F && stats.utilization <= 100.F);
+            {
+                std::stringstream ss;
+                ss << "Completed: " << stats.completed;
+                _print(ss.str());
+            }
+            {
+                std::stringstream ss;
+                ss << "Utilization: " << stats.utilization << "%";
+                _print(ss.str());
+            }
+        }
+        
+    } // namespace SystemTest
+} // namespace djv
+
@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace SystemTest
+    {
+        class ThreadPoolTest : public Test::ITest
+        {
+        public:
+            ThreadPoolTest(
+                const System::File::Path& tempPath,
+                const std::shared_ptr<System::Context>&);
+            
+            void run() override;
+
+        private:
+            void _submit();
+            void _priority();
+            void _cancel();
+            void _stats();
+        };
+        
+    } // namespace SystemTest
+} // namespace djv
+
@@ -40,6 +40,7 @@
 #include <djvSystemTest/EventFuncTest.h>
 #include <djvSystemTest/EventTest.h>
 #include <djvSystemTest/FileFuncTest.h>
+#include <djvSystemTest/FileAsyncIOTest.h>
 #include <djvSystemTest/FileIOFuncTest.h>
 #include <djvSystemTest/FileIOTest.h>
 #include <djvSystemTest/FileInfoFuncTest.h>
@@ -52,12 +53,15 @@
 #include <djvSystemTest/PathTest.h>
 #include <djvSystemTest/RecentFilesModelTest.h>
 #include <djvSystemTest/TextSystemTest.h>
+#include <djvSystemTest/ThreadPoolTest.h>
 #include <djvSystemTest/TimerFuncTest.h>
 #include <djvSystemTest/TimerTest.h>
 
 #include <djvImageTest/ColorFuncTest.h>
 #include <djvImageTest/ColorTest.h>
+#include <djvImageTest/ConvertTest.h>
 #include <djvImageTest/DataFuncTest.h>
+#include <djvImageTest/DataPoolTest.h>
 #include <djvImageTest/DataTest.h>
 #include <djvImageTest/InfoFuncTest.h>
 #include <djvImageTest/InfoTest.h>
@@ -70,8 +74,10 @@
 #include <djvAudioTest/DataFuncTest.h>
 #include <djvAudioTest/DataTest.h>
 #include <djvAudioTest/InfoTest.h>
+#include <djvAudioTest/RingBufferTest.h>
 #include <djvAudioTest/TypeFuncTest.h>
 #include <djvAudioTest/TypeTest.h>
+#include <djvAudioTest/WaveformTest.h>
 
 #include <djvGeomTest/ShapeTest.h>
 #include <djvGeomTest/TriangleMeshFuncTest.h>
@@ -208,6 +214,7 @@ int main(int argc, char ** argv)
         tests.emplace_back(new SystemTest::EventFuncTest(tempPath, context));
         tests.emplace_back(new SystemTest::EventTest(tempPath, context));
         tests.emplace_back(new SystemTest::FileFuncTest(tempPath, context));
+        tests.emplace_back(new SystemTest::FileAsyncIOTest(tempPath, context));
         tests.emplace_back(new SystemTest::FileIOFuncTest(tempPath, context));
         tests.emplace_back(new SystemTest::FileIOTest(tempPath, context));
         tests.emplace_back(new SystemTest::FileInfoFuncTest(tempPath, context));
@@ -220,12 +227,15 @@ int main(int argc, char ** argv)
         tests.emplace_back(new SystemTest::PathTest(tempPath, context));
         tests.emplace_back(new SystemTest::RecentFilesModelTest(tempPath, context));
         tests.emplace_back(new SystemTest::TextSystemTest(tempPath, context));
+        tests.emplace_back(new SystemTest::ThreadPoolTest(tempPath, context));
         tests.emplace_back(new SystemTest::TimerFuncTest(tempPath, context));
         tests.emplace_back(new SystemTest::TimerTest(tempPath, context));
 
         tests.emplace_back(new ImageTest::ColorFuncTest(tempPath, context));
         tests.emplace_back(new ImageTest::ColorTest(tempPath, context));
+        tests.emplace_back(new ImageTest::ConvertTest(tempPath, context));
         tests.emplace_back(new ImageTest::DataFuncTest(tempPath, context));
+        tests.emplace_back(new ImageTest::DataPoolTest(tempPath, context));
         tests.emplace_back(new ImageTest::DataTest(tempPath, context));
         tests.emplace_back(new ImageTest::InfoTest(tempPath, context));
         tests.emplace_back(new ImageTest::InfoFuncTest(tempPath, context));
@@ -238,8 +248,10 @@ int main(int argc, char ** argv)
         tests.emplace_back(new AudioTest::DataFuncTest(tempPath, context));
         tests.emplace_back(new AudioTest::DataTest(tempPath, context));
         tests.emplace_back(new AudioTest::InfoTest(tempPath, context));
+        tests.emplace_back(new AudioTest::RingBufferTest(tempPath, context));
         tests.emplace_back(new AudioTest::TypeFuncTest(tempPath, context));
         tests.emplace_back(new AudioTest::TypeTest(tempPath, context));
+        tests.emplace_back(new AudioTest::WaveformTest(tempPath, context));
 
         tests.emplace_back(new GeomTest::ShapeTest(tempPath, context));
         tests.emplace_back(new GeomTest::TriangleMeshFuncTest(tempPath, context));